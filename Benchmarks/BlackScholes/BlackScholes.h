@@ -59,6 +59,8 @@ public:
                                 FieldIn, FieldOut, FieldOut);
   typedef void ExecutionSignature(_6,_7,_1,_2,_3,_4,_5);
 
+  static const int BATCH_SIZE = 8;
+
   DAX_EXEC_EXPORT
   void operator()(dax::Scalar& callResult, dax::Scalar& putResult,
                 const dax::Scalar stockPrice, const dax::Scalar optionStrike,
@@ -84,6 +86,23 @@ public:
   putResult = X * expRT * (1.0f - CNDD2) - S * (1.0f - CNDD1);
   }
 
+  // Invoked on BATCH_SIZE consecutive options at a time so that the
+  // compiler sees a fixed length loop over contiguous values.
+  typedef dax::Tuple<dax::Scalar,BATCH_SIZE> ScalarBatch;
+  DAX_EXEC_EXPORT
+  void operator()(ScalarBatch& callResult, ScalarBatch& putResult,
+                const ScalarBatch& stockPrice, const ScalarBatch& optionStrike,
+                const ScalarBatch& optionYears, const ScalarBatch& Riskfree,
+                const ScalarBatch& Volatility) const
+  {
+  for (int lane = 0; lane < BATCH_SIZE; ++lane)
+    {
+    (*this)(callResult[lane], putResult[lane],
+            stockPrice[lane], optionStrike[lane], optionYears[lane],
+            Riskfree[lane], Volatility[lane]);
+    }
+  }
+
 };
 
 }
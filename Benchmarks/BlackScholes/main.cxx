@@ -56,6 +56,54 @@ void initOptions(std::vector<dax::Scalar> &price,
     }
 }
 
+// Compares the results of the batched dispatch against invoking the scalar
+// operator of the worklet on each option.
+bool checkResults(const std::vector<dax::Scalar> &price,
+                  const std::vector<dax::Scalar> &strike,
+                  const std::vector<dax::Scalar> &years,
+                  const std::vector<dax::Scalar> &callResult,
+                  const std::vector<dax::Scalar> &putResult)
+{
+  const dax::Scalar  RISKFREE = 0.02f;
+  const dax::Scalar  VOLATILITY = 0.30f;
+  const dax::Scalar  TOLERANCE = 1e-5f;
+
+  worklet::BlackScholes blackScholes;
+  for (std::size_t i = 0; i < price.size(); i++)
+    {
+    dax::Scalar call, put;
+    blackScholes(call, put, price[i], strike[i], years[i],
+                 RISKFREE, VOLATILITY);
+    if (fabs(call - callResult[i]) > TOLERANCE * std::max(1.0f, fabsf(call))
+        || fabs(put - putResult[i]) > TOLERANCE * std::max(1.0f, fabsf(put)))
+      {
+      printf("Option %i differs from the scalar result\n",
+             static_cast<int>(i));
+      return false;
+      }
+    }
+  return true;
+}
+
+// Runs an options set whose size is not a multiple of the batch size so
+// that the options left over at the end are checked too.
+bool checkRemainder()
+{
+  const dax::Id OPT_N = 1021;
+
+  std::vector<dax::Scalar> stockPrice(OPT_N);
+  std::vector<dax::Scalar> optionStrike(OPT_N);
+  std::vector<dax::Scalar> optionYears(OPT_N);
+  std::vector<dax::Scalar> callResult(OPT_N);
+  std::vector<dax::Scalar> putResult(OPT_N);
+
+  initOptions(stockPrice, optionStrike, optionYears);
+  launchBlackScholes(stockPrice, optionStrike, optionYears,
+                     callResult, putResult);
+  return checkResults(stockPrice, optionStrike, optionYears,
+                      callResult, putResult);
+}
+
 
 int main(int, char **)
 {
@@ -82,5 +130,11 @@ int main(int, char **)
         ((double)(5 * OPT_N * sizeof(dax::Scalar)) * 1E-9) / time);
   printf("Gigaoptions per second    : %f     \n\n",
         ((double)(2 * OPT_N) * 1E-9) / time);
+
+  if (!checkResults(stockPrice, optionStrike, optionYears,
+                    callResult, putResult) || !checkRemainder())
+    {
+    return 1;
+    }
   return 0;
 }
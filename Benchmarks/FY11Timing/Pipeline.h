@@ -17,9 +17,9 @@
 #include <iostream>
 
 #include <dax/cont/ArrayHandle.h>
-#include <dax/cont/ArrayHandleTransform.h>
 #include <dax/cont/DispatcherMapCell.h>
 #include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/PipelineMapField.h>
 #include <dax/cont/Timer.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/VectorOperations.h>
@@ -36,23 +36,6 @@
 #define MAKE_STRING1(x) MAKE_STRING2(x)
 #define DEVICE_ADAPTER MAKE_STRING1(DAX_DEFAULT_DEVICE_ADAPTER_TAG)
 
-namespace worklets
-{
-struct MagWrapper
-{
-  //dax::worklet::Magnitude isn't a unary function, so
-  //we have to wrap it
-  DAX_EXEC_EXPORT
-  dax::Scalar operator()(dax::Vector3 inValue) const
-  {
-    dax::Scalar result;
-    dax::worklet::Magnitude()(inValue,result);
-    return result;
-  }
-};
-
-}
-
 namespace
 {
 
@@ -225,27 +208,15 @@ void RunPipeline4(const dax::cont::UniformGrid<> &grid)
 
   dax::cont::Timer<> timer;
 
-  //fuse the first three worklets into the transform handle instead of
-  //explicitly calling each of them, only the cosine worklet will be called
-  typedef dax::cont::ArrayHandleTransform< dax::Scalar,
-          dax::cont::UniformGrid<>::PointCoordinatesType,
-          ::worklets::MagWrapper > MagnitudeHandle;
-
-  typedef dax::cont::ArrayHandleTransform< dax::Scalar,
-          MagnitudeHandle,
-          dax::worklet::Sine > SineFusedHandle;
-
-  typedef dax::cont::ArrayHandleTransform< dax::Scalar,
-          SineFusedHandle,
-          dax::worklet::Square > SquareFusedHandle;
+  //fuse all four worklets into a single worklet, so the intermediate values
+  //are never written to an array
+  typedef dax::cont::PipelineMapField<
+      dax::exec::PipelineStage<dax::worklet::Magnitude, dax::Scalar>,
+      dax::worklet::Sine,
+      dax::worklet::Square,
+      dax::worklet::Cosine> FusedPipeline;
 
-  MagnitudeHandle mag(grid.GetPointCoordinates());
-
-  SineFusedHandle sine(mag);
-  SquareFusedHandle fused(sine);
-
-  dax::cont::DispatcherMapField< dax::worklet::Cosine>().Invoke(fused,
-                                                                results);
+  FusedPipeline().Invoke(grid.GetPointCoordinates(), results);
 
   double time = timer.GetElapsedTime();
 
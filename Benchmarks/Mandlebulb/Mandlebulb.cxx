@@ -98,6 +98,13 @@ mandle::MandlebulbVolume computeMandlebulb( dax::Vector3 origin,
             << " sec (" << vol.Grid.GetNumberOfPoints() << " points)"
             << std::endl;
 
+  //summarize the field once, every surface extraction reuses it
+  timer.Reset();
+  vol.EscapeRanges.Build(vol.Grid, vol.EscapeIteration);
+  std::cout << "Compute Brick Ranges: " << timer.GetElapsedTime()
+            << " sec (" << vol.EscapeRanges.GetNumberOfBricks() << " bricks)"
+            << std::endl;
+
   return vol;
 }
 
@@ -111,10 +118,10 @@ mandle::MandlebulbSurface extractSurface( mandle::MandlebulbVolume& vol,
   dax::cont::ArrayHandle<dax::Id> count;
 
   dax::cont::Timer<> timer;
-  //run the classify step
-  dax::cont::DispatcherMapCell< ::dax::worklet::MarchingCubesCount >
-        classify( (::dax::worklet::MarchingCubesCount(iteration)) );
-  classify.Invoke(vol.Grid, vol.EscapeIteration, count );
+  //run the classify step, skipping the bricks the surface can't pass through
+  vol.EscapeRanges.CountCells(::dax::worklet::MarchingCubesCount(iteration),
+                              vol.EscapeIteration,
+                              count );
 
 
   std::cout << "mc stage 1: " << timer.GetElapsedTime() << " sec" << std::endl;
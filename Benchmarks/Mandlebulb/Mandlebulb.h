@@ -17,6 +17,7 @@
 #define __dax__benchmarks_Mandlebulb_h
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/BrickRanges.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 
@@ -44,6 +45,10 @@ namespace mandle
 
   dax::cont::UniformGrid< > Grid;
   dax::cont::ArrayHandle<dax::Scalar> EscapeIteration;
+
+  //min and max escape iteration of each brick of cells, so that extracting
+  //a surface only visits the bricks that can hold part of it
+  dax::cont::BrickRanges< > EscapeRanges;
   };
 
   class MandlebulbSurface
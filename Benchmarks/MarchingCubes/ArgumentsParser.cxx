@@ -96,6 +96,10 @@ bool dax::testing::ArgumentsParser::parseArguments(int argc, char* argv[])
       {
       this->Pipeline = MARCHING_CUBES_REMOVE_DUPLICATES;
       }
+    if (pipelineflag == 4)
+      {
+      this->Pipeline = FLYING_EDGES;
+      }
     }
 
   delete[] options;
@@ -32,8 +32,8 @@ public:
   enum PipelineMode
     {
     MARCHING_CUBES = 1,
-    MARCHING_CUBES_REMOVE_DUPLICATES = 2
-
+    MARCHING_CUBES_REMOVE_DUPLICATES = 2,
+    FLYING_EDGES = 4
     };
   PipelineMode pipeline() const
     { return this->Pipeline; }
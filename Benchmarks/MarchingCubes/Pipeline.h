@@ -25,6 +25,7 @@
 #include <dax/cont/UnstructuredGrid.h>
 #include <dax/cont/VectorOperations.h>
 
+#include <dax/worklet/FlyingEdges.h>
 #include <dax/worklet/Magnitude.h>
 #include <dax/worklet/MarchingCubes.h>
 
@@ -48,8 +49,39 @@ void PrintResults(int pipeline, double time)
             << pipeline << "," << time << std::endl;
 }
 
+void RunFlyingEdgesPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
+{
+  std::cout << "Running pipeline " << pipeline << ": Magnitude -> FlyingEdges" << std::endl;
+
+  dax::cont::UnstructuredGrid<dax::CellTagTriangle> outGrid;
+
+  dax::cont::ArrayHandle<dax::Scalar> intermediate1;
+  dax::cont::DispatcherMapField< dax::worklet::Magnitude > magDispatcher;
+  magDispatcher.Invoke( grid.GetPointCoordinates(), intermediate1);
+
+  dax::cont::Timer<> timer;
+
+  //every cut edge gets a single point, so the output matches marching cubes
+  //with duplicate points removed
+  dax::worklet::FlyingEdges<> flyingEdges(ISOVALUE);
+  flyingEdges.Run(grid, intermediate1, outGrid);
+
+  double time = timer.GetElapsedTime();
+
+  std::cout << "number of coordinates in: " << grid.GetNumberOfPoints() << std::endl;
+  std::cout << "number of coordinates out: " << outGrid.GetNumberOfPoints() << std::endl;
+  std::cout << "number of cells out: " << outGrid.GetNumberOfCells() << std::endl;
+  PrintResults(pipeline, time);
+}
+
 void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
 {
+  if (pipeline == dax::testing::ArgumentsParser::FLYING_EDGES)
+    {
+    RunFlyingEdgesPipeline(grid, pipeline);
+    return;
+    }
+
   std::cout << "Running pipeline " << pipeline << ": Magnitude -> MarchingCubes" << std::endl;
 
   dax::cont::UnstructuredGrid<dax::CellTagTriangle> outGrid;
@@ -61,16 +93,21 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
   dax::cont::Timer<> timer;
 
   //dispatch marching cubes worklet generate step
-  typedef dax::cont::DispatcherGenerateInterpolatedCells< dax::worklet::MarchingCubesGenerate > DispatcherIC;
+  typedef dax::cont::DispatcherGenerateInterpolatedCells<
+      dax::worklet::MarchingCubesGenerateFromCase > DispatcherIC;
   typedef DispatcherIC::CountHandleType  CountHandleType;
+  typedef dax::cont::ArrayHandle<
+      dax::worklet::MarchingCubesClassify::CaseType> CaseHandleType;
 
-  dax::worklet::MarchingCubesCount classifyWorklet(ISOVALUE);
-  dax::worklet::MarchingCubesGenerate generateWorklet(ISOVALUE);
+  dax::worklet::MarchingCubesClassify classifyWorklet(ISOVALUE);
+  dax::worklet::MarchingCubesGenerateFromCase generateWorklet(ISOVALUE);
 
-  //run the first step
+  //run the first step, keeping the case of each cell for the second step
   CountHandleType count; //array handle for the first step count
-  dax::cont::DispatcherMapCell<dax::worklet::MarchingCubesCount > cellDispatcher( classifyWorklet );
-  cellDispatcher.Invoke(grid, intermediate1, count);
+  CaseHandleType caseIds;
+  dax::cont::DispatcherMapCell<dax::worklet::MarchingCubesClassify >
+      cellDispatcher( classifyWorklet );
+  cellDispatcher.Invoke(grid, intermediate1, count, caseIds);
 
   //construct the topology generation worklet
   DispatcherIC icDispatcher(count, generateWorklet );
@@ -78,7 +115,10 @@ void RunDAXPipeline(const dax::cont::UniformGrid<> &grid, int pipeline)
                 pipeline == dax::testing::ArgumentsParser::MARCHING_CUBES_REMOVE_DUPLICATES);
 
   //run the second step
-  icDispatcher.Invoke(grid, outGrid, intermediate1);
+  icDispatcher.Invoke(grid,
+                      outGrid,
+                      caseIds,
+                      dax::worklet::make_MarchingCubesPointField(intermediate1));
 
   double time = timer.GetElapsedTime();
 
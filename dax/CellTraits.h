@@ -73,6 +73,12 @@ struct CellTraits
   ///
   typedef dax::CellTagHexahedron CanonicalCellTag;
 
+  /// A number identifying the cell type when it is not known at compile time,
+  /// such as in the shapes array of a dax::cont::UnstructuredGridMixed. The
+  /// numbers match the cell types of VTK.
+  ///
+  const static dax::Id SHAPE_ID = 12;
+
 };
 #else // DAX_DOXYGEN_ONLY
     ;
@@ -86,6 +92,7 @@ template<> struct CellTraits<dax::CellTagHexahedron> {
   typedef dax::CellTopologicalDimensionsTag<3> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagHexahedron CanonicalCellTag;
+  const static dax::Id SHAPE_ID = 12;
 };
 
 template<> struct CellTraits<dax::CellTagLine> {
@@ -94,6 +101,7 @@ template<> struct CellTraits<dax::CellTagLine> {
   typedef dax::CellTopologicalDimensionsTag<1> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagLine CanonicalCellTag;
+  const static dax::Id SHAPE_ID = 3;
 };
 
 template<> struct CellTraits<dax::CellTagQuadrilateral> {
@@ -102,6 +110,7 @@ template<> struct CellTraits<dax::CellTagQuadrilateral> {
   typedef dax::CellTopologicalDimensionsTag<2> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagQuadrilateral CanonicalCellTag;
+  const static dax::Id SHAPE_ID = 9;
 };
 
 template<> struct CellTraits<dax::CellTagTetrahedron> {
@@ -110,6 +119,7 @@ template<> struct CellTraits<dax::CellTagTetrahedron> {
   typedef dax::CellTopologicalDimensionsTag<3> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagTetrahedron CanonicalCellTag;
+  const static dax::Id SHAPE_ID = 10;
 };
 
 template<> struct CellTraits<dax::CellTagTriangle> {
@@ -118,6 +128,7 @@ template<> struct CellTraits<dax::CellTagTriangle> {
   typedef dax::CellTopologicalDimensionsTag<2> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagTriangle CanonicalCellTag;
+  const static dax::Id SHAPE_ID = 5;
 };
 
 template<> struct CellTraits<dax::CellTagVertex> {
@@ -126,6 +137,7 @@ template<> struct CellTraits<dax::CellTagVertex> {
   typedef dax::CellTopologicalDimensionsTag<0> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagVertex CanonicalCellTag;
+  const static dax::Id SHAPE_ID = 1;
 };
 
 template<> struct CellTraits<dax::CellTagVoxel> {
@@ -134,6 +146,7 @@ template<> struct CellTraits<dax::CellTagVoxel> {
   typedef dax::CellTopologicalDimensionsTag<3> TopologicalDimensionsTag;
   typedef dax::GridTagUniform GridTag;
   typedef dax::CellTagHexahedron CanonicalCellTag;
+  const static dax::Id SHAPE_ID = 11;
 };
 
 template<> struct CellTraits<dax::CellTagWedge> {
@@ -142,6 +155,7 @@ template<> struct CellTraits<dax::CellTagWedge> {
   typedef dax::CellTopologicalDimensionsTag<3> TopologicalDimensionsTag;
   typedef dax::GridTagUnstructured GridTag;
   typedef dax::CellTagWedge CanonicalCellTag;
+  const static dax::Id SHAPE_ID = 13;
 };
 
 } // namespace dax
@@ -65,6 +65,10 @@ struct Pair
   Pair(const FirstType &firstSrc, const SecondType &secondSrc)
     : first(firstSrc), second(secondSrc) {  }
 
+  DAX_EXEC_CONT_EXPORT
+  Pair(const dax::Pair<FirstType,SecondType> &src)
+    : first(src.first), second(src.second) {  }
+
   template <typename U1, typename U2>
   DAX_EXEC_CONT_EXPORT
   Pair(const dax::Pair<U1,U2> &src)
@@ -80,7 +84,7 @@ struct Pair
   operator=(const dax::Pair<FirstType,SecondType> &src) {
     this->first = src.first;
     this->second = src.second;
-    return this;
+    return *this;
   }
 
   DAX_EXEC_CONT_EXPORT
@@ -96,6 +100,7 @@ struct Pair
   /// Tests ordering on the first object, and then on the second object if the
   /// first are equal.
   ///
+  DAX_EXEC_CONT_EXPORT
   bool operator<(const dax::Pair<FirstType,SecondType> &other) const {
     return ((this->first < other.first)
             || (!(other.first < this->first) && (this->second < other.second)));
@@ -104,6 +109,7 @@ struct Pair
   /// Tests ordering on the first object, and then on the second object if the
   /// first are equal.
   ///
+  DAX_EXEC_CONT_EXPORT
   bool operator>(const dax::Pair<FirstType,SecondType> &other) const {
     return (other < *this);
   }
@@ -111,6 +117,7 @@ struct Pair
   /// Tests ordering on the first object, and then on the second object if the
   /// first are equal.
   ///
+  DAX_EXEC_CONT_EXPORT
   bool operator<=(const dax::Pair<FirstType,SecondType> &other) const {
     return !(other < *this);
   }
@@ -118,6 +125,7 @@ struct Pair
   /// Tests ordering on the first object, and then on the second object if the
   /// first are equal.
   ///
+  DAX_EXEC_CONT_EXPORT
   bool operator>=(const dax::Pair<FirstType,SecondType> &other) const {
     return !(*this < other);
   }
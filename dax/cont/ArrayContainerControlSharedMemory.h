@@ -0,0 +1,518 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__ArrayContainerControlSharedMemory_h
+#define __dax__cont__ArrayContainerControlSharedMemory_h
+
+#include <dax/Types.h>
+#include <dax/TypeTraits.h>
+#include <dax/VectorTraits.h>
+#include <dax/cont/ArrayContainerControl.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/ErrorControlOutOfMemory.h>
+#include <dax/cont/internal/ArrayPortalFromIterators.h>
+
+#include <boost/smart_ptr/shared_ptr.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dax {
+namespace cont {
+
+/// A tag for an ArrayContainerControl that keeps its array in a named POSIX
+/// shared memory segment (see \c shm_open). Another process on the same node
+/// can map the same segment, so arrays can be handed between processes
+/// without copying them.
+///
+struct ArrayContainerControlTagSharedMemory {  };
+
+/// Returns the name used for type \c T in a \c SharedMemoryArrayDescriptor.
+/// The name is the kind of the components (\c int or \c float), their size in
+/// bits, and the number of components in brackets if there is more than one.
+/// For example, a \c dax::Vector3 of 32 bit floats is <tt>float32[3]</tt>.
+///
+template<typename T>
+DAX_CONT_EXPORT std::string SharedMemoryTypeName();
+
+/// \brief Describes where an array lives in a shared memory segment.
+///
+/// A producer process publishes an array by passing the descriptor to the
+/// consumer, which uses it to map the same memory. The descriptor holds the
+/// name of the segment (as given to \c shm_open), the type of the values, the
+/// number of values, and the byte offset of the first value in the segment.
+/// \c ToString and \c FromString convert the descriptor to and from a single
+/// line of text of the form <tt>name type length offset</tt> (for example
+/// <tt>/pressure float32 1048576 0</tt>) that is easy to send over a pipe,
+/// socket, or command line.
+///
+class SharedMemoryArrayDescriptor
+{
+public:
+  DAX_CONT_EXPORT SharedMemoryArrayDescriptor()
+    : NumberOfValues(0), Offset(0) {  }
+
+  DAX_CONT_EXPORT SharedMemoryArrayDescriptor(const std::string &name,
+                                              const std::string &typeName,
+                                              dax::Id numberOfValues,
+                                              dax::Id offset = 0)
+    : Name(name),
+      TypeName(typeName),
+      NumberOfValues(numberOfValues),
+      Offset(offset) {  }
+
+  DAX_CONT_EXPORT const std::string &GetName() const { return this->Name; }
+  DAX_CONT_EXPORT void SetName(const std::string &name) { this->Name = name; }
+
+  DAX_CONT_EXPORT const std::string &GetTypeName() const
+  {
+    return this->TypeName;
+  }
+  DAX_CONT_EXPORT void SetTypeName(const std::string &typeName)
+  {
+    this->TypeName = typeName;
+  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfValues() const
+  {
+    return this->NumberOfValues;
+  }
+  DAX_CONT_EXPORT void SetNumberOfValues(dax::Id numberOfValues)
+  {
+    this->NumberOfValues = numberOfValues;
+  }
+
+  DAX_CONT_EXPORT dax::Id GetOffset() const { return this->Offset; }
+  DAX_CONT_EXPORT void SetOffset(dax::Id offset) { this->Offset = offset; }
+
+  DAX_CONT_EXPORT std::string ToString() const
+  {
+    std::stringstream stream;
+    stream << this->Name << " " << this->TypeName << " "
+           << this->NumberOfValues << " " << this->Offset;
+    return stream.str();
+  }
+
+  /// Parses a descriptor written by \c ToString. Throws an
+  /// ErrorControlBadValue if \c text is not a valid descriptor.
+  ///
+  static DAX_CONT_EXPORT SharedMemoryArrayDescriptor FromString(
+      const std::string &text)
+  {
+    SharedMemoryArrayDescriptor descriptor;
+    std::stringstream stream(text);
+    std::string extra;
+    stream >> descriptor.Name >> descriptor.TypeName
+           >> descriptor.NumberOfValues >> descriptor.Offset;
+    if (stream.fail() || (stream >> extra)
+        || (descriptor.NumberOfValues < 0) || (descriptor.Offset < 0))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Invalid shared memory array descriptor: " + text);
+      }
+    return descriptor;
+  }
+
+private:
+  std::string Name;
+  std::string TypeName;
+  dax::Id NumberOfValues;
+  dax::Id Offset;
+};
+
+namespace internal {
+namespace detail {
+
+DAX_CONT_EXPORT const char *SharedMemoryNumericName(dax::TypeTraitsRealTag)
+{
+  return "float";
+}
+DAX_CONT_EXPORT const char *SharedMemoryNumericName(dax::TypeTraitsIntegerTag)
+{
+  return "int";
+}
+
+/// Holds the mapping of a shared memory segment. The segment is unmapped when
+/// the last reference goes away and, if this process created the segment, its
+/// name is removed as well.
+///
+class SharedMemorySegment
+{
+public:
+  /// Creates a new segment of \c numBytes bytes. If \c name is empty, a name
+  /// unique to this process is made up.
+  ///
+  static DAX_CONT_EXPORT
+  boost::shared_ptr<SharedMemorySegment> Create(const std::string &name,
+                                                std::size_t numBytes)
+  {
+    std::string segmentName = name;
+    int fileDescriptor = -1;
+    if (segmentName.empty())
+      {
+      // Another process might have picked the same name, so keep trying.
+      static unsigned long counter = 0;
+      do
+        {
+        std::stringstream stream;
+        stream << "/dax_" << getpid() << "_" << counter++;
+        segmentName = stream.str();
+        fileDescriptor = shm_open(segmentName.c_str(),
+                                  O_RDWR | O_CREAT | O_EXCL,
+                                  S_IRUSR | S_IWUSR);
+        } while ((fileDescriptor < 0) && (errno == EEXIST));
+      }
+    else
+      {
+      CheckName(segmentName);
+      fileDescriptor = shm_open(segmentName.c_str(),
+                                O_RDWR | O_CREAT | O_EXCL,
+                                S_IRUSR | S_IWUSR);
+      }
+    if (fileDescriptor < 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Could not create shared memory segment " + segmentName + ": "
+            + std::strerror(errno));
+      }
+
+    if (ftruncate(fileDescriptor, static_cast<off_t>(numBytes)) != 0)
+      {
+      close(fileDescriptor);
+      shm_unlink(segmentName.c_str());
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Could not allocate shared memory segment " + segmentName + ".");
+      }
+
+    boost::shared_ptr<SharedMemorySegment> segment(
+          new SharedMemorySegment(segmentName, true));
+    segment->Map(fileDescriptor, numBytes);
+    return segment;
+  }
+
+  /// Maps an existing segment created by this or another process.
+  ///
+  static DAX_CONT_EXPORT
+  boost::shared_ptr<SharedMemorySegment> Open(const std::string &name)
+  {
+    CheckName(name);
+    int fileDescriptor = shm_open(name.c_str(), O_RDWR, 0);
+    if (fileDescriptor < 0)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Could not open shared memory segment " + name + ": "
+            + std::strerror(errno));
+      }
+
+    struct stat status;
+    if (fstat(fileDescriptor, &status) != 0)
+      {
+      close(fileDescriptor);
+      throw dax::cont::ErrorControlBadValue(
+            "Could not get size of shared memory segment " + name + ".");
+      }
+
+    boost::shared_ptr<SharedMemorySegment> segment(
+          new SharedMemorySegment(name, false));
+    segment->Map(fileDescriptor, static_cast<std::size_t>(status.st_size));
+    return segment;
+  }
+
+  DAX_CONT_EXPORT ~SharedMemorySegment()
+  {
+    if (this->Address != NULL)
+      {
+      munmap(this->Address, this->Size);
+      }
+    if (this->UnlinkOnRelease)
+      {
+      shm_unlink(this->Name.c_str());
+      }
+  }
+
+  DAX_CONT_EXPORT const std::string &GetName() const { return this->Name; }
+  DAX_CONT_EXPORT char *GetAddress() const { return this->Address; }
+  DAX_CONT_EXPORT std::size_t GetSize() const { return this->Size; }
+
+  DAX_CONT_EXPORT bool GetUnlinkOnRelease() const
+  {
+    return this->UnlinkOnRelease;
+  }
+  DAX_CONT_EXPORT void SetUnlinkOnRelease(bool unlinkOnRelease)
+  {
+    this->UnlinkOnRelease = unlinkOnRelease;
+  }
+
+private:
+  DAX_CONT_EXPORT SharedMemorySegment(const std::string &name,
+                                      bool unlinkOnRelease)
+    : Name(name), Address(NULL), Size(0), UnlinkOnRelease(unlinkOnRelease) {  }
+
+  // Not implemented.
+  SharedMemorySegment(const SharedMemorySegment &);
+  void operator=(const SharedMemorySegment &);
+
+  static DAX_CONT_EXPORT void CheckName(const std::string &name)
+  {
+    // Descriptors are whitespace separated, so names cannot contain any.
+    if (   name.size() < 2 || name[0] != '/'
+        || name.find_first_of(" \t\n/", 1) != std::string::npos)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Invalid shared memory segment name: " + name);
+      }
+  }
+
+  /// Maps the segment and closes the file descriptor, which is no longer
+  /// needed once the mapping exists. Releases the segment on failure.
+  ///
+  DAX_CONT_EXPORT void Map(int fileDescriptor, std::size_t numBytes)
+  {
+    void *address = NULL;
+    if (numBytes > 0)
+      {
+      address = mmap(NULL, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fileDescriptor, 0);
+      }
+    close(fileDescriptor);
+    if (address == MAP_FAILED)
+      {
+      throw dax::cont::ErrorControlOutOfMemory(
+            "Could not map shared memory segment " + this->Name + ".");
+      }
+    this->Address = static_cast<char *>(address);
+    this->Size = numBytes;
+  }
+
+  std::string Name;
+  char *Address;
+  std::size_t Size;
+  bool UnlinkOnRelease;
+};
+
+} // namespace detail
+
+/// An implementation of an ArrayContainerControl object that keeps its values
+/// in a POSIX shared memory segment.
+///
+/// The container either creates a new segment (through \c Allocate or the
+/// constructor taking a name and size) or attaches to an array another
+/// process published (through the constructor taking a \c
+/// SharedMemoryArrayDescriptor). Copies of the container share the mapping,
+/// which is removed once all of them are released. \c ReleaseResources only
+/// drops this container's reference. A segment this container created is
+/// also unlinked, so that no other process can attach to it afterward,
+/// unless \c SetUnlinkOnRelease(false) was called. A segment that was
+/// attached to is never unlinked; that is up to the process that created it.
+///
+/// Like the basic container, this container does \em not construct the values
+/// within the array.
+///
+template <typename ValueT>
+class ArrayContainerControl<
+    ValueT, dax::cont::ArrayContainerControlTagSharedMemory>
+{
+public:
+  typedef ValueT ValueType;
+  typedef dax::cont::internal::ArrayPortalFromIterators<ValueType*> PortalType;
+  typedef dax::cont::internal::ArrayPortalFromIterators<const ValueType*> PortalConstType;
+
+private:
+  typedef dax::cont::internal::detail::SharedMemorySegment SegmentType;
+
+public:
+
+  ArrayContainerControl() : Array(NULL), NumberOfValues(0), AllocatedSize(0) { }
+
+  /// Creates a new shared memory segment called \c name that holds \c
+  /// numberOfValues values.
+  ///
+  ArrayContainerControl(const std::string &name, dax::Id numberOfValues)
+    : Array(NULL), NumberOfValues(0), AllocatedSize(0)
+  {
+    this->CreateSegment(name, numberOfValues);
+  }
+
+  /// Attaches to the array described by \c descriptor. Throws an
+  /// ErrorControlBadValue if the segment does not exist, does not contain the
+  /// array, or the type in the descriptor does not match \c ValueType.
+  ///
+  explicit
+  ArrayContainerControl(const dax::cont::SharedMemoryArrayDescriptor &descriptor)
+    : Array(NULL), NumberOfValues(0), AllocatedSize(0)
+  {
+    if (descriptor.GetTypeName() != SharedMemoryTypeName<ValueType>())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Shared memory array has type " + descriptor.GetTypeName()
+            + " but " + SharedMemoryTypeName<ValueType>() + " was expected.");
+      }
+
+    boost::shared_ptr<SegmentType> segment =
+        SegmentType::Open(descriptor.GetName());
+
+    const std::size_t offset = static_cast<std::size_t>(descriptor.GetOffset());
+    const std::size_t numBytes =
+        static_cast<std::size_t>(descriptor.GetNumberOfValues())
+        * sizeof(ValueType);
+    typedef typename dax::VectorTraits<ValueType>::ComponentType ComponentType;
+    if (   (descriptor.GetOffset() < 0) || (descriptor.GetNumberOfValues() < 0)
+        || (offset % sizeof(ComponentType) != 0)
+        || (offset + numBytes > segment->GetSize()))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Shared memory segment " + descriptor.GetName()
+            + " does not contain the described array.");
+      }
+
+    this->Segment = segment;
+    this->Array = reinterpret_cast<ValueType *>(segment->GetAddress() + offset);
+    this->NumberOfValues = descriptor.GetNumberOfValues();
+    this->AllocatedSize = descriptor.GetNumberOfValues();
+  }
+
+  void ReleaseResources()
+  {
+    this->Segment.reset();
+    this->Array = NULL;
+    this->NumberOfValues = 0;
+    this->AllocatedSize = 0;
+  }
+
+  /// Allocates the array. If the current segment is too small, it is released
+  /// and a new segment with a made up name is created.
+  ///
+  void Allocate(dax::Id numberOfValues)
+  {
+    if (numberOfValues <= this->AllocatedSize)
+      {
+      this->NumberOfValues = numberOfValues;
+      return;
+      }
+
+    this->ReleaseResources();
+    this->CreateSegment(std::string(), numberOfValues);
+  }
+
+  dax::Id GetNumberOfValues() const
+  {
+    return this->NumberOfValues;
+  }
+
+  void Shrink(dax::Id numberOfValues)
+  {
+    if (numberOfValues > this->GetNumberOfValues())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Shrink method cannot be used to grow array.");
+      }
+
+    this->NumberOfValues = numberOfValues;
+  }
+
+  PortalType GetPortal()
+  {
+    return PortalType(this->Array, this->Array + this->NumberOfValues);
+  }
+
+  PortalConstType GetPortalConst() const
+  {
+    return PortalConstType(this->Array, this->Array + this->NumberOfValues);
+  }
+
+  /// Returns the descriptor another process can use to attach to the array.
+  /// Throws an ErrorControlBadValue if no array is allocated.
+  ///
+  dax::cont::SharedMemoryArrayDescriptor GetDescriptor() const
+  {
+    if (!this->Segment)
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Shared memory container has no array to describe.");
+      }
+    return dax::cont::SharedMemoryArrayDescriptor(
+          this->Segment->GetName(),
+          SharedMemoryTypeName<ValueType>(),
+          this->NumberOfValues,
+          reinterpret_cast<char *>(this->Array) - this->Segment->GetAddress());
+  }
+
+  /// Whether the name of the segment is removed when it is released. This is
+  /// on for segments this container created and off for attached ones. Turn
+  /// it off to keep a published array available after this process is done
+  /// with it.
+  ///
+  bool GetUnlinkOnRelease() const
+  {
+    return (this->Segment.get() != NULL)
+        && this->Segment->GetUnlinkOnRelease();
+  }
+  void SetUnlinkOnRelease(bool unlinkOnRelease)
+  {
+    DAX_ASSERT_CONT(this->Segment.get() != NULL);
+    this->Segment->SetUnlinkOnRelease(unlinkOnRelease);
+  }
+
+private:
+  void CreateSegment(const std::string &name, dax::Id numberOfValues)
+  {
+    if (numberOfValues <= 0 && name.empty())
+      {
+      return;
+      }
+    this->Segment = SegmentType::Create(
+          name, static_cast<std::size_t>(numberOfValues)*sizeof(ValueType));
+    this->Array = reinterpret_cast<ValueType *>(this->Segment->GetAddress());
+    this->NumberOfValues = numberOfValues;
+    this->AllocatedSize = numberOfValues;
+  }
+
+  boost::shared_ptr<SegmentType> Segment;
+  ValueType *Array;
+  dax::Id NumberOfValues;
+  dax::Id AllocatedSize;
+};
+
+} // namespace internal
+
+template<typename T>
+DAX_CONT_EXPORT std::string SharedMemoryTypeName()
+{
+  typedef typename dax::VectorTraits<T>::ComponentType ComponentType;
+  const int numComponents = dax::VectorTraits<T>::NUM_COMPONENTS;
+
+  std::stringstream stream;
+  stream << dax::cont::internal::detail::SharedMemoryNumericName(
+              typename dax::TypeTraits<ComponentType>::NumericTag())
+         << 8*sizeof(ComponentType);
+  if (numComponents > 1)
+    {
+    stream << "[" << numComponents << "]";
+    }
+  return stream.str();
+}
+
+}
+} // namespace dax::cont
+
+#endif //__dax__cont__ArrayContainerControlSharedMemory_h
@@ -382,6 +382,19 @@ protected:
     this->Internals->ExecutionArrayValid = executionArrayValid;
   }
 
+  /// Special constructor for subclass specializations that start out with
+  /// the data already in a control container (for example one attached to
+  /// memory owned by someone else).
+  ///
+  explicit ArrayHandle(const ArrayContainerControlType &container)
+    : Internals(new InternalStruct)
+  {
+    this->Internals->UserPortalValid = false;
+    this->Internals->ControlArray = container;
+    this->Internals->ControlArrayValid = true;
+    this->Internals->ExecutionArrayValid = false;
+  }
+
 private:
   struct InternalStruct {
     PortalConstControl UserPortal;
@@ -0,0 +1,133 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ArrayHandleSharedMemory_h
+#define __dax_cont_ArrayHandleSharedMemory_h
+
+#include <dax/cont/ArrayContainerControlSharedMemory.h>
+#include <dax/cont/ArrayHandle.h>
+
+#include <string>
+
+namespace dax {
+namespace cont {
+
+/// ArrayHandleSharedMemory is a specialization of ArrayHandle that keeps its
+/// control array in a POSIX shared memory segment. It is constructed either
+/// by creating a new named segment, which can then be published to other
+/// processes with \c GetDescriptor, or by attaching to an array another
+/// process published. In both cases the values are used in place; nothing is
+/// copied. On device adapters that share memory with the control environment,
+/// an operation writing to an attached array of the same size writes straight
+/// into the shared segment.
+///
+/// The descriptor is the one of the array the handle was constructed with.
+/// It is no longer valid once the array is reallocated or released.
+///
+template <typename T, class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class ArrayHandleSharedMemory
+    : public dax::cont::ArrayHandle<
+          T, dax::cont::ArrayContainerControlTagSharedMemory, DeviceAdapterTag_>
+{
+public:
+  typedef T ValueType;
+  typedef dax::cont::ArrayContainerControlTagSharedMemory
+      ArrayContainerControlTag;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+  typedef dax::cont::ArrayHandle<
+      ValueType, ArrayContainerControlTag, DeviceAdapterTag> Superclass;
+
+private:
+  typedef dax::cont::internal::ArrayContainerControl<
+      ValueType, ArrayContainerControlTag> ArrayContainerControlType;
+
+public:
+  DAX_CONT_EXPORT ArrayHandleSharedMemory() : Superclass() {  }
+
+  /// Creates a new shared memory segment called \c name holding \c
+  /// numberOfValues uninitialized values. If \c name is empty, a name unique
+  /// to this process is made up. The segment is unlinked when the last copy of
+  /// this handle releases it.
+  ///
+  DAX_CONT_EXPORT
+  ArrayHandleSharedMemory(const std::string &name, dax::Id numberOfValues)
+    : Superclass()
+  {
+    // The container picks the name when none is given, so the descriptor has
+    // to come from the container rather than from the arguments.
+    ArrayContainerControlType container(name, numberOfValues);
+    dax::cont::SharedMemoryArrayDescriptor descriptor;
+    if (numberOfValues > 0 || !name.empty())
+      {
+      descriptor = container.GetDescriptor();
+      }
+    *this = ArrayHandleSharedMemory(container, descriptor);
+  }
+
+  /// Attaches to an array published by another process. The segment is not
+  /// unlinked when this handle releases it.
+  ///
+  DAX_CONT_EXPORT explicit
+  ArrayHandleSharedMemory(
+      const dax::cont::SharedMemoryArrayDescriptor &descriptor)
+    : Superclass(ArrayContainerControlType(descriptor)),
+      Descriptor(descriptor)
+  {  }
+
+  /// Returns the descriptor another process can use to attach to the array
+  /// this handle was constructed with.
+  ///
+  DAX_CONT_EXPORT
+  const dax::cont::SharedMemoryArrayDescriptor &GetDescriptor() const
+  {
+    return this->Descriptor;
+  }
+
+private:
+  DAX_CONT_EXPORT ArrayHandleSharedMemory(
+      const ArrayContainerControlType &container,
+      const dax::cont::SharedMemoryArrayDescriptor &descriptor)
+    : Superclass(container), Descriptor(descriptor) {  }
+
+  dax::cont::SharedMemoryArrayDescriptor Descriptor;
+};
+
+/// A convenience function for attaching an ArrayHandle to an array published
+/// in shared memory by another process.
+///
+template<typename T, typename DeviceAdapterTag>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleSharedMemory<T, DeviceAdapterTag>
+make_ArrayHandleSharedMemory(
+    const dax::cont::SharedMemoryArrayDescriptor &descriptor,
+    DeviceAdapterTag)
+{
+  return dax::cont::ArrayHandleSharedMemory<T, DeviceAdapterTag>(descriptor);
+}
+template<typename T>
+DAX_CONT_EXPORT
+dax::cont::ArrayHandleSharedMemory<T, DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+make_ArrayHandleSharedMemory(
+    const dax::cont::SharedMemoryArrayDescriptor &descriptor)
+{
+  return dax::cont::make_ArrayHandleSharedMemory<T>(
+        descriptor, DAX_DEFAULT_DEVICE_ADAPTER_TAG());
+}
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ArrayHandleSharedMemory_h
@@ -0,0 +1,347 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_BrickRanges_h
+#define __dax_cont_BrickRanges_h
+
+#include <dax/Extent.h>
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleConstant.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/PermutationContainer.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/exec/internal/kernel/BrickRangeWorklets.h>
+#include <dax/exec/internal/kernel/MixedCellWorklets.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace dax {
+namespace cont {
+
+/// \brief A summary of the range of a point field over bricks of cells of a
+/// uniform grid, used to skip the cells that cannot match a query.
+///
+/// The cells of the grid are split into bricks of \c brickSize^3 cells, and
+/// the minimum and maximum of the field over the points of each brick are
+/// kept. Contouring at an isovalue or thresholding to a range usually only
+/// matches a small part of the grid. \c CountCells runs a count worklet on
+/// the cells of the bricks whose range intersects the worklet's query and
+/// sets the count of every other cell to 0 without loading its point values.
+///
+/// Building the summary reads the whole field once, so it should be built
+/// once per field and kept alongside the field's array while several
+/// queries (for example isovalues) are tried. Like \c ArrayHandle, copies of
+/// a \c BrickRanges share their state. Call \c Invalidate or \c Build again
+/// when the field changes.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class BrickRanges
+{
+  typedef dax::exec::internal::kernel::BrickLayout LayoutType;
+
+public:
+  typedef dax::cont::ArrayHandle<dax::Vector2,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> RangeArrayHandleType;
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayHandleType;
+
+  static const dax::Id DEFAULT_BRICK_SIZE = 8;
+
+  /// Creates an invalid summary. It has to be built before it is used.
+  ///
+  DAX_CONT_EXPORT BrickRanges() : Internals(new InternalStruct) {  }
+
+  /// Creates the summary of \c field, which holds one value per point of
+  /// \c grid.
+  ///
+  template<class FieldHandleType>
+  DAX_CONT_EXPORT BrickRanges(
+      const dax::cont::UniformGrid<DeviceAdapterTag> &grid,
+      const FieldHandleType &field,
+      dax::Id brickSize = DEFAULT_BRICK_SIZE)
+    : Internals(new InternalStruct)
+  {
+    this->Build(grid, field, brickSize);
+  }
+
+  /// (Re)builds the summary of \c field, which holds one value per point of
+  /// \c grid. Every copy of this summary sees the new state.
+  ///
+  template<class FieldHandleType>
+  DAX_CONT_EXPORT void Build(
+      const dax::cont::UniformGrid<DeviceAdapterTag> &grid,
+      const FieldHandleType &field,
+      dax::Id brickSize = DEFAULT_BRICK_SIZE)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    DAX_ASSERT_CONT(brickSize > 0);
+    DAX_ASSERT_CONT(field.GetNumberOfValues() == grid.GetNumberOfPoints());
+
+    this->Invalidate();
+    this->Internals->Layout =
+        LayoutType(dax::extentCellDimensions(grid.GetExtent()), brickSize);
+    this->Internals->Grid = grid;
+
+    const dax::Id numBricks = this->Internals->Layout.GetNumberOfBricks();
+    if (numBricks > 0)
+      {
+      Algorithm::Schedule(
+            dax::exec::internal::kernel::ComputeBrickRangesFunctor<
+                typename FieldHandleType::PortalConstExecution,
+                typename RangeArrayHandleType::PortalExecution>(
+              field.PrepareForInput(),
+              this->Internals->Ranges.PrepareForOutput(numBricks),
+              this->Internals->Layout),
+            numBricks);
+      }
+    this->Internals->Valid = true;
+  }
+
+  /// Marks the summary as out of date and releases the array it holds. Call
+  /// this when the field the summary was built from changes.
+  ///
+  DAX_CONT_EXPORT void Invalidate()
+  {
+    this->Internals->Ranges.ReleaseResources();
+    this->Internals->Valid = false;
+  }
+
+  /// Returns true if the summary has been built and not invalidated since.
+  ///
+  DAX_CONT_EXPORT bool IsValid() const { return this->Internals->Valid; }
+
+  DAX_CONT_EXPORT dax::Id GetBrickSize() const
+  {
+    return this->Internals->Layout.BrickSize;
+  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfBricks() const
+  {
+    return this->Internals->Layout.GetNumberOfBricks();
+  }
+
+  /// Returns an array with the minimum and maximum value of each brick.
+  /// Bricks are ordered with i varying fastest, like the cells of a grid.
+  ///
+  DAX_CONT_EXPORT RangeArrayHandleType GetRanges() const
+  {
+    return this->Internals->Ranges;
+  }
+
+  /// Returns the indices of the bricks whose range intersects the closed
+  /// range [query[0], query[1]].
+  ///
+  DAX_CONT_EXPORT IdArrayHandleType
+  GetActiveBricks(const dax::Vector2 &query) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    DAX_ASSERT_CONT(this->IsValid());
+
+    const dax::Id numBricks = this->GetNumberOfBricks();
+    IdArrayHandleType activeBricks;
+    if (numBricks < 1)
+      {
+      activeBricks.PrepareForOutput(0);
+      return activeBricks;
+      }
+
+    IdArrayHandleType flags;
+    Algorithm::Schedule(
+          dax::exec::internal::kernel::MarkActiveBricksFunctor<
+              typename RangeArrayHandleType::PortalConstExecution,
+              typename IdArrayHandleType::PortalExecution>(
+            this->Internals->Ranges.PrepareForInput(),
+            flags.PrepareForOutput(numBricks),
+            query),
+          numBricks);
+    Algorithm::StreamCompact(flags, activeBricks);
+    return activeBricks;
+  }
+
+  /// Runs the count worklet \c worklet on the cells of the bricks whose
+  /// range intersects the range returned by \c worklet.GetValueRange(), and
+  /// writes 0 for all other cells. \c field must be the field this summary
+  /// was built from. The result is the same as invoking the worklet with a
+  /// DispatcherMapCell on the grid and field. The cells of the active bricks
+  /// are invoked through a DispatcherMapCell too, on a permutation of the
+  /// grid, so any map cell worklet with a ControlSignature of (TopologyIn,
+  /// FieldPointIn, FieldOut) that returns a count of 0 for cells whose
+  /// values are all outside its value range can be used, such as
+  /// MarchingCubesCount and ThresholdCount.
+  ///
+  template<class WorkletType, class FieldHandleType, class CountHandleType>
+  DAX_CONT_EXPORT void CountCells(const WorkletType &worklet,
+                                  const FieldHandleType &field,
+                                  CountHandleType &counts) const
+  {
+    typedef dax::cont::ArrayHandle<typename CountHandleType::ValueType,
+                                   dax::cont::ArrayContainerControlTagBasic,
+                                   DeviceAdapterTag> ActiveCountHandleType;
+    typedef dax::exec::internal::kernel::PermutedCellWorklet<WorkletType>
+        PermutedWorkletType;
+    DAX_ASSERT_CONT(this->IsValid());
+    const dax::cont::UniformGrid<DeviceAdapterTag> &grid =
+        this->Internals->Grid;
+    DAX_ASSERT_CONT(field.GetNumberOfValues() == grid.GetNumberOfPoints());
+
+    IdArrayHandleType activeCells =
+        this->GetActiveCells(worklet.GetValueRange());
+    ActiveCountHandleType activeCounts;
+    if (activeCells.GetNumberOfValues() > 0)
+      {
+      dax::cont::DispatcherMapCell<PermutedWorkletType, DeviceAdapterTag>(
+            PermutedWorkletType(worklet)).Invoke(
+              dax::cont::make_Permutation(activeCells,
+                                          grid,
+                                          grid.GetNumberOfCells()),
+              field,
+              activeCounts);
+      }
+    this->ScatterToCells(activeCells, activeCounts, counts);
+  }
+
+  /// Like the other \c CountCells, for a worklet that also writes a second
+  /// cell field, such as the case ids of MarchingCubesClassify, with a
+  /// ControlSignature of (TopologyIn, FieldPointIn, FieldOut, FieldOut). The
+  /// skipped cells get 0 for both fields.
+  ///
+  template<class WorkletType,
+           class FieldHandleType,
+           class CountHandleType,
+           class CellFieldHandleType>
+  DAX_CONT_EXPORT void CountCells(const WorkletType &worklet,
+                                  const FieldHandleType &field,
+                                  CountHandleType &counts,
+                                  CellFieldHandleType &cellField) const
+  {
+    typedef dax::cont::ArrayHandle<typename CountHandleType::ValueType,
+                                   dax::cont::ArrayContainerControlTagBasic,
+                                   DeviceAdapterTag> ActiveCountHandleType;
+    typedef dax::cont::ArrayHandle<typename CellFieldHandleType::ValueType,
+                                   dax::cont::ArrayContainerControlTagBasic,
+                                   DeviceAdapterTag> ActiveCellFieldHandleType;
+    typedef dax::exec::internal::kernel::PermutedCellWorklet<WorkletType>
+        PermutedWorkletType;
+    DAX_ASSERT_CONT(this->IsValid());
+    const dax::cont::UniformGrid<DeviceAdapterTag> &grid =
+        this->Internals->Grid;
+    DAX_ASSERT_CONT(field.GetNumberOfValues() == grid.GetNumberOfPoints());
+
+    IdArrayHandleType activeCells =
+        this->GetActiveCells(worklet.GetValueRange());
+    ActiveCountHandleType activeCounts;
+    ActiveCellFieldHandleType activeCellField;
+    if (activeCells.GetNumberOfValues() > 0)
+      {
+      dax::cont::DispatcherMapCell<PermutedWorkletType, DeviceAdapterTag>(
+            PermutedWorkletType(worklet)).Invoke(
+              dax::cont::make_Permutation(activeCells,
+                                          grid,
+                                          grid.GetNumberOfCells()),
+              field,
+              activeCounts,
+              activeCellField);
+      }
+    this->ScatterToCells(activeCells, activeCounts, counts);
+    this->ScatterToCells(activeCells, activeCellField, cellField);
+  }
+
+private:
+  struct InternalStruct
+  {
+    InternalStruct()
+      : Layout(dax::make_Id3(0, 0, 0), DEFAULT_BRICK_SIZE),
+        Valid(false) {  }
+
+    RangeArrayHandleType Ranges;
+    LayoutType Layout;
+    dax::cont::UniformGrid<DeviceAdapterTag> Grid;
+    bool Valid;
+  };
+
+  boost::shared_ptr<InternalStruct> Internals;
+
+  // Lists the cells of the bricks whose range intersects query, dropping
+  // the cell slots of the boundary bricks that lie outside the grid.
+  DAX_CONT_EXPORT
+  IdArrayHandleType GetActiveCells(const dax::Vector2 &query) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    const LayoutType &layout = this->Internals->Layout;
+
+    IdArrayHandleType activeBricks = this->GetActiveBricks(query);
+    const dax::Id numSlots =
+        activeBricks.GetNumberOfValues()*layout.GetCellsPerBrick();
+    IdArrayHandleType activeCells;
+    if (numSlots < 1)
+      {
+      activeCells.PrepareForOutput(0);
+      return activeCells;
+      }
+
+    IdArrayHandleType slotCells;
+    IdArrayHandleType slotFlags;
+    Algorithm::Schedule(
+          dax::exec::internal::kernel::ActiveBrickCellsFunctor<
+              typename IdArrayHandleType::PortalConstExecution,
+              typename IdArrayHandleType::PortalExecution>(
+            activeBricks.PrepareForInput(),
+            slotCells.PrepareForOutput(numSlots),
+            slotFlags.PrepareForOutput(numSlots),
+            layout),
+          numSlots);
+    Algorithm::StreamCompact(slotCells, slotFlags, activeCells);
+    return activeCells;
+  }
+
+  // Writes the values computed for the active cells to their places in a
+  // field over all the cells of the grid, and 0 everywhere else.
+  template<class ActiveHandleType, class HandleType>
+  DAX_CONT_EXPORT void ScatterToCells(const IdArrayHandleType &activeCells,
+                                      const ActiveHandleType &activeValues,
+                                      HandleType &values) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef typename HandleType::ValueType ValueType;
+    Algorithm::Copy(
+          dax::cont::ArrayHandleConstant<ValueType,DeviceAdapterTag>(
+            ValueType(0), this->Internals->Grid.GetNumberOfCells()),
+          values);
+
+    const dax::Id numActiveCells = activeCells.GetNumberOfValues();
+    if (numActiveCells < 1) { return; }
+    Algorithm::Schedule(
+          dax::exec::internal::kernel::ScatterCellFieldFunctor<
+              typename IdArrayHandleType::PortalConstExecution,
+              typename ActiveHandleType::PortalConstExecution,
+              typename HandleType::PortalExecution>(
+            activeCells.PrepareForInput(),
+            activeValues.PrepareForInput(),
+            values.PrepareForInPlace()),
+          numActiveCells);
+  }
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_BrickRanges_h
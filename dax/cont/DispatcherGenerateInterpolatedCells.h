@@ -16,31 +16,31 @@
 #ifndef __dax_cont_DispatcherGenerateInterpolatedCells_h
 #define __dax_cont_DispatcherGenerateInterpolatedCells_h
 
+#include <dax/Pair.h>
 #include <dax/Types.h>
 
+#include <dax/cont/ArrayHandleConstant.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/ScatterPlan.h>
 #include <dax/cont/dispatcher/DispatcherBase.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
+#include <dax/cont/internal/InterpolatedCellBlocks.h>
+#include <dax/cont/internal/InterpolatedCellRecords.h>
 #include <dax/exec/WorkletInterpolatedCell.h>
+#include <dax/exec/WorkletInterpolatedCellSet.h>
+#include <dax/exec/internal/FunctorBlocks.h>
 #include <dax/internal/ParameterPack.h>
 
-#include <dax/math/Compare.h>
 #include <dax/cont/dispatcher/AddVisitIndexArg.h>
+#include <dax/exec/InterpolatedCellPoints.h>
 #include <dax/exec/internal/kernel/GenerateWorklets.h>
 
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_base_of.hpp>
 
 namespace dax { namespace cont {
 
-namespace detail
-{
-  struct sort_V3_less
-  {
-  DAX_EXEC_CONT_EXPORT bool operator()(const dax::Vector3& a,
-                                       const dax::Vector3& b) const
-    { return (a[0] < b[0]) || (a[0] == b[0] && a[1] < b[1]); }
-  };
-
-}
-
 template <
   class WorkletType_,
   class CountHandleType_ = dax::cont::ArrayHandle< dax::Id >,
@@ -62,15 +62,23 @@ class DispatcherGenerateInterpolatedCells :
                                                  WorkletType_,
                                                  DeviceAdapterTag_>;
 
-  typedef dax::cont::ArrayHandle< dax::Vector3,
+  typedef dax::cont::ArrayHandle< dax::exec::InterpolationRecord,
                   dax::cont::ArrayContainerControlTagBasic,
                   DeviceAdapterTag_ >  InterpolationWeightsType;
 
+  typedef typename boost::is_base_of<
+      dax::exec::WorkletInterpolatedCellSet, WorkletType_>::type
+      GeneratesCellSets;
+
 public:
   typedef WorkletType_ WorkletType;
   typedef CountHandleType_ CountHandleType;
   typedef DeviceAdapterTag_ DeviceAdapterTag;
 
+  typedef dax::cont::ScatterPlan<DeviceAdapterTag> ScatterPlanType;
+  typedef dax::cont::ArrayHandle<dax::Id,
+                  dax::cont::ArrayContainerControlTagBasic,
+                  DeviceAdapterTag_ > LayerHandleType;
 
   DAX_CONT_EXPORT
   DispatcherGenerateInterpolatedCells(const CountHandleType &count):
@@ -78,7 +86,13 @@ public:
     RemoveDuplicatePoints(true),
     ReleaseCount(true),
     Count(count),
-    InterpolationWeights()
+    InterpolationWeights(),
+    Plan(),
+    PlanIsShared(false),
+    MergeLayers(),
+    UseMergeLayers(false),
+    KeepInputPoints(false),
+    BlockSize(DefaultBlockSize())
     { }
 
   DAX_CONT_EXPORT
@@ -88,9 +102,53 @@ public:
     RemoveDuplicatePoints(true),
     ReleaseCount(true),
     Count(count),
-    InterpolationWeights()
+    InterpolationWeights(),
+    Plan(),
+    PlanIsShared(false),
+    MergeLayers(),
+    UseMergeLayers(false),
+    KeepInputPoints(false),
+    BlockSize(DefaultBlockSize())
+    { }
+
+
+  /// Makes a dispatcher for a worklet that derives from
+  /// dax::exec::WorkletInterpolatedCellSet. Such a worklet generates all the
+  /// cells of an input cell at once, so it needs no count array. The input
+  /// cells are invoked in blocks of GetBlockSize() cells, each run in order
+  /// by one thread that appends the cells it generates to a buffer with room
+  /// for MAX_CELLS cells per input cell. The counts of the blocks are then
+  /// scanned and the buffers compacted into the output. The input field is
+  /// read once and no count or map per cell is made, at the cost of the
+  /// buffers, which are sized for every input cell generating MAX_CELLS
+  /// cells. Merge layers are not supported for these worklets.
+  ///
+  DAX_CONT_EXPORT
+  explicit DispatcherGenerateInterpolatedCells(const WorkletType& work):
+    Superclass( work ),
+    RemoveDuplicatePoints(true),
+    ReleaseCount(false),
+    Count(),
+    InterpolationWeights(),
+    Plan(),
+    PlanIsShared(false),
+    MergeLayers(),
+    UseMergeLayers(false),
+    KeepInputPoints(false),
+    BlockSize(DefaultBlockSize())
     { }
 
+  /// Sets the number of consecutive input cells a worklet deriving from
+  /// dax::exec::WorkletInterpolatedCellSet is invoked on by one thread.
+  ///
+  DAX_CONT_EXPORT void SetBlockSize(dax::Id blockSize)
+    { this->BlockSize = blockSize; }
+
+  DAX_CONT_EXPORT dax::Id GetBlockSize() const
+    { return this->BlockSize; }
+
+  DAX_CONT_EXPORT static dax::Id DefaultBlockSize()
+    { return 256; }
 
   DAX_CONT_EXPORT void SetReleaseCount(bool b)
     { ReleaseCount = b; }
@@ -106,6 +164,51 @@ public:
   void DoReleaseCount()
     { Count.ReleaseResourcesExecution(); }
 
+  /// Gives the dispatcher a scatter plan to use instead of building its own
+  /// from the count array on every Invoke. If the plan is not valid it is
+  /// built from the count array the next time the dispatcher is invoked and
+  /// the caller's copy sees the result. Pass the same plan to other
+  /// dispatchers sharing the counts to skip rebuilding it.
+  ///
+  DAX_CONT_EXPORT void SetScatterPlan(const ScatterPlanType& plan)
+    { this->Plan = plan; this->PlanIsShared = true; }
+
+  /// Returns the scatter plan used by the last Invoke (or the one given to
+  /// SetScatterPlan).
+  ///
+  DAX_CONT_EXPORT ScatterPlanType GetScatterPlan() const
+    { return this->Plan; }
+
+  /// Gives each generated cell a layer, such as the index of the isovalue
+  /// it was contoured at, so that duplicate points are only merged within a
+  /// layer. Points of different layers lying on the same input edge are
+  /// then kept apart. The array is read after the worklet runs, so it is
+  /// usually also passed to Invoke as a FieldOut that the worklet fills with
+  /// one value per generated cell.
+  ///
+  DAX_CONT_EXPORT void SetMergeLayers(const LayerHandleType &layers)
+    { this->MergeLayers = layers; this->UseMergeLayers = true; }
+
+  /// Goes back to merging the points of all generated cells together.
+  ///
+  DAX_CONT_EXPORT void ClearMergeLayers()
+    { this->MergeLayers = LayerHandleType(); this->UseMergeLayers = false; }
+
+  /// Keeps every point of the input grid, with the same ids, ahead of the
+  /// new points in the output. A worklet emits an input point as a record
+  /// from the point to itself (SetInterpolationPoint with the same id twice),
+  /// and those records are mapped back to the input point instead of
+  /// becoming new points. The output then shares its points with grids whose
+  /// connections refer to the input points, such as cells passed through
+  /// by DispatcherGenerateTopology without removing duplicate points. This
+  /// needs duplicate points to be removed.
+  ///
+  DAX_CONT_EXPORT void SetKeepInputPoints(bool b)
+    { this->KeepInputPoints = b; }
+
+  DAX_CONT_EXPORT bool GetKeepInputPoints() const
+    { return this->KeepInputPoints; }
+
   DAX_CONT_EXPORT
   void SetRemoveDuplicatePoints(bool b)
     { RemoveDuplicatePoints = b; }
@@ -130,10 +233,13 @@ public:
     typedef typename dax::cont::ArrayHandle<T,Container2,DeviceAdapter>::
                                         PortalExecution OutPortalType;
 
-    const dax::Id size = output.GetNumberOfValues();
-    dax::exec::internal::kernel::InterpolateFieldToField<InPortalType,
-                                                         OutPortalType>
-        interpolate( input.PrepareForInput(),
+    const dax::Id size = this->InterpolationWeights.GetNumberOfValues();
+    dax::exec::internal::kernel::InterpolateFieldToField<
+        typename InterpolationWeightsType::PortalConstExecution,
+        InPortalType,
+        OutPortalType>
+        interpolate( this->InterpolationWeights.PrepareForInput(),
+                     input.PrepareForInput(),
                      output.PrepareForOutput(size));
 
     Algorithm::Schedule(interpolate, size);
@@ -148,13 +254,50 @@ private:
   void DoInvoke(WorkletType worklet,
                 ParameterPackType arguments)
   {
+    if(this->KeepInputPoints && !this->GetRemoveDuplicatePoints())
+      {
+      throw dax::cont::ErrorControlBadValue(
+        "Input points can only be kept when removing duplicate points.");
+      }
+
     this->GenerateNewTopology(
           worklet,
           dax::internal::ParameterPackGetArgument<1>(arguments),
           dax::internal::ParameterPackGetArgument<2>(arguments),
-          arguments);
+          arguments,
+          GeneratesCellSets());
   }
 
+  template<typename FunctorType>
+  DAX_CONT_EXPORT
+  void ScheduleIndices(FunctorType &functor, dax::Id count) const
+  {
+    this->ScheduleIndices(functor, count, GeneratesCellSets());
+  }
+
+  template<typename FunctorType>
+  DAX_CONT_EXPORT
+  void ScheduleIndices(FunctorType &functor,
+                       dax::Id count,
+                       boost::false_type) const
+  {
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(functor,
+                                                                  count);
+  }
+
+  //worklets generating sets of cells run the input cells of a block in
+  //order on one thread, so that each cell can append to the block's buffer
+  template<typename FunctorType>
+  DAX_CONT_EXPORT
+  void ScheduleIndices(FunctorType &functor,
+                       dax::Id count,
+                       boost::true_type) const
+  {
+    typedef dax::exec::internal::FunctorBlocks<FunctorType> BlocksType;
+    BlocksType blocks(functor, count, this->BlockSize);
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          blocks, BlocksType::GetNumberOfBlocks(count, this->BlockSize));
+  }
 
   template <typename InputGrid,
             typename OutputGrid,
@@ -163,41 +306,31 @@ private:
       WorkletType worklet,
       InputGrid inputGrid,
       OutputGrid outputGrid,
-      const ParameterPackType &arguments)
+      const ParameterPackType &arguments,
+      boost::false_type)
   {
     typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
         Algorithm;
     typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
         DeviceAdapterTag> IdArrayHandleType;
 
-    //do an inclusive scan of the cell count / cell mask to get the number
-    //of cells in the output
-    IdArrayHandleType scannedNewCellCounts;
-    const dax::Id numNewCells =
-        Algorithm::ScanInclusive(this->GetCount(),
-                                 scannedNewCellCounts);
+    //the scatter plan maps each new cell to the input cell that
+    //generated it
+    this->PrepareScatterPlan();
 
     if(this->GetReleaseCount())
       {
       this->DoReleaseCount();
       }
 
+    const dax::Id numNewCells = this->Plan.GetNumberOfOutputValues();
     if(numNewCells == 0)
       {
       //nothing to do
       return;
       }
 
-
-    //now do the uppper bounds of the cell indices so that we figure out
-    //which original topology indexs match the new indices.
-    IdArrayHandleType validCellRange;
-    Algorithm::UpperBounds(scannedNewCellCounts,
-                   dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
-                   validCellRange);
-
-    // We are done with scannedNewCellCounts.
-    scannedNewCellCounts.ReleaseResources();
+    IdArrayHandleType validCellRange = this->Plan.GetOutputToInputMap();
 
     //we need to scan the args of the generate topology worklet
     //and determine if we have the VisitIndex signature. If we do,
@@ -215,19 +348,14 @@ private:
 
     IndexArgType visitIndex;
     AddVisitIndexFunctor createVisitIndex;
-    createVisitIndex(validCellRange,visitIndex);
-
-    //make fake indicies so that the worklet can write out the interpolated
-    //cell points information as geometry
-    outputGrid.GetCellConnections().PrepareForOutput(
-       numNewCells * dax::CellTraits<typename OutputGrid::CellTag>::NUM_VERTICES);
-    dax::cont::DispatcherMapField< dax::exec::internal::kernel::Index >()
-                                      .Invoke(outputGrid.GetCellConnections());
+    createVisitIndex(this->Plan,visitIndex);
 
-    //Next step is to set the dispatcher to fill the output geometry
-    //with the interpolated cell values. We use the outputGrid,
-    //since a vec3 is what the interpolated cell values and the outputGrids
-    //coordinate space are
+    //the worklet writes each interpolated cell as records of the two input
+    //points and the weight of each of its points, so in place of the output
+    //grid it is given an array of records with one entry per output vertex
+    typedef dax::cont::internal::InterpolatedCellRecords<
+        typename OutputGrid::CellTag, DeviceAdapterTag> CellRecordsType;
+    CellRecordsType cellRecords;
 
     //we get our magic here. we need to wrap some parameters and pass
     //them to the real dispatcher
@@ -237,7 +365,9 @@ private:
           arguments.template Replace<1>(
             dax::cont::make_Permutation(validCellRange,inputGrid,
                                         inputGrid.GetNumberOfCells()))
+          .template Replace<2>(cellRecords)
           .Append(visitIndex));
+    this->InterpolationWeights = cellRecords.GetRecords();
 
     //now that the interpolated grid is filled we now have to properly
     //fixup the topology and coordinates
@@ -245,6 +375,98 @@ private:
                              this->GetRemoveDuplicatePoints());
   }
 
+  //a worklet generating sets of cells is invoked once on each input cell and
+  //appends the cells it generates to the buffer of its block of input cells.
+  //The only counts are the ones of the blocks, whose scan gives where each
+  //block goes in the output, and the blocks are then compacted into the
+  //interpolation records in order. The cells come out in the same order as
+  //generating them one at a time through a scatter plan.
+  template <typename InputGrid,
+            typename OutputGrid,
+            typename ParameterPackType>
+  DAX_CONT_EXPORT void GenerateNewTopology(
+      WorkletType worklet,
+      InputGrid inputGrid,
+      OutputGrid outputGrid,
+      const ParameterPackType &arguments,
+      boost::true_type)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> IdArrayHandleType;
+    typedef dax::cont::internal::InterpolatedCellBlocks<
+        typename OutputGrid::CellTag,
+        WorkletType::MAX_CELLS,
+        DeviceAdapterTag> CellBlocksType;
+
+    if(this->UseMergeLayers)
+      {
+      throw dax::cont::ErrorControlBadValue(
+        "Merge layers are not supported for worklets generating cell sets.");
+      }
+    if(this->BlockSize < 1)
+      {
+      throw dax::cont::ErrorControlBadValue(
+        "The block size must be at least one cell.");
+      }
+
+    const dax::Id numInputCells = inputGrid.GetNumberOfCells();
+    if(numInputCells == 0)
+      {
+      //nothing to do
+      return;
+      }
+
+    CellBlocksType cellBlocks(numInputCells, this->BlockSize);
+    this->BasicInvoke( worklet,
+                       arguments.template Replace<2>(cellBlocks) );
+
+    IdArrayHandleType blockOffsets;
+    const dax::Id numNewCells =
+        Algorithm::ScanExclusive(cellBlocks.GetBlockCounts(), blockOffsets);
+    if(numNewCells == 0)
+      {
+      //nothing to do
+      return;
+      }
+
+    {
+    dax::exec::internal::kernel::CompactInterpolatedCellBlocksFunctor<
+        typename CellBlocksType::RecordsType::PortalConstExecution,
+        typename IdArrayHandleType::PortalConstExecution,
+        typename InterpolationWeightsType::PortalExecution>
+        compact(cellBlocks.GetRecords().PrepareForInput(),
+                cellBlocks.GetBlockCounts().PrepareForInput(),
+                blockOffsets.PrepareForInput(),
+                this->InterpolationWeights.PrepareForOutput(
+                  numNewCells * CellBlocksType::NUM_VERTICES),
+                cellBlocks.GetBlockCapacity(),
+                CellBlocksType::NUM_VERTICES);
+    Algorithm::Schedule(compact, cellBlocks.GetNumberOfBlocks());
+    }
+    //the buffers are sized for every cell generating all it can, so free
+    //them before resolving the points
+    cellBlocks.GetRecords().ReleaseResources();
+
+    this->ResolveCoordinates(inputGrid,outputGrid,
+                             this->GetRemoveDuplicatePoints());
+  }
+
+  DAX_CONT_EXPORT void PrepareScatterPlan()
+  {
+    //without a plan from the user the counts may have changed since the
+    //last invoke, so start from a fresh plan
+    if(!this->PlanIsShared)
+      {
+      this->Plan = ScatterPlanType();
+      }
+    if(!this->Plan.IsValid())
+      {
+      this->Plan.Build(this->GetCount());
+      }
+  }
+
   //take the input grid and the interpolated grid to produce the new points
   //that fill the output grid. In the future the user should be able to to
   //specify the coordinate array to interpolate on, instead of it being based
@@ -255,33 +477,27 @@ private:
                                           OutputGrid& outputGrid,
                                           bool removeDuplicates )
   {
-    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
-        Algorithm;
+    //allocate the connections through the grid so that it drops any reverse
+    //connectivity built for its old cells
+    outputGrid.PrepareForOutput(
+      this->InterpolationWeights.GetNumberOfValues() /
+      dax::CellTraits<typename OutputGrid::CellTag>::NUM_VERTICES);
 
     if(removeDuplicates)
       {
-      //we have stored the interpolation weights inside the output grid coordinates
-      //which in the future needs to be changed. So store a copy of them
-      //into our own array handle
-      Algorithm::Copy(outputGrid.GetPointCoordinates(),
-                    this->InterpolationWeights);
-
-      // the sort and unique will get us the subset of new points
-      // the lower bounds on the subset and the original coords, will produce
-      // the resulting topology array
-
-      detail::sort_V3_less comparisonFunctor;
-
-      Algorithm::Sort(this->InterpolationWeights, comparisonFunctor );
-      Algorithm::Unique(this->InterpolationWeights);
-      Algorithm::LowerBounds(this->InterpolationWeights,
-                             outputGrid.GetPointCoordinates(),
-                             outputGrid.GetCellConnections(),
-                             comparisonFunctor );
-
-      //reduce and resize outputGrid
-      Algorithm::Copy(this->InterpolationWeights,
-                      outputGrid.GetPointCoordinates());
+      this->MergeDuplicatePoints(inputGrid.GetNumberOfPoints(), outputGrid);
+      if(this->KeepInputPoints)
+        {
+        this->PlaceAfterInputPoints(inputGrid.GetNumberOfPoints(), outputGrid);
+        }
+      }
+    else
+      {
+      //every record is a point of its own, so the connections simply
+      //enumerate them
+      dax::cont::DispatcherMapField< dax::exec::internal::kernel::Index,
+                                     DeviceAdapterTag >()
+                                      .Invoke(outputGrid.GetCellConnections());
       }
 
     this->CompactPointField(inputGrid.GetPointCoordinates(),
@@ -297,12 +513,387 @@ private:
       }
   }
 
+  //the worklet wrote one interpolation record per output vertex. Records
+  //lying on the same edge of the input grid are the same point, so merge
+  //them keyed by the edge: sort the edge keys, flag the first of each run and
+  //scan the flags to number the unique points. This works on integer ids and
+  //so is exact for any number of points. With merge layers the key also
+  //holds the layer of the cell.
+  //
+  //The layer and the two point ids usually fit in 64 bits, and then the
+  //packed keys are radix sorted on just the bits they use, which takes a
+  //fixed number of linear passes instead of a comparison sort. Only keys
+  //that do not fit are sorted by comparison.
+  template <typename OutputGrid>
+  DAX_CONT_EXPORT void MergeDuplicatePoints(dax::Id numInputPoints,
+                                            OutputGrid& outputGrid)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> IdArrayHandleType;
+    typedef dax::exec::internal::InterpolationEdgeKey EdgeKeyType;
+    typedef dax::cont::ArrayHandle<EdgeKeyType, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> EdgeKeyArrayHandleType;
+    typedef dax::Pair<dax::Id, EdgeKeyType> LayerKeyType;
+    typedef dax::cont::ArrayHandle<LayerKeyType, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> LayerKeyArrayHandleType;
+    typedef dax::cont::ArrayHandle<dax::internal::UInt64Type,
+        ArrayContainerControlTagBasic, DeviceAdapterTag>
+        PackedKeyArrayHandleType;
+    typedef dax::cont::ArrayHandleConstant<dax::Id, DeviceAdapterTag>
+        NoLayersType;
+    typedef InterpolationWeightsType RecordArrayHandleType;
+
+    RecordArrayHandleType records = this->InterpolationWeights;
+    const dax::Id numRecords = records.GetNumberOfValues();
+    if(numRecords == 0)
+      {
+      return;
+      }
+
+    const dax::Id numVertices =
+        dax::CellTraits<typename OutputGrid::CellTag>::NUM_VERTICES;
+    if(this->UseMergeLayers &&
+       this->MergeLayers.GetNumberOfValues() * numVertices != numRecords)
+      {
+      throw dax::cont::ErrorControlBadValue(
+        "Merge layers must hold one value per generated cell.");
+      }
+
+    const int pointBits = this->NumberOfBits(numInputPoints - 1);
+    const int layerBits =
+        this->UseMergeLayers ? this->NumberOfBits(this->MergeLayers) : 0;
+    const int keyBits = 2*pointBits + layerBits;
+
+    if(keyBits <= 64)
+      {
+      PackedKeyArrayHandleType keys;
+      if(this->UseMergeLayers)
+        {
+        dax::exec::internal::kernel::InterpolationPackedEdgeKeysFunctor<
+            typename RecordArrayHandleType::PortalExecution,
+            typename LayerHandleType::PortalConstExecution,
+            typename PackedKeyArrayHandleType::PortalExecution>
+            packedKeys(records.PrepareForInPlace(),
+                       this->MergeLayers.PrepareForInput(),
+                       numVertices,
+                       pointBits,
+                       keys.PrepareForOutput(numRecords));
+        Algorithm::Schedule(packedKeys, numRecords);
+        }
+      else
+        {
+        NoLayersType noLayers(0, numRecords / numVertices);
+        dax::exec::internal::kernel::InterpolationPackedEdgeKeysFunctor<
+            typename RecordArrayHandleType::PortalExecution,
+            typename NoLayersType::PortalConstExecution,
+            typename PackedKeyArrayHandleType::PortalExecution>
+            packedKeys(records.PrepareForInPlace(),
+                       noLayers.PrepareForInput(),
+                       numVertices,
+                       pointBits,
+                       keys.PrepareForOutput(numRecords));
+        Algorithm::Schedule(packedKeys, numRecords);
+        }
+      IdArrayHandleType sortedIndices;
+      this->RadixSortByKey(keys, sortedIndices, keyBits);
+      this->MergeSortedRecords(outputGrid, keys, sortedIndices);
+      }
+    else if(this->UseMergeLayers)
+      {
+      LayerKeyArrayHandleType keys;
+      dax::exec::internal::kernel::InterpolationLayerEdgeKeysFunctor<
+          typename RecordArrayHandleType::PortalExecution,
+          typename LayerHandleType::PortalConstExecution,
+          typename LayerKeyArrayHandleType::PortalExecution>
+          layerEdgeKeys(records.PrepareForInPlace(),
+                        this->MergeLayers.PrepareForInput(),
+                        numVertices,
+                        keys.PrepareForOutput(numRecords));
+      Algorithm::Schedule(layerEdgeKeys, numRecords);
+      this->MergeRecordsByKey(outputGrid, keys);
+      }
+    else
+      {
+      EdgeKeyArrayHandleType keys;
+      dax::exec::internal::kernel::InterpolationEdgeKeysFunctor<
+          typename RecordArrayHandleType::PortalExecution,
+          typename EdgeKeyArrayHandleType::PortalExecution>
+          edgeKeys(records.PrepareForInPlace(),
+                   keys.PrepareForOutput(numRecords));
+      Algorithm::Schedule(edgeKeys, numRecords);
+      this->MergeRecordsByKey(outputGrid, keys);
+      }
+  }
+
+  //number of bits needed to hold a non negative value
+  DAX_CONT_EXPORT static int NumberOfBits(dax::Id value)
+  {
+    const dax::internal::UInt64Type bits =
+        static_cast<dax::internal::UInt64Type>(value);
+    int numBits = 0;
+    while(numBits < 64 && (bits >> numBits) != 0)
+      {
+      ++numBits;
+      }
+    return numBits;
+  }
+
+  //number of bits needed to hold every value of an array, found by a binary
+  //search on the count of values with bits at or above a given bit. A
+  //negative value takes all 64.
+  DAX_CONT_EXPORT int NumberOfBits(const LayerHandleType &values) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> IdArrayHandleType;
+
+    const dax::Id numValues = values.GetNumberOfValues();
+    IdArrayHandleType flags;
+    IdArrayHandleType counts;
+    int low = 0;
+    int high = 64;
+    while(low < high)
+      {
+      const int middle = (low + high) / 2;
+      dax::exec::internal::kernel::MarkBitsAtOrAboveFunctor<
+          typename LayerHandleType::PortalConstExecution,
+          typename IdArrayHandleType::PortalExecution>
+          markBits(values.PrepareForInput(),
+                   flags.PrepareForOutput(numValues),
+                   middle);
+      Algorithm::Schedule(markBits, numValues);
+      if(Algorithm::ScanInclusive(flags, counts) == 0)
+        {
+        high = middle;
+        }
+      else
+        {
+        low = middle + 1;
+        }
+      }
+    return low;
+  }
+
+  //sorts keys on their numBits lowest bits and gives the original index of
+  //each sorted key. Each pass splits the keys on one bit, stably, with a scan
+  //of the keys having a 0 there, starting from the lowest bit. Passes on a
+  //bit that is the same for every key move nothing and are skipped.
+  template <typename KeyArrayHandleType, typename IdArrayHandleType>
+  DAX_CONT_EXPORT void RadixSortByKey(KeyArrayHandleType &keys,
+                                      IdArrayHandleType &sortedIndices,
+                                      int numBits) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+
+    const dax::Id numKeys = keys.GetNumberOfValues();
+    Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0),numKeys),
+                    sortedIndices);
+
+    KeyArrayHandleType keysOut;
+    IdArrayHandleType indicesOut;
+    IdArrayHandleType zeroFlags;
+    IdArrayHandleType zeroOffsets;
+    for(int bit = 0; bit < numBits; ++bit)
+      {
+      {
+      dax::exec::internal::kernel::RadixZeroFlagsFunctor<
+          typename KeyArrayHandleType::PortalConstExecution,
+          typename IdArrayHandleType::PortalExecution>
+          zeroFlagsFunctor(keys.PrepareForInput(),
+                           zeroFlags.PrepareForOutput(numKeys),
+                           bit);
+      Algorithm::Schedule(zeroFlagsFunctor, numKeys);
+      }
+      const dax::Id numZeros =
+          Algorithm::ScanExclusive(zeroFlags, zeroOffsets);
+      if(numZeros == 0 || numZeros == numKeys)
+        {
+        continue;
+        }
+
+      {
+      dax::exec::internal::kernel::RadixSplitFunctor<
+          typename KeyArrayHandleType::PortalConstExecution,
+          typename IdArrayHandleType::PortalConstExecution,
+          typename KeyArrayHandleType::PortalExecution,
+          typename IdArrayHandleType::PortalExecution>
+          split(keys.PrepareForInput(),
+                sortedIndices.PrepareForInput(),
+                zeroOffsets.PrepareForInput(),
+                numZeros,
+                bit,
+                keysOut.PrepareForOutput(numKeys),
+                indicesOut.PrepareForOutput(numKeys));
+      Algorithm::Schedule(split, numKeys);
+      }
+
+      //the sorted arrays of this pass are the input of the next
+      const KeyArrayHandleType sortedKeys = keysOut;
+      keysOut = keys;
+      keys = sortedKeys;
+      const IdArrayHandleType indices = indicesOut;
+      indicesOut = sortedIndices;
+      sortedIndices = indices;
+      }
+  }
+
+  //puts records of all the input points ahead of the merged records, which
+  //are renumbered so that records of an input point to itself become that
+  //input point and the new points follow in order
+  template <typename OutputGrid>
+  DAX_CONT_EXPORT void PlaceAfterInputPoints(dax::Id numInputPoints,
+                                             OutputGrid& outputGrid)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> IdArrayHandleType;
+    typedef InterpolationWeightsType RecordArrayHandleType;
+
+    RecordArrayHandleType records = this->InterpolationWeights;
+    const dax::Id numRecords = records.GetNumberOfValues();
+
+    IdArrayHandleType newPointFlags;
+    {
+    dax::exec::internal::kernel::MarkNewInterpolationRecordsFunctor<
+        typename RecordArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalExecution>
+        markNew(records.PrepareForInput(),
+                newPointFlags.PrepareForOutput(numRecords));
+    Algorithm::Schedule(markNew, numRecords);
+    }
+    IdArrayHandleType newPointOffsets;
+    const dax::Id numNewPoints =
+        Algorithm::ScanExclusive(newPointFlags, newPointOffsets);
+    newPointFlags.ReleaseResources();
+
+    InterpolationWeightsType placedRecords;
+    typename InterpolationWeightsType::PortalExecution placedPortal =
+        placedRecords.PrepareForOutput(numInputPoints + numNewPoints);
+    {
+    dax::exec::internal::kernel::InputPointRecordsFunctor<
+        typename InterpolationWeightsType::PortalExecution>
+        inputRecords(placedPortal);
+    Algorithm::Schedule(inputRecords, numInputPoints);
+    }
+
+    IdArrayHandleType pointIds;
+    {
+    dax::exec::internal::kernel::PlaceAfterInputPointsFunctor<
+        typename RecordArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalExecution,
+        typename InterpolationWeightsType::PortalExecution>
+        place(records.PrepareForInput(),
+              newPointOffsets.PrepareForInput(),
+              pointIds.PrepareForOutput(numRecords),
+              placedPortal,
+              numInputPoints);
+    Algorithm::Schedule(place, numRecords);
+    }
+
+    //point each connection at the placed id of its merged record
+    {
+    dax::exec::internal::kernel::RemapPointIdsFunctor<
+        typename IdArrayHandleType::PortalConstExecution,
+        typename OutputGrid::CellConnectionsType::PortalExecution>
+        remap(pointIds.PrepareForInput(),
+              outputGrid.GetCellConnections().PrepareForInPlace());
+    Algorithm::Schedule(remap,
+                        outputGrid.GetCellConnections().GetNumberOfValues());
+    }
+
+    this->InterpolationWeights = placedRecords;
+  }
+
+  //merges the interpolation records that share a key, given one key per
+  //record, by sorting the keys with a comparison sort
+  template <typename OutputGrid, typename KeyArrayHandleType>
+  DAX_CONT_EXPORT void MergeRecordsByKey(OutputGrid& outputGrid,
+                                         KeyArrayHandleType sortedKeys)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
+        DeviceAdapterTag> IdArrayHandleType;
+
+    const dax::Id numRecords = this->InterpolationWeights.GetNumberOfValues();
+    IdArrayHandleType sortedIndices;
+    Algorithm::Copy(dax::cont::make_ArrayHandleCounting(dax::Id(0),numRecords),
+                    sortedIndices);
+    Algorithm::SortByKey(sortedKeys, sortedIndices);
+    this->MergeSortedRecords(outputGrid, sortedKeys, sortedIndices);
+  }
+
+  //merges the interpolation records that share a key, given the sorted keys
+  //and the original index of each sorted key, and points the connections of
+  //the output grid at the merged records
+  template <typename OutputGrid,
+            typename KeyArrayHandleType,
+            typename IdArrayHandleType>
+  DAX_CONT_EXPORT void MergeSortedRecords(OutputGrid& outputGrid,
+                                          KeyArrayHandleType sortedKeys,
+                                          IdArrayHandleType sortedIndices)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+    typedef InterpolationWeightsType RecordArrayHandleType;
+
+    RecordArrayHandleType records = this->InterpolationWeights;
+    const dax::Id numRecords = records.GetNumberOfValues();
+
+    IdArrayHandleType flags;
+    {
+    dax::exec::internal::kernel::MarkUniqueKeysFunctor<
+        typename KeyArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalExecution>
+        markUnique(sortedKeys.PrepareForInput(),
+                   flags.PrepareForOutput(numRecords));
+    Algorithm::Schedule(markUnique, numRecords);
+    }
+    sortedKeys.ReleaseResources();
+
+    //the inclusive scan of the flags counts the edges up to and including
+    //each sorted record, which is one more than its merged point id
+    IdArrayHandleType uniqueIds;
+    const dax::Id numUniquePoints = Algorithm::ScanInclusive(flags, uniqueIds);
+
+    RecordArrayHandleType uniqueRecords;
+    {
+    dax::exec::internal::kernel::MergeInterpolationEdgesFunctor<
+        typename RecordArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalConstExecution,
+        typename IdArrayHandleType::PortalExecution,
+        typename RecordArrayHandleType::PortalExecution>
+        mergeEdges(records.PrepareForInput(),
+                   sortedIndices.PrepareForInput(),
+                   flags.PrepareForInput(),
+                   uniqueIds.PrepareForInput(),
+                   outputGrid.GetCellConnections().PrepareForOutput(
+                     numRecords),
+                   uniqueRecords.PrepareForOutput(numUniquePoints));
+    Algorithm::Schedule(mergeEdges, numRecords);
+    }
+
+    this->InterpolationWeights = uniqueRecords;
+  }
+
 
   bool RemoveDuplicatePoints;
   bool ReleaseCount;
   CountHandleType Count;
 
   InterpolationWeightsType InterpolationWeights;
+  ScatterPlanType Plan;
+  bool PlanIsShared;
+  LayerHandleType MergeLayers;
+  bool UseMergeLayers;
+  bool KeepInputPoints;
+  dax::Id BlockSize;
 
 };
 
@@ -17,6 +17,7 @@
 #define __dax_cont_DispatcherGenerateKeysValues_h
 
 #include <dax/Types.h>
+#include <dax/cont/ScatterPlan.h>
 #include <dax/cont/dispatcher/DispatcherBase.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
 #include <dax/exec/WorkletGenerateKeysValues.h>
@@ -53,18 +54,24 @@ public:
   typedef OutputCountType_ OutputCountType;
   typedef DeviceAdapterTag_ DeviceAdapterTag;
 
+  typedef dax::cont::ScatterPlan<DeviceAdapterTag> ScatterPlanType;
+
   DAX_CONT_EXPORT
   DispatcherGenerateKeysValues(OutputCountType outputCountArray):
     Superclass(WorkletType()),
     ReleaseOutputCountArray(true),
-    OutputCountArray(outputCountArray)
+    OutputCountArray(outputCountArray),
+    Plan(),
+    PlanIsShared(false)
     { }
 
   DAX_CONT_EXPORT
   DispatcherGenerateKeysValues(OutputCountType outputCountArray, WorkletType& work):
     Superclass( work ),
     ReleaseOutputCountArray(true),
-    OutputCountArray(outputCountArray)
+    OutputCountArray(outputCountArray),
+    Plan(),
+    PlanIsShared(false)
     { }
 
   DAX_CONT_EXPORT void SetReleaseOutputCountArray(bool flag){
@@ -83,6 +90,21 @@ public:
     this->OutputCountArray.ReleaseResourcesExecution();
   }
 
+  /// Gives the dispatcher a scatter plan to use instead of building its own
+  /// from the count array on every Invoke. If the plan is not valid it is
+  /// built from the count array the next time the dispatcher is invoked and
+  /// the caller's copy sees the result. Pass the same plan to other
+  /// dispatchers sharing the counts to skip rebuilding it.
+  ///
+  DAX_CONT_EXPORT void SetScatterPlan(const ScatterPlanType& plan)
+    { this->Plan = plan; this->PlanIsShared = true; }
+
+  /// Returns the scatter plan used by the last Invoke (or the one given to
+  /// SetScatterPlan).
+  ///
+  DAX_CONT_EXPORT ScatterPlanType GetScatterPlan() const
+    { return this->Plan; }
+
 private:
 
   template<typename ParameterPackType>
@@ -107,33 +129,30 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
   typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
       DeviceAdapterTag> IdArrayHandleType;
 
-  //do an inclusive scan of the cell count / cell mask to get the number
-  //of cells in the output
-  IdArrayHandleType scannedOutputCounts;
-  const dax::Id numNewValues =
-      Algorithm::ScanInclusive(this->GetOutputCountArray(),
-                               scannedOutputCounts);
+  //without a plan from the user the counts may have changed since the
+  //last invoke, so start from a fresh plan
+  if(!this->PlanIsShared)
+    {
+    this->Plan = ScatterPlanType();
+    }
+  if(!this->Plan.IsValid())
+    {
+    this->Plan.Build(this->GetOutputCountArray());
+    }
 
   if(this->GetReleaseOutputCountArray())
     {
     this->DoReleaseOutputCountArray();
     }
 
-  if(numNewValues == 0)
+  if(this->Plan.GetNumberOfOutputValues() == 0)
     {
     //nothing to do
     return;
     }
 
-
-  //now do the lower bounds of the cell indices so that we figure out
-  IdArrayHandleType outputIndexRanges;
-  Algorithm::UpperBounds(scannedOutputCounts,
-                 dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewValues),
-                 outputIndexRanges);
-
-  // We are done with scannedOutputCounts.
-  scannedOutputCounts.ReleaseResources();
+  //the plan maps each output value to the input cell that generated it
+  IdArrayHandleType outputIndexRanges = this->Plan.GetOutputToInputMap();
 
   //we need to scan the args of the generate topology worklet and determine if
   //we have the VisitIndex signature. If we do, we have to call a different
@@ -150,7 +169,7 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
 
   IndexArgType visitIndex;
   AddVisitIndexFunctor createVisitIndex;
-  createVisitIndex(outputIndexRanges,visitIndex);
+  createVisitIndex(this->Plan,visitIndex);
 
   DerivedWorkletType derivedWorklet(worklet);
 
@@ -165,6 +184,8 @@ DAX_CONT_EXPORT void InvokeGenerateKeysValues(
 
   bool ReleaseOutputCountArray;
   OutputCountType OutputCountArray;
+  ScatterPlanType Plan;
+  bool PlanIsShared;
 };
 
 } }
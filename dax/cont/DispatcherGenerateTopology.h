@@ -18,6 +18,7 @@
 
 #include <dax/Types.h>
 
+#include <dax/cont/ScatterPlan.h>
 #include <dax/cont/dispatcher/DispatcherBase.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
 #include <dax/exec/WorkletGenerateTopology.h>
@@ -59,13 +60,17 @@ public:
             dax::cont::ArrayContainerControlTagBasic,
             DeviceAdapterTag> PointMaskType;
 
+  typedef dax::cont::ScatterPlan<DeviceAdapterTag> ScatterPlanType;
+
   DAX_CONT_EXPORT
   DispatcherGenerateTopology(CountHandleType count):
     Superclass(WorkletType()),
     RemoveDuplicatePoints(true),
     ReleaseCount(true),
     Count(count),
-    PointMask()
+    PointMask(),
+    Plan(),
+    PlanIsShared(false)
     { }
 
   DAX_CONT_EXPORT
@@ -74,7 +79,9 @@ public:
     RemoveDuplicatePoints(true),
     ReleaseCount(true),
     Count(count),
-    PointMask()
+    PointMask(),
+    Plan(),
+    PlanIsShared(false)
     { }
 
   DAX_CONT_EXPORT void SetReleaseCount(bool b)
@@ -89,6 +96,22 @@ public:
   DAX_CONT_EXPORT void DoReleaseCount()
     { Count.ReleaseResourcesExecution(); }
 
+  /// Gives the dispatcher a scatter plan to use instead of building its own
+  /// from the count array on every Invoke. If the plan is not valid it is
+  /// built from the count array the next time the dispatcher is invoked and
+  /// the caller's copy sees the result. Pass the same plan to other
+  /// dispatchers sharing the counts to skip rebuilding it.
+  ///
+  DAX_CONT_EXPORT void SetScatterPlan(const ScatterPlanType& plan)
+    { this->Plan = plan; this->PlanIsShared = true; }
+
+  /// Returns the scatter plan used by the last Invoke (or the one given to
+  /// SetScatterPlan). When the count array is an \c ArrayHandleConstant and
+  /// no plan was given, the scatter is implicit and this plan is not valid.
+  ///
+  DAX_CONT_EXPORT ScatterPlanType GetScatterPlan() const
+    { return this->Plan; }
+
   DAX_CONT_EXPORT
   void SetRemoveDuplicatePoints(bool b){ RemoveDuplicatePoints = b; }
 
@@ -134,38 +157,86 @@ private:
       OutputGrid outputGrid,
       const ParameterPackType &arguments)
   {
-    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
-        Algorithm;
-    typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
-        DeviceAdapterTag> IdArrayHandleType;
+    typedef typename dax::cont::internal::IsConstantScatterCount<
+        CountHandleType>::type IsConstantCount;
 
-    //do an inclusive scan of the cell count / cell mask to get the number
-    //of cells in the output
-    IdArrayHandleType scannedNewCellCounts;
-    const dax::Id numNewCells =
-        Algorithm::ScanInclusive(this->GetCount(),
-                                 scannedNewCellCounts);
+    //a plan given by the user always wins, otherwise a constant count
+    //lets us skip building the scatter arrays altogether
+    if(!this->PlanIsShared && IsConstantCount::value)
+      {
+      this->GenerateNewTopologyConstant(worklet,inputGrid,outputGrid,
+                                        arguments,IsConstantCount());
+      return;
+      }
+
+    //the scatter plan maps each new cell to the input cell that
+    //generated it
+    this->PrepareScatterPlan();
 
     if(this->GetReleaseCount())
       {
       this->DoReleaseCount();
       }
 
-    if(numNewCells == 0)
+    this->GenerateWithScatterPlan(worklet,inputGrid,outputGrid,arguments,
+                                  this->Plan);
+  }
+
+  template <typename InputGrid,
+            typename OutputGrid,
+            typename ParameterPackType>
+  DAX_CONT_EXPORT void GenerateNewTopologyConstant(
+      WorkletType worklet,
+      const InputGrid inputGrid,
+      OutputGrid outputGrid,
+      const ParameterPackType &arguments,
+      boost::true_type)
+  {
+    //every input cell generates the same number of cells, so the new cell
+    //to input cell map and visit index are computed on the fly
+    const CountHandleType count = this->GetCount();
+    const dax::Id numInputCells = count.GetNumberOfValues();
+    const dax::Id countPerCell =
+        (numInputCells > 0) ? count.GetPortalConstControl().Get(0) : 0;
+    this->Plan = ScatterPlanType();
+
+    this->GenerateWithScatterPlan(worklet,inputGrid,outputGrid,arguments,
+              dax::cont::ScatterPlanConstant<DeviceAdapterTag>(countPerCell,
+                                                               numInputCells));
+  }
+
+  template <typename InputGrid,
+            typename OutputGrid,
+            typename ParameterPackType>
+  DAX_CONT_EXPORT void GenerateNewTopologyConstant(
+      WorkletType, const InputGrid, OutputGrid, const ParameterPackType &,
+      boost::false_type)
+  {
+    //never called, the count is not constant
+  }
+
+  template <typename InputGrid,
+            typename OutputGrid,
+            typename ParameterPackType,
+            typename PlanType>
+  DAX_CONT_EXPORT void GenerateWithScatterPlan(
+      WorkletType worklet,
+      const InputGrid inputGrid,
+      OutputGrid outputGrid,
+      const ParameterPackType &arguments,
+      const PlanType &plan)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>
+        Algorithm;
+
+    if(plan.GetNumberOfOutputValues() == 0)
       {
       //nothing to do
       return;
       }
 
-    //now do the lower bounds of the cell indices so that we figure out
-    //which original topology indexs match the new indices.
-    IdArrayHandleType validCellRange;
-    Algorithm::UpperBounds(scannedNewCellCounts,
-                   dax::cont::make_ArrayHandleCounting(dax::Id(0),numNewCells),
-                   validCellRange);
-
-    // We are done with scannedNewCellCounts.
-    scannedNewCellCounts.ReleaseResources();
+    typename PlanType::OutputToInputMapType validCellRange =
+        plan.GetOutputToInputMap();
 
     //we need to scan the args of the generate topology worklet
     //and determine if we have the VisitIndex signature. If we do,
@@ -177,13 +248,13 @@ private:
     //The AddVisitIndexArg does all this, plus creates a derived worklet
     //from the users worklet with the visit index added to the signature.
     typedef dax::cont::dispatcher::AddVisitIndexArg<WorkletType,
-      Algorithm,IdArrayHandleType> AddVisitIndexFunctor;
+      Algorithm,typename PlanType::VisitIndexType> AddVisitIndexFunctor;
     typedef typename AddVisitIndexFunctor::VisitIndexArgType IndexArgType;
     typedef typename AddVisitIndexFunctor::DerivedWorkletType DerivedWorkletType;
 
     IndexArgType visitIndex;
     AddVisitIndexFunctor createVisitIndex;
-    createVisitIndex(validCellRange,visitIndex);
+    createVisitIndex(plan,visitIndex);
 
     DerivedWorkletType derivedWorklet(worklet);
 
@@ -203,6 +274,20 @@ private:
       }
   }
 
+  DAX_CONT_EXPORT void PrepareScatterPlan()
+  {
+    //without a plan from the user the counts may have changed since the
+    //last invoke, so start from a fresh plan
+    if(!this->PlanIsShared)
+      {
+      this->Plan = ScatterPlanType();
+      }
+    if(!this->Plan.IsValid())
+      {
+      this->Plan.Build(this->GetCount());
+      }
+  }
+
   template<class InGridType, class OutGridType>
   DAX_CONT_EXPORT void FillPointMask(const InGridType &inGrid,
                                      const OutGridType &outGrid)
@@ -243,17 +328,22 @@ private:
     //compact the topology array to reference the extracted
     //coordinates ids
     {
-    // Make usedPointIds become a sorted array of used point indices.
-    // If entry i in usedPointIndices is j, then point index i in the
-    // output corresponds to point index j in the input.
+    // The point mask holds a 1 for every used input point, so its exclusive
+    // scan is the index of each used point in the compacted points.
     typedef dax::cont::ArrayHandle<dax::Id, ArrayContainerControlTagBasic,
         DeviceAdapterTag> IdArrayHandleType;
-    IdArrayHandleType usedPointIndices;
-    Algorithm::Copy(outGrid.GetCellConnections(), usedPointIndices);
-    Algorithm::Sort(usedPointIndices);
-    Algorithm::Unique(usedPointIndices);
-    // Modify the connections of outGrid to point to compacted points.
-    Algorithm::LowerBounds(usedPointIndices, outGrid.GetCellConnections());
+    IdArrayHandleType newPointIds;
+    Algorithm::ScanExclusive(this->PointMask, newPointIds);
+    // Rewrite the connections of outGrid in place to refer to the compacted
+    // points. outGrid is a copy that shares its arrays with the caller's
+    // grid, so the caller sees the new connections.
+    dax::exec::internal::kernel::RemapPointIdsFunctor<
+        typename IdArrayHandleType::PortalConstExecution,
+        typename OutGridType::CellConnectionsType::PortalExecution>
+        remap(newPointIds.PrepareForInput(),
+              outGrid.GetCellConnections().PrepareForInPlace());
+    Algorithm::Schedule(remap,
+                        outGrid.GetCellConnections().GetNumberOfValues());
     }
   }
 
@@ -261,6 +351,8 @@ private:
   bool ReleaseCount;
   CountHandleType Count;
   PointMaskType PointMask;
+  ScatterPlanType Plan;
+  bool PlanIsShared;
 };
 
 } } //namespace dax::cont
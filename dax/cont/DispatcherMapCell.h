@@ -18,10 +18,13 @@
 
 #include <dax/Types.h>
 #include <dax/cont/dispatcher/DispatcherBase.h>
+#include <dax/cont/dispatcher/MixedCellsArg.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
 #include <dax/exec/WorkletMapCell.h>
 #include <dax/internal/ParameterPack.h>
 
+#include <boost/mpl/bool.hpp>
+
 namespace dax { namespace cont {
 
 template <
@@ -57,10 +60,107 @@ private:
   template<typename ParameterPackType>
   DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
                                 ParameterPackType arguments) const
+  {
+    this->DoInvokeGrid(worklet,
+                       arguments,
+                       typename dax::cont::dispatcher::internal::
+                         FindUnstructuredGridMixed<ParameterPackType>::type());
+  }
+
+  template<typename ParameterPackType>
+  DAX_CONT_EXPORT void DoInvokeGrid(WorkletType worklet,
+                                    const ParameterPackType &arguments,
+                                    boost::mpl::false_) const
   {
     this->BasicInvoke(worklet, arguments);
   }
 
+  // A grid with mixed cell types is visited one type of cell at a time, so
+  // that each invocation is compiled for a fixed cell type.
+  template<typename ParameterPackType>
+  DAX_CONT_EXPORT void DoInvokeGrid(WorkletType worklet,
+                                    const ParameterPackType &arguments,
+                                    boost::mpl::true_) const
+  {
+    enum { GridIndex = dax::cont::dispatcher::internal::
+           FindUnstructuredGridMixed<ParameterPackType>::value };
+    typedef typename dax::cont::dispatcher::internal::ParameterPackArgType<
+        ParameterPackType, GridIndex>::type GridType;
+
+    InvokeCellShapeFunctor<ParameterPackType, GridType> functor(
+          *this,
+          worklet,
+          arguments,
+          dax::internal::ParameterPackGetArgument<GridIndex>(arguments));
+    GridType::ForEachCellShape(functor);
+  }
+
+  template<typename ParameterPackType, typename GridType>
+  struct InvokeCellShapeFunctor
+  {
+    const DispatcherMapCell &Dispatcher;
+    const WorkletType &Worklet;
+    const ParameterPackType &Arguments;
+    const GridType &Grid;
+    bool IsFirst;
+
+    DAX_CONT_EXPORT
+    InvokeCellShapeFunctor(const DispatcherMapCell &dispatcher,
+                           const WorkletType &worklet,
+                           const ParameterPackType &arguments,
+                           const GridType &grid)
+      : Dispatcher(dispatcher),
+        Worklet(worklet),
+        Arguments(arguments),
+        Grid(grid),
+        IsFirst(true) {  }
+
+    template<class CellTag>
+    DAX_CONT_EXPORT void operator()(CellTag)
+    {
+      if (this->Grid.GetNumberOfCellsOfShape(CellTag()) < 1) { return; }
+      dax::cont::dispatcher::MixedCellsGroup<GridType,CellTag>
+          group(this->Grid, this->IsFirst);
+      this->Dispatcher.template InvokeCellShape<1>(
+            this->Worklet,
+            group,
+            this->Arguments,
+            boost::mpl::true_());
+      this->IsFirst = false;
+    }
+  };
+
+  // Converts the arguments one at a time for the group of cells and invokes
+  // the worklet once all are converted.
+  template<int Index, typename GroupType, typename ParameterPackType>
+  DAX_CONT_EXPORT void InvokeCellShape(const WorkletType &worklet,
+                                       const GroupType &group,
+                                       const ParameterPackType &arguments,
+                                       boost::mpl::true_) const
+  {
+    typedef typename dax::cont::dispatcher::internal::ParameterPackArgType<
+        ParameterPackType, Index>::type ArgType;
+    dax::cont::dispatcher::MixedCellsArg<
+        WorkletType,Index,ArgType,GroupType> arg(
+          dax::internal::ParameterPackGetArgument<Index>(arguments), group);
+
+    this->template InvokeCellShape<Index+1>(
+          worklet,
+          group,
+          arguments.template Replace<Index>(arg.GetGroupArgument()),
+          boost::mpl::bool_<(Index < ParameterPackType::NUM_PARAMETERS)>());
+
+    arg.Finish(group);
+  }
+
+  template<int Index, typename GroupType, typename ParameterPackType>
+  DAX_CONT_EXPORT void InvokeCellShape(const WorkletType &worklet,
+                                       const GroupType &,
+                                       const ParameterPackType &arguments,
+                                       boost::mpl::false_) const
+  {
+    this->BasicInvoke(worklet, arguments);
+  }
 };
 
 } }
@@ -0,0 +1,95 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_DispatcherMapCellToPoint_h
+#define __dax_cont_DispatcherMapCellToPoint_h
+
+#include <dax/Types.h>
+#include <dax/cont/arg/Topology.h>
+#include <dax/cont/internal/DeviceAdapterTag.h>
+#include <dax/cont/internal/FindBinding.h>
+#include <dax/cont/internal/GridPointCells.h>
+#include <dax/cont/dispatcher/DispatcherBase.h>
+#include <dax/exec/WorkletMapCellToPoint.h>
+#include <dax/internal/Invocation.h>
+#include <dax/internal/ParameterPack.h>
+
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+namespace dax { namespace cont {
+
+/// Dispatcher for worklets that inherit dax::exec::WorkletMapCellToPoint.
+/// The worklet is invoked once for each point of the grid passed as its
+/// topology argument. The grid is visited through its reverse connectivity,
+/// so each point gathers the values of its incident cells in a single pass.
+/// Unstructured grids build the reverse connectivity the first time it is
+/// needed and keep it; uniform grids compute it on the fly.
+///
+template <
+  class WorkletType_,
+  class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class DispatcherMapCellToPoint :
+  public dax::cont::dispatcher::DispatcherBase<
+          DispatcherMapCellToPoint< WorkletType_, DeviceAdapterTag_ >,
+          dax::exec::WorkletMapCellToPoint,
+          WorkletType_,
+          DeviceAdapterTag_ >
+{
+
+  typedef dax::cont::dispatcher::DispatcherBase<
+          DispatcherMapCellToPoint< WorkletType_, DeviceAdapterTag_>,
+          dax::exec::WorkletMapCellToPoint,
+          WorkletType_,
+          DeviceAdapterTag_> Superclass;
+  friend class dax::cont::dispatcher::DispatcherBase<
+          DispatcherMapCellToPoint< WorkletType_, DeviceAdapterTag_>,
+          dax::exec::WorkletMapCellToPoint,
+          WorkletType_,
+          DeviceAdapterTag_>;
+
+public:
+  typedef WorkletType_ WorkletType;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+  DAX_CONT_EXPORT DispatcherMapCellToPoint() : Superclass(WorkletType()) { }
+  DAX_CONT_EXPORT DispatcherMapCellToPoint(WorkletType worklet)
+    : Superclass(worklet) { }
+
+private:
+  template<typename ParameterPackType>
+  DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
+                                ParameterPackType arguments) const
+  {
+    // Swap the grid given as topology for a wrapper that visits its points.
+    typedef dax::internal::Invocation<WorkletType,ParameterPackType>
+        Invocation;
+    enum { TopoIndex = dax::cont::internal::FindBinding<
+           Invocation, dax::cont::arg::Topology>::type::value };
+    typedef typename boost::remove_const<typename boost::remove_reference<
+        typename ParameterPackType::template Parameter<TopoIndex>::type
+        >::type>::type GridType;
+
+    this->BasicInvoke(
+          worklet,
+          arguments.template Replace<TopoIndex>(
+            dax::cont::internal::GridPointCells<GridType>(
+              dax::internal::ParameterPackGetArgument<TopoIndex>(arguments))));
+  }
+};
+
+} } // namespace dax::cont
+
+#endif //__dax_cont_DispatcherMapCellToPoint_h
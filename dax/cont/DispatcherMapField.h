@@ -16,6 +16,7 @@
 #ifndef __dax_cont_DispatcherMapField_h
 #define __dax_cont_DispatcherMapField_h
 
+#include <dax/Extent.h>
 #include <dax/Types.h>
 #include <dax/cont/internal/DeviceAdapterTag.h>
 #include <dax/cont/dispatcher/DispatcherBase.h>
@@ -48,12 +49,30 @@ public:
   typedef WorkletType_ WorkletType;
   typedef DeviceAdapterTag_ DeviceAdapterTag;
 
-  DAX_CONT_EXPORT DispatcherMapField() : Superclass(WorkletType())
+  DAX_CONT_EXPORT DispatcherMapField() : Superclass(WorkletType()),
+    HasPointExtent(false)
     { }
-  DAX_CONT_EXPORT DispatcherMapField(WorkletType worklet) : Superclass(worklet)
+  DAX_CONT_EXPORT DispatcherMapField(WorkletType worklet) : Superclass(worklet),
+    HasPointExtent(false)
     { }
 
+  /// Tells the dispatcher that the fields it is invoked with hold a value for
+  /// each point of a structured block with the given extent, laid out in the
+  /// usual i, j, k order. The worklet is then scheduled over the point
+  /// dimensions rather than as a flat range. Without this, the dispatcher
+  /// still does so when one of the arguments is the point coordinates of a
+  /// uniform grid.
+  ///
+  DAX_CONT_EXPORT void SetPointExtent(const dax::Extent3 &extent)
+    {
+    this->PointExtent = extent;
+    this->HasPointExtent = true;
+    }
+
 private:
+  dax::Extent3 PointExtent;
+  bool HasPointExtent;
+
   template<typename ParameterPackType>
   DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
                                 ParameterPackType arguments) const
@@ -61,6 +80,16 @@ private:
     this->BasicInvoke(worklet, arguments);
   }
 
+  template<typename SchedulingIndicesType>
+  DAX_CONT_EXPORT
+  void ConfigureScheduling(SchedulingIndicesType &scheduler) const
+  {
+    if (this->HasPointExtent)
+      {
+      scheduler.SetPointExtent(this->PointExtent);
+      }
+  }
+
 };
 
 } } // namespace dax::cont
@@ -0,0 +1,135 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_DispatcherMapPointNeighborhood_h
+#define __dax_cont_DispatcherMapPointNeighborhood_h
+
+#include <dax/Types.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/internal/DeviceAdapterTag.h>
+#include <dax/cont/dispatcher/DispatcherBase.h>
+#include <dax/exec/WorkletMapPointNeighborhood.h>
+#include <dax/exec/internal/FunctorTiles.h>
+#include <dax/internal/ParameterPack.h>
+
+namespace dax { namespace cont {
+
+/// Dispatcher for worklets that inherit dax::exec::WorkletMapPointNeighborhood.
+/// The worklet is invoked once for each point of the uniform grid passed as
+/// its topology argument, and every field must hold one value per point.
+///
+/// The points are visited in tiles of the grid, a row of each tile at a
+/// time. Along a row, the neighborhood of a point is shifted from that of the
+/// previous one so that only a new column of values is loaded. Across rows
+/// and planes, a tile small enough that its neighborhood fits in cache means
+/// those loads hit data already brought in by the rows before.
+///
+template <
+  class WorkletType_,
+  class DeviceAdapterTag_ = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class DispatcherMapPointNeighborhood :
+  public dax::cont::dispatcher::DispatcherBase<
+          DispatcherMapPointNeighborhood< WorkletType_, DeviceAdapterTag_ >,
+          dax::exec::WorkletMapPointNeighborhood,
+          WorkletType_,
+          DeviceAdapterTag_ >
+{
+
+  typedef dax::cont::dispatcher::DispatcherBase<
+          DispatcherMapPointNeighborhood< WorkletType_, DeviceAdapterTag_>,
+          dax::exec::WorkletMapPointNeighborhood,
+          WorkletType_,
+          DeviceAdapterTag_> Superclass;
+  friend class dax::cont::dispatcher::DispatcherBase<
+          DispatcherMapPointNeighborhood< WorkletType_, DeviceAdapterTag_>,
+          dax::exec::WorkletMapPointNeighborhood,
+          WorkletType_,
+          DeviceAdapterTag_>;
+
+public:
+  typedef WorkletType_ WorkletType;
+  typedef DeviceAdapterTag_ DeviceAdapterTag;
+
+  DAX_CONT_EXPORT DispatcherMapPointNeighborhood() : Superclass(WorkletType()),
+    TileSize(DefaultTileSize())
+    { }
+  DAX_CONT_EXPORT DispatcherMapPointNeighborhood(WorkletType worklet)
+    : Superclass(worklet),
+      TileSize(DefaultTileSize())
+    { }
+
+  /// Sets the number of points in the i, j, and k directions of the tiles
+  /// the grid is visited in. Each tile is handed to a single thread. Wider
+  /// tiles in i give longer rows to shift neighborhoods along; tiles shallow
+  /// in j and k keep the planes of the neighborhood in cache.
+  ///
+  DAX_CONT_EXPORT void SetTileSize(const dax::Id3 &tileSize)
+    {
+    if ((tileSize[0] < 1) || (tileSize[1] < 1) || (tileSize[2] < 1))
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Point neighborhood tiles must have at least one point in "
+            "each direction.");
+      }
+    this->TileSize = tileSize;
+    }
+  DAX_CONT_EXPORT const dax::Id3 &GetTileSize() const
+    {
+    return this->TileSize;
+    }
+
+private:
+  dax::Id3 TileSize;
+
+  DAX_CONT_EXPORT static dax::Id3 DefaultTileSize()
+    {
+    // 64 x 8 x 8 points of scalars with a neighborhood of radius 1 around them
+    // take about 26 KB, which fits in the L1 cache of most processors.
+    return dax::make_Id3(64, 8, 8);
+    }
+
+  template<typename ParameterPackType>
+  DAX_CONT_EXPORT void DoInvoke(WorkletType worklet,
+                                ParameterPackType arguments) const
+  {
+    this->BasicInvoke(worklet, arguments);
+  }
+
+  template<typename SchedulingIndicesType>
+  DAX_CONT_EXPORT
+  void ConfigureScheduling(SchedulingIndicesType &scheduler) const
+  {
+    if (!scheduler.isValidForGridScheduling())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Point neighborhood worklets must be given fields with one "
+            "value for each point of the grid.");
+      }
+  }
+
+  template<typename FunctorType>
+  DAX_CONT_EXPORT
+  void ScheduleGrid(FunctorType &functor, const dax::Id3 &pointDims) const
+  {
+    typedef dax::exec::internal::FunctorTiles<FunctorType> TilesType;
+    TilesType tiles(functor, pointDims, this->TileSize);
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          tiles, TilesType::GetNumberOfTiles(pointDims, this->TileSize));
+  }
+};
+
+} } // namespace dax::cont
+
+#endif //__dax_cont_DispatcherMapPointNeighborhood_h
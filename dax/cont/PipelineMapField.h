@@ -0,0 +1,320 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_PipelineMapField_h
+#define __dax_cont_PipelineMapField_h
+
+#include <dax/Types.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/exec/WorkletPipeline.h>
+
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/bool.hpp>
+
+namespace dax { namespace cont {
+
+namespace detail {
+
+template<class Stage1, class Stage2, class Stage3, class Stage4,
+         class Stage5, class Stage6, class Stage7, class Stage8>
+struct PipelineMapFieldBuild
+{
+  typedef PipelineMapFieldBuild<Stage2, Stage3, Stage4, Stage5,
+                                Stage6, Stage7, Stage8,
+                                dax::exec::internal::PipelineEnd> RestBuild;
+  typedef dax::exec::WorkletPipeline<Stage1, typename RestBuild::type> type;
+  static const int NUM_STAGES = RestBuild::NUM_STAGES + 1;
+};
+
+template<class Stage2, class Stage3, class Stage4,
+         class Stage5, class Stage6, class Stage7, class Stage8>
+struct PipelineMapFieldBuild<dax::exec::internal::PipelineEnd,
+                             Stage2, Stage3, Stage4,
+                             Stage5, Stage6, Stage7, Stage8>
+{
+  typedef dax::exec::internal::PipelineEnd type;
+  static const int NUM_STAGES = 0;
+};
+
+/// Dispatches a fused pipeline worklet. The last argument is always an output
+/// array, which also gives the device adapter.
+///
+template<class FusedWorkletType>
+class PipelineMapFieldInvoker
+{
+public:
+  DAX_CONT_EXPORT PipelineMapFieldInvoker(const FusedWorkletType &worklet)
+    : Worklet(worklet) {  }
+
+  template<class A1, class A2>
+  DAX_CONT_EXPORT void Invoke(const A1 &a1, const A2 &a2) const
+  {
+    BOOST_MPL_ASSERT_RELATION(FusedWorkletType::NUM_ARGUMENTS, ==, 2);
+    dax::cont::DispatcherMapField<
+        FusedWorkletType,typename A2::DeviceAdapterTag>(
+          this->Worklet).Invoke(a1, a2);
+  }
+  template<class A1, class A2, class A3>
+  DAX_CONT_EXPORT void Invoke(const A1 &a1, const A2 &a2, const A3 &a3) const
+  {
+    BOOST_MPL_ASSERT_RELATION(FusedWorkletType::NUM_ARGUMENTS, ==, 3);
+    dax::cont::DispatcherMapField<
+        FusedWorkletType,typename A3::DeviceAdapterTag>(
+          this->Worklet).Invoke(a1, a2, a3);
+  }
+  template<class A1, class A2, class A3, class A4>
+  DAX_CONT_EXPORT void Invoke(const A1 &a1, const A2 &a2, const A3 &a3,
+                              const A4 &a4) const
+  {
+    BOOST_MPL_ASSERT_RELATION(FusedWorkletType::NUM_ARGUMENTS, ==, 4);
+    dax::cont::DispatcherMapField<
+        FusedWorkletType,typename A4::DeviceAdapterTag>(
+          this->Worklet).Invoke(a1, a2, a3, a4);
+  }
+  template<class A1, class A2, class A3, class A4, class A5>
+  DAX_CONT_EXPORT void Invoke(const A1 &a1, const A2 &a2, const A3 &a3,
+                              const A4 &a4, const A5 &a5) const
+  {
+    BOOST_MPL_ASSERT_RELATION(FusedWorkletType::NUM_ARGUMENTS, ==, 5);
+    dax::cont::DispatcherMapField<
+        FusedWorkletType,typename A5::DeviceAdapterTag>(
+          this->Worklet).Invoke(a1, a2, a3, a4, a5);
+  }
+  template<class A1, class A2, class A3, class A4, class A5, class A6>
+  DAX_CONT_EXPORT void Invoke(const A1 &a1, const A2 &a2, const A3 &a3,
+                              const A4 &a4, const A5 &a5, const A6 &a6) const
+  {
+    BOOST_MPL_ASSERT_RELATION(FusedWorkletType::NUM_ARGUMENTS, ==, 6);
+    dax::cont::DispatcherMapField<
+        FusedWorkletType,typename A6::DeviceAdapterTag>(
+          this->Worklet).Invoke(a1, a2, a3, a4, a5, a6);
+  }
+  template<class A1, class A2, class A3, class A4, class A5, class A6,
+           class A7>
+  DAX_CONT_EXPORT void Invoke(const A1 &a1, const A2 &a2, const A3 &a3,
+                              const A4 &a4, const A5 &a5, const A6 &a6,
+                              const A7 &a7) const
+  {
+    BOOST_MPL_ASSERT_RELATION(FusedWorkletType::NUM_ARGUMENTS, ==, 7);
+    dax::cont::DispatcherMapField<
+        FusedWorkletType,typename A7::DeviceAdapterTag>(
+          this->Worklet).Invoke(a1, a2, a3, a4, a5, a6, a7);
+  }
+
+private:
+  FusedWorkletType Worklet;
+};
+
+} // namespace detail
+
+/// \headerfile PipelineMapField.h dax/cont/PipelineMapField.h
+/// \brief Runs a chain of map field worklets as a single worklet.
+///
+/// Each stage is a map field worklet or a dax::exec::PipelineStage. By
+/// default a stage is unary (its control signature is (FieldIn, FieldOut))
+/// and takes the output of the stage before it; the first stage takes the
+/// first input. Invoking the pipeline dispatches one worklet that runs every
+/// stage for an index before moving to the next index, so the values passed
+/// between the stages stay local and only the output of the last stage is
+/// written to an array. For example, this computes cos(sin(|v|)^2) for each
+/// vector v.
+///
+/// \code
+/// dax::cont::PipelineMapField<
+///     dax::exec::PipelineStage<dax::worklet::Magnitude, dax::Scalar>,
+///     dax::worklet::Sine,
+///     dax::worklet::Square,
+///     dax::worklet::Cosine> pipeline;
+/// pipeline.Invoke(vectors, result);
+/// \endcode
+///
+/// A PipelineStage can also wire the FieldIn arguments of its worklet, with
+/// up to three arguments per stage. dax::exec::PipelineInput<N> names input
+/// array \c N of the pipeline and dax::exec::PipelineResult<N> names the
+/// value of an earlier stage \c N (both count from 1). The pipeline takes as
+/// many input arrays as the highest PipelineInput any stage names (up to
+/// three), passed to Invoke in order before the output. For example, this
+/// computes sin(|v| * s) + |v| for each vector v and scalar s.
+///
+/// \code
+/// dax::cont::PipelineMapField<
+///     dax::exec::PipelineStage<dax::worklet::Magnitude, dax::Scalar>,
+///     dax::exec::PipelineStage<Multiply, dax::Scalar,
+///         void(dax::exec::PipelineResult<1>, dax::exec::PipelineInput<2>)>,
+///     dax::worklet::Sine,
+///     dax::exec::PipelineStage<Add, dax::Scalar,
+///         void(dax::exec::PipelineResult<3>, dax::exec::PipelineResult<1>)>
+///     > pipeline;
+/// pipeline.Invoke(vectors, scalars, result);
+/// \endcode
+///
+/// Recomputation rules: every stage runs exactly once per index and
+/// invocation, whether or not a later stage or output uses its value. A value
+/// used by several later stages is computed once. To also get the values of
+/// up to three intermediate stages, invoke through Keeping (or InvokeKeeping
+/// for a single input and kept stage). Kept values are the same ones passed
+/// to the later stages, written as they are produced; keeping a stage never
+/// runs it again. Nothing is cached between invocations, so invoking the
+/// pipeline again, or a shorter pipeline, to get another intermediate
+/// recomputes every stage up to it.
+///
+/// A stage whose worklet does not have one FieldIn for each wired argument
+/// and one FieldOut fails to compile with an assertion in
+/// dax::exec::WorkletPipeline.
+///
+template<class Stage1,
+         class Stage2 = dax::exec::internal::PipelineEnd,
+         class Stage3 = dax::exec::internal::PipelineEnd,
+         class Stage4 = dax::exec::internal::PipelineEnd,
+         class Stage5 = dax::exec::internal::PipelineEnd,
+         class Stage6 = dax::exec::internal::PipelineEnd,
+         class Stage7 = dax::exec::internal::PipelineEnd,
+         class Stage8 = dax::exec::internal::PipelineEnd>
+class PipelineMapField
+{
+  typedef detail::PipelineMapFieldBuild<Stage1, Stage2, Stage3, Stage4,
+                                        Stage5, Stage6, Stage7, Stage8> Build;
+
+public:
+  /// The map field worklet that runs all the stages.
+  ///
+  typedef typename Build::type WorkletType;
+
+  /// The number of stages in the pipeline.
+  ///
+  static const int NUM_STAGES = Build::NUM_STAGES;
+
+  /// The number of input arrays the pipeline takes.
+  ///
+  static const int NUM_INPUTS = WorkletType::NUM_INPUTS;
+
+private:
+  BOOST_MPL_ASSERT_RELATION(NUM_INPUTS, <=, 3);
+
+  typedef dax::exec::internal::WorkletPipelineFused<
+      WorkletType,NUM_INPUTS> FusedWorkletType;
+  typedef detail::PipelineMapFieldInvoker<FusedWorkletType> InvokerType;
+
+public:
+  DAX_CONT_EXPORT PipelineMapField() {  }
+  DAX_CONT_EXPORT PipelineMapField(const WorkletType &worklet)
+    : Worklet(worklet) {  }
+
+  DAX_CONT_EXPORT const WorkletType &GetWorklet() const
+  {
+    return this->Worklet;
+  }
+
+  /// Runs the pipeline like PipelineMapField::Invoke and also writes the
+  /// values of stages \c Keep1, \c Keep2, and \c Keep3 (0 keeps nothing). The
+  /// arguments of Invoke are the inputs, then one array for each kept stage
+  /// in order, then the output. Kept stages must come before the last one.
+  ///
+  /// \code
+  /// PipelineType::Keeping<1,2>(pipeline).Invoke(
+  ///     vectors, scalars, magnitudes, products, result);
+  /// \endcode
+  ///
+  template<int Keep1, int Keep2 = 0, int Keep3 = 0>
+  class Keeping
+      : public detail::PipelineMapFieldInvoker<
+          dax::exec::internal::WorkletPipelineFused<
+            WorkletType,NUM_INPUTS,Keep1,Keep2,Keep3> >
+  {
+    typedef dax::exec::internal::WorkletPipelineFused<
+        WorkletType,NUM_INPUTS,Keep1,Keep2,Keep3> KeepingWorkletType;
+
+    BOOST_MPL_ASSERT_RELATION(Keep1, >=, 1);
+    BOOST_MPL_ASSERT_RELATION(Keep1, <, NUM_STAGES);
+    BOOST_MPL_ASSERT_RELATION(Keep2, >=, 0);
+    BOOST_MPL_ASSERT_RELATION(Keep2, <, NUM_STAGES);
+    BOOST_MPL_ASSERT_RELATION(Keep3, >=, 0);
+    BOOST_MPL_ASSERT_RELATION(Keep3, <, NUM_STAGES);
+    // Keep3 can only be given along with Keep2.
+    BOOST_MPL_ASSERT((boost::mpl::bool_<(Keep2 != 0) || (Keep3 == 0)>));
+
+  public:
+    DAX_CONT_EXPORT Keeping(const PipelineMapField &pipeline)
+      : detail::PipelineMapFieldInvoker<KeepingWorkletType>(
+          KeepingWorkletType(pipeline.GetWorklet())) {  }
+  };
+
+  /// Runs every stage of the pipeline on \c input and writes the output of
+  /// the last stage to \c output. \c input can be anything a FieldIn of a
+  /// DispatcherMapField accepts.
+  ///
+  template<class InputType, typename T, class Container, class DeviceAdapterTag>
+  DAX_CONT_EXPORT void Invoke(
+      const InputType &input,
+      dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &output) const
+  {
+    InvokerType(FusedWorkletType(this->Worklet)).Invoke(input, output);
+  }
+
+  /// Runs the pipeline on two input arrays.
+  ///
+  template<class Input1Type, class Input2Type,
+           typename T, class Container, class DeviceAdapterTag>
+  DAX_CONT_EXPORT void Invoke(
+      const Input1Type &input1,
+      const Input2Type &input2,
+      dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &output) const
+  {
+    InvokerType(FusedWorkletType(this->Worklet)).Invoke(input1,
+                                                        input2,
+                                                        output);
+  }
+
+  /// Runs the pipeline on three input arrays.
+  ///
+  template<class Input1Type, class Input2Type, class Input3Type,
+           typename T, class Container, class DeviceAdapterTag>
+  DAX_CONT_EXPORT void Invoke(
+      const Input1Type &input1,
+      const Input2Type &input2,
+      const Input3Type &input3,
+      dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &output) const
+  {
+    InvokerType(FusedWorkletType(this->Worklet)).Invoke(input1,
+                                                        input2,
+                                                        input3,
+                                                        output);
+  }
+
+  /// Runs every stage of the pipeline like Invoke, and also writes the output
+  /// of stage \c KeepStage (the first stage is 1) to \c kept. The kept stage
+  /// must come before the last one. This is a shorthand of Keeping for a
+  /// pipeline with one input.
+  ///
+  template<int KeepStage,
+           class InputType,
+           typename KeptT, class KeptContainer,
+           typename T, class Container, class DeviceAdapterTag>
+  DAX_CONT_EXPORT void InvokeKeeping(
+      const InputType &input,
+      dax::cont::ArrayHandle<KeptT,KeptContainer,DeviceAdapterTag> &kept,
+      dax::cont::ArrayHandle<T,Container,DeviceAdapterTag> &output) const
+  {
+    Keeping<KeepStage>(*this).Invoke(input, kept, output);
+  }
+
+private:
+  WorkletType Worklet;
+};
+
+}} // namespace dax::cont
+
+#endif //__dax_cont_PipelineMapField_h
@@ -0,0 +1,628 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__RectilinearGrid_h
+#define __dax__cont__RectilinearGrid_h
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/internal/ArrayTransfer.h>
+#include <dax/cont/internal/GridTags.h>
+#include <dax/cont/internal/IteratorFromArrayPortal.h>
+
+#include <dax/CellTag.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/internal/FieldAccess.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+#include <dax/internal/FastDivide.h>
+
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <algorithm>
+
+namespace dax {
+namespace cont {
+
+namespace detail {
+
+/// An array portal holding the point coordinates of a rectilinear grid. Each
+/// coordinate is looked up in the array of coordinates along its axis, so
+/// only the three axis arrays are stored. Like the coordinates of a uniform
+/// grid, random access splits the flat index into an i, j, k location with a
+/// precomputed multiply-shift division, and access through an \c IJKIndex
+/// does not divide at all.
+///
+template<class AxisPortalType>
+class ArrayPortalFromRectilinearGridPointCoordinates
+{
+public:
+  typedef dax::Vector3 ValueType;
+  typedef dax::cont::internal::IteratorFromArrayPortal<
+      ArrayPortalFromRectilinearGridPointCoordinates<AxisPortalType> >
+      IteratorType;
+
+  DAX_EXEC_CONT_EXPORT
+  ArrayPortalFromRectilinearGridPointCoordinates()
+    : Dimensions(0, 0, 0), NumberOfValues(0), UseFastDivide(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayPortalFromRectilinearGridPointCoordinates(
+      const AxisPortalType &xCoordinates,
+      const AxisPortalType &yCoordinates,
+      const AxisPortalType &zCoordinates)
+    : XCoordinates(xCoordinates),
+      YCoordinates(yCoordinates),
+      ZCoordinates(zCoordinates),
+      Dimensions(xCoordinates.GetNumberOfValues(),
+                 yCoordinates.GetNumberOfValues(),
+                 zCoordinates.GetNumberOfValues()),
+      NumberOfValues(0),
+      UseFastDivide(false)
+  {
+    this->NumberOfValues =
+        this->Dimensions[0]*this->Dimensions[1]*this->Dimensions[2];
+    if ((this->NumberOfValues > 0)
+        && (static_cast<dax::internal::UInt64Type>(this->NumberOfValues)
+            <= 0x7FFFFFFFul))
+      {
+      this->XDivisor = dax::internal::FastDivisor(
+            static_cast<dax::internal::UInt32Type>(this->Dimensions[0]));
+      this->YDivisor = dax::internal::FastDivisor(
+            static_cast<dax::internal::UInt32Type>(this->Dimensions[1]));
+      this->UseFastDivide = true;
+      }
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::Id GetNumberOfValues() const { return this->NumberOfValues; }
+
+  /// The extent of the points, which always starts at the origin.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::Extent3 GetExtent() const {
+    return dax::Extent3(dax::make_Id3(0, 0, 0),
+                        this->Dimensions - dax::make_Id3(1, 1, 1));
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  ValueType Get(dax::Id index) const {
+    return this->GetFromIJK(this->ComputeLocation(index));
+  }
+
+  /// Returns the coordinates of the point at the given i, j, k location.
+  /// Used through \c FieldGet when the points are scheduled with an \c
+  /// IJKIndex.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  ValueType GetFromIJK(const dax::Id3 &ijk) const {
+    return dax::make_Vector3(this->XCoordinates.Get(ijk[0]),
+                             this->YCoordinates.Get(ijk[1]),
+                             this->ZCoordinates.Get(ijk[2]));
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  const dax::Id3 &GetIJKDimensions() const { return this->Dimensions; }
+
+  /// Converts a flat index to an i, j, k location without integer division
+  /// for all but enormous grids.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::Id3 ComputeLocation(dax::Id index) const {
+    if (!this->UseFastDivide)
+      {
+      return dax::flatIndexToIndex3(index, this->GetExtent());
+      }
+    dax::internal::UInt32Type i, j;
+    const dax::internal::UInt32Type jk = this->XDivisor.Divide(
+          static_cast<dax::internal::UInt32Type>(index), i);
+    const dax::internal::UInt32Type k = this->YDivisor.Divide(jk, j);
+    return dax::make_Id3(static_cast<dax::Id>(i),
+                         static_cast<dax::Id>(j),
+                         static_cast<dax::Id>(k));
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorBegin() const {
+    return IteratorType(*this);
+  }
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const {
+    return IteratorType(*this, this->GetNumberOfValues());
+  }
+
+private:
+  AxisPortalType XCoordinates;
+  AxisPortalType YCoordinates;
+  AxisPortalType ZCoordinates;
+  dax::Id3 Dimensions;
+  dax::Id NumberOfValues;
+  dax::internal::FastDivisor XDivisor;
+  dax::internal::FastDivisor YDivisor;
+  bool UseFastDivide;
+};
+
+} // namespace detail
+
+namespace internal {
+
+/// Tag for the container of the point coordinates of a rectilinear grid. The
+/// container holds the three arrays of coordinates along each axis.
+///
+template<class AxisArrayHandleType>
+struct ArrayContainerControlTagRectilinearCoordinates {  };
+
+template<class AxisArrayHandleType>
+class ArrayContainerControl<
+    dax::Vector3,
+    ArrayContainerControlTagRectilinearCoordinates<AxisArrayHandleType> >
+{
+public:
+  typedef dax::Vector3 ValueType;
+  typedef dax::cont::detail::ArrayPortalFromRectilinearGridPointCoordinates<
+      typename AxisArrayHandleType::PortalConstControl> PortalConstType;
+
+  // This is meant to be invalid. The coordinates are computed from the axis
+  // arrays, so you should only be able to use the const version.
+  struct PortalType {
+    typedef void *ValueType;
+    typedef void *IteratorType;
+  };
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl() : Valid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayContainerControl(const AxisArrayHandleType &xCoordinates,
+                        const AxisArrayHandleType &yCoordinates,
+                        const AxisArrayHandleType &zCoordinates)
+    : XCoordinates(xCoordinates),
+      YCoordinates(yCoordinates),
+      ZCoordinates(zCoordinates),
+      Valid(true) {  }
+
+  DAX_CONT_EXPORT
+  PortalType GetPortal() {
+    throw dax::cont::ErrorControlBadValue(
+          "Rectilinear grid point coordinates are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstType GetPortalConst() const {
+    DAX_ASSERT_CONT(this->Valid);
+    return PortalConstType(this->XCoordinates.GetPortalConstControl(),
+                           this->YCoordinates.GetPortalConstControl(),
+                           this->ZCoordinates.GetPortalConstControl());
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->Valid);
+    return this->XCoordinates.GetNumberOfValues()
+        * this->YCoordinates.GetNumberOfValues()
+        * this->ZCoordinates.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void Allocate(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Rectilinear grid point coordinates are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Rectilinear grid point coordinates are read-only.");
+  }
+
+  // The grid owns the axis arrays, so there is nothing to release here.
+  DAX_CONT_EXPORT
+  void ReleaseResources() {  }
+
+private:
+  AxisArrayHandleType XCoordinates;
+  AxisArrayHandleType YCoordinates;
+  AxisArrayHandleType ZCoordinates;
+  bool Valid;
+};
+
+template<class AxisArrayHandleType, class DeviceAdapterTag>
+class ArrayTransfer<
+    dax::Vector3,
+    ArrayContainerControlTagRectilinearCoordinates<AxisArrayHandleType>,
+    DeviceAdapterTag>
+{
+private:
+  typedef ArrayContainerControlTagRectilinearCoordinates<AxisArrayHandleType>
+      ArrayContainerControlTag;
+  typedef dax::cont::internal::ArrayContainerControl<
+      dax::Vector3,ArrayContainerControlTag> ContainerType;
+
+public:
+  typedef dax::Vector3 ValueType;
+
+  typedef typename ContainerType::PortalType PortalControl;
+  typedef typename ContainerType::PortalConstType PortalConstControl;
+
+  typedef PortalControl PortalExecution;
+  typedef dax::cont::detail::ArrayPortalFromRectilinearGridPointCoordinates<
+      typename AxisArrayHandleType::PortalConstExecution> PortalConstExecution;
+
+  DAX_CONT_EXPORT
+  ArrayTransfer() : ArraysValid(false), ExecutionPortalConstValid(false) {  }
+
+  DAX_CONT_EXPORT
+  ArrayTransfer(const AxisArrayHandleType &xCoordinates,
+                const AxisArrayHandleType &yCoordinates,
+                const AxisArrayHandleType &zCoordinates)
+    : XCoordinates(xCoordinates),
+      YCoordinates(yCoordinates),
+      ZCoordinates(zCoordinates),
+      ArraysValid(true),
+      ExecutionPortalConstValid(false) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfValues() const {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    return this->XCoordinates.GetNumberOfValues()
+        * this->YCoordinates.GetNumberOfValues()
+        * this->ZCoordinates.GetNumberOfValues();
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInput(PortalConstControl daxNotUsed(portal)) {
+    // Assumes the given portal reads the same axis arrays as this.
+    DAX_ASSERT_CONT(this->ArraysValid);
+    this->ExecutionPortalConst = PortalConstExecution(
+          this->XCoordinates.PrepareForInput(),
+          this->YCoordinates.PrepareForInput(),
+          this->ZCoordinates.PrepareForInput());
+    this->ExecutionPortalConstValid = true;
+  }
+
+  DAX_CONT_EXPORT
+  void LoadDataForInPlace(PortalControl daxNotUsed(portal)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Rectilinear grid point coordinates cannot be used in place.");
+  }
+
+  DAX_CONT_EXPORT
+  void AllocateArrayForOutput(ContainerType &daxNotUsed(controlArray),
+                              dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Rectilinear grid point coordinates cannot be used for output.");
+  }
+
+  DAX_CONT_EXPORT
+  void RetrieveOutputData(ContainerType &daxNotUsed(controlArray)) const {
+    throw dax::cont::ErrorControlBadValue(
+          "Rectilinear grid point coordinates cannot be used for output.");
+  }
+
+  template <class IteratorTypeControl>
+  DAX_CONT_EXPORT void CopyInto(IteratorTypeControl dest) const
+  {
+    DAX_ASSERT_CONT(this->ArraysValid);
+    PortalConstControl portal(this->XCoordinates.GetPortalConstControl(),
+                              this->YCoordinates.GetPortalConstControl(),
+                              this->ZCoordinates.GetPortalConstControl());
+    std::copy(portal.GetIteratorBegin(), portal.GetIteratorEnd(), dest);
+  }
+
+  DAX_CONT_EXPORT
+  void Shrink(dax::Id daxNotUsed(numberOfValues)) {
+    throw dax::cont::ErrorControlBadValue(
+          "Rectilinear grid point coordinates are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  PortalExecution GetPortalExecution() {
+    throw dax::cont::ErrorControlBadValue(
+          "Rectilinear grid point coordinates are read-only.");
+  }
+
+  DAX_CONT_EXPORT
+  PortalConstExecution GetPortalConstExecution() const {
+    DAX_ASSERT_CONT(this->ExecutionPortalConstValid);
+    return this->ExecutionPortalConst;
+  }
+
+  // The grid owns the axis arrays, so leave their memory alone.
+  DAX_CONT_EXPORT
+  void ReleaseResources() {
+    this->ExecutionPortalConstValid = false;
+  }
+
+private:
+  AxisArrayHandleType XCoordinates;
+  AxisArrayHandleType YCoordinates;
+  AxisArrayHandleType ZCoordinates;
+  bool ArraysValid;
+  PortalConstExecution ExecutionPortalConst;
+  bool ExecutionPortalConstValid;
+};
+
+} // namespace internal
+
+namespace detail {
+
+/// An ArrayHandle of the point coordinates of a rectilinear grid. This
+/// subclass only exists to reach the constructor of ArrayHandle that takes
+/// a container and array transfer; copy it to its superclass.
+///
+template<class AxisArrayHandleType>
+class ArrayHandleRectilinearGridPointCoordinates
+    : public dax::cont::ArrayHandle<
+        dax::Vector3,
+        dax::cont::internal::ArrayContainerControlTagRectilinearCoordinates<
+          AxisArrayHandleType>,
+        typename AxisArrayHandleType::DeviceAdapterTag>
+{
+  typedef dax::cont::internal::ArrayContainerControlTagRectilinearCoordinates<
+      AxisArrayHandleType> ArrayContainerControlTag;
+  typedef typename AxisArrayHandleType::DeviceAdapterTag DeviceAdapterTag;
+  typedef dax::cont::internal::ArrayContainerControl<
+      dax::Vector3,ArrayContainerControlTag> ContainerType;
+  typedef dax::cont::internal::ArrayTransfer<
+      dax::Vector3,ArrayContainerControlTag,DeviceAdapterTag> ArrayTransferType;
+
+public:
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3,ArrayContainerControlTag,DeviceAdapterTag> Superclass;
+
+  DAX_CONT_EXPORT
+  ArrayHandleRectilinearGridPointCoordinates(
+      const AxisArrayHandleType &xCoordinates,
+      const AxisArrayHandleType &yCoordinates,
+      const AxisArrayHandleType &zCoordinates)
+    : Superclass(ContainerType(xCoordinates, yCoordinates, zCoordinates),
+                 true,
+                 ArrayTransferType(xCoordinates, yCoordinates, zCoordinates),
+                 false)
+  {  }
+};
+
+} // namespace detail
+
+}
+} // namespace dax::cont
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+template<class AxisPortalType>
+struct ArrayPortalIJKTraits<
+    dax::cont::detail::ArrayPortalFromRectilinearGridPointCoordinates<
+      AxisPortalType> >
+{
+  typedef boost::true_type HasIJKAccess;
+};
+
+}
+}
+} // namespace dax::exec::internal
+
+namespace dax {
+namespace cont {
+
+/// This class defines the topology of a rectilinear grid. A rectilinear grid
+/// is axis aligned like a uniform grid, but the spacing between grid points
+/// can vary along each axis. The grid is defined by three arrays holding the
+/// coordinates of the grid points along the x, y, and z axes.
+///
+/// The connections of the cells are implicit and are the same as those of a
+/// uniform grid with the same dimensions. Worklets given a rectilinear grid
+/// are scheduled over the i, j, k indices of the cells just like they are
+/// for a uniform grid. The point coordinates are computed from the three
+/// axis arrays on demand, so no connections or point coordinates are stored.
+///
+template <
+    class ArrayContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class RectilinearGrid
+{
+public:
+  typedef dax::CellTagVoxel CellTag;
+  typedef dax::cont::internal::RectilinearGridTag GridTypeTag;
+
+  typedef dax::cont::ArrayHandle<
+      dax::Scalar, ArrayContainerControlTag, DeviceAdapterTag>
+      AxisCoordinatesType;
+
+  DAX_CONT_EXPORT
+  RectilinearGrid() {  }
+
+  DAX_CONT_EXPORT
+  RectilinearGrid(AxisCoordinatesType xCoordinates,
+                  AxisCoordinatesType yCoordinates,
+                  AxisCoordinatesType zCoordinates)
+    : XCoordinates(xCoordinates),
+      YCoordinates(yCoordinates),
+      ZCoordinates(zCoordinates) {  }
+
+  /// The XCoordinates array holds the x coordinate of each plane of points
+  /// perpendicular to the x axis, in increasing index order. Its length is
+  /// the number of points along the x axis.
+  ///
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetXCoordinates() const {
+    return this->XCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetXCoordinates(AxisCoordinatesType coordinates) {
+    this->XCoordinates = coordinates;
+  }
+
+  /// The YCoordinates array holds the y coordinate of each plane of points
+  /// perpendicular to the y axis.
+  ///
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetYCoordinates() const {
+    return this->YCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetYCoordinates(AxisCoordinatesType coordinates) {
+    this->YCoordinates = coordinates;
+  }
+
+  /// The ZCoordinates array holds the z coordinate of each plane of points
+  /// perpendicular to the z axis.
+  ///
+  DAX_CONT_EXPORT
+  const AxisCoordinatesType &GetZCoordinates() const {
+    return this->ZCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetZCoordinates(AxisCoordinatesType coordinates) {
+    this->ZCoordinates = coordinates;
+  }
+
+  /// The extent of the grid's points. It always starts at the origin and
+  /// goes up to the length of each coordinate array less one.
+  ///
+  DAX_CONT_EXPORT
+  dax::Extent3 GetExtent() const {
+    return dax::Extent3(dax::make_Id3(0, 0, 0),
+                        dax::make_Id3(this->XCoordinates.GetNumberOfValues(),
+                                      this->YCoordinates.GetNumberOfValues(),
+                                      this->ZCoordinates.GetNumberOfValues())
+                        - dax::make_Id3(1, 1, 1));
+  }
+
+  // Helper functions
+
+  /// Get the number of points.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    dax::Id3 dims = dax::extentDimensions(this->GetExtent());
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Get the number of cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    dax::Id3 dims = dax::extentCellDimensions(this->GetExtent());
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Converts an i, j, k point location to a point index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputePointIndex(const dax::Id3 &ijk) const {
+    return dax::index3ToFlatIndex(ijk, this->GetExtent());
+  }
+
+  /// Converts an i, j, k cell location to a cell index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputeCellIndex(const dax::Id3 &ijk) const {
+    return dax::index3ToFlatIndexCell(ijk, this->GetExtent());
+  }
+
+  /// Converts a flat point index to an i, j, k point location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 ComputePointLocation(dax::Id index) const {
+    return dax::flatIndexToIndex3(index, this->GetExtent());
+  }
+
+  /// Converts a flat cell index to an i, j, k cell location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 ComputeCellLocation(dax::Id index) const {
+    return dax::flatIndexToIndex3Cell(index, this->GetExtent());
+  }
+
+  /// Given a point i, j, k location, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id3 location) const {
+    return dax::make_Vector3(
+          this->XCoordinates.GetPortalConstControl().Get(location[0]),
+          this->YCoordinates.GetPortalConstControl().Get(location[1]),
+          this->ZCoordinates.GetPortalConstControl().Get(location[2]));
+  }
+
+  /// Given a point index, computes the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id index) const {
+    return this->ComputePointCoordinates(this->ComputePointLocation(index));
+  }
+
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3,
+      dax::cont::internal::ArrayContainerControlTagRectilinearCoordinates<
+          AxisCoordinatesType>,
+      DeviceAdapterTag> PointCoordinatesType;
+
+  /// Returns a read-only array of the coordinates of every point, computed
+  /// from the three axis arrays.
+  ///
+  DAX_CONT_EXPORT
+  PointCoordinatesType GetPointCoordinates() const {
+    return detail::ArrayHandleRectilinearGridPointCoordinates<
+        AxisCoordinatesType>(this->XCoordinates,
+                             this->YCoordinates,
+                             this->ZCoordinates);
+  }
+
+  typedef dax::exec::internal::TopologyUniform TopologyStructConstExecution;
+  typedef dax::exec::internal::TopologyUniform TopologyStructExecution;
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment.  Returns a structure that can be used directly
+  /// in the execution environment. The topology of a rectilinear grid is the
+  /// same as that of a uniform grid. Only its connections are used; the
+  /// point coordinates come from GetPointCoordinates.
+  ///
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    TopologyStructConstExecution topology;
+    topology.Origin = dax::make_Vector3(0.0, 0.0, 0.0);
+    topology.Spacing = dax::make_Vector3(1.0, 1.0, 1.0);
+    topology.Extent = this->GetExtent();
+    return topology;
+  }
+
+  typedef dax::exec::internal::TopologyUniform PointCellsStructConstExecution;
+
+  /// Prepares the reverse connectivity of this topology (the cells incident
+  /// to each point) to be used as an input to an operation in the execution
+  /// environment. As with a uniform grid, nothing is stored.
+  ///
+  DAX_CONT_EXPORT
+  PointCellsStructConstExecution PreparePointCellsForInput() const {
+    return this->PrepareForInput();
+  }
+
+private:
+  AxisCoordinatesType XCoordinates;
+  AxisCoordinatesType YCoordinates;
+  AxisCoordinatesType ZCoordinates;
+};
+
+}
+}
+
+#endif //__dax__cont__RectilinearGrid_h
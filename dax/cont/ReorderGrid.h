@@ -0,0 +1,328 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ReorderGrid_h
+#define __dax_cont_ReorderGrid_h
+
+#include <dax/CellTraits.h>
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/exec/internal/SpaceFillingCurve.h>
+#include <dax/exec/internal/kernel/ReorderGridWorklets.h>
+
+namespace dax {
+namespace cont {
+
+/// \brief Renumbers the points and cells of an unstructured grid along a
+/// space filling curve.
+///
+/// Meshers tend to number points and cells in ways that have little to do
+/// with where they are, so gathering the point values of a cell (as
+/// \c FieldPointIn arguments do) jumps all over memory. \c ReorderGrid
+/// computes a Morton or Hilbert key for every point and for the centroid of
+/// every cell, sorts both by key, and builds a new grid in that order with
+/// the cell connections renumbered. Nearby points and cells then end up
+/// nearby in memory.
+///
+/// The permutations are kept so that fields on the points or cells of the
+/// original grid can be reordered to match the new grid, and results
+/// computed on the new grid can be restored to the original order.
+///
+template<class CurveTag = dax::exec::internal::SpaceFillingCurveTagHilbert,
+         class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class ReorderGrid
+{
+public:
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> PermutationType;
+
+  /// Computes the new order of the points and cells of \c inGrid and writes
+  /// the reordered grid to \c outGrid. The two grids must not share arrays.
+  ///
+  template<typename CellTag, class ConnectionsTag, class PointsTag>
+  DAX_CONT_EXPORT void Run(
+      const dax::cont::UnstructuredGrid<
+          CellTag,ConnectionsTag,PointsTag,DeviceAdapterTag> &inGrid,
+      dax::cont::UnstructuredGrid<
+          CellTag,ConnectionsTag,PointsTag,DeviceAdapterTag> &outGrid)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef dax::cont::UnstructuredGrid<
+        CellTag,ConnectionsTag,PointsTag,DeviceAdapterTag> GridType;
+    typedef typename GridType::CellConnectionsType ConnectionsHandleType;
+    typedef typename GridType::PointCoordinatesType PointsHandleType;
+    const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+
+    const dax::Id numPoints = inGrid.GetNumberOfPoints();
+    const dax::Id numCells = inGrid.GetNumberOfCells();
+
+    dax::Vector3 origin;
+    dax::Vector3 scale;
+    this->ComputeLattice(inGrid.GetPointCoordinates(), origin, scale);
+
+    // Sort the points by key, carrying along their old indices.
+    PermutationType keys;
+    Algorithm::Copy(
+          dax::cont::ArrayHandleCounting<dax::Id,DeviceAdapterTag>(0,
+                                                                   numPoints),
+          this->PointPermutation);
+    Algorithm::Schedule(
+          dax::exec::internal::kernel::PointCurveKeyFunctor<
+              CurveTag,
+              typename PointsHandleType::PortalConstExecution,
+              typename PermutationType::PortalExecution>(
+            inGrid.GetPointCoordinates().PrepareForInput(),
+            keys.PrepareForOutput(numPoints),
+            origin,
+            scale),
+          numPoints);
+    Algorithm::SortByKey(keys, this->PointPermutation);
+    this->Invert(this->PointPermutation, this->PointInversePermutation);
+
+    // Sort the cells by the key of their centroid.
+    Algorithm::Copy(
+          dax::cont::ArrayHandleCounting<dax::Id,DeviceAdapterTag>(0,
+                                                                   numCells),
+          this->CellPermutation);
+    Algorithm::Schedule(
+          dax::exec::internal::kernel::CellCurveKeyFunctor<
+              CurveTag,
+              NUM_VERTICES,
+              typename ConnectionsHandleType::PortalConstExecution,
+              typename PointsHandleType::PortalConstExecution,
+              typename PermutationType::PortalExecution>(
+            inGrid.GetCellConnections().PrepareForInput(),
+            inGrid.GetPointCoordinates().PrepareForInput(),
+            keys.PrepareForOutput(numCells),
+            origin,
+            scale),
+          numCells);
+    Algorithm::SortByKey(keys, this->CellPermutation);
+    this->Invert(this->CellPermutation, this->CellInversePermutation);
+
+    // Gather the cells in their new order and renumber their points.
+    ConnectionsHandleType connections;
+    Algorithm::Schedule(
+          dax::exec::internal::kernel::PermuteCellConnectionsFunctor<
+              NUM_VERTICES,
+              typename PermutationType::PortalConstExecution,
+              typename PermutationType::PortalConstExecution,
+              typename ConnectionsHandleType::PortalConstExecution,
+              typename ConnectionsHandleType::PortalExecution>(
+            this->CellPermutation.PrepareForInput(),
+            this->PointInversePermutation.PrepareForInput(),
+            inGrid.GetCellConnections().PrepareForInput(),
+            connections.PrepareForOutput(numCells*NUM_VERTICES)),
+          numCells);
+
+    PointsHandleType points;
+    this->ReorderPointField(inGrid.GetPointCoordinates(), points);
+
+    outGrid = GridType(connections, points);
+  }
+
+  /// Returns, for each point of the reordered grid, the index of the same
+  /// point in the original grid.
+  ///
+  DAX_CONT_EXPORT PermutationType GetPointPermutation() const
+  {
+    return this->PointPermutation;
+  }
+
+  /// Returns, for each cell of the reordered grid, the index of the same cell
+  /// in the original grid.
+  ///
+  DAX_CONT_EXPORT PermutationType GetCellPermutation() const
+  {
+    return this->CellPermutation;
+  }
+
+  /// Returns, for each point of the original grid, the index of the same
+  /// point in the reordered grid.
+  ///
+  DAX_CONT_EXPORT PermutationType GetPointInversePermutation() const
+  {
+    return this->PointInversePermutation;
+  }
+
+  /// Returns, for each cell of the original grid, the index of the same cell
+  /// in the reordered grid.
+  ///
+  DAX_CONT_EXPORT PermutationType GetCellInversePermutation() const
+  {
+    return this->CellInversePermutation;
+  }
+
+  /// Copies a field on the points of the original grid into the order of
+  /// the points of the reordered grid.
+  ///
+  template<typename T, class InContainerTag, class OutContainerTag>
+  DAX_CONT_EXPORT void ReorderPointField(
+      const dax::cont::ArrayHandle<T,InContainerTag,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,OutContainerTag,DeviceAdapterTag> &output) const
+  {
+    this->Gather(this->PointPermutation, input, output);
+  }
+
+  /// Copies a field on the cells of the original grid into the order of the
+  /// cells of the reordered grid.
+  ///
+  template<typename T, class InContainerTag, class OutContainerTag>
+  DAX_CONT_EXPORT void ReorderCellField(
+      const dax::cont::ArrayHandle<T,InContainerTag,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,OutContainerTag,DeviceAdapterTag> &output) const
+  {
+    this->Gather(this->CellPermutation, input, output);
+  }
+
+  /// Copies a field on the points of the reordered grid back into the order
+  /// of the points of the original grid.
+  ///
+  template<typename T, class InContainerTag, class OutContainerTag>
+  DAX_CONT_EXPORT void RestorePointField(
+      const dax::cont::ArrayHandle<T,InContainerTag,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,OutContainerTag,DeviceAdapterTag> &output) const
+  {
+    this->Gather(this->PointInversePermutation, input, output);
+  }
+
+  /// Copies a field on the cells of the reordered grid back into the order
+  /// of the cells of the original grid.
+  ///
+  template<typename T, class InContainerTag, class OutContainerTag>
+  DAX_CONT_EXPORT void RestoreCellField(
+      const dax::cont::ArrayHandle<T,InContainerTag,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,OutContainerTag,DeviceAdapterTag> &output) const
+  {
+    this->Gather(this->CellInversePermutation, input, output);
+  }
+
+private:
+  // Finds the lattice the keys are computed on. It covers the bounds of the
+  // points with cubic bins so that the curve is not stretched along any axis.
+  template<class PointsHandleType>
+  DAX_CONT_EXPORT void ComputeLattice(const PointsHandleType &points,
+                                      dax::Vector3 &origin,
+                                      dax::Vector3 &scale) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef dax::cont::ArrayHandle<dax::Vector3,
+                                   dax::cont::ArrayContainerControlTagBasic,
+                                   DeviceAdapterTag> BoundsHandleType;
+    typedef dax::exec::internal::kernel::PointBoundsFunctor<
+        typename PointsHandleType::PortalConstExecution,
+        typename BoundsHandleType::PortalExecution> BoundsFunctor;
+
+    origin = dax::make_Vector3(0.0, 0.0, 0.0);
+    scale = dax::make_Vector3(0.0, 0.0, 0.0);
+    const dax::Id numPoints = points.GetNumberOfValues();
+    if (numPoints < 1) { return; }
+
+    const dax::Id numChunks =
+        (numPoints + BoundsFunctor::CHUNK_SIZE - 1)/BoundsFunctor::CHUNK_SIZE;
+    BoundsHandleType minBounds;
+    BoundsHandleType maxBounds;
+    Algorithm::Schedule(BoundsFunctor(points.PrepareForInput(),
+                                      minBounds.PrepareForOutput(numChunks),
+                                      maxBounds.PrepareForOutput(numChunks)),
+                        numChunks);
+
+    typename BoundsHandleType::PortalConstControl minPortal =
+        minBounds.GetPortalConstControl();
+    typename BoundsHandleType::PortalConstControl maxPortal =
+        maxBounds.GetPortalConstControl();
+    origin = minPortal.Get(0);
+    dax::Vector3 maxCorner = maxPortal.Get(0);
+    for (dax::Id chunk = 1; chunk < numChunks; ++chunk)
+      {
+      const dax::Vector3 chunkMin = minPortal.Get(chunk);
+      const dax::Vector3 chunkMax = maxPortal.Get(chunk);
+      for (int component = 0; component < 3; ++component)
+        {
+        if (chunkMin[component] < origin[component])
+          {
+          origin[component] = chunkMin[component];
+          }
+        if (chunkMax[component] > maxCorner[component])
+          {
+          maxCorner[component] = chunkMax[component];
+          }
+        }
+      }
+
+    dax::Scalar length = 0;
+    for (int component = 0; component < 3; ++component)
+      {
+      const dax::Scalar axisLength = maxCorner[component] - origin[component];
+      if (axisLength > length) { length = axisLength; }
+      }
+    if (length > 0)
+      {
+      const dax::Scalar steps = static_cast<dax::Scalar>(
+            (dax::Id(1) << dax::exec::internal::SPACE_FILLING_CURVE_BITS) - 1);
+      scale = dax::make_Vector3(steps/length, steps/length, steps/length);
+      }
+  }
+
+  DAX_CONT_EXPORT void Invert(const PermutationType &permutation,
+                              PermutationType &inverse) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    const dax::Id numValues = permutation.GetNumberOfValues();
+    Algorithm::Schedule(
+          dax::exec::internal::kernel::InvertPermutationFunctor<
+              typename PermutationType::PortalConstExecution,
+              typename PermutationType::PortalExecution>(
+            permutation.PrepareForInput(),
+            inverse.PrepareForOutput(numValues)),
+          numValues);
+  }
+
+  template<typename T, class InContainerTag, class OutContainerTag>
+  DAX_CONT_EXPORT void Gather(
+      const PermutationType &indices,
+      const dax::cont::ArrayHandle<T,InContainerTag,DeviceAdapterTag> &input,
+      dax::cont::ArrayHandle<T,OutContainerTag,DeviceAdapterTag> &output) const
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef dax::cont::ArrayHandle<T,InContainerTag,DeviceAdapterTag>
+        InputHandleType;
+    DAX_ASSERT_CONT(indices.GetNumberOfValues()
+                    == input.GetNumberOfValues());
+    Algorithm::Copy(
+          dax::cont::ArrayHandlePermutation<
+              PermutationType,InputHandleType,DeviceAdapterTag>(indices, input),
+          output);
+  }
+
+  PermutationType PointPermutation;
+  PermutationType PointInversePermutation;
+  PermutationType CellPermutation;
+  PermutationType CellInversePermutation;
+};
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ReorderGrid_h
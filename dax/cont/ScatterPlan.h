@@ -0,0 +1,249 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_ScatterPlan_h
+#define __dax_cont_ScatterPlan_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleConstant.h>
+#include <dax/cont/ArrayHandleImplicit.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/exec/internal/kernel/VisitIndexWorklets.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace dax {
+namespace cont {
+
+/// \brief Describes how the output values of a generate-style dispatch map
+/// back to the input values that produced them.
+///
+/// A \c ScatterPlan is built from a count array giving the number of output
+/// values each input value generates. It holds the output to input map, the
+/// total number of output values and the visit index of each output value.
+/// Building these is the expensive part of the generate dispatchers (a scan
+/// plus a pass over the whole output), so when the counts do not change
+/// between dispatches (for example when several fields are generated over
+/// the same topology, or a timestep only changes point coordinates) the same
+/// plan should be given to each dispatcher.
+///
+/// Like \c ArrayHandle, copies of a \c ScatterPlan share their state. A plan
+/// that is default constructed or has been invalidated is rebuilt from the
+/// count array of the next dispatcher it is given to.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class ScatterPlan
+{
+public:
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayHandleType;
+  typedef IdArrayHandleType OutputToInputMapType;
+  typedef IdArrayHandleType VisitIndexType;
+
+  /// Creates an invalid plan. It has to be built before it is used.
+  ///
+  DAX_CONT_EXPORT ScatterPlan() : Internals(new InternalStruct)
+  {
+    this->Internals->Valid = false;
+    this->Internals->NumberOfInputValues = 0;
+    this->Internals->NumberOfOutputValues = 0;
+  }
+
+  /// Creates a plan from an array with the number of output values each
+  /// input value generates.
+  ///
+  template<class CountHandleType>
+  DAX_CONT_EXPORT explicit ScatterPlan(const CountHandleType &count)
+    : Internals(new InternalStruct)
+  {
+    this->Build(count);
+  }
+
+  /// (Re)builds the plan from an array with the number of output values each
+  /// input value generates. Every copy of this plan sees the new state.
+  ///
+  template<class CountHandleType>
+  DAX_CONT_EXPORT void Build(const CountHandleType &count)
+  {
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+    this->Invalidate();
+
+    //do an inclusive scan of the counts to get the number of output values
+    IdArrayHandleType scannedCounts;
+    const dax::Id numOutputValues = Algorithm::ScanInclusive(count,
+                                                             scannedCounts);
+
+    //walk the scanned counts once to write, for each output value, the
+    //input value that generated it and how many outputs that input value
+    //generated before it. This is balanced over the output values, so a few
+    //inputs generating many values do not serialize the pass.
+    if(numOutputValues > 0)
+      {
+      typedef dax::exec::internal::kernel::ScatterMapAndVisitIndex<
+          typename IdArrayHandleType::PortalConstExecution,
+          typename IdArrayHandleType::PortalExecution> ScatterKernel;
+      ScatterKernel kernel(
+            scannedCounts.PrepareForInput(),
+            this->Internals->OutputToInputMap.PrepareForOutput(numOutputValues),
+            this->Internals->VisitIndex.PrepareForOutput(numOutputValues),
+            numOutputValues);
+      const dax::Id numChunks =
+          (numOutputValues + ScatterKernel::CHUNK_SIZE - 1)
+          / ScatterKernel::CHUNK_SIZE;
+      Algorithm::Schedule(kernel, numChunks);
+      }
+
+    this->Internals->NumberOfInputValues = count.GetNumberOfValues();
+    this->Internals->NumberOfOutputValues = numOutputValues;
+    this->Internals->Valid = true;
+  }
+
+  /// Marks the plan as out of date and releases the arrays it holds. Call
+  /// this when the counts the plan was built from change.
+  ///
+  DAX_CONT_EXPORT void Invalidate()
+  {
+    this->Internals->OutputToInputMap.ReleaseResources();
+    this->Internals->VisitIndex.ReleaseResources();
+    this->Internals->Valid = false;
+    this->Internals->NumberOfInputValues = 0;
+    this->Internals->NumberOfOutputValues = 0;
+  }
+
+  /// Returns true if the plan has been built and not invalidated since.
+  ///
+  DAX_CONT_EXPORT bool IsValid() const { return this->Internals->Valid; }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfInputValues() const
+  {
+    return this->Internals->NumberOfInputValues;
+  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfOutputValues() const
+  {
+    return this->Internals->NumberOfOutputValues;
+  }
+
+  /// Returns an array with, for each output value, the index of the input
+  /// value that generated it.
+  ///
+  DAX_CONT_EXPORT IdArrayHandleType GetOutputToInputMap() const
+  {
+    return this->Internals->OutputToInputMap;
+  }
+
+  /// Returns an array with, for each output value, how many output values
+  /// the same input value generated before it.
+  ///
+  DAX_CONT_EXPORT IdArrayHandleType GetVisitIndex() const
+  {
+    return this->Internals->VisitIndex;
+  }
+
+private:
+  struct InternalStruct
+  {
+    IdArrayHandleType OutputToInputMap;
+    IdArrayHandleType VisitIndex;
+    dax::Id NumberOfInputValues;
+    dax::Id NumberOfOutputValues;
+    bool Valid;
+  };
+
+  boost::shared_ptr<InternalStruct> Internals;
+};
+
+/// \brief A scatter where every input value generates the same number of
+/// output values.
+///
+/// The output to input map and the visit index of such a scatter are simple
+/// functions of the output index, so this plan holds no arrays at all and
+/// costs nothing to build. The generate dispatchers use it automatically when
+/// they are given an \c ArrayHandleConstant as the count array.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class ScatterPlanConstant
+{
+public:
+  typedef dax::cont::ArrayHandleImplicit<dax::Id,
+      dax::exec::internal::kernel::ConstantScatterInputIndex,
+      DeviceAdapterTag> OutputToInputMapType;
+  typedef dax::cont::ArrayHandleImplicit<dax::Id,
+      dax::exec::internal::kernel::ConstantScatterVisitIndex,
+      DeviceAdapterTag> VisitIndexType;
+
+  DAX_CONT_EXPORT ScatterPlanConstant(dax::Id countPerInput,
+                                      dax::Id numberOfInputValues)
+    : CountPerInput(countPerInput),
+      NumberOfInputValues(numberOfInputValues) {  }
+
+  DAX_CONT_EXPORT bool IsValid() const { return true; }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfInputValues() const
+  {
+    return this->NumberOfInputValues;
+  }
+
+  DAX_CONT_EXPORT dax::Id GetNumberOfOutputValues() const
+  {
+    return this->CountPerInput * this->NumberOfInputValues;
+  }
+
+  DAX_CONT_EXPORT OutputToInputMapType GetOutputToInputMap() const
+  {
+    return OutputToInputMapType(
+          dax::exec::internal::kernel::ConstantScatterInputIndex(
+            this->CountPerInput),
+          this->GetNumberOfOutputValues());
+  }
+
+  DAX_CONT_EXPORT VisitIndexType GetVisitIndex() const
+  {
+    return VisitIndexType(
+          dax::exec::internal::kernel::ConstantScatterVisitIndex(
+            this->CountPerInput),
+          this->GetNumberOfOutputValues());
+  }
+
+private:
+  dax::Id CountPerInput;
+  dax::Id NumberOfInputValues;
+};
+
+namespace internal {
+
+/// Tells whether a count array has the same value everywhere, in which case a
+/// \c ScatterPlanConstant can be used.
+///
+template<class CountHandleType>
+struct IsConstantScatterCount : boost::false_type {  };
+
+template<class DeviceAdapterTag>
+struct IsConstantScatterCount<
+    dax::cont::ArrayHandleConstant<dax::Id,DeviceAdapterTag> >
+    : boost::true_type {  };
+
+} // namespace internal
+
+}
+} // namespace dax::cont
+
+#endif //__dax_cont_ScatterPlan_h
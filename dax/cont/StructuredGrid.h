@@ -0,0 +1,194 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__cont__StructuredGrid_h
+#define __dax__cont__StructuredGrid_h
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/Assert.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/internal/GridTags.h>
+
+#include <dax/CellTag.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/internal/TopologyStructured.h>
+
+namespace dax {
+namespace cont {
+
+/// This class defines the topology of a structured (curvilinear) grid. Like
+/// a uniform grid, the points are arranged in a regular i, j, k lattice given
+/// by an extent, so the connections of the cells are implicit and nothing is
+/// stored for them. Unlike a uniform or rectilinear grid, the coordinates of
+/// each point are arbitrary and are held in an explicit array.
+///
+/// Because the points are not axis aligned, the cells of a structured grid
+/// are hexahedra rather than voxels. Operations such as
+/// dax::exec::CellDerivative therefore use the general hexahedron Jacobian,
+/// while worklets are still scheduled over the i, j, k indices of the cells.
+///
+template <
+    class PointsArrayContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class StructuredGrid
+{
+public:
+  typedef dax::CellTagHexahedron CellTag;
+  typedef dax::cont::internal::StructuredGridTag GridTypeTag;
+
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3, PointsArrayContainerControlTag, DeviceAdapterTag>
+      PointCoordinatesType;
+
+  DAX_CONT_EXPORT
+  StructuredGrid() {  }
+
+  DAX_CONT_EXPORT
+  StructuredGrid(const dax::Extent3 &extent,
+                 PointCoordinatesType pointCoordinates)
+    : Extent(extent), PointCoordinates(pointCoordinates)
+  {
+    DAX_ASSERT_CONT(this->PointCoordinates.GetNumberOfValues()
+                    == this->GetNumberOfPoints());
+  }
+
+  /// The extent defines the minimum and maximum indices in each dimension.
+  ///
+  DAX_CONT_EXPORT
+  const dax::Extent3 &GetExtent() const { return this->Extent; }
+  DAX_CONT_EXPORT
+  void SetExtent(const dax::Extent3 &extent) { this->Extent = extent; }
+  DAX_CONT_EXPORT
+  void SetExtent(const dax::Id3 &min, const dax::Id3 &max) {
+    this->Extent.Min = min;
+    this->Extent.Max = max;
+  }
+
+  /// The PointCoordinates array defines the location of each point. The
+  /// points are ordered with i varying fastest, then j, then k, and there
+  /// must be exactly one for each point of the extent.
+  ///
+  DAX_CONT_EXPORT
+  const PointCoordinatesType &GetPointCoordinates() const {
+    return this->PointCoordinates;
+  }
+  DAX_CONT_EXPORT
+  PointCoordinatesType &GetPointCoordinates() {
+    return this->PointCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetPointCoordinates(PointCoordinatesType pointCoordinates) {
+    this->PointCoordinates = pointCoordinates;
+  }
+
+  // Helper functions
+
+  /// Get the number of points.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    dax::Id3 dims = dax::extentDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Get the number of cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    dax::Id3 dims = dax::extentCellDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Converts an i, j, k point location to a point index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputePointIndex(const dax::Id3 &ijk) const {
+    return dax::index3ToFlatIndex(ijk, this->Extent);
+  }
+
+  /// Converts an i, j, k cell location to a cell index.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id ComputeCellIndex(const dax::Id3 &ijk) const {
+    return dax::index3ToFlatIndexCell(ijk, this->Extent);
+  }
+
+  /// Converts a flat point index to an i, j, k point location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 ComputePointLocation(dax::Id index) const {
+    return dax::flatIndexToIndex3(index, this->Extent);
+  }
+
+  /// Converts a flat cell index to an i, j, k cell location.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id3 ComputeCellLocation(dax::Id index) const {
+    return dax::flatIndexToIndex3Cell(index, this->Extent);
+  }
+
+  /// Given a point index, returns the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id index) const {
+    DAX_ASSERT_CONT(index >= 0);
+    DAX_ASSERT_CONT(index < this->PointCoordinates.GetNumberOfValues());
+    return this->PointCoordinates.GetPortalConstControl().Get(index);
+  }
+
+  /// Given a point i, j, k location, returns the coordinates.
+  ///
+  DAX_CONT_EXPORT
+  dax::Vector3 ComputePointCoordinates(dax::Id3 location) const {
+    return this->ComputePointCoordinates(this->ComputePointIndex(location));
+  }
+
+  typedef dax::exec::internal::TopologyStructured TopologyStructConstExecution;
+  typedef dax::exec::internal::TopologyStructured TopologyStructExecution;
+
+  /// Prepares this topology to be used as an input to an operation in the
+  /// execution environment.  Returns a structure that can be used directly
+  /// in the execution environment. Only the extent is needed; the point
+  /// coordinates come from GetPointCoordinates.
+  ///
+  DAX_CONT_EXPORT
+  TopologyStructConstExecution PrepareForInput() const {
+    TopologyStructConstExecution topology;
+    topology.Extent = this->Extent;
+    return topology;
+  }
+
+  typedef dax::exec::internal::TopologyStructured
+      PointCellsStructConstExecution;
+
+  /// Prepares the reverse connectivity of this topology (the cells incident
+  /// to each point) to be used as an input to an operation in the execution
+  /// environment. As with a uniform grid, nothing is stored.
+  ///
+  DAX_CONT_EXPORT
+  PointCellsStructConstExecution PreparePointCellsForInput() const {
+    return this->PrepareForInput();
+  }
+
+private:
+  dax::Extent3 Extent;
+  PointCoordinatesType PointCoordinates;
+};
+
+}
+}
+
+#endif //__dax__cont__StructuredGrid_h
@@ -21,23 +21,35 @@
 #include <dax/cont/ArrayPortal.h>
 #include <dax/cont/DeviceAdapter.h>
 #include <dax/cont/internal/GridTags.h>
-#include <dax/cont/internal/IteratorFromArrayPortal.h>
 
 #include <dax/CellTag.h>
 
+#include <dax/exec/internal/FieldAccess.h>
 #include <dax/exec/internal/TopologyUniform.h>
 
+#include <dax/internal/FastDivide.h>
+
+#include <boost/iterator/iterator_facade.hpp>
+
 namespace dax {
 namespace cont {
 
 namespace detail {
 
+class IteratorFromUniformGridPointCoordinates;
+
+/// An implicit array portal holding the point coordinates of a uniform grid.
+/// Coordinates are computed from the i, j, k location of each point. Random
+/// access splits the flat index into a location with a precomputed
+/// multiply-shift division rather than integer divides. The iterator and
+/// access through an \c IJKIndex (when scheduling over the points of the
+/// grid) advance the location incrementally and do not divide at all.
+///
 class ArrayPortalFromUniformGridPointCoordinates
 {
 public:
   typedef dax::Vector3 ValueType;
-  typedef dax::cont::internal::IteratorFromArrayPortal<
-      ArrayPortalFromUniformGridPointCoordinates> IteratorType;
+  typedef IteratorFromUniformGridPointCoordinates IteratorType;
 
   DAX_EXEC_CONT_EXPORT
   ArrayPortalFromUniformGridPointCoordinates() {  }
@@ -49,10 +61,22 @@ public:
   Origin(origin),
   Spacing(spacing),
   Extent(extent),
-  NumberOfValues(0)
+  Dimensions(dax::extentDimensions(extent)),
+  NumberOfValues(0),
+  UseFastDivide(false)
   {
-    const dax::Id3 dims = dax::extentDimensions(extent);
-    this->NumberOfValues = dims[0]*dims[1]*dims[2];
+    this->NumberOfValues =
+        this->Dimensions[0]*this->Dimensions[1]*this->Dimensions[2];
+    if ((this->NumberOfValues > 0)
+        && (static_cast<dax::internal::UInt64Type>(this->NumberOfValues)
+            <= 0x7FFFFFFFul))
+      {
+      this->XDivisor = dax::internal::FastDivisor(
+            static_cast<dax::internal::UInt32Type>(this->Dimensions[0]));
+      this->YDivisor = dax::internal::FastDivisor(
+            static_cast<dax::internal::UInt32Type>(this->Dimensions[1]));
+      this->UseFastDivide = true;
+      }
   }
 
   DAX_EXEC_CONT_EXPORT
@@ -61,7 +85,11 @@ public:
     : Origin(src.Origin),
       Spacing(src.Spacing),
       Extent(src.Extent),
-      NumberOfValues(src.NumberOfValues)
+      Dimensions(src.Dimensions),
+      NumberOfValues(src.NumberOfValues),
+      XDivisor(src.XDivisor),
+      YDivisor(src.YDivisor),
+      UseFastDivide(src.UseFastDivide)
   {  }
 
   DAX_EXEC_CONT_EXPORT
@@ -71,42 +99,215 @@ public:
     this->Origin = src.Origin;
     this->Spacing = src.Spacing;
     this->Extent = src.Extent;
+    this->Dimensions = src.Dimensions;
     this->NumberOfValues = src.NumberOfValues;
+    this->XDivisor = src.XDivisor;
+    this->YDivisor = src.YDivisor;
+    this->UseFastDivide = src.UseFastDivide;
     return *this;
   }
 
   DAX_EXEC_CONT_EXPORT
   dax::Id GetNumberOfValues() const { return this->NumberOfValues; }
 
+  DAX_EXEC_CONT_EXPORT
+  const dax::Extent3 &GetExtent() const { return this->Extent; }
+
   DAX_EXEC_CONT_EXPORT
   ValueType Get(dax::Id index) const {
-    dax::Id3 location = dax::flatIndexToIndex3(index, this->Extent);
+    return this->GetFromLocation(this->ComputeLocation(index));
+  }
+
+  /// Returns the coordinates of the point at the given i, j, k location,
+  /// which (like the extent) includes the minimum of the extent.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  ValueType GetFromLocation(const dax::Id3 &location) const {
     return dax::make_Vector3(
                       this->Origin[0] + this->Spacing[0]*location[0],
                       this->Origin[1] + this->Spacing[1]*location[1],
                       this->Origin[2] + this->Spacing[2]*location[2]);
+  }
 
+  /// Returns the coordinates of the point at the given i, j, k location
+  /// relative to the minimum of the extent. Used through \c FieldGet when the
+  /// points are scheduled with an \c IJKIndex.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  ValueType GetFromIJK(const dax::Id3 &ijk) const {
+    return this->GetFromLocation(ijk + this->Extent.Min);
   }
 
-  DAX_CONT_EXPORT
-  IteratorType GetIteratorBegin() const {
-    return IteratorType(*this);
+  DAX_EXEC_CONT_EXPORT
+  const dax::Id3 &GetIJKDimensions() const { return this->Dimensions; }
+
+  /// Converts a flat index to an i, j, k location. Same as \c
+  /// dax::flatIndexToIndex3, but without integer division for all but
+  /// enormous grids.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::Id3 ComputeLocation(dax::Id index) const {
+    if (!this->UseFastDivide)
+      {
+      return dax::flatIndexToIndex3(index, this->Extent);
+      }
+    dax::internal::UInt32Type i, j;
+    const dax::internal::UInt32Type jk = this->XDivisor.Divide(
+          static_cast<dax::internal::UInt32Type>(index), i);
+    const dax::internal::UInt32Type k = this->YDivisor.Divide(jk, j);
+    return dax::make_Id3(static_cast<dax::Id>(i) + this->Extent.Min[0],
+                         static_cast<dax::Id>(j) + this->Extent.Min[1],
+                         static_cast<dax::Id>(k) + this->Extent.Min[2]);
   }
 
   DAX_CONT_EXPORT
-  IteratorType GetIteratorEnd() const {
-    return IteratorType(*this, this->GetNumberOfValues());
-  }
+  IteratorType GetIteratorBegin() const;
+
+  DAX_CONT_EXPORT
+  IteratorType GetIteratorEnd() const;
 
 private:
   dax::Vector3 Origin;
   dax::Vector3 Spacing;
   dax::Extent3 Extent;
+  dax::Id3 Dimensions;
   dax::Id NumberOfValues;
+  dax::internal::FastDivisor XDivisor;
+  dax::internal::FastDivisor YDivisor;
+  bool UseFastDivide;
 };
 
+/// Iterates over the point coordinates of a uniform grid. Stepping the
+/// iterator updates the i, j, k location of the point with additions and
+/// comparisons only, so sequential copies of the coordinates never divide.
+///
+class IteratorFromUniformGridPointCoordinates : public
+    boost::iterator_facade<
+      IteratorFromUniformGridPointCoordinates,
+      dax::Vector3,
+      boost::random_access_traversal_tag,
+      dax::Vector3,
+      dax::Id>
+{
+public:
+  IteratorFromUniformGridPointCoordinates()
+    : Portal(), Index(0), Location(0, 0, 0) {  }
+
+  explicit IteratorFromUniformGridPointCoordinates(
+      const ArrayPortalFromUniformGridPointCoordinates &portal,
+      dax::Id index = 0)
+    : Portal(portal), Index(index), Location(portal.ComputeLocation(index)) {  }
+
+  DAX_CONT_EXPORT
+  dax::Vector3 operator[](dax::Id delta) const
+  {
+    return this->Portal.Get(this->Index + delta);
+  }
+
+private:
+  ArrayPortalFromUniformGridPointCoordinates Portal;
+  dax::Id Index;
+  dax::Id3 Location;
+
+  // Implementation for boost iterator_facade
+  friend class boost::iterator_core_access;
+
+  DAX_CONT_EXPORT
+  dax::Vector3 dereference() const {
+    return this->Portal.GetFromLocation(this->Location);
+  }
+
+  DAX_CONT_EXPORT
+  bool equal(const IteratorFromUniformGridPointCoordinates &other) const {
+    return (this->Index == other.Index);
+  }
+
+  DAX_CONT_EXPORT
+  void increment() {
+    this->Index++;
+    DAX_ASSERT_CONT(this->Index <= this->Portal.GetNumberOfValues());
+    const dax::Extent3 &extent = this->Portal.GetExtent();
+    this->Location[0]++;
+    if (this->Location[0] > extent.Max[0])
+      {
+      this->Location[0] = extent.Min[0];
+      this->Location[1]++;
+      if (this->Location[1] > extent.Max[1])
+        {
+        this->Location[1] = extent.Min[1];
+        this->Location[2]++;
+        }
+      }
+  }
+
+  DAX_CONT_EXPORT
+  void decrement() {
+    this->Index--;
+    DAX_ASSERT_CONT(this->Index >= 0);
+    const dax::Extent3 &extent = this->Portal.GetExtent();
+    this->Location[0]--;
+    if (this->Location[0] < extent.Min[0])
+      {
+      this->Location[0] = extent.Max[0];
+      this->Location[1]--;
+      if (this->Location[1] < extent.Min[1])
+        {
+        this->Location[1] = extent.Max[1];
+        this->Location[2]--;
+        }
+      }
+  }
+
+  DAX_CONT_EXPORT
+  void advance(dax::Id delta) {
+    this->Index += delta;
+    DAX_ASSERT_CONT(this->Index >= 0);
+    DAX_ASSERT_CONT(this->Index <= this->Portal.GetNumberOfValues());
+    this->Location = this->Portal.ComputeLocation(this->Index);
+  }
+
+  DAX_CONT_EXPORT
+  dax::Id
+  distance_to(const IteratorFromUniformGridPointCoordinates &other) const {
+    return other.Index - this->Index;
+  }
+};
+
+DAX_CONT_EXPORT
+ArrayPortalFromUniformGridPointCoordinates::IteratorType
+ArrayPortalFromUniformGridPointCoordinates::GetIteratorBegin() const {
+  return IteratorType(*this);
+}
+
+DAX_CONT_EXPORT
+ArrayPortalFromUniformGridPointCoordinates::IteratorType
+ArrayPortalFromUniformGridPointCoordinates::GetIteratorEnd() const {
+  return IteratorType(*this, this->GetNumberOfValues());
+}
+
 } // namespace detail
 
+}
+} // namespace dax::cont
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+template<>
+struct ArrayPortalIJKTraits<
+    dax::cont::detail::ArrayPortalFromUniformGridPointCoordinates>
+{
+  typedef boost::true_type HasIJKAccess;
+};
+
+}
+}
+} // namespace dax::exec::internal
+
+namespace dax {
+namespace cont {
+
 /// This class defines the topology of a uniform grid. A uniform grid is axis
 /// aligned and has uniform spacing between grid points in every dimension. The
 /// grid can be shifted and scaled in space by defining and origin and spacing.
@@ -245,6 +446,18 @@ public:
     return topology;
   }
 
+  typedef dax::exec::internal::TopologyUniform PointCellsStructConstExecution;
+
+  /// Prepares the reverse connectivity of this topology (the cells incident
+  /// to each point) to be used as an input to an operation in the execution
+  /// environment. Nothing is stored for a uniform grid; the topology finds
+  /// the incident cells from the structure of the grid.
+  ///
+  DAX_CONT_EXPORT
+  PointCellsStructConstExecution PreparePointCellsForInput() const {
+    return this->PrepareForInput();
+  }
+
 private:
   dax::Vector3 Origin;
   dax::Vector3 Spacing;
@@ -20,8 +20,14 @@
 #include <dax/CellTraits.h>
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandleImplicit.h>
+#include <dax/cont/DeviceAdapter.h>
 #include <dax/cont/internal/GridTags.h>
 #include <dax/exec/internal/TopologyUnstructured.h>
+#include <dax/exec/internal/kernel/VisitIndexWorklets.h>
+
+#include <boost/shared_ptr.hpp>
 
 namespace dax {
 namespace cont {
@@ -46,14 +52,19 @@ public:
   typedef dax::cont::ArrayHandle<
       dax::Vector3, PointsArrayContainerControlTag, DeviceAdapterTag>
       PointCoordinatesType;
+  typedef dax::cont::ArrayHandle<
+      dax::Id, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
+      PointCellsArrayType;
 
   DAX_CONT_EXPORT
-  UnstructuredGrid() { }
+  UnstructuredGrid() : PointCells(new PointCellsCache) { }
 
   DAX_CONT_EXPORT
   UnstructuredGrid(CellConnectionsType cellConnections,
                    PointCoordinatesType pointCoordinates)
-    : CellConnections(cellConnections), PointCoordinates(pointCoordinates)
+    : CellConnections(cellConnections),
+      PointCoordinates(pointCoordinates),
+      PointCells(new PointCellsCache)
   {
     DAX_ASSERT_CONT((this->CellConnections.GetNumberOfValues()
                      % dax::CellTraits<CellTag>::NUM_VERTICES) == 0);
@@ -64,6 +75,10 @@ public:
   /// of cell. Each cell is represented by this number of points defining the
   /// structure of the cell.
   ///
+  /// The connections must not be changed in place through the array
+  /// returned here once the reverse connectivity has been used, as it would
+  /// not be rebuilt. Change them with SetCellConnections or PrepareForOutput.
+  ///
   DAX_CONT_EXPORT
   const CellConnectionsType &GetCellConnections() const {
     return this->CellConnections;
@@ -73,12 +88,15 @@ public:
     return this->CellConnections;
   }
   void SetCellConnections(CellConnectionsType cellConnections) {
+    this->ReleasePointCells();
     this->CellConnections = cellConnections;
   }
 
 
   /// The PointCoordinates array defines the location of each point.  The
-  /// length of this array defines how many points are in the mesh.
+  /// length of this array defines how many points are in the mesh. Moving
+  /// the points in place is fine, but changing how many there are should go
+  /// through SetPointCoordinates or PrepareForOutput.
   ///
   DAX_CONT_EXPORT
   const PointCoordinatesType &GetPointCoordinates() const {
@@ -90,9 +108,28 @@ public:
   }
   DAX_CONT_EXPORT
   void SetPointCoordinates(PointCoordinatesType pointCoordinates) {
+    this->ReleasePointCells();
     this->PointCoordinates = pointCoordinates;
   }
 
+  /// The reverse connectivity of the mesh gives the cells incident to each
+  /// point. GetPointCellIds lists the cells of point 0, then the cells of
+  /// point 1, and so on. GetPointCellOffsets has one more value than there are
+  /// points and gives where the list of each point starts. Both arrays are
+  /// built the first time they are needed and kept until the connections or
+  /// the points change.
+  ///
+  DAX_CONT_EXPORT
+  const PointCellsArrayType &GetPointCellOffsets() const {
+    this->BuildPointCells();
+    return this->PointCells->Offsets;
+  }
+  DAX_CONT_EXPORT
+  const PointCellsArrayType &GetPointCellIds() const {
+    this->BuildPointCells();
+    return this->PointCells->CellIds;
+  }
+
   // Helper functions
 
   /// Given a point idnex, computes the coordinates.
@@ -144,6 +181,7 @@ public:
   ///
   DAX_CONT_EXPORT
   TopologyStructExecution PrepareForOutput(dax::Id numberOfCells) {
+    this->InvalidatePointCells();
     // Set the number of points to 0 since we really don't know better. Now
     // that I consider it, I wonder what the point of having the number of
     // points field in the first place. The number of cells fields seems pretty
@@ -155,9 +193,77 @@ public:
           numberOfCells);
   }
 
+  typedef dax::exec::internal::TopologyUnstructuredPointCells<
+      CellTag, typename PointCellsArrayType::PortalConstExecution>
+      PointCellsStructConstExecution;
+
+  /// Prepares the reverse connectivity of this topology to be used as an
+  /// input to an operation in the execution environment.
+  ///
+  DAX_CONT_EXPORT
+  PointCellsStructConstExecution PreparePointCellsForInput() const {
+    this->BuildPointCells();
+    return PointCellsStructConstExecution(
+          this->PointCells->Offsets.PrepareForInput(),
+          this->PointCells->CellIds.PrepareForInput(),
+          this->GetNumberOfPoints());
+  }
+
 private:
+  struct PointCellsCache
+  {
+    PointCellsCache() : Valid(false) {  }
+    bool Valid;
+    PointCellsArrayType Offsets;
+    PointCellsArrayType CellIds;
+  };
+
+  // Copies of a grid share the reverse connectivity until one of them
+  // changes its topology.
+  DAX_CONT_EXPORT
+  void ReleasePointCells() {
+    this->PointCells.reset(new PointCellsCache);
+  }
+
+  // The arrays of a grid are shared by its copies, so writing them in place
+  // has to invalidate the reverse connectivity of all the copies.
+  DAX_CONT_EXPORT
+  void InvalidatePointCells() {
+    this->PointCells->Valid = false;
+  }
+
+  DAX_CONT_EXPORT
+  void BuildPointCells() const {
+    if (this->PointCells->Valid) { return; }
+
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef dax::exec::internal::kernel::ConstantScatterInputIndex CellOfIndex;
+    const dax::Id numConnections = this->CellConnections.GetNumberOfValues();
+
+    // Pair every connection with the cell it belongs to, then group the
+    // pairs by point.
+    PointCellsArrayType pointIds;
+    Algorithm::Copy(this->CellConnections, pointIds);
+    Algorithm::Copy(
+          dax::cont::ArrayHandleImplicit<dax::Id,CellOfIndex,DeviceAdapterTag>(
+            CellOfIndex(dax::CellTraits<CellTag>::NUM_VERTICES),
+            numConnections),
+          this->PointCells->CellIds);
+    Algorithm::SortByKey(pointIds, this->PointCells->CellIds);
+
+    // The list of a point starts at the first connection to it (or to a
+    // point after it).
+    Algorithm::LowerBounds(
+          pointIds,
+          dax::cont::ArrayHandleCounting<dax::Id,DeviceAdapterTag>(
+            0, this->GetNumberOfPoints()+1),
+          this->PointCells->Offsets);
+    this->PointCells->Valid = true;
+  }
+
   CellConnectionsType CellConnections;
   PointCoordinatesType PointCoordinates;
+  boost::shared_ptr<PointCellsCache> PointCells;
 };
 
 }
@@ -0,0 +1,362 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_UnstructuredGridMixed_h
+#define __dax_cont_UnstructuredGridMixed_h
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/UnstructuredGrid.h>
+#include <dax/cont/internal/GridTags.h>
+#include <dax/exec/internal/kernel/MixedCellWorklets.h>
+
+#include <boost/shared_ptr.hpp>
+
+namespace dax {
+namespace cont {
+
+namespace internal {
+
+/// The cell types a dax::cont::UnstructuredGridMixed can hold, each with the
+/// slot its cells are kept in once the grid sorts them by type.
+///
+template<class CellTag> struct UnstructuredGridMixedSlot;
+template<> struct UnstructuredGridMixedSlot<dax::CellTagVertex>
+  { static const int value = 0; };
+template<> struct UnstructuredGridMixedSlot<dax::CellTagLine>
+  { static const int value = 1; };
+template<> struct UnstructuredGridMixedSlot<dax::CellTagTriangle>
+  { static const int value = 2; };
+template<> struct UnstructuredGridMixedSlot<dax::CellTagQuadrilateral>
+  { static const int value = 3; };
+template<> struct UnstructuredGridMixedSlot<dax::CellTagTetrahedron>
+  { static const int value = 4; };
+template<> struct UnstructuredGridMixedSlot<dax::CellTagWedge>
+  { static const int value = 5; };
+template<> struct UnstructuredGridMixedSlot<dax::CellTagHexahedron>
+  { static const int value = 6; };
+
+const int UNSTRUCTURED_GRID_MIXED_NUM_SLOTS = 7;
+
+} // namespace internal
+
+/// This class defines the topology of an unstructured grid whose cells can
+/// be of different types. Three arrays describe the cells. CellShapes holds
+/// the dax::CellTraits::SHAPE_ID of each cell. CellOffsets holds where the
+/// vertices of each cell start in CellConnections. CellConnections holds the
+/// point indices of the vertices of all the cells.
+///
+/// Worklets are compiled for one cell type at a time, so the grid groups its
+/// cells by type. This sort is done once, the first time it is needed, and
+/// kept until the cells change. Each group can then be used as a
+/// dax::cont::UnstructuredGrid of a single cell type (see GetCellsOfShape),
+/// and dax::cont::DispatcherMapCell runs a worklet on each group in turn.
+/// Cell fields given to the worklet are gathered to and scattered from the
+/// order of the group, but the WorkId a worklet sees is the index of the cell
+/// within its group, not within this grid.
+///
+template <
+    class CellConnectionsContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class PointsArrayContainerControlTag = DAX_DEFAULT_ARRAY_CONTAINER_CONTROL_TAG,
+    class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class UnstructuredGridMixed
+{
+public:
+  typedef dax::cont::internal::UnstructuredGridMixedTag GridTypeTag;
+
+  typedef dax::cont::ArrayHandle<
+      dax::Id, CellConnectionsContainerControlTag, DeviceAdapterTag>
+      CellShapesType;
+  typedef dax::cont::ArrayHandle<
+      dax::Id, CellConnectionsContainerControlTag, DeviceAdapterTag>
+      CellOffsetsType;
+  typedef dax::cont::ArrayHandle<
+      dax::Id, CellConnectionsContainerControlTag, DeviceAdapterTag>
+      CellConnectionsType;
+  typedef dax::cont::ArrayHandle<
+      dax::Vector3, PointsArrayContainerControlTag, DeviceAdapterTag>
+      PointCoordinatesType;
+  typedef dax::cont::ArrayHandle<
+      dax::Id, dax::cont::ArrayContainerControlTagBasic, DeviceAdapterTag>
+      CellIdsType;
+
+  /// The type of grid holding the cells of one type.
+  ///
+  template<class CellTag>
+  struct CellsOfShape
+  {
+    typedef dax::cont::UnstructuredGrid<
+        CellTag,
+        dax::cont::ArrayContainerControlTagBasic,
+        PointsArrayContainerControlTag,
+        DeviceAdapterTag> type;
+  };
+
+  DAX_CONT_EXPORT
+  UnstructuredGridMixed() : Shapes(new ShapesCache) { }
+
+  DAX_CONT_EXPORT
+  UnstructuredGridMixed(CellShapesType cellShapes,
+                        CellOffsetsType cellOffsets,
+                        CellConnectionsType cellConnections,
+                        PointCoordinatesType pointCoordinates)
+    : CellShapes(cellShapes),
+      CellOffsets(cellOffsets),
+      CellConnections(cellConnections),
+      PointCoordinates(pointCoordinates),
+      Shapes(new ShapesCache)
+  {
+    DAX_ASSERT_CONT(this->CellShapes.GetNumberOfValues()
+                    == this->CellOffsets.GetNumberOfValues());
+  }
+
+  /// The CellShapes array has the dax::CellTraits::SHAPE_ID of each cell.
+  ///
+  DAX_CONT_EXPORT
+  const CellShapesType &GetCellShapes() const { return this->CellShapes; }
+  DAX_CONT_EXPORT
+  void SetCellShapes(CellShapesType cellShapes) {
+    this->ReleaseShapes();
+    this->CellShapes = cellShapes;
+  }
+
+  /// The CellOffsets array has, for each cell, the index in CellConnections
+  /// of its first vertex.
+  ///
+  DAX_CONT_EXPORT
+  const CellOffsetsType &GetCellOffsets() const { return this->CellOffsets; }
+  DAX_CONT_EXPORT
+  void SetCellOffsets(CellOffsetsType cellOffsets) {
+    this->ReleaseShapes();
+    this->CellOffsets = cellOffsets;
+  }
+
+  /// The CellConnections array has the point indices of the vertices of each
+  /// cell, in the order given by CellOffsets.
+  ///
+  DAX_CONT_EXPORT
+  const CellConnectionsType &GetCellConnections() const {
+    return this->CellConnections;
+  }
+  DAX_CONT_EXPORT
+  void SetCellConnections(CellConnectionsType cellConnections) {
+    this->ReleaseShapes();
+    this->CellConnections = cellConnections;
+  }
+
+  /// The PointCoordinates array defines the location of each point.  The
+  /// length of this array defines how many points are in the mesh.
+  ///
+  DAX_CONT_EXPORT
+  const PointCoordinatesType &GetPointCoordinates() const {
+    return this->PointCoordinates;
+  }
+  DAX_CONT_EXPORT
+  void SetPointCoordinates(PointCoordinatesType pointCoordinates) {
+    this->PointCoordinates = pointCoordinates;
+  }
+
+  /// Get the number of points.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfPoints() const {
+    return this->PointCoordinates.GetNumberOfValues();
+  }
+
+  /// Get the number of cells.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const {
+    return this->CellShapes.GetNumberOfValues();
+  }
+
+  /// Get the number of cells of the given type.
+  ///
+  template<class CellTag>
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCellsOfShape(CellTag) const {
+    return this->GetCellIdsOfShape(CellTag()).GetNumberOfValues();
+  }
+
+  /// Returns the indices of the cells of the given type, in increasing
+  /// order. The i'th cell of GetCellsOfShape is the cell with index
+  /// GetCellIdsOfShape()[i] in this grid.
+  ///
+  template<class CellTag>
+  DAX_CONT_EXPORT
+  const CellIdsType &GetCellIdsOfShape(CellTag) const {
+    this->BuildShapes();
+    return this->Shapes->CellIds[
+        dax::cont::internal::UnstructuredGridMixedSlot<CellTag>::value];
+  }
+
+  /// Returns the cells of the given type as a grid of a single cell type.
+  /// The grid shares the points of this grid.
+  ///
+  template<class CellTag>
+  DAX_CONT_EXPORT
+  typename CellsOfShape<CellTag>::type GetCellsOfShape(CellTag) const {
+    this->BuildShapes();
+    return typename CellsOfShape<CellTag>::type(
+          this->Shapes->Connections[
+            dax::cont::internal::UnstructuredGridMixedSlot<CellTag>::value],
+          this->PointCoordinates);
+  }
+
+  /// Calls \c functor with a tag of each type of cell this grid can hold.
+  ///
+  template<class Functor>
+  DAX_CONT_EXPORT
+  static void ForEachCellShape(Functor &functor) {
+    functor(dax::CellTagVertex());
+    functor(dax::CellTagLine());
+    functor(dax::CellTagTriangle());
+    functor(dax::CellTagQuadrilateral());
+    functor(dax::CellTagTetrahedron());
+    functor(dax::CellTagWedge());
+    functor(dax::CellTagHexahedron());
+  }
+
+private:
+  struct ShapesCache
+  {
+    ShapesCache() : Valid(false) {  }
+    bool Valid;
+    CellIdsType CellIds[dax::cont::internal::UNSTRUCTURED_GRID_MIXED_NUM_SLOTS];
+    CellIdsType Connections[
+        dax::cont::internal::UNSTRUCTURED_GRID_MIXED_NUM_SLOTS];
+  };
+
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+  // Copies of a grid share the groups of cells until one of them changes
+  // its cells.
+  DAX_CONT_EXPORT
+  void ReleaseShapes() {
+    this->Shapes.reset(new ShapesCache);
+  }
+
+  // Functor for ForEachCellShape that fills in the group of one cell type
+  // from the cells sorted by type.
+  struct BuildShapeFunctor
+  {
+    const UnstructuredGridMixed *Grid;
+    const CellIdsType *SortedShapes;
+    const CellIdsType *SortedCellIds;
+    dax::Id NumberOfCellsFound;
+
+    template<class CellTag>
+    DAX_CONT_EXPORT void operator()(CellTag)
+    {
+      const int slot =
+          dax::cont::internal::UnstructuredGridMixedSlot<CellTag>::value;
+      const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+      const dax::Id shapeId = dax::CellTraits<CellTag>::SHAPE_ID;
+
+      // The cells of this type are a contiguous range of the sorted cells.
+      CellIdsType shapeIdArray = dax::cont::make_ArrayHandle(
+            &shapeId, 1, dax::cont::ArrayContainerControlTagBasic(),
+            DeviceAdapterTag());
+      CellIdsType bound;
+      Algorithm::LowerBounds(*this->SortedShapes, shapeIdArray, bound);
+      const dax::Id first = bound.GetPortalConstControl().Get(0);
+      Algorithm::UpperBounds(*this->SortedShapes, shapeIdArray, bound);
+      const dax::Id numCells = bound.GetPortalConstControl().Get(0) - first;
+      this->NumberOfCellsFound += numCells;
+
+      ShapesCache &cache = *this->Grid->Shapes;
+      cache.CellIds[slot] = CellIdsType();
+      cache.Connections[slot] = CellIdsType();
+      if (numCells < 1)
+        {
+        // Still allocate the (empty) arrays so they can be read like any
+        // other group.
+        cache.CellIds[slot].PrepareForOutput(0);
+        cache.Connections[slot].PrepareForOutput(0);
+        return;
+        }
+
+      Algorithm::Copy(
+            dax::cont::make_ArrayHandlePermutation(
+              dax::cont::ArrayHandleCounting<dax::Id,DeviceAdapterTag>(
+                first, numCells),
+              *this->SortedCellIds),
+            cache.CellIds[slot]);
+      // Keep the cells of the group in their original order so that they
+      // are read from memory in order.
+      Algorithm::Sort(cache.CellIds[slot]);
+
+      typedef dax::exec::internal::kernel::GatherCellConnectionsFunctor<
+          NUM_VERTICES,
+          typename CellIdsType::PortalConstExecution,
+          typename CellOffsetsType::PortalConstExecution,
+          typename CellConnectionsType::PortalConstExecution,
+          typename CellIdsType::PortalExecution> GatherType;
+      Algorithm::Schedule(
+            GatherType(cache.CellIds[slot].PrepareForInput(),
+                       this->Grid->CellOffsets.PrepareForInput(),
+                       this->Grid->CellConnections.PrepareForInput(),
+                       cache.Connections[slot].PrepareForOutput(
+                         numCells*NUM_VERTICES)),
+            numCells);
+    }
+  };
+
+  DAX_CONT_EXPORT
+  void BuildShapes() const {
+    if (this->Shapes->Valid) { return; }
+
+    // Sort the cells by type once.
+    CellIdsType sortedShapes;
+    CellIdsType sortedCellIds;
+    Algorithm::Copy(this->CellShapes, sortedShapes);
+    Algorithm::Copy(dax::cont::ArrayHandleCounting<dax::Id,DeviceAdapterTag>(
+                      0, this->GetNumberOfCells()),
+                    sortedCellIds);
+    Algorithm::SortByKey(sortedShapes, sortedCellIds);
+
+    BuildShapeFunctor functor;
+    functor.Grid = this;
+    functor.SortedShapes = &sortedShapes;
+    functor.SortedCellIds = &sortedCellIds;
+    functor.NumberOfCellsFound = 0;
+    ForEachCellShape(functor);
+
+    if (functor.NumberOfCellsFound != this->GetNumberOfCells())
+      {
+      throw dax::cont::ErrorControlBadValue(
+            "Mixed unstructured grid has cells of an unsupported type.");
+      }
+    this->Shapes->Valid = true;
+  }
+
+  CellShapesType CellShapes;
+  CellOffsetsType CellOffsets;
+  CellConnectionsType CellConnections;
+  PointCoordinatesType PointCoordinates;
+  boost::shared_ptr<ShapesCache> Shapes;
+};
+
+}
+}
+
+#endif //__dax_cont_UnstructuredGridMixed_h
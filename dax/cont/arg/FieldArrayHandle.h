@@ -48,11 +48,15 @@ public:
   typedef dax::cont::sig::AnyDomain DomainTag;
   typedef dax::exec::arg::FieldPortal<T,Tags,PortalType> ExecArg;
 
+  typedef HandleType ContArg;
+
   ConceptMap(HandleType handle):
     Handle(handle),
     Portal()
     {}
 
+  DAX_CONT_EXPORT const ContArg& GetContArg() const { return this->Handle; }
+
   DAX_CONT_EXPORT ExecArg GetExecArg() const
     {
     return ExecArg(this->Portal);
@@ -100,11 +104,15 @@ public:
   typedef dax::cont::sig::AnyDomain DomainTag;
   typedef dax::exec::arg::FieldPortal<T,Tags,PortalType> ExecArg;
 
+  typedef HandleType ContArg;
+
   ConceptMap(HandleType handle):
     Handle(handle),
     Portal()
     {}
 
+  DAX_CONT_EXPORT const ContArg& GetContArg() const { return this->Handle; }
+
   DAX_CONT_EXPORT ExecArg GetExecArg()
     {
     return ExecArg(this->Portal);
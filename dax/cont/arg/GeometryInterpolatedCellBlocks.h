@@ -0,0 +1,89 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_arg_GeometryInterpolatedCellBlocks_h
+#define __dax_cont_arg_GeometryInterpolatedCellBlocks_h
+
+#include <dax/Types.h>
+#include <dax/internal/Tags.h>
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Geometry.h>
+#include <dax/cont/internal/GridTags.h>
+#include <dax/cont/internal/InterpolatedCellBlocks.h>
+#include <dax/cont/sig/Tag.h>
+
+#include <dax/exec/arg/GeometryInterpolatedCellSet.h>
+
+namespace dax { namespace cont { namespace arg {
+
+/// \headerfile GeometryInterpolatedCellBlocks.h dax/cont/arg/GeometryInterpolatedCellBlocks.h
+/// \brief Map blocks of interpolation records to an execution side geometry
+/// parameter that receives the sets of interpolated cells of a worklet.
+template <typename Tags, typename CellTag, int MaxCells, typename DeviceTag>
+class ConceptMap<Geometry(Tags),
+                 dax::cont::internal::InterpolatedCellBlocks<
+                   CellTag,MaxCells,DeviceTag> >
+{
+  typedef dax::cont::internal::InterpolatedCellBlocks<
+      CellTag,MaxCells,DeviceTag> BlocksType;
+  typedef typename BlocksType::RecordsType::PortalExecution PortalType;
+  typedef typename BlocksType::BlockCountsType::PortalExecution
+      CountPortalType;
+  typedef dax::exec::arg::GeometryInterpolatedCellSet<
+      Tags,CellTag,MaxCells,PortalType,CountPortalType> ExecCellSetType;
+  BlocksType Blocks;
+  PortalType Portal;
+  CountPortalType CountPortal;
+
+public:
+  //All Topology binding classes must export the cell tag and grid tag
+  //This allows us to do better scheduling based on cell / grid types
+  typedef CellTag CellTypeTag;
+  typedef dax::cont::internal::UnspecifiedGridTag GridTypeTag;
+
+  typedef BlocksType ContArg;
+  typedef ExecCellSetType ExecArg;
+  typedef dax::cont::sig::Cell DomainTag;
+
+  DAX_CONT_EXPORT ConceptMap(BlocksType b): Blocks(b) {}
+
+  DAX_CONT_EXPORT ExecArg GetExecArg() const
+    {
+    return ExecCellSetType(this->Portal,
+                           this->CountPortal,
+                           this->Blocks.GetBlockSize());
+    }
+
+  DAX_CONT_EXPORT const ContArg& GetContArg() const { return this->Blocks; }
+
+  //every block gets room for all the cells its input cells can generate
+  DAX_CONT_EXPORT void ToExecution(dax::Id)
+    { /* Output */
+    const dax::Id numBlocks = this->Blocks.GetNumberOfBlocks();
+    this->Portal = this->Blocks.GetRecords().PrepareForOutput(
+                     numBlocks * this->Blocks.GetBlockCapacity());
+    this->CountPortal =
+        this->Blocks.GetBlockCounts().PrepareForOutput(numBlocks);
+    }
+
+  DAX_CONT_EXPORT dax::Id GetDomainLength(sig::Cell) const
+    {
+    return this->Blocks.GetNumberOfInputCells();
+    }
+};
+
+}}} // namespace dax::cont::arg
+
+#endif //__dax_cont_arg_GeometryInterpolatedCellBlocks_h
@@ -0,0 +1,80 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_arg_GeometryInterpolatedCellRecords_h
+#define __dax_cont_arg_GeometryInterpolatedCellRecords_h
+
+#include <dax/Types.h>
+#include <dax/internal/Tags.h>
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Geometry.h>
+#include <dax/cont/internal/GridTags.h>
+#include <dax/cont/internal/InterpolatedCellRecords.h>
+#include <dax/cont/sig/Tag.h>
+
+#include <dax/exec/arg/GeometryInterpolatedCell.h>
+
+namespace dax { namespace cont { namespace arg {
+
+/// \headerfile GeometryInterpolatedCellRecords.h dax/cont/arg/GeometryInterpolatedCellRecords.h
+/// \brief Map interpolation records to an execution side geometry parameter
+/// that receives the interpolated cells of a worklet.
+template <typename Tags, typename CellTag, typename DeviceTag>
+class ConceptMap<Geometry(Tags),
+                 dax::cont::internal::InterpolatedCellRecords<CellTag,DeviceTag> >
+{
+  typedef dax::cont::internal::InterpolatedCellRecords<CellTag,DeviceTag>
+      RecordsType;
+  typedef typename RecordsType::RecordsType::PortalExecution PortalType;
+  typedef dax::exec::arg::GeometryInterpolatedCell<Tags,CellTag,PortalType>
+      ExecRecordsType;
+  RecordsType Records;
+  PortalType Portal;
+
+public:
+  //All Topology binding classes must export the cell tag and grid tag
+  //This allows us to do better scheduling based on cell / grid types
+  typedef CellTag CellTypeTag;
+  typedef dax::cont::internal::UnspecifiedGridTag GridTypeTag;
+
+  typedef RecordsType ContArg;
+  typedef ExecRecordsType ExecArg;
+  typedef dax::cont::sig::Cell DomainTag;
+
+  DAX_CONT_EXPORT ConceptMap(RecordsType r): Records(r) {}
+
+  DAX_CONT_EXPORT ExecArg GetExecArg() const
+    {
+    return ExecRecordsType(this->Portal);
+    }
+
+  DAX_CONT_EXPORT const ContArg& GetContArg() const { return this->Records; }
+
+  //we need to pass the number of elements to allocate
+  DAX_CONT_EXPORT void ToExecution(dax::Id size)
+    { /* Output */
+    this->Portal = this->Records.GetRecords().PrepareForOutput(
+                     size * RecordsType::NUM_VERTICES);
+    }
+
+  DAX_CONT_EXPORT dax::Id GetDomainLength(sig::Cell) const
+    {
+    return this->Records.GetNumberOfCells();
+    }
+};
+
+}}} // namespace dax::cont::arg
+
+#endif //__dax_cont_arg_GeometryInterpolatedCellRecords_h
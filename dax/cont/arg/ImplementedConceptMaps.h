@@ -28,8 +28,13 @@
 #include <dax/cont/arg/FieldArrayHandleTransform.h>
 #include <dax/cont/arg/FieldConstant.h>
 #include <dax/cont/arg/FieldMap.h>
+#include <dax/cont/arg/GeometryImplicitTopologyGrid.h>
+#include <dax/cont/arg/GeometryInterpolatedCellBlocks.h>
+#include <dax/cont/arg/GeometryInterpolatedCellRecords.h>
 #include <dax/cont/arg/GeometryUniformGrid.h>
 #include <dax/cont/arg/GeometryUnstructuredGrid.h>
+#include <dax/cont/arg/TopologyImplicitTopologyGrid.h>
+#include <dax/cont/arg/TopologyPointCells.h>
 #include <dax/cont/arg/TopologyUniformGrid.h>
 #include <dax/cont/arg/TopologyUnstructuredGrid.h>
 
@@ -0,0 +1,81 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_arg_TopologyPointCells_h
+#define __dax_cont_arg_TopologyPointCells_h
+
+#include <dax/Types.h>
+#include <dax/internal/Tags.h>
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Topology.h>
+#include <dax/cont/internal/GridPointCells.h>
+#include <dax/cont/sig/Tag.h>
+
+#include <dax/exec/arg/TopologyPointCells.h>
+
+namespace dax { namespace cont { namespace arg {
+
+/// \headerfile TopologyPointCells.h dax/cont/arg/TopologyPointCells.h
+/// \brief Map a grid visited by point to an execution side topology parameter
+/// giving the cells incident to each point.
+template <typename Tags, typename GridType>
+class ConceptMap<Topology(Tags),
+                 dax::cont::internal::GridPointCells<GridType> >
+{
+  typedef dax::cont::internal::GridPointCells<GridType> PointCellsType;
+  typedef typename GridType::PointCellsStructConstExecution TopologyType;
+  typedef dax::exec::arg::TopologyPointCells<Tags,TopologyType> ExecGridType;
+  PointCellsType PointCells;
+  TopologyType Topology;
+
+public:
+  //All Topology binding classes must export the cell tag and grid tag
+  //This allows us to do better scheduling based on cell / grid types
+  typedef typename GridType::CellTag CellTypeTag;
+  typedef typename GridType::GridTypeTag GridTypeTag;
+
+  typedef GridType ContArg;
+  typedef ExecGridType ExecArg;
+  typedef dax::cont::sig::Point DomainTag;
+
+  DAX_CONT_EXPORT ConceptMap(PointCellsType p): PointCells(p) {}
+
+  DAX_CONT_EXPORT ExecArg GetExecArg() const { return ExecGridType(Topology); }
+
+  //All topology fields are required by dispatchers to expose the cont arg
+  DAX_CONT_EXPORT const ContArg& GetContArg() const
+    {
+    return this->PointCells.GetGrid();
+    }
+
+  DAX_CONT_EXPORT void ToExecution(dax::Id)
+    { /* Input  */
+    this->Topology = this->PointCells.GetGrid().PreparePointCellsForInput();
+    }
+
+  DAX_CONT_EXPORT dax::Id GetDomainLength(sig::Point) const
+    {
+    return this->PointCells.GetGrid().GetNumberOfPoints();
+    }
+
+  DAX_CONT_EXPORT dax::Id GetDomainLength(sig::Cell) const
+    {
+    return this->PointCells.GetGrid().GetNumberOfCells();
+    }
+};
+
+}}} // namespace dax::cont::arg
+
+#endif //__dax_cont_arg_TopologyPointCells_h
@@ -31,7 +31,12 @@
 #include <dax/internal/WorkletSignatureFunctions.h>
 
 
-namespace dax { namespace cont { namespace dispatcher {
+namespace dax { namespace cont {
+
+template<class DeviceAdapterTag> class ScatterPlan;
+template<class DeviceAdapterTag> class ScatterPlanConstant;
+
+namespace dispatcher {
 
 namespace internal
 {
@@ -60,6 +65,23 @@ struct MakeVisitIndexControlType
 
     dispatcher.Invoke( visitIndices, visitIndices ); //as input and output
   }
+
+  template<class DeviceAdapterTag>
+  void operator()(const dax::cont::ScatterPlan<DeviceAdapterTag>& plan,
+                  Type& visitIndices) const
+  {
+    //the plan computes the visit indices along with the output to input
+    //map, so there is nothing left to search for
+    visitIndices = plan.GetVisitIndex();
+  }
+
+  template<class DeviceAdapterTag>
+  void operator()(const dax::cont::ScatterPlanConstant<DeviceAdapterTag>& plan,
+                  Type& visitIndices) const
+  {
+    //the visit indices are implicit
+    visitIndices = plan.GetVisitIndex();
+  }
 };
 
 template<class Algorithm, typename HandleType>
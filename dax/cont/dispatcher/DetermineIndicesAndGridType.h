@@ -17,12 +17,22 @@
 #define __dax_cont_dispatcher_DetermineIndicesAndGridType_h
 
 #include <dax/Extent.h>
+#include <dax/cont/RectilinearGrid.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/arg/FieldArrayHandle.h>
 #include <dax/cont/arg/Topology.h>
 #include <dax/cont/internal/Bindings.h>
 #include <dax/cont/internal/FindBinding.h>
 #include <dax/cont/internal/GridTags.h>
+#include <dax/cont/sig/Tag.h>
 
 #include <dax/exec/WorkletMapCell.h>
+#include <dax/exec/WorkletMapField.h>
+#include <dax/exec/WorkletMapPointNeighborhood.h>
+
+#include <boost/mpl/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
 
 namespace dax { namespace cont { namespace dispatcher {
 
@@ -40,6 +50,18 @@ namespace internal
     typedef dax::Id3 type;
   };
 
+  template<>
+  struct DetermineGridIndexType< dax::cont::internal::RectilinearGridTag >
+  {
+    typedef dax::Id3 type;
+  };
+
+  template<>
+  struct DetermineGridIndexType< dax::cont::internal::StructuredGridTag >
+  {
+    typedef dax::Id3 type;
+  };
+
   template< class GridTypeTag>
   struct GenerateGridCount
   {
@@ -62,15 +84,118 @@ namespace internal
       }
   };
 
+  template<>
+  struct GenerateGridCount< dax::cont::internal::RectilinearGridTag >
+  {
+    typedef dax::cont::internal::RectilinearGridTag GridTypeTag;
+    typedef DetermineGridIndexType<GridTypeTag>::type ReturnType;
+
+    template<class Topo>
+    ReturnType operator()(const Topo& t) const
+      {
+      return dax::extentCellDimensions(t.GetExtent());
+      }
+  };
+
+  template<>
+  struct GenerateGridCount< dax::cont::internal::StructuredGridTag >
+  {
+    typedef dax::cont::internal::StructuredGridTag GridTypeTag;
+    typedef DetermineGridIndexType<GridTypeTag>::type ReturnType;
+
+    template<class Topo>
+    ReturnType operator()(const Topo& t) const
+      {
+      return dax::extentCellDimensions(t.GetExtent());
+      }
+  };
+
   template<typename ReturnType, int N, typename BindingsType>
   const ReturnType& get_topology(const BindingsType& bindings)
   {
     return bindings.template Get<N>().GetContArg();
   }
+
+  // Visits the bindings of a worklet looking for the implicit point
+  // coordinates of a uniform or rectilinear grid. If found, the extent of the
+  // grid's points is recorded.
+  class FindUniformPointExtent
+  {
+    typedef dax::cont::ArrayContainerControlTagImplicit<
+        dax::cont::detail::ArrayPortalFromUniformGridPointCoordinates>
+        UniformPointCoordinatesTag;
+
+    dax::Extent3 &Extent;
+    bool &Found;
+
+  public:
+    FindUniformPointExtent(dax::Extent3 &extent, bool &found)
+      : Extent(extent), Found(found) {  }
+
+    template <typename C, typename A>
+    void operator()(const dax::cont::arg::ConceptMap<C,A>&) const {  }
+
+    template <typename Tags, typename Device>
+    void operator()(const dax::cont::arg::ConceptMap<
+                      dax::cont::arg::Field(Tags),
+                      dax::cont::ArrayHandle<dax::Vector3,
+                                             UniformPointCoordinatesTag,
+                                             Device> > &concept) const
+    {
+      this->Record(concept.GetContArg());
+    }
+
+    template <typename Tags, typename Device>
+    void operator()(const dax::cont::arg::ConceptMap<
+                      dax::cont::arg::Field(Tags),
+                      const dax::cont::ArrayHandle<dax::Vector3,
+                                                   UniformPointCoordinatesTag,
+                                                   Device> > &concept) const
+    {
+      this->Record(concept.GetContArg());
+    }
+
+    template <typename Tags, typename AxisHandle, typename Device>
+    void operator()(const dax::cont::arg::ConceptMap<
+                      dax::cont::arg::Field(Tags),
+                      dax::cont::ArrayHandle<dax::Vector3,
+                        dax::cont::internal::
+                          ArrayContainerControlTagRectilinearCoordinates<
+                            AxisHandle>,
+                        Device> > &concept) const
+    {
+      this->Record(concept.GetContArg());
+    }
+
+    template <typename Tags, typename AxisHandle, typename Device>
+    void operator()(const dax::cont::arg::ConceptMap<
+                      dax::cont::arg::Field(Tags),
+                      const dax::cont::ArrayHandle<dax::Vector3,
+                        dax::cont::internal::
+                          ArrayContainerControlTagRectilinearCoordinates<
+                            AxisHandle>,
+                        Device> > &concept) const
+    {
+      this->Record(concept.GetContArg());
+    }
+
+  private:
+    template<typename HandleType>
+    void Record(const HandleType &handle) const
+    {
+      if (!this->Found)
+        {
+        this->Extent = handle.GetPortalConstControl().GetExtent();
+        this->Found = true;
+        }
+    }
+  };
 }
 
 //the default is that the worklet isn't a candidate for grid scheduling
-template<typename WorkletBaseType, typename Invocation>
+template<typename WorkletBaseType,
+         typename Invocation,
+         typename DomainType = typename Invocation::Worklet::DomainType>
 class DetermineIndicesAndGridType
 {
   typedef typename dax::cont::internal::Bindings<Invocation>::type BindingsType;
@@ -94,10 +219,13 @@ public:
 };
 
 
-//worklet map cell is a candidate for grid scheduling.
+//worklet map cell is a candidate for grid scheduling. A map cell worklet
+//invoked on a permutation of the cells has a permuted cell domain instead
+//and uses the default.
 template<typename Invocation>
 class DetermineIndicesAndGridType<dax::exec::WorkletMapCell,
-                                  Invocation>
+                                  Invocation,
+                                  dax::cont::sig::Cell>
 {
   // Determine the topology type by finding the topo binding. First
   // we look up the index of the binding, the second step is to actually
@@ -146,5 +274,99 @@ public:
 
 };
 
+//worklet map field is a candidate for grid scheduling when it iterates over
+//the points of a uniform or rectilinear grid. This is detected when one of
+//the arguments is the point coordinates of such a grid or when the
+//dispatcher is given the extent of the points.
+template<typename Invocation>
+class DetermineIndicesAndGridType<dax::exec::WorkletMapField,
+                                  Invocation>
+{
+  typedef typename dax::cont::internal::Bindings<Invocation>::type BindingsType;
+
+  dax::Extent3 PointExtent;
+  bool HasPointExtent;
+  const dax::Id NumInstances;
+
+public:
+  DetermineIndicesAndGridType(BindingsType& bindings,
+                              dax::Id numInstances ):
+    HasPointExtent(false),
+    NumInstances(numInstances)
+    {
+    bindings.ForEachCont(
+          internal::FindUniformPointExtent(this->PointExtent,
+                                           this->HasPointExtent));
+    }
+
+  //use the given extent of points instead of looking at the arguments
+  void SetPointExtent(const dax::Extent3& extent)
+    {
+    this->PointExtent = extent;
+    this->HasPointExtent = true;
+    }
+
+  //return the proper exec object that can be used to dispatch
+  dax::Id3 gridCount() const
+  {
+    return dax::extentDimensions(this->PointExtent);
+  }
+
+  bool isValidForGridScheduling() const
+    {
+    //only schedule over the points if every point is visited exactly once,
+    //otherwise the field arrays are not laid out like the grid
+    if (!this->HasPointExtent) { return false; }
+    const dax::Id3 dims = this->gridCount();
+    return this->NumInstances == dims[0]*dims[1]*dims[2];
+    }
+};
+
+//worklet map point neighborhood must be scheduled over the points of the
+//uniform grid it is given, since its neighborhoods are found from the i, j, k
+//index of each point.
+template<typename Invocation>
+class DetermineIndicesAndGridType<dax::exec::WorkletMapPointNeighborhood,
+                                  Invocation>
+{
+  typedef typename dax::cont::internal::FindBinding<
+                                  Invocation,
+                                  dax::cont::arg::Topology>::type TopoIndex;
+  typedef typename dax::cont::internal::Bindings<Invocation>::type BindingsType;
+  typedef typename BindingsType::template GetType<
+                                  TopoIndex::value>::type TopoControlBinding;
+  typedef typename TopoControlBinding::ContArg TopoContArgType;
+  typedef typename TopoControlBinding::GridTypeTag GridTypeTag;
+
+  //if you get a compile error here, the worklet was given a grid that is not
+  //uniform. Point neighborhoods are only defined on uniform grids.
+  BOOST_MPL_ASSERT((boost::is_same<GridTypeTag,
+                                   dax::cont::internal::UniformGridTag>));
+
+  const TopoContArgType& Topology;
+  const dax::Id NumInstances;
+
+public:
+  DetermineIndicesAndGridType(const BindingsType& bindings,
+                              dax::Id numInstances):
+    Topology( internal::get_topology<TopoContArgType, TopoIndex::value >(bindings) ),
+    NumInstances(numInstances)
+    {
+    }
+
+  //return the proper exec object that can be used to dispatch
+  dax::Id3 gridCount() const
+  {
+    return dax::extentDimensions(this->Topology.GetExtent());
+  }
+
+  bool isValidForGridScheduling() const
+    {
+    //the fields have to hold a value for every point of the grid, otherwise
+    //they are not laid out like the grid
+    return this->NumInstances == this->Topology.GetNumberOfPoints();
+    }
+};
+
 } } } //namespace dax::cont::dispatcher
 #endif
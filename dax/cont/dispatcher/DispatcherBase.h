@@ -131,21 +131,54 @@ protected:
                       WorkletBaseType, Invocation>  CellSchedulingIndices;
 
   CellSchedulingIndices cellScheduler(bindings,count);
+  static_cast<const DerivedDispatcher*>(this)->ConfigureScheduling(
+                                                                cellScheduler);
   if(cellScheduler.isValidForGridScheduling())
     {
     // Schedule the worklet invocations in the execution environment
     // using the specialized id3 scheduler
-    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::
-            Schedule(bindingFunctor,cellScheduler.gridCount());
+    static_cast<const DerivedDispatcher*>(this)->ScheduleGrid(
+                                  bindingFunctor,cellScheduler.gridCount());
     }
   else
     {
     // Schedule the worklet invocations in the execution environment.
-    dax::cont::DeviceAdapterAlgorithm< DeviceAdapterTag >::
-            Schedule(bindingFunctor,count);
+    static_cast<const DerivedDispatcher*>(this)->ScheduleIndices(
+                                  bindingFunctor,count);
     }
   }
 
+  /// Gives the derived dispatcher a chance to adjust how the worklet is
+  /// scheduled before it is. A derived dispatcher can hide this method to do
+  /// so. By default nothing is changed.
+  template<typename SchedulingIndicesType>
+  DAX_CONT_EXPORT
+  void ConfigureScheduling(SchedulingIndicesType &) const {  }
+
+  /// Schedules the worklet invocations over the grid of indices found when
+  /// the worklet is a candidate for grid scheduling. A derived dispatcher can
+  /// hide this method to change how the grid is traversed. By default the
+  /// device adapter schedules over the whole grid.
+  template<typename FunctorType, typename GridCountType>
+  DAX_CONT_EXPORT
+  void ScheduleGrid(FunctorType &functor, const GridCountType &gridCount) const
+  {
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::
+            Schedule(functor,gridCount);
+  }
+
+  /// Schedules the worklet invocations over \c count indices when the
+  /// worklet is not grid scheduled. A derived dispatcher can hide this method
+  /// to change how the indices are traversed. By default the device adapter
+  /// schedules each index.
+  template<typename FunctorType>
+  DAX_CONT_EXPORT
+  void ScheduleIndices(FunctorType &functor, dax::Id count) const
+  {
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::
+            Schedule(functor,count);
+  }
+
 private:
   WorkletType Worklet;
 };
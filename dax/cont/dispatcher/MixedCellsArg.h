@@ -0,0 +1,276 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_dispatcher_MixedCellsArg_h
+#define __dax_cont_dispatcher_MixedCellsArg_h
+
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandlePermutation.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/UnstructuredGridMixed.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/internal/Bindings.h>
+#include <dax/cont/sig/Tag.h>
+#include <dax/exec/internal/kernel/MixedCellWorklets.h>
+#include <dax/internal/GetNthType.h>
+#include <dax/internal/ParameterPack.h>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_const.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+namespace dax { namespace cont { namespace dispatcher {
+
+namespace internal
+{
+  template<typename T>
+  struct IsUnstructuredGridMixed : boost::false_type {  };
+  template<class C, class P, class D>
+  struct IsUnstructuredGridMixed<dax::cont::UnstructuredGridMixed<C,P,D> >
+    : boost::true_type {  };
+
+  // True for dax::cont::ArrayHandle and the classes derived from it.
+  template<typename T>
+  struct IsArrayHandle
+  {
+  private:
+    typedef char YesType;
+    struct NoType { char dummy[2]; };
+    template<typename V, class C, class D>
+    static YesType Test(const dax::cont::ArrayHandle<V,C,D> *);
+    static NoType Test(...);
+  public:
+    static const bool value =
+        (sizeof(Test(static_cast<T*>(0))) == sizeof(YesType));
+    typedef boost::mpl::bool_<value> type;
+  };
+
+  template<typename ParameterPackType, int Index>
+  struct ParameterPackArgType
+  {
+    typedef typename boost::remove_const<typename boost::remove_reference<
+        typename ParameterPackType::template Parameter<Index>::type
+        >::type>::type type;
+  };
+
+  // Finds the first argument that is a mixed unstructured grid, or 0.
+  template<typename ParameterPackType,
+           int Index = ParameterPackType::NUM_PARAMETERS>
+  struct FindUnstructuredGridMixed
+  {
+  private:
+    typedef FindUnstructuredGridMixed<ParameterPackType,Index-1> Previous;
+    typedef typename ParameterPackArgType<ParameterPackType,Index>::type
+        ArgType;
+  public:
+    static const int value = (Previous::value > 0) ? Previous::value
+        : (IsUnstructuredGridMixed<ArgType>::value ? Index : 0);
+    typedef boost::mpl::bool_<(value > 0)> type;
+  };
+  template<typename ParameterPackType>
+  struct FindUnstructuredGridMixed<ParameterPackType, 0>
+  {
+    static const int value = 0;
+    typedef boost::mpl::false_ type;
+  };
+
+  struct MixedCellsArgOther {  };
+  struct MixedCellsArgGrid {  };
+  struct MixedCellsArgCellIn {  };
+  struct MixedCellsArgCellOut {  };
+
+  // Decides how argument Index of a worklet is handled, from its type and
+  // its tags in the ControlSignature. Arrays bound to Field parameters that
+  // are not point fields hold a value per cell.
+  template<class WorkletType, int Index, typename ArgType>
+  struct MixedCellsArgKind
+  {
+  private:
+    typedef typename dax::internal::GetNthType<
+        Index, typename WorkletType::ControlSignature>::type ParameterType;
+    typedef dax::cont::internal::detail::GetConceptAndTagsImpl<ParameterType>
+        ConceptAndTags;
+    typedef typename ConceptAndTags::Concept Concept;
+    typedef typename ConceptAndTags::Tags Tags;
+
+    typedef boost::mpl::bool_<
+        boost::is_same<Concept,dax::cont::arg::Field>::value &&
+        IsArrayHandle<ArgType>::value &&
+        !Tags::template Has<dax::cont::sig::Point>::value> IsCellField;
+    typedef typename boost::mpl::if_<
+        typename Tags::template Has<dax::cont::sig::Out>::type,
+        MixedCellsArgCellOut,
+        MixedCellsArgCellIn>::type CellFieldKind;
+  public:
+    typedef typename boost::mpl::if_<
+        IsUnstructuredGridMixed<ArgType>,
+        MixedCellsArgGrid,
+        typename boost::mpl::if_<
+          IsCellField, CellFieldKind, MixedCellsArgOther>::type>::type type;
+  };
+}
+
+/// The cells of one type of a mixed unstructured grid, which a worklet is
+/// being run on.
+///
+template<class GridType, class CellTag>
+struct MixedCellsGroup
+{
+  typedef typename GridType::CellIdsType CellIdsType;
+  typedef typename GridType::template CellsOfShape<CellTag>::type
+      CellsGridType;
+
+  DAX_CONT_EXPORT
+  MixedCellsGroup(const GridType &grid, bool isFirst)
+    : Grid(grid),
+      CellIds(grid.GetCellIdsOfShape(CellTag())),
+      IsFirst(isFirst) {  }
+
+  const GridType &Grid;
+  CellIdsType CellIds;
+  bool IsFirst;
+};
+
+/// Converts one argument of a worklet invoked on a mixed unstructured grid
+/// into the argument for one group of cells. The grid becomes the grid of
+/// the group. Input cell fields are permuted to the cells of the group.
+/// Output cell fields are computed in a temporary array that Finish then
+/// scatters back to the cells of the group. Everything else is unchanged.
+///
+template<class WorkletType,
+         int Index,
+         typename ArgType,
+         class GroupType,
+         class Kind = typename internal::MixedCellsArgKind<
+           WorkletType,Index,ArgType>::type>
+class MixedCellsArg
+{
+public:
+  typedef ArgType GroupArgType;
+
+  DAX_CONT_EXPORT
+  MixedCellsArg(const ArgType &arg, const GroupType &) : Arg(arg) {  }
+
+  DAX_CONT_EXPORT
+  const GroupArgType &GetGroupArgument() const { return this->Arg; }
+
+  DAX_CONT_EXPORT void Finish(const GroupType &) {  }
+
+private:
+  ArgType Arg;
+};
+
+template<class WorkletType, int Index, typename ArgType, class GroupType>
+class MixedCellsArg<WorkletType,Index,ArgType,GroupType,
+                    internal::MixedCellsArgGrid>
+{
+public:
+  typedef typename GroupType::CellsGridType GroupArgType;
+
+  DAX_CONT_EXPORT
+  MixedCellsArg(const ArgType &arg, const GroupType &group)
+    : GroupGrid(arg.GetCellsOfShape(typename GroupArgType::CellTag()))
+  {
+    (void)group;
+  }
+
+  DAX_CONT_EXPORT
+  const GroupArgType &GetGroupArgument() const { return this->GroupGrid; }
+
+  DAX_CONT_EXPORT void Finish(const GroupType &) {  }
+
+private:
+  GroupArgType GroupGrid;
+};
+
+template<class WorkletType, int Index, typename ArgType, class GroupType>
+class MixedCellsArg<WorkletType,Index,ArgType,GroupType,
+                    internal::MixedCellsArgCellIn>
+{
+  typedef dax::cont::ArrayHandle<typename ArgType::ValueType,
+                                 typename ArgType::ArrayContainerControlTag,
+                                 typename ArgType::DeviceAdapterTag>
+      HandleType;
+public:
+  typedef dax::cont::ArrayHandlePermutation<
+      typename GroupType::CellIdsType,
+      HandleType,
+      typename ArgType::DeviceAdapterTag> GroupArgType;
+
+  DAX_CONT_EXPORT
+  MixedCellsArg(const ArgType &arg, const GroupType &group)
+    : GroupField(group.CellIds, arg) {  }
+
+  DAX_CONT_EXPORT
+  const GroupArgType &GetGroupArgument() const { return this->GroupField; }
+
+  DAX_CONT_EXPORT void Finish(const GroupType &) {  }
+
+private:
+  GroupArgType GroupField;
+};
+
+template<class WorkletType, int Index, typename ArgType, class GroupType>
+class MixedCellsArg<WorkletType,Index,ArgType,GroupType,
+                    internal::MixedCellsArgCellOut>
+{
+  typedef typename ArgType::DeviceAdapterTag DeviceAdapterTag;
+  typedef dax::cont::ArrayHandle<typename ArgType::ValueType,
+                                 typename ArgType::ArrayContainerControlTag,
+                                 DeviceAdapterTag> HandleType;
+public:
+  typedef dax::cont::ArrayHandle<typename ArgType::ValueType,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> GroupArgType;
+
+  DAX_CONT_EXPORT
+  MixedCellsArg(const ArgType &arg, const GroupType &group) : Field(arg)
+  {
+    if (group.IsFirst)
+      {
+      this->Field.PrepareForOutput(group.Grid.GetNumberOfCells());
+      }
+  }
+
+  DAX_CONT_EXPORT
+  const GroupArgType &GetGroupArgument() const { return this->GroupField; }
+
+  DAX_CONT_EXPORT void Finish(const GroupType &group)
+  {
+    typedef dax::exec::internal::kernel::ScatterCellFieldFunctor<
+        typename GroupType::CellIdsType::PortalConstExecution,
+        typename GroupArgType::PortalConstExecution,
+        typename HandleType::PortalExecution> ScatterType;
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Schedule(
+          ScatterType(group.CellIds.PrepareForInput(),
+                      this->GroupField.PrepareForInput(),
+                      this->Field.PrepareForInPlace()),
+          group.CellIds.GetNumberOfValues());
+  }
+
+private:
+  HandleType Field;
+  GroupArgType GroupField;
+};
+
+}}} // namespace dax::cont::dispatcher
+
+#endif //__dax_cont_dispatcher_MixedCellsArg_h
@@ -0,0 +1,232 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/DeviceAdapter.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/RectilinearGrid.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/arg/FieldArrayHandle.h>
+#include <dax/cont/dispatcher/DetermineIndicesAndGridType.h>
+#include <dax/cont/internal/Bindings.h>
+#include <dax/cont/sig/Tag.h>
+#include <dax/cont/testing/Testing.h>
+#include <dax/exec/WorkletMapField.h>
+#include <dax/Types.h>
+
+#include <vector>
+
+namespace{
+
+struct CopyCoordinates : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn,FieldOut,FieldOut);
+  typedef void ExecutionSignature(_1,_2,_3,WorkId);
+
+  DAX_EXEC_EXPORT
+  void operator()(const dax::Vector3 &inCoordinates,
+                  dax::Vector3 &outCoordinates,
+                  dax::Id &outIndex,
+                  dax::Id workId) const
+  {
+    outCoordinates = inCoordinates;
+    outIndex = workId;
+  }
+};
+
+struct CopyId : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn,FieldOut);
+  typedef void ExecutionSignature(_1,_2);
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id in, dax::Id &out) const { out = in; }
+};
+
+dax::cont::UniformGrid<> MakeGrid()
+{
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(-1, 2, 0), dax::make_Id3(3, 4, 6));
+  grid.SetOrigin(dax::make_Vector3(1.0, 0.0, -2.0));
+  grid.SetSpacing(dax::make_Vector3(0.5, 1.0, 0.25));
+  return grid;
+}
+
+void TestDetermineGridScheduling()
+{
+  dax::cont::UniformGrid<> grid = MakeGrid();
+  dax::cont::ArrayHandle<dax::Vector3> outCoords;
+  dax::cont::ArrayHandle<dax::Id> outIds;
+
+  std::cout << "Checking point coordinates enable grid scheduling."
+            << std::endl;
+  {
+  typedef dax::internal::Invocation<
+      CopyCoordinates,
+      dax::internal::ParameterPack<
+        dax::cont::UniformGrid<>::PointCoordinatesType,
+        dax::cont::ArrayHandle<dax::Vector3>,
+        dax::cont::ArrayHandle<dax::Id> > > Invocation;
+  typedef dax::cont::internal::Bindings<Invocation>::type BindingsType;
+  BindingsType bindings = dax::cont::internal::BindingsCreate(
+        CopyCoordinates(),
+        dax::internal::make_ParameterPack(grid.GetPointCoordinates(),
+                                          outCoords,
+                                          outIds));
+
+  dax::cont::dispatcher::DetermineIndicesAndGridType<
+      dax::exec::WorkletMapField, Invocation>
+      scheduler(bindings, grid.GetNumberOfPoints());
+  DAX_TEST_ASSERT(scheduler.isValidForGridScheduling(),
+                  "Point coordinates should be scheduled over the grid.");
+  DAX_TEST_ASSERT(scheduler.gridCount() ==
+                  dax::extentDimensions(grid.GetExtent()),
+                  "Scheduled over wrong dimensions.");
+
+  dax::cont::dispatcher::DetermineIndicesAndGridType<
+      dax::exec::WorkletMapField, Invocation>
+      permutedScheduler(bindings, grid.GetNumberOfPoints()-1);
+  DAX_TEST_ASSERT(!permutedScheduler.isValidForGridScheduling(),
+                  "Cannot schedule over grid with a different count.");
+  }
+
+  std::cout << "Checking rectilinear point coordinates do too." << std::endl;
+  {
+  const dax::Scalar xCoordinates[] = { 0.0f, 0.5f, 2.0f };
+  const dax::Scalar yCoordinates[] = { -1.0f, 0.0f, 0.25f, 3.0f };
+  const dax::Scalar zCoordinates[] = { 1.0f, 4.0f };
+  dax::cont::RectilinearGrid<> rectilinearGrid(
+        dax::cont::make_ArrayHandle(xCoordinates, 3),
+        dax::cont::make_ArrayHandle(yCoordinates, 4),
+        dax::cont::make_ArrayHandle(zCoordinates, 2));
+
+  typedef dax::internal::Invocation<
+      CopyCoordinates,
+      dax::internal::ParameterPack<
+        dax::cont::RectilinearGrid<>::PointCoordinatesType,
+        dax::cont::ArrayHandle<dax::Vector3>,
+        dax::cont::ArrayHandle<dax::Id> > > Invocation;
+  typedef dax::cont::internal::Bindings<Invocation>::type BindingsType;
+  BindingsType bindings = dax::cont::internal::BindingsCreate(
+        CopyCoordinates(),
+        dax::internal::make_ParameterPack(
+          rectilinearGrid.GetPointCoordinates(), outCoords, outIds));
+
+  dax::cont::dispatcher::DetermineIndicesAndGridType<
+      dax::exec::WorkletMapField, Invocation>
+      scheduler(bindings, rectilinearGrid.GetNumberOfPoints());
+  DAX_TEST_ASSERT(scheduler.isValidForGridScheduling(),
+                  "Point coordinates should be scheduled over the grid.");
+  DAX_TEST_ASSERT(scheduler.gridCount() == dax::make_Id3(3, 4, 2),
+                  "Scheduled over wrong dimensions.");
+  }
+
+  std::cout << "Checking basic arrays do not." << std::endl;
+  std::vector<dax::Id> ids(grid.GetNumberOfPoints());
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    ids[index] = index;
+    }
+  dax::cont::ArrayHandle<dax::Id> idHandle = dax::cont::make_ArrayHandle(ids);
+  {
+  typedef dax::internal::Invocation<
+      CopyId,
+      dax::internal::ParameterPack<
+        dax::cont::ArrayHandle<dax::Id>,
+        dax::cont::ArrayHandle<dax::Id> > > Invocation;
+  typedef dax::cont::internal::Bindings<Invocation>::type BindingsType;
+  BindingsType bindings = dax::cont::internal::BindingsCreate(
+        CopyId(), dax::internal::make_ParameterPack(idHandle, outIds));
+
+  dax::cont::dispatcher::DetermineIndicesAndGridType<
+      dax::exec::WorkletMapField, Invocation>
+      scheduler(bindings, grid.GetNumberOfPoints());
+  DAX_TEST_ASSERT(!scheduler.isValidForGridScheduling(),
+                  "Basic arrays should be scheduled flat.");
+
+  scheduler.SetPointExtent(grid.GetExtent());
+  DAX_TEST_ASSERT(scheduler.isValidForGridScheduling(),
+                  "Given extent should be scheduled over the grid.");
+  }
+}
+
+void TestDispatchOverPoints()
+{
+  dax::cont::UniformGrid<> grid = MakeGrid();
+  const dax::Id numPoints = grid.GetNumberOfPoints();
+
+  std::cout << "Dispatching over point coordinates." << std::endl;
+  dax::cont::ArrayHandle<dax::Vector3> outCoords;
+  dax::cont::ArrayHandle<dax::Id> outIds;
+  dax::cont::DispatcherMapField<CopyCoordinates>().Invoke(
+        grid.GetPointCoordinates(), outCoords, outIds);
+  DAX_TEST_ASSERT(outCoords.GetNumberOfValues() == numPoints,
+                  "Wrong number of coordinates.");
+  for (dax::Id index = 0; index < numPoints; index++)
+    {
+    DAX_TEST_ASSERT(outCoords.GetPortalConstControl().Get(index) ==
+                    grid.ComputePointCoordinates(index),
+                    "Wrong coordinates.");
+    DAX_TEST_ASSERT(outIds.GetPortalConstControl().Get(index) == index,
+                    "Wrong work id.");
+    }
+
+  std::cout << "Dispatching over given point extent." << std::endl;
+  std::vector<dax::Id> ids(numPoints);
+  for (dax::Id index = 0; index < numPoints; index++)
+    {
+    ids[index] = 3*index;
+    }
+  dax::cont::ArrayHandle<dax::Id> outCopy;
+  dax::cont::DispatcherMapField<CopyId> dispatcher;
+  dispatcher.SetPointExtent(grid.GetExtent());
+  dispatcher.Invoke(dax::cont::make_ArrayHandle(ids), outCopy);
+  DAX_TEST_ASSERT(outCopy.GetNumberOfValues() == numPoints,
+                  "Wrong number of values.");
+  for (dax::Id index = 0; index < numPoints; index++)
+    {
+    DAX_TEST_ASSERT(outCopy.GetPortalConstControl().Get(index) == 3*index,
+                    "Wrong copied value.");
+    }
+
+  std::cout << "Dispatching with extent that does not match." << std::endl;
+  ids.resize(numPoints/2);
+  dispatcher.Invoke(dax::cont::make_ArrayHandle(ids), outCopy);
+  DAX_TEST_ASSERT(outCopy.GetNumberOfValues() == numPoints/2,
+                  "Wrong number of values.");
+  for (dax::Id index = 0; index < numPoints/2; index++)
+    {
+    DAX_TEST_ASSERT(outCopy.GetPortalConstControl().Get(index) == 3*index,
+                    "Wrong copied value.");
+    }
+}
+
+void DetermineIndicesAndGridType()
+{
+  TestDetermineGridScheduling();
+  TestDispatchOverPoints();
+}
+
+} // anonymous namespace
+
+int UnitTestDetermineIndicesAndGridType(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(DetermineIndicesAndGridType);
+}
@@ -22,8 +22,9 @@
 #include <dax/cont/internal/DeviceAdapterAlgorithmGeneral.h>
 #include <dax/cont/internal/DeviceAdapterTagSerial.h>
 
-#include <dax/exec/internal/IJKIndex.h>
 #include <dax/exec/internal/ErrorMessageBuffer.h>
+#include <dax/exec/internal/FunctorRange.h>
+#include <dax/exec/internal/IJKIndex.h>
 
 #include <boost/iterator/counting_iterator.hpp>
 #include <boost/utility/enable_if.hpp>
@@ -98,26 +99,6 @@ public:
     return fullSum;
   }
 
-private:
-  // This runs in the execution environment.
-  template<class FunctorType>
-  class ScheduleKernel
-  {
-  public:
-    ScheduleKernel(const FunctorType &functor)
-      : Functor(functor) {  }
-
-    //needed for when calling from schedule on a range
-    DAX_EXEC_EXPORT void operator()(dax::Id index) const
-    {
-      this->Functor(index);
-    }
-
-  private:
-    const FunctorType Functor;
-  };
-
-public:
   template<class Functor>
   DAX_CONT_EXPORT static void Schedule(Functor functor,
                                        dax::Id numInstances)
@@ -130,12 +111,8 @@ public:
 
     functor.SetErrorMessageBuffer(errorMessage);
 
-    DeviceAdapterAlgorithm::ScheduleKernel<Functor> kernel(functor);
-
-    std::for_each(
-          ::boost::counting_iterator<dax::Id>(0),
-          ::boost::counting_iterator<dax::Id>(numInstances),
-          kernel);
+    dax::exec::internal::FunctorRange<Functor>::Invoke(
+          functor, 0, numInstances);
 
     if (errorMessage.IsErrorRaised())
       {
@@ -162,11 +139,8 @@ public:
       for( dax::Id j=0; j!=rangeMax[1]; ++j)
         {
         index.SetJ(j);
-        for (dax::Id i=0; i < rangeMax[0]; ++i)
-          {
-          index.SetI(i);
-          functor(index);
-          }
+        dax::exec::internal::IJKIndexRow<FunctorType>::Invoke(
+              functor, index, 0, rangeMax[0]);
         }
       }
     if (errorMessage.IsErrorRaised())
@@ -0,0 +1,53 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_GridPointCells_h
+#define __dax_cont_internal_GridPointCells_h
+
+#include <dax/Types.h>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// Wraps a grid so that it is visited by point, with each point seeing the
+/// cells incident to it. Dispatchers of worklets that map cells to points
+/// substitute this for the grid given as topology. The grid must provide
+/// \c PointCellsStructConstExecution and \c PreparePointCellsForInput.
+///
+template<class GridType>
+class GridPointCells
+{
+public:
+  typedef GridType ContGridType;
+
+  DAX_CONT_EXPORT
+  GridPointCells() {  }
+
+  DAX_CONT_EXPORT
+  GridPointCells(const GridType &grid) : Grid(grid) {  }
+
+  DAX_CONT_EXPORT
+  const GridType &GetGrid() const { return this->Grid; }
+
+private:
+  GridType Grid;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_GridPointCells_h
@@ -16,6 +16,8 @@
 #ifndef __dax__cont__GridTags_h
 #define __dax__cont__GridTags_h
 
+#include <boost/type_traits/integral_constant.hpp>
+
 namespace dax {
 namespace cont {
 namespace internal
@@ -31,16 +33,41 @@ struct UnstructuredGridTag {  };
 template<class _CellTag>
 struct UnstructuredGridOfCell : UnstructuredGridTag { };
 
+/// A subtag of UnstructuredGridTag for unstructured grids that hold cells of
+/// more than one type.
+///
+struct UnstructuredGridMixedTag : UnstructuredGridTag { };
+
 
 /// A tag you can use to identify when a grid is a uniform grid.
 ///
 struct UniformGridTag {  };
 
+/// A tag you can use to identify when a grid is a rectilinear grid.
+///
+struct RectilinearGridTag {  };
+
+/// A tag you can use to identify when a grid is a structured (curvilinear)
+/// grid.
+///
+struct StructuredGridTag {  };
+
 
 /// A tag you can use to state you don't have a grid.
 /// Mainly used by algorithms and dispatchers to state they work on all grid
 /// types
 struct UnspecifiedGridTag { };
+
+/// Identifies the grids other than the uniform grid whose cell topology is
+/// implicit in their extent, so that they can share concept maps. Its value
+/// is true for the tags of such grids.
+///
+template<class GridTypeTag>
+struct GridTagHasImplicitTopology : boost::false_type {  };
+template<>
+struct GridTagHasImplicitTopology<RectilinearGridTag> : boost::true_type {  };
+template<>
+struct GridTagHasImplicitTopology<StructuredGridTag> : boost::true_type {  };
 }
 }
 }
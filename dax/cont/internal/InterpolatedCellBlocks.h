@@ -0,0 +1,100 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_InterpolatedCellBlocks_h
+#define __dax_cont_internal_InterpolatedCellBlocks_h
+
+#include <dax/Types.h>
+#include <dax/CellTraits.h>
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/exec/InterpolatedCellPoints.h>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// Holds the interpolation records written by a worklet generating sets of
+/// interpolated cells. The input cells are split in blocks of \c BlockSize
+/// consecutive cells, and each block has room for \c MaxCells output cells
+/// per input cell, \c NUM_VERTICES consecutive records per output cell. The
+/// cells of a block are generated in order and appended to the front of its
+/// room, and the number of output cells of each block is kept in the block
+/// counts. Dispatchers of such worklets substitute this for the output grid
+/// given as geometry and compact the blocks afterwards.
+///
+template<class CellTag, int MaxCells, class DeviceAdapterTag>
+class InterpolatedCellBlocks
+{
+public:
+  typedef CellTag CellTagType;
+  const static int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+  const static int MAX_CELLS = MaxCells;
+  typedef dax::cont::ArrayHandle<dax::exec::InterpolationRecord,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> RecordsType;
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> BlockCountsType;
+
+  DAX_CONT_EXPORT
+  InterpolatedCellBlocks() : NumberOfInputCells(0), BlockSize(1) {  }
+
+  DAX_CONT_EXPORT
+  InterpolatedCellBlocks(dax::Id numInputCells, dax::Id blockSize)
+    : NumberOfInputCells(numInputCells), BlockSize(blockSize) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfInputCells() const { return this->NumberOfInputCells; }
+
+  DAX_CONT_EXPORT
+  dax::Id GetBlockSize() const { return this->BlockSize; }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfBlocks() const
+  {
+    return (this->NumberOfInputCells + this->BlockSize - 1) / this->BlockSize;
+  }
+
+  /// The number of records of the room of each block.
+  ///
+  DAX_CONT_EXPORT
+  dax::Id GetBlockCapacity() const
+  {
+    return this->BlockSize * MaxCells * NUM_VERTICES;
+  }
+
+  DAX_CONT_EXPORT
+  const RecordsType &GetRecords() const { return this->Records; }
+  DAX_CONT_EXPORT
+  RecordsType &GetRecords() { return this->Records; }
+
+  DAX_CONT_EXPORT
+  const BlockCountsType &GetBlockCounts() const { return this->BlockCounts; }
+  DAX_CONT_EXPORT
+  BlockCountsType &GetBlockCounts() { return this->BlockCounts; }
+
+private:
+  dax::Id NumberOfInputCells;
+  dax::Id BlockSize;
+  RecordsType Records;
+  BlockCountsType BlockCounts;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_InterpolatedCellBlocks_h
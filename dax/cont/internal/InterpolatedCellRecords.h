@@ -0,0 +1,69 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_InterpolatedCellRecords_h
+#define __dax_cont_internal_InterpolatedCellRecords_h
+
+#include <dax/Types.h>
+#include <dax/CellTraits.h>
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/exec/InterpolatedCellPoints.h>
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// Holds the interpolation records written by a worklet generating
+/// interpolated cells, \c NUM_VERTICES consecutive records per output cell.
+/// Dispatchers of such worklets substitute this for the output grid given as
+/// geometry and resolve the records into point coordinates afterwards.
+///
+template<class CellTag, class DeviceAdapterTag>
+class InterpolatedCellRecords
+{
+public:
+  typedef CellTag CellTagType;
+  const static int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+  typedef dax::cont::ArrayHandle<dax::exec::InterpolationRecord,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> RecordsType;
+
+  DAX_CONT_EXPORT
+  InterpolatedCellRecords() {  }
+
+  DAX_CONT_EXPORT
+  InterpolatedCellRecords(const RecordsType &records) : Records(records) {  }
+
+  DAX_CONT_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    return this->Records.GetNumberOfValues() / NUM_VERTICES;
+  }
+
+  DAX_CONT_EXPORT
+  const RecordsType &GetRecords() const { return this->Records; }
+  DAX_CONT_EXPORT
+  RecordsType &GetRecords() { return this->Records; }
+
+private:
+  RecordsType Records;
+};
+
+}
+}
+} // namespace dax::cont::internal
+
+#endif //__dax_cont_internal_InterpolatedCellRecords_h
@@ -0,0 +1,231 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_internal_NumaPlacement_h
+#define __dax_cont_internal_NumaPlacement_h
+
+#define DAX_NUMA_PLACEMENT_NONE         0
+#define DAX_NUMA_PLACEMENT_FIRST_TOUCH  1
+#define DAX_NUMA_PLACEMENT_INTERLEAVE   2
+
+#ifndef DAX_NUMA_PLACEMENT
+#define DAX_NUMA_PLACEMENT DAX_NUMA_PLACEMENT_FIRST_TOUCH
+#endif
+
+#include <dax/Types.h>
+
+#include <cstddef>
+#include <vector>
+
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace dax {
+namespace cont {
+namespace internal {
+
+/// Tag specifying that device adapters sharing memory with the control
+/// environment do nothing special when allocating output arrays. Pages end up
+/// on the memory node of whichever thread happens to write them first.
+///
+struct NumaPlacementTagNone {  };
+
+/// Tag specifying that output arrays are touched in parallel right after they
+/// are allocated, using the same static partition the device adapter uses to
+/// schedule. Each page then resides on the memory node of the thread that is
+/// going to process it.
+///
+struct NumaPlacementTagFirstTouch {  };
+
+/// Tag specifying that the pages of output arrays are interleaved round robin
+/// across all the memory nodes this process may allocate on. Use this when
+/// arrays are mostly accessed through indirection (for example gathering
+/// point fields through cell connections) so that no partition matches.
+///
+struct NumaPlacementTagInterleave {  };
+
+/// Arrays smaller than this many bytes are not worth placing. They are
+/// usually carved out of pages the allocator has already touched anyway.
+///
+const std::size_t NUMA_PLACEMENT_MINIMUM_BYTES = 1 << 16;
+
+/// Returns the size of a memory page.
+///
+DAX_CONT_EXPORT std::size_t NumaPageSize()
+{
+#if defined(__linux__)
+  static const std::size_t pageSize =
+      static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  return pageSize;
+#else
+  return 4096;
+#endif
+}
+
+/// Returns the address of the memory an iterator points to when the iterator
+/// is a plain pointer, or NULL for any other iterator. Only arrays with an
+/// address can be placed.
+///
+template<typename IteratorType>
+DAX_CONT_EXPORT const void *NumaArrayAddress(IteratorType)
+{
+  return NULL;
+}
+template<typename T>
+DAX_CONT_EXPORT const void *NumaArrayAddress(T *pointer)
+{
+  return pointer;
+}
+
+/// Writes one byte in every page that holds part of the values in the range
+/// [\c begin, \c end). The contents of the values are undefined afterward.
+/// This is the per-thread kernel of a parallel first touch; neighboring
+/// threads may touch the same page at a boundary, but never the same byte.
+///
+template<typename T>
+DAX_CONT_EXPORT void NumaTouchPages(T *begin, T *end)
+{
+  const std::size_t pageSize = NumaPageSize();
+  char *location = reinterpret_cast<char *>(begin);
+  char *last = reinterpret_cast<char *>(end);
+  while (location < last)
+    {
+    *location = 0;
+    const std::size_t address = reinterpret_cast<std::size_t>(location);
+    location += pageSize - (address % pageSize);
+    }
+}
+
+/// Asks the operating system to interleave the pages holding \c numBytes
+/// bytes starting at \c begin across all allowed memory nodes. Only pages that
+/// have not been touched yet are affected. Returns false when the operating
+/// system does not support memory policies or there is only one node.
+///
+DAX_CONT_EXPORT bool NumaInterleave(const void *begin, std::size_t numBytes)
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+  // These match the values in <numaif.h>, which we do not want to require.
+  const int MPOL_INTERLEAVE_MODE = 3;
+  const unsigned long MPOL_F_MEMS_ALLOWED_FLAG = 1 << 2;
+  const unsigned long MAX_NODES = 1024;
+  const unsigned long BITS_PER_WORD = 8*sizeof(unsigned long);
+
+  unsigned long allowedNodes[MAX_NODES/BITS_PER_WORD] = { 0 };
+  int mode;
+  if (syscall(SYS_get_mempolicy, &mode, allowedNodes, MAX_NODES, NULL,
+              MPOL_F_MEMS_ALLOWED_FLAG) != 0)
+    {
+    return false;
+    }
+
+  int numNodes = 0;
+  for (unsigned long word = 0; word < MAX_NODES/BITS_PER_WORD; ++word)
+    {
+    numNodes += __builtin_popcountl(allowedNodes[word]);
+    }
+  if (numNodes < 2) { return false; }
+
+  const std::size_t pageSize = NumaPageSize();
+  const std::size_t start = reinterpret_cast<std::size_t>(begin);
+  const std::size_t alignedStart = start - (start % pageSize);
+  const std::size_t length = numBytes + (start - alignedStart);
+  return syscall(SYS_mbind, alignedStart, length, MPOL_INTERLEAVE_MODE,
+                 allowedNodes, MAX_NODES, 0) == 0;
+#else
+  (void)begin;
+  (void)numBytes;
+  return false;
+#endif
+}
+
+/// Fills \c nodes with the memory node holding each page that overlaps the
+/// \c numBytes bytes starting at \c begin. A page that is not resident yet
+/// gets a negative value (-ENOENT on Linux). Returns false if the operating
+/// system cannot report page locations.
+///
+DAX_CONT_EXPORT bool NumaGetPageNodes(const void *begin,
+                                      std::size_t numBytes,
+                                      std::vector<int> &nodes)
+{
+  nodes.clear();
+#if defined(__linux__) && defined(SYS_move_pages)
+  const std::size_t pageSize = NumaPageSize();
+  const std::size_t start = reinterpret_cast<std::size_t>(begin);
+  const std::size_t alignedStart = start - (start % pageSize);
+  const std::size_t numPages =
+      (numBytes + (start - alignedStart) + pageSize - 1) / pageSize;
+  if (numPages == 0) { return true; }
+
+  std::vector<void *> pages(numPages);
+  for (std::size_t pageIndex = 0; pageIndex < numPages; ++pageIndex)
+    {
+    pages[pageIndex] =
+        reinterpret_cast<void *>(alignedStart + pageIndex*pageSize);
+    }
+  nodes.resize(numPages);
+
+  // With a NULL node list move_pages only reports where each page lives.
+  if (syscall(SYS_move_pages, 0, numPages, &pages[0], NULL, &nodes[0], 0)
+      != 0)
+    {
+    nodes.clear();
+    return false;
+    }
+  return true;
+#else
+  (void)begin;
+  (void)numBytes;
+  return false;
+#endif
+}
+
+/// Returns the memory node of the processor the calling thread is running on,
+/// or -1 if the operating system cannot tell.
+///
+DAX_CONT_EXPORT int NumaGetCurrentNode()
+{
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned int cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+    {
+    return -1;
+    }
+  return static_cast<int>(node);
+#else
+  return -1;
+#endif
+}
+
+}
+}
+} // namespace dax::cont::internal
+
+#if DAX_NUMA_PLACEMENT == DAX_NUMA_PLACEMENT_NONE
+#define DAX_DEFAULT_NUMA_PLACEMENT_TAG \
+  ::dax::cont::internal::NumaPlacementTagNone
+#elif DAX_NUMA_PLACEMENT == DAX_NUMA_PLACEMENT_FIRST_TOUCH
+#define DAX_DEFAULT_NUMA_PLACEMENT_TAG \
+  ::dax::cont::internal::NumaPlacementTagFirstTouch
+#elif DAX_NUMA_PLACEMENT == DAX_NUMA_PLACEMENT_INTERLEAVE
+#define DAX_DEFAULT_NUMA_PLACEMENT_TAG \
+  ::dax::cont::internal::NumaPlacementTagInterleave
+#else
+#warning Unrecognized NUMA placement given.
+#endif
+
+#endif //__dax_cont_internal_NumaPlacement_h
@@ -36,6 +36,11 @@ class In: public Tag {};
 /// \brief Mark output parameters in a worklet \c ControlSignature.
 class Out: public Tag {};
 
+/// \headerfile Tag.h dax/cont/sig/Tag.h
+/// \brief Mark input fields in a worklet \c ControlSignature that are read
+/// as the neighborhood around each point of a structured grid.
+class PointNeighborhood: public Tag {};
+
 class Domain: public Tag
 {
 public:
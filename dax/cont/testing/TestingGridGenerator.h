@@ -24,6 +24,8 @@
 #include <dax/cont/ArrayContainerControlBasic.h>
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/RectilinearGrid.h>
+#include <dax/cont/StructuredGrid.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 
@@ -66,6 +68,18 @@ private:
     std::vector<dax::Id> topology;
     std::vector<dax::Vector3> points;
     };
+  template<class UCCT, class DAT>
+  struct GridStorage<dax::cont::RectilinearGrid<UCCT,DAT> >
+    {
+    std::vector<dax::Scalar> xCoordinates;
+    std::vector<dax::Scalar> yCoordinates;
+    std::vector<dax::Scalar> zCoordinates;
+    };
+  template<class PCCT, class DAT>
+  struct GridStorage<dax::cont::StructuredGrid<PCCT,DAT> >
+    {
+    std::vector<dax::Vector3> points;
+    };
   GridStorage<GridType> Info;
 
   typedef typename GridType::TopologyStructConstExecution TopoType;
@@ -183,8 +197,42 @@ private:
   ComputeCellConnections(const dax::cont::UniformGrid<DeviceAdapterTag> &uniform,
                          dax::Id cell_index) const
   {
-    dax::Id3 ijk = uniform.ComputeCellLocation(cell_index);
-    dax::Id3 dims = dax::extentDimensions(uniform.GetExtent());
+    return this->ComputeStructuredCellConnections(uniform.GetExtent(),
+                                                  cell_index);
+  }
+
+  // ................................................... ComputeCellConnections
+  DAX_CONT_EXPORT
+  dax::cont::testing::CellConnections<CellTag>
+  ComputeCellConnections(
+      const dax::cont::RectilinearGrid<ArrayContainerControlTag,
+                                       DeviceAdapterTag> &rectilinear,
+      dax::Id cell_index) const
+  {
+    return this->ComputeStructuredCellConnections(rectilinear.GetExtent(),
+                                                  cell_index);
+  }
+
+  // ................................................... ComputeCellConnections
+  DAX_CONT_EXPORT
+  dax::cont::testing::CellConnections<CellTag>
+  ComputeCellConnections(
+      const dax::cont::StructuredGrid<ArrayContainerControlTag,
+                                      DeviceAdapterTag> &structured,
+      dax::Id cell_index) const
+  {
+    return this->ComputeStructuredCellConnections(structured.GetExtent(),
+                                                  cell_index);
+  }
+
+  // ......................................... ComputeStructuredCellConnections
+  DAX_CONT_EXPORT
+  dax::cont::testing::CellConnections<CellTag>
+  ComputeStructuredCellConnections(const dax::Extent3 &extent,
+                                   dax::Id cell_index) const
+  {
+    dax::Id3 ijk = dax::flatIndexToIndex3Cell(cell_index, extent) - extent.Min;
+    dax::Id3 dims = dax::extentDimensions(extent);
     dax::Id firstPointIndex =
                       ijk[0] + ijk[1] * dims[0] + ijk[2] * dims[0] * dims[1];
     dax::Id secondPointIndex = firstPointIndex + (dims[0] * dims[1]);
@@ -262,6 +310,57 @@ private:
     grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(Size-1, Size-1, Size-1));
     }
 
+  // .......................................................... RectilinearGrid
+  void BuildGrid(
+    dax::cont::RectilinearGrid<ArrayContainerControlTag,DeviceAdapterTag>
+    &grid)
+    {
+    // The spacing between points grows along each axis so that the grid is
+    // not uniform.
+    this->Info.xCoordinates.resize(Size);
+    this->Info.yCoordinates.resize(Size);
+    this->Info.zCoordinates.resize(Size);
+    for (dax::Id index = 0; index < Size; index++)
+      {
+      const dax::Scalar coordinate = static_cast<dax::Scalar>(index)
+          + static_cast<dax::Scalar>(index*index)/(2*Size);
+      this->Info.xCoordinates[index] = coordinate;
+      this->Info.yCoordinates[index] = 0.5f*coordinate;
+      this->Info.zCoordinates[index] = 2.0f*coordinate;
+      }
+    grid = dax::cont::RectilinearGrid<
+           ArrayContainerControlTag,DeviceAdapterTag>(
+          this->MakeArrayHandle(this->Info.xCoordinates),
+          this->MakeArrayHandle(this->Info.yCoordinates),
+          this->MakeArrayHandle(this->Info.zCoordinates));
+    }
+
+  // ........................................................... StructuredGrid
+  void BuildGrid(
+    dax::cont::StructuredGrid<ArrayContainerControlTag,DeviceAdapterTag>
+    &grid)
+    {
+    dax::cont::UniformGrid<DeviceAdapterTag> uniform;
+    this->BuildGrid(uniform);
+
+    // Shear and bend the points of a uniform grid so that the cells are
+    // neither axis aligned nor parallelepipeds.
+    this->Info.points.resize(uniform.GetNumberOfPoints());
+    for (dax::Id index = 0; index < uniform.GetNumberOfPoints(); index++)
+      {
+      const dax::Vector3 ijk = uniform.ComputePointCoordinates(index);
+      const dax::Scalar size = static_cast<dax::Scalar>(Size);
+      this->Info.points[index] = dax::make_Vector3(
+            ijk[0] + 0.5f*ijk[2],
+            ijk[1] + 0.25f*ijk[0]*ijk[0]/size,
+            ijk[2] + 0.125f*ijk[0]*ijk[1]/size);
+      }
+    grid = dax::cont::StructuredGrid<
+           ArrayContainerControlTag,DeviceAdapterTag>(
+          uniform.GetExtent(),
+          this->MakeArrayHandle(this->Info.points));
+    }
+
   // ............................................................... Hexahedron
   void BuildGrid(
     dax::cont::UnstructuredGrid<
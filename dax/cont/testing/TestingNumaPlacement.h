@@ -0,0 +1,347 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_cont_testing_TestingNumaPlacement_h
+#define __dax_cont_testing_TestingNumaPlacement_h
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/internal/NumaPlacement.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace dax {
+namespace cont {
+namespace testing {
+
+/// This class has a single static member, Run, that checks that a device
+/// adapter sharing memory with the control environment places the pages of
+/// the arrays it allocates for output.
+///
+template<class DeviceAdapterTag>
+struct TestingNumaPlacement
+{
+private:
+  typedef dax::cont::ArrayHandle<dax::Scalar,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> ScalarArrayHandle;
+  typedef typename ScalarArrayHandle::PortalExecution PortalType;
+  typedef dax::cont::ArrayHandle<dax::Id,
+                                 dax::cont::ArrayContainerControlTagBasic,
+                                 DeviceAdapterTag> IdArrayHandle;
+  typedef typename IdArrayHandle::PortalExecution IdPortalType;
+  typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+
+  // Large enough that the allocator gets fresh pages from the system.
+  static const dax::Id ARRAY_SIZE = 1 << 22;
+
+  // Threads that are not pinned may move to another node between placing an
+  // array and using it, so allow a few pages to be somewhere else.
+  static const int MAX_MISPLACED_PERCENT = 10;
+
+  struct RecordNodeKernel
+  {
+    DAX_CONT_EXPORT
+    RecordNodeKernel(const IdPortalType &nodes) : Nodes(nodes) {  }
+
+    DAX_EXEC_EXPORT void operator()(dax::Id index) const
+    {
+      this->Nodes.Set(index, dax::cont::internal::NumaGetCurrentNode());
+    }
+
+    DAX_CONT_EXPORT void SetErrorMessageBuffer(
+        const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+    IdPortalType Nodes;
+  };
+
+  struct WriteValuesKernel
+  {
+    DAX_CONT_EXPORT
+    WriteValuesKernel(dax::Scalar *values) : Values(values) {  }
+
+    DAX_EXEC_EXPORT void operator()(dax::Id index) const
+    {
+      this->Values[index] = static_cast<dax::Scalar>(index);
+    }
+
+    DAX_CONT_EXPORT void SetErrorMessageBuffer(
+        const dax::exec::internal::ErrorMessageBuffer &) {  }
+
+    dax::Scalar *Values;
+  };
+
+  static DAX_CONT_EXPORT void CountPages(const PortalType &portal,
+                                         int &numResident,
+                                         int &numMissing,
+                                         std::vector<int> &numPerNode)
+  {
+    std::vector<int> nodes;
+    const std::size_t numBytes =
+        portal.GetNumberOfValues()*sizeof(dax::Scalar);
+    DAX_TEST_ASSERT(dax::cont::internal::NumaGetPageNodes(
+                      &(*portal.GetIteratorBegin()), numBytes, nodes),
+                    "Could not query page locations.");
+
+    numResident = numMissing = 0;
+    numPerNode.clear();
+    for (std::size_t pageIndex = 0; pageIndex < nodes.size(); ++pageIndex)
+      {
+      const int node = nodes[pageIndex];
+      if (node < 0)
+        {
+        numMissing++;
+        continue;
+        }
+      numResident++;
+      if (static_cast<std::size_t>(node) >= numPerNode.size())
+        {
+        numPerNode.resize(node+1, 0);
+        }
+      numPerNode[node]++;
+      }
+  }
+
+  static DAX_CONT_EXPORT void TestPagesResident()
+  {
+    std::cout << "Checking pages of output array are placed." << std::endl;
+
+    ScalarArrayHandle array;
+    PortalType portal = array.PrepareForOutput(ARRAY_SIZE);
+
+    int numResident, numMissing;
+    std::vector<int> numPerNode;
+    CountPages(portal, numResident, numMissing, numPerNode);
+    std::cout << "  " << numResident << " pages resident, "
+              << numMissing << " missing, spread over "
+              << numPerNode.size() << " node(s)." << std::endl;
+
+#if DAX_NUMA_PLACEMENT != DAX_NUMA_PLACEMENT_NONE
+    DAX_TEST_ASSERT(numMissing == 0,
+                    "Allocation for output did not touch every page.");
+#endif
+
+#if DAX_NUMA_PLACEMENT == DAX_NUMA_PLACEMENT_INTERLEAVE
+    // Only meaningful on machines with more than one memory node.
+    int numNodesUsed = 0;
+    for (std::size_t node = 0; node < numPerNode.size(); ++node)
+      {
+      if (numPerNode[node] > 0) { numNodesUsed++; }
+      }
+    if (numPerNode.size() > 1)
+      {
+      DAX_TEST_ASSERT(numNodesUsed > 1,
+                      "Interleaved array landed on a single node.");
+      }
+#endif
+  }
+
+  static DAX_CONT_EXPORT void TestPagesOnScheduleNodes()
+  {
+    std::cout << "Checking pages of output array are on the node of the "
+              << "thread scheduled on them." << std::endl;
+
+    ScalarArrayHandle array;
+    PortalType portal = array.PrepareForOutput(ARRAY_SIZE);
+    std::vector<int> pageNodes;
+    const dax::Scalar *arrayBegin = &(*portal.GetIteratorBegin());
+    DAX_TEST_ASSERT(dax::cont::internal::NumaGetPageNodes(
+                      arrayBegin, ARRAY_SIZE*sizeof(dax::Scalar), pageNodes),
+                    "Could not query page locations.");
+
+    // Schedule uses the same static partition as the first touch, so each
+    // value is processed on the node its page was placed on.
+    IdArrayHandle threadNodes;
+    Algorithm::Schedule(
+          RecordNodeKernel(threadNodes.PrepareForOutput(ARRAY_SIZE)),
+          ARRAY_SIZE);
+    typename IdArrayHandle::PortalConstControl threadNodesPortal =
+        threadNodes.GetPortalConstControl();
+    if (threadNodesPortal.Get(0) < 0)
+      {
+      std::cout << "  Thread locations cannot be queried. Skipping."
+                << std::endl;
+      return;
+      }
+
+    const std::size_t pageSize = dax::cont::internal::NumaPageSize();
+    const std::size_t start = reinterpret_cast<std::size_t>(arrayBegin);
+    const std::size_t alignedStart = start - (start % pageSize);
+    const dax::Id valuesPerPage =
+        static_cast<dax::Id>(pageSize/sizeof(dax::Scalar));
+
+    int numChecked = 0;
+    int numMisplaced = 0;
+    for (std::size_t pageIndex = 0; pageIndex < pageNodes.size(); ++pageIndex)
+      {
+      const std::size_t pageStart = alignedStart + pageIndex*pageSize;
+      const dax::Id firstValue = (pageStart > start)
+          ? static_cast<dax::Id>((pageStart - start)/sizeof(dax::Scalar)) : 0;
+      const dax::Id endValue =
+          std::min(firstValue + valuesPerPage, ARRAY_SIZE);
+
+      // Pages split between two threads may go either way.
+      const dax::Id expectedNode = threadNodesPortal.Get(firstValue);
+      bool oneThreadNode = true;
+      for (dax::Id index = firstValue + 1; index < endValue; ++index)
+        {
+        if (threadNodesPortal.Get(index) != expectedNode)
+          {
+          oneThreadNode = false;
+          break;
+          }
+        }
+      if (!oneThreadNode) { continue; }
+
+      numChecked++;
+      if (pageNodes[pageIndex] != expectedNode) { numMisplaced++; }
+      }
+    std::cout << "  " << numMisplaced << " of " << numChecked
+              << " pages on another node than their thread." << std::endl;
+
+#if DAX_NUMA_PLACEMENT == DAX_NUMA_PLACEMENT_FIRST_TOUCH
+    DAX_TEST_ASSERT(numChecked > 0, "No page was processed by one thread.");
+    DAX_TEST_ASSERT(100*numMisplaced <= MAX_MISPLACED_PERCENT*numChecked,
+                    "Pages are not on the node of the thread using them.");
+#endif
+  }
+
+  static DAX_CONT_EXPORT void TestInterleave()
+  {
+    std::cout << "Checking interleaved pages are spread over nodes."
+              << std::endl;
+
+    // Fresh memory from the system that nothing has touched yet.
+    const std::size_t numBytes = ARRAY_SIZE*sizeof(dax::Scalar);
+    dax::Scalar *values = static_cast<dax::Scalar *>(std::malloc(numBytes));
+    DAX_TEST_ASSERT(values != NULL, "Could not allocate array.");
+
+    if (!dax::cont::internal::NumaInterleave(values, numBytes))
+      {
+      std::cout << "  Fewer than two memory nodes. Skipping." << std::endl;
+      std::free(values);
+      return;
+      }
+    Algorithm::Schedule(WriteValuesKernel(values), ARRAY_SIZE);
+
+    int numResident, numMissing;
+    std::vector<int> numPerNode;
+    std::vector<int> nodes;
+    DAX_TEST_ASSERT(dax::cont::internal::NumaGetPageNodes(
+                      values, numBytes, nodes),
+                    "Could not query page locations.");
+    std::free(values);
+
+    numResident = numMissing = 0;
+    for (std::size_t pageIndex = 0; pageIndex < nodes.size(); ++pageIndex)
+      {
+      const int node = nodes[pageIndex];
+      if (node < 0) { numMissing++; continue; }
+      numResident++;
+      if (static_cast<std::size_t>(node) >= numPerNode.size())
+        {
+        numPerNode.resize(node+1, 0);
+        }
+      numPerNode[node]++;
+      }
+    DAX_TEST_ASSERT(numMissing == 0, "Pages of written array not resident.");
+
+    int numNodesUsed = 0;
+    int fewestPages = numResident;
+    int mostPages = 0;
+    for (std::size_t node = 0; node < numPerNode.size(); ++node)
+      {
+      if (numPerNode[node] == 0) { continue; }
+      numNodesUsed++;
+      fewestPages = std::min(fewestPages, numPerNode[node]);
+      mostPages = std::max(mostPages, numPerNode[node]);
+      }
+    std::cout << "  " << numResident << " pages over " << numNodesUsed
+              << " nodes." << std::endl;
+    DAX_TEST_ASSERT(numNodesUsed > 1,
+                    "Interleaved array landed on a single node.");
+    DAX_TEST_ASSERT(mostPages <= 2*fewestPages,
+                    "Interleaved pages are not spread evenly.");
+  }
+
+  static DAX_CONT_EXPORT void TestReusedArrayUntouched()
+  {
+    std::cout << "Checking reused output array keeps its values." << std::endl;
+
+    // An operation may use the same array as input and output. Preparing the
+    // output then reuses the memory, which must not be overwritten.
+    std::vector<dax::Scalar> values(ARRAY_SIZE);
+    for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+      {
+      values[index] = static_cast<dax::Scalar>(index % 1000 + 1);
+      }
+    ScalarArrayHandle input =
+        dax::cont::make_ArrayHandle(values,
+                                    dax::cont::ArrayContainerControlTagBasic(),
+                                    DeviceAdapterTag());
+    ScalarArrayHandle array;
+    dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag>::Copy(input, array);
+
+    PortalType portal = array.PrepareForOutput(ARRAY_SIZE);
+    for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+      {
+      DAX_TEST_ASSERT(test_equal(portal.Get(index), values[index]),
+                      "Reallocating an array for output cleared it.");
+      }
+  }
+
+  struct TestAll
+  {
+    DAX_CONT_EXPORT void operator()() const
+    {
+      std::vector<int> nodes;
+      int dummy = 0;
+      if (!dax::cont::internal::NumaGetPageNodes(&dummy, sizeof(int), nodes))
+        {
+        std::cout << "Page locations cannot be queried on this system. "
+                  << "Skipping placement checks." << std::endl;
+        }
+      else
+        {
+        TestPagesResident();
+        TestPagesOnScheduleNodes();
+        TestInterleave();
+        }
+      TestReusedArrayUntouched();
+    }
+  };
+
+public:
+
+  /// Run a suite of tests to check the placement of arrays allocated by the
+  /// device adapter. Returns an error code that can be returned from the
+  /// main function of a test.
+  ///
+  static DAX_CONT_EXPORT int Run()
+  {
+    return dax::cont::testing::Testing::Run(TestAll());
+  }
+};
+
+}
+}
+} // namespace dax::cont::testing
+
+#endif //__dax_cont_testing_TestingNumaPlacement_h
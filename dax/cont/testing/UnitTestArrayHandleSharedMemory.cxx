@@ -0,0 +1,265 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_ERROR
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandleSharedMemory.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/DeviceAdapterSerial.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 10;
+
+typedef dax::cont::ArrayHandleSharedMemory<dax::Scalar> ScalarArrayHandle;
+
+std::string SegmentName(const char *suffix)
+{
+  std::stringstream stream;
+  stream << "/dax_unit_test_" << getpid() << "_" << suffix;
+  return stream.str();
+}
+
+dax::Scalar TestValue(dax::Id index)
+{
+  return static_cast<dax::Scalar>(10.0*index + 0.01*(index+1));
+}
+
+template<typename ArrayHandleType>
+bool CheckValues(const ArrayHandleType &array, dax::Scalar shift)
+{
+  typename ArrayHandleType::PortalConstControl portal =
+      array.GetPortalConstControl();
+  for (dax::Id index = 0; index < portal.GetNumberOfValues(); index++)
+    {
+    if (!test_equal(portal.Get(index), TestValue(index) + shift))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+void TestDescriptor()
+{
+  std::cout << "Checking descriptor format." << std::endl;
+
+  DAX_TEST_ASSERT(dax::cont::SharedMemoryTypeName<dax::Id3>()
+                  == (sizeof(dax::Id) == 4 ? "int32[3]" : "int64[3]"),
+                  "Bad type name for Id3.");
+  DAX_TEST_ASSERT(dax::cont::SharedMemoryTypeName<float>() == "float32",
+                  "Bad type name for float.");
+
+  dax::cont::SharedMemoryArrayDescriptor descriptor("/pressure",
+                                                    "float64[3]",
+                                                    1024,
+                                                    64);
+  DAX_TEST_ASSERT(descriptor.ToString() == "/pressure float64[3] 1024 64",
+                  "Bad descriptor string.");
+
+  dax::cont::SharedMemoryArrayDescriptor parsed =
+      dax::cont::SharedMemoryArrayDescriptor::FromString(
+        descriptor.ToString());
+  DAX_TEST_ASSERT(parsed.GetName() == "/pressure", "Bad parsed name.");
+  DAX_TEST_ASSERT(parsed.GetTypeName() == "float64[3]", "Bad parsed type.");
+  DAX_TEST_ASSERT(parsed.GetNumberOfValues() == 1024, "Bad parsed length.");
+  DAX_TEST_ASSERT(parsed.GetOffset() == 64, "Bad parsed offset.");
+
+  try
+    {
+    dax::cont::SharedMemoryArrayDescriptor::FromString("/pressure float32");
+    DAX_TEST_FAIL("Parsed incomplete descriptor.");
+    }
+  catch (dax::cont::ErrorControlBadValue)
+    {
+    std::cout << "Got expected error." << std::endl;
+    }
+}
+
+void TestCreateAndAttach()
+{
+  std::cout << "Creating shared array." << std::endl;
+  ScalarArrayHandle producer(SegmentName("attach"), ARRAY_SIZE);
+  DAX_TEST_ASSERT(producer.GetNumberOfValues() == ARRAY_SIZE,
+                  "Shared array has wrong size.");
+  ScalarArrayHandle::PortalControl portal = producer.GetPortalControl();
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    portal.Set(index, TestValue(index));
+    }
+
+  std::cout << "Attaching to shared array." << std::endl;
+  const std::string text = producer.GetDescriptor().ToString();
+  ScalarArrayHandle consumer = dax::cont::make_ArrayHandleSharedMemory<
+      dax::Scalar>(dax::cont::SharedMemoryArrayDescriptor::FromString(text));
+  DAX_TEST_ASSERT(consumer.GetNumberOfValues() == ARRAY_SIZE,
+                  "Attached array has wrong size.");
+  DAX_TEST_ASSERT(CheckValues(consumer, 0), "Attached array has bad values.");
+  DAX_TEST_ASSERT(consumer.GetPortalConstControl().GetIteratorBegin()
+                  != producer.GetPortalConstControl().GetIteratorBegin(),
+                  "Attached array should be a separate mapping.");
+
+  std::cout << "Writing through attached array." << std::endl;
+  ScalarArrayHandle::PortalExecution outPortal =
+      consumer.PrepareForInPlace();
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    outPortal.Set(index, outPortal.Get(index) + 1);
+    }
+  DAX_TEST_ASSERT(CheckValues(producer, 1),
+                  "Producer did not see values written by consumer.");
+
+  std::cout << "Checking type mismatch." << std::endl;
+  try
+    {
+    dax::cont::make_ArrayHandleSharedMemory<dax::Id>(
+          producer.GetDescriptor());
+    DAX_TEST_FAIL("Attached array with wrong type.");
+    }
+  catch (dax::cont::ErrorControlBadValue)
+    {
+    std::cout << "Got expected error." << std::endl;
+    }
+
+  std::cout << "Checking release of creator." << std::endl;
+  producer.ReleaseResources();
+  DAX_TEST_ASSERT(CheckValues(consumer, 1),
+                  "Attached array lost values when creator released.");
+  try
+    {
+    dax::cont::make_ArrayHandleSharedMemory<dax::Scalar>(
+          consumer.GetDescriptor());
+    DAX_TEST_FAIL("Attached to array that should be unlinked.");
+    }
+  catch (dax::cont::ErrorControlBadValue)
+    {
+    std::cout << "Got expected error." << std::endl;
+    }
+}
+
+void TestUnnamedSegment()
+{
+  std::cout << "Creating shared array without a name." << std::endl;
+  ScalarArrayHandle producer(std::string(), ARRAY_SIZE);
+  const dax::cont::SharedMemoryArrayDescriptor &descriptor =
+      producer.GetDescriptor();
+  DAX_TEST_ASSERT(!descriptor.GetName().empty(),
+                  "Descriptor of unnamed array has no name.");
+  ScalarArrayHandle::PortalControl portal = producer.GetPortalControl();
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    portal.Set(index, TestValue(index));
+    }
+
+  ScalarArrayHandle consumer =
+      dax::cont::make_ArrayHandleSharedMemory<dax::Scalar>(descriptor);
+  DAX_TEST_ASSERT(CheckValues(consumer, 0),
+                  "Attached to unnamed array but got bad values.");
+}
+
+void TestOtherProcess()
+{
+  std::cout << "Handing array to another process." << std::endl;
+  ScalarArrayHandle producer(SegmentName("process"), ARRAY_SIZE);
+  ScalarArrayHandle::PortalControl portal = producer.GetPortalControl();
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    portal.Set(index, TestValue(index));
+    }
+  const std::string text = producer.GetDescriptor().ToString();
+
+  pid_t child = fork();
+  DAX_TEST_ASSERT(child >= 0, "Could not fork.");
+  if (child == 0)
+    {
+    int status = 1;
+    try
+      {
+      ScalarArrayHandle consumer(
+            dax::cont::SharedMemoryArrayDescriptor::FromString(text));
+      if (CheckValues(consumer, 0))
+        {
+        ScalarArrayHandle::PortalControl childPortal =
+            consumer.GetPortalControl();
+        for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+          {
+          childPortal.Set(index, childPortal.Get(index) + 2);
+          }
+        status = 0;
+        }
+      }
+    catch (...) {  }
+    _exit(status);
+    }
+
+  int status;
+  DAX_TEST_ASSERT(waitpid(child, &status, 0) == child,
+                  "Could not wait for child.");
+  DAX_TEST_ASSERT(WIFEXITED(status) && (WEXITSTATUS(status) == 0),
+                  "Child process did not read shared array.");
+  DAX_TEST_ASSERT(CheckValues(producer, 2),
+                  "Did not see values written by child process.");
+}
+
+void TestAllocateForOutput()
+{
+  std::cout << "Allocating shared array for output." << std::endl;
+  dax::cont::ArrayHandle<dax::Id,
+                         dax::cont::ArrayContainerControlTagSharedMemory>
+      array;
+  std::vector<dax::Id> values(ARRAY_SIZE, 7);
+  dax::cont::DeviceAdapterAlgorithm<dax::cont::DeviceAdapterTagSerial>::Copy(
+        dax::cont::make_ArrayHandle(values,
+                                    dax::cont::ArrayContainerControlTagBasic(),
+                                    dax::cont::DeviceAdapterTagSerial()),
+        array);
+  DAX_TEST_ASSERT(array.GetNumberOfValues() == ARRAY_SIZE,
+                  "Output array has wrong size.");
+  for (dax::Id index = 0; index < ARRAY_SIZE; index++)
+    {
+    DAX_TEST_ASSERT(array.GetPortalConstControl().Get(index) == 7,
+                    "Output array has wrong value.");
+    }
+  array.ReleaseResources();
+  DAX_TEST_ASSERT(array.GetNumberOfValues() == 0,
+                  "Released array not empty.");
+}
+
+void TestArrayHandleSharedMemory()
+{
+  TestDescriptor();
+  TestCreateAndAttach();
+  TestUnnamedSegment();
+  TestOtherProcess();
+  TestAllocateForOutput();
+}
+
+} // anonymous namespace
+
+int UnitTestArrayHandleSharedMemory(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestArrayHandleSharedMemory);
+}
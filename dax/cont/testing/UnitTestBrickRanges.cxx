@@ -0,0 +1,223 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/cont/BrickRanges.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/exec/WorkletMapCell.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 20;
+
+typedef dax::cont::UniformGrid<> GridType;
+typedef dax::cont::BrickRanges<> BrickRangesType;
+
+// Counts the vertices of a cell with a value inside a range.
+struct CountInRange : public dax::exec::WorkletMapCell
+{
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_CONT_EXPORT CountInRange(dax::Scalar min, dax::Scalar max)
+    : Min(min), Max(max) {  }
+
+  DAX_CONT_EXPORT dax::Vector2 GetValueRange() const
+  {
+    return dax::make_Vector2(this->Min, this->Max);
+  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Id operator()(const dax::exec::CellField<dax::Scalar,CellTag> &values)
+  const
+  {
+    dax::Id count = 0;
+    for (int vertexIndex = 0; vertexIndex < values.NUM_VERTICES; vertexIndex++)
+      {
+      count += (values[vertexIndex] >= this->Min)
+          && (values[vertexIndex] <= this->Max);
+      }
+    return count;
+  }
+
+private:
+  dax::Scalar Min;
+  dax::Scalar Max;
+};
+
+dax::Scalar FieldValue(const dax::Id3 &ijk)
+{
+  return static_cast<dax::Scalar>(ijk[0]*ijk[0] + ijk[1]*ijk[1] + ijk[2]*ijk[2]);
+}
+
+void CheckRanges(const GridType &grid,
+                 const std::vector<dax::Scalar> &field,
+                 const BrickRangesType &brickRanges)
+{
+  const dax::Id brickSize = brickRanges.GetBrickSize();
+  const dax::Id3 cellDims = dax::extentCellDimensions(grid.GetExtent());
+  const dax::Id3 numBricks((cellDims[0]+brickSize-1)/brickSize,
+                           (cellDims[1]+brickSize-1)/brickSize,
+                           (cellDims[2]+brickSize-1)/brickSize);
+  DAX_TEST_ASSERT(brickRanges.GetNumberOfBricks()
+                  == numBricks[0]*numBricks[1]*numBricks[2],
+                  "Wrong number of bricks.");
+
+  BrickRangesType::RangeArrayHandleType::PortalConstControl ranges =
+      brickRanges.GetRanges().GetPortalConstControl();
+  dax::Id brick = 0;
+  dax::Id3 brickIjk;
+  for (brickIjk[2] = 0; brickIjk[2] < numBricks[2]; brickIjk[2]++)
+    {
+    for (brickIjk[1] = 0; brickIjk[1] < numBricks[1]; brickIjk[1]++)
+      {
+      for (brickIjk[0] = 0; brickIjk[0] < numBricks[0]; brickIjk[0]++)
+        {
+        dax::Scalar minValue = field[grid.ComputePointIndex(
+              brickSize*brickIjk)];
+        dax::Scalar maxValue = minValue;
+        dax::Id3 ijk;
+        for (ijk[2] = brickSize*brickIjk[2];
+             ijk[2] <= std::min(brickSize*(brickIjk[2]+1), cellDims[2]);
+             ijk[2]++)
+          {
+          for (ijk[1] = brickSize*brickIjk[1];
+               ijk[1] <= std::min(brickSize*(brickIjk[1]+1), cellDims[1]);
+               ijk[1]++)
+            {
+            for (ijk[0] = brickSize*brickIjk[0];
+                 ijk[0] <= std::min(brickSize*(brickIjk[0]+1), cellDims[0]);
+                 ijk[0]++)
+              {
+              const dax::Scalar value = field[grid.ComputePointIndex(ijk)];
+              minValue = std::min(minValue, value);
+              maxValue = std::max(maxValue, value);
+              }
+            }
+          }
+        DAX_TEST_ASSERT(ranges.Get(brick) == dax::make_Vector2(minValue,
+                                                               maxValue),
+                        "Wrong brick range.");
+        brick++;
+        }
+      }
+    }
+}
+
+void CheckCount(const GridType &grid,
+                const dax::cont::ArrayHandle<dax::Scalar> &fieldHandle,
+                const BrickRangesType &brickRanges,
+                dax::Scalar min,
+                dax::Scalar max)
+{
+  std::cout << "  Counting for range [" << min << ", " << max << "]"
+            << std::endl;
+  CountInRange worklet(min, max);
+
+  dax::cont::ArrayHandle<dax::Id> expected;
+  dax::cont::DispatcherMapCell<CountInRange>(worklet).Invoke(
+        grid, fieldHandle, expected);
+
+  dax::cont::ArrayHandle<dax::Id> counts;
+  brickRanges.CountCells(worklet, fieldHandle, counts);
+
+  DAX_TEST_ASSERT(counts.GetNumberOfValues() == grid.GetNumberOfCells(),
+                  "Wrong number of counts.");
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); cellIndex++)
+    {
+    DAX_TEST_ASSERT(counts.GetPortalConstControl().Get(cellIndex)
+                    == expected.GetPortalConstControl().Get(cellIndex),
+                    "Count with skipped bricks differs.");
+    }
+
+  // Check that the bricks skipped are exactly those out of range.
+  BrickRangesType::IdArrayHandleType activeBricks =
+      brickRanges.GetActiveBricks(worklet.GetValueRange());
+  std::vector<bool> isActive(brickRanges.GetNumberOfBricks(), false);
+  for (dax::Id index = 0; index < activeBricks.GetNumberOfValues(); index++)
+    {
+    isActive[activeBricks.GetPortalConstControl().Get(index)] = true;
+    }
+  for (dax::Id brick = 0; brick < brickRanges.GetNumberOfBricks(); brick++)
+    {
+    dax::Vector2 range = brickRanges.GetRanges().GetPortalConstControl()
+        .Get(brick);
+    DAX_TEST_ASSERT(isActive[brick] == ((range[0] <= max) && (range[1] >= min)),
+                    "Wrong active bricks.");
+    }
+  std::cout << "    " << activeBricks.GetNumberOfValues() << " of "
+            << brickRanges.GetNumberOfBricks() << " bricks active."
+            << std::endl;
+}
+
+void TestBrickRanges()
+{
+  GridType grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-1, DIM-1));
+
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    field[index] = FieldValue(grid.ComputePointLocation(index));
+    }
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+
+  std::cout << "Checking an invalid summary." << std::endl;
+  BrickRangesType brickRanges;
+  DAX_TEST_ASSERT(!brickRanges.IsValid(), "Default summary is valid.");
+  DAX_TEST_ASSERT(brickRanges.GetNumberOfBricks() == 0,
+                  "Default summary has bricks.");
+
+  std::cout << "Checking default brick size." << std::endl;
+  brickRanges.Build(grid, fieldHandle);
+  DAX_TEST_ASSERT(brickRanges.IsValid(), "Built summary is invalid.");
+  DAX_TEST_ASSERT(brickRanges.GetBrickSize()
+                  == BrickRangesType::DEFAULT_BRICK_SIZE,
+                  "Wrong brick size.");
+  CheckRanges(grid, field, brickRanges);
+  CheckCount(grid, fieldHandle, brickRanges, 10, 50);
+  CheckCount(grid, fieldHandle, brickRanges, 400, 401);
+  CheckCount(grid, fieldHandle, brickRanges, -10, -1);
+  CheckCount(grid, fieldHandle, brickRanges, 0, 2000);
+
+  std::cout << "Checking copies share their state." << std::endl;
+  BrickRangesType copy = brickRanges;
+  copy.Invalidate();
+  DAX_TEST_ASSERT(!brickRanges.IsValid(), "Copy did not share state.");
+
+  std::cout << "Checking brick size that does not divide the grid."
+            << std::endl;
+  copy.Build(grid, fieldHandle, 5);
+  DAX_TEST_ASSERT(brickRanges.IsValid(), "Copy did not share state.");
+  DAX_TEST_ASSERT(brickRanges.GetBrickSize() == 5, "Wrong brick size.");
+  CheckRanges(grid, field, brickRanges);
+  CheckCount(grid, fieldHandle, brickRanges, 100, 150);
+}
+
+} // anonymous namespace
+
+int UnitTestBrickRanges(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestBrickRanges);
+}
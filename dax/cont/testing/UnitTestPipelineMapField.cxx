@@ -0,0 +1,282 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/PipelineMapField.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ErrorExecution.h>
+#include <dax/math/Trig.h>
+#include <dax/math/VectorAnalysis.h>
+#include <dax/worklet/Cosine.h>
+#include <dax/worklet/Magnitude.h>
+#include <dax/worklet/Sine.h>
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id ARRAY_SIZE = 100;
+
+struct Offset : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_CONT_EXPORT Offset(dax::Scalar amount = 0) : Amount(amount) {  }
+
+  DAX_EXEC_EXPORT dax::Scalar operator()(dax::Scalar value) const
+  {
+    if (value > 1000) { this->RaiseError("Offset input out of range."); }
+    return value + this->Amount;
+  }
+
+  dax::Scalar Amount;
+};
+
+struct Multiply : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldIn, FieldOut);
+  typedef _3 ExecutionSignature(_1, _2);
+
+  DAX_EXEC_EXPORT dax::Scalar operator()(dax::Scalar a, dax::Scalar b) const
+  {
+    return a * b;
+  }
+};
+
+struct MultiplyAdd : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldIn, FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+
+  DAX_EXEC_EXPORT void operator()(dax::Scalar a,
+                                  dax::Scalar b,
+                                  dax::Scalar c,
+                                  dax::Scalar &result) const
+  {
+    result = a * b + c;
+  }
+};
+
+dax::Vector3 TestVector(dax::Id index)
+{
+  return dax::make_Vector3(0.01f*index, 0.02f*index, -0.01f*index);
+}
+
+dax::Scalar Expected(dax::Id index)
+{
+  dax::Scalar sine = dax::math::Sin(dax::math::Magnitude(TestVector(index)));
+  return dax::math::Cos(sine*sine);
+}
+
+typedef dax::cont::PipelineMapField<
+    dax::exec::PipelineStage<dax::worklet::Magnitude, dax::Scalar>,
+    dax::worklet::Sine,
+    dax::worklet::Square,
+    dax::worklet::Cosine> PipelineType;
+
+void TestInvoke()
+{
+  std::cout << "Running four stage pipeline." << std::endl;
+  DAX_TEST_ASSERT(PipelineType::NUM_STAGES == 4, "Wrong number of stages.");
+
+  std::vector<dax::Vector3> input(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+    input[index] = TestVector(index);
+    }
+  dax::cont::ArrayHandle<dax::Vector3> inputHandle =
+      dax::cont::make_ArrayHandle(input);
+  dax::cont::ArrayHandle<dax::Scalar> outputHandle;
+
+  PipelineType().Invoke(inputHandle, outputHandle);
+
+  std::vector<dax::Scalar> output(ARRAY_SIZE);
+  outputHandle.CopyInto(output.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+    DAX_TEST_ASSERT(test_equal(output[index], Expected(index)),
+                    "Got bad value from pipeline.");
+    }
+
+  std::cout << "Running pipeline keeping the second stage." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> keptHandle;
+  PipelineType().InvokeKeeping<2>(inputHandle, keptHandle, outputHandle);
+
+  std::vector<dax::Scalar> kept(ARRAY_SIZE);
+  keptHandle.CopyInto(kept.begin());
+  outputHandle.CopyInto(output.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+    dax::Scalar sine = dax::math::Sin(dax::math::Magnitude(TestVector(index)));
+    DAX_TEST_ASSERT(test_equal(kept[index], sine),
+                    "Got bad value for kept stage.");
+    DAX_TEST_ASSERT(test_equal(output[index], Expected(index)),
+                    "Got bad value from pipeline keeping a stage.");
+    }
+}
+
+dax::Scalar TestScale(dax::Id index)
+{
+  return 0.5f + 0.01f*index;
+}
+
+// Computes sin(|v| * s) * s + |v| for vectors v and scalars s.
+typedef dax::cont::PipelineMapField<
+    dax::exec::PipelineStage<dax::worklet::Magnitude, dax::Scalar>,
+    dax::exec::PipelineStage<
+      Multiply,
+      dax::Scalar,
+      void(dax::exec::PipelineResult<1>, dax::exec::PipelineInput<2>)>,
+    dax::worklet::Sine,
+    dax::exec::PipelineStage<
+      MultiplyAdd,
+      dax::Scalar,
+      void(dax::exec::PipelineResult<3>,
+           dax::exec::PipelineInput<2>,
+           dax::exec::PipelineResult<1>)>
+    > WiredPipelineType;
+
+void TestWiring()
+{
+  std::cout << "Running pipeline with wired stages." << std::endl;
+  DAX_TEST_ASSERT(WiredPipelineType::NUM_STAGES == 4,
+                  "Wrong number of stages.");
+  DAX_TEST_ASSERT(WiredPipelineType::NUM_INPUTS == 2,
+                  "Wrong number of inputs.");
+
+  std::vector<dax::Vector3> vectors(ARRAY_SIZE);
+  std::vector<dax::Scalar> scales(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+    vectors[index] = TestVector(index);
+    scales[index] = TestScale(index);
+    }
+  dax::cont::ArrayHandle<dax::Vector3> vectorHandle =
+      dax::cont::make_ArrayHandle(vectors);
+  dax::cont::ArrayHandle<dax::Scalar> scaleHandle =
+      dax::cont::make_ArrayHandle(scales);
+  dax::cont::ArrayHandle<dax::Scalar> outputHandle;
+
+  WiredPipelineType pipeline;
+  pipeline.Invoke(vectorHandle, scaleHandle, outputHandle);
+
+  std::vector<dax::Scalar> output(ARRAY_SIZE);
+  outputHandle.CopyInto(output.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+    dax::Scalar magnitude = dax::math::Magnitude(TestVector(index));
+    dax::Scalar sine = dax::math::Sin(magnitude*TestScale(index));
+    DAX_TEST_ASSERT(test_equal(output[index],
+                               sine*TestScale(index) + magnitude),
+                    "Got bad value from wired pipeline.");
+    }
+
+  std::cout << "Running wired pipeline keeping three stages." << std::endl;
+  dax::cont::ArrayHandle<dax::Scalar> magnitudeHandle;
+  dax::cont::ArrayHandle<dax::Scalar> productHandle;
+  dax::cont::ArrayHandle<dax::Scalar> sineHandle;
+  WiredPipelineType::Keeping<1,2,3>(pipeline).Invoke(vectorHandle,
+                                                     scaleHandle,
+                                                     magnitudeHandle,
+                                                     productHandle,
+                                                     sineHandle,
+                                                     outputHandle);
+
+  std::vector<dax::Scalar> magnitudes(ARRAY_SIZE);
+  std::vector<dax::Scalar> products(ARRAY_SIZE);
+  std::vector<dax::Scalar> sines(ARRAY_SIZE);
+  magnitudeHandle.CopyInto(magnitudes.begin());
+  productHandle.CopyInto(products.begin());
+  sineHandle.CopyInto(sines.begin());
+  outputHandle.CopyInto(output.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+    dax::Scalar magnitude = dax::math::Magnitude(TestVector(index));
+    dax::Scalar product = magnitude*TestScale(index);
+    dax::Scalar sine = dax::math::Sin(product);
+    DAX_TEST_ASSERT(test_equal(magnitudes[index], magnitude),
+                    "Got bad value for kept first stage.");
+    DAX_TEST_ASSERT(test_equal(products[index], product),
+                    "Got bad value for kept second stage.");
+    DAX_TEST_ASSERT(test_equal(sines[index], sine),
+                    "Got bad value for kept third stage.");
+    DAX_TEST_ASSERT(test_equal(output[index],
+                               sine*TestScale(index) + magnitude),
+                    "Got bad value from wired pipeline keeping stages.");
+    }
+}
+
+void TestWorkletState()
+{
+  std::cout << "Running pipeline with worklet state." << std::endl;
+  typedef dax::cont::PipelineMapField<Offset, Offset> OffsetPipeline;
+  typedef OffsetPipeline::WorkletType WorkletType;
+
+  OffsetPipeline pipeline(
+        WorkletType(Offset(1), WorkletType::RestType(Offset(10))));
+
+  std::vector<dax::Scalar> input(ARRAY_SIZE);
+  for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+    input[index] = static_cast<dax::Scalar>(index);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> outputHandle;
+  pipeline.Invoke(dax::cont::make_ArrayHandle(input), outputHandle);
+
+  std::vector<dax::Scalar> output(ARRAY_SIZE);
+  outputHandle.CopyInto(output.begin());
+  for (dax::Id index = 0; index < ARRAY_SIZE; ++index)
+    {
+    DAX_TEST_ASSERT(test_equal(output[index], index + 11.0f),
+                    "Stages did not keep their state.");
+    }
+
+  std::cout << "Checking errors raised by a later stage." << std::endl;
+  // Only the second stage gets a value out of range.
+  input[ARRAY_SIZE/2] = 999.5f;
+  bool gotError = false;
+  try
+    {
+    pipeline.Invoke(dax::cont::make_ArrayHandle(input), outputHandle);
+    }
+  catch (dax::cont::ErrorExecution error)
+    {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Error from a stage was not reported.");
+}
+
+void TestPipelineMapField()
+{
+  TestInvoke();
+  TestWiring();
+  TestWorkletState();
+}
+
+} // anonymous namespace
+
+int UnitTestPipelineMapField(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestPipelineMapField);
+}
@@ -0,0 +1,171 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/cont/RectilinearGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/exec/WorkletMapCell.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+typedef dax::cont::RectilinearGrid<> GridType;
+
+struct CellCenterWorklet : public dax::exec::WorkletMapCell
+{
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagVoxel> &coords) const
+  {
+    dax::Vector3 sum = dax::make_Vector3(0.0, 0.0, 0.0);
+    for (int vertexIndex = 0; vertexIndex < coords.NUM_VERTICES; vertexIndex++)
+      {
+      sum = sum + coords[vertexIndex];
+      }
+    return (dax::Scalar(1)/dax::Scalar(coords.NUM_VERTICES))*sum;
+  }
+};
+
+struct CopyCoordinatesWorklet : public dax::exec::WorkletMapField
+{
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(const dax::Vector3 &coords) const
+  {
+    return coords;
+  }
+};
+
+void TestRectilinearGrid()
+{
+  const dax::Id DIM = 5;
+
+  dax::cont::testing::TestGrid<GridType> gridGen(DIM);
+  GridType grid = gridGen.GetRealGrid();
+
+  std::cout << "Test basic information." << std::endl;
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == (DIM-1)*(DIM-1)*(DIM-1),
+                  "Wrong number of cells.");
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == DIM*DIM*DIM,
+                  "Wrong number of points.");
+  DAX_TEST_ASSERT(grid.GetExtent().Min == dax::make_Id3(0, 0, 0),
+                  "Wrong extent.");
+  DAX_TEST_ASSERT(grid.GetExtent().Max == dax::make_Id3(DIM-1, DIM-1, DIM-1),
+                  "Wrong extent.");
+
+  std::cout << "Test point locations and coordinates." << std::endl;
+  dax::Id index = 0;
+  dax::Id3 ijk;
+  for (ijk[2] = 0; ijk[2] < DIM; ijk[2]++)
+    {
+    for (ijk[1] = 0; ijk[1] < DIM; ijk[1]++)
+      {
+      for (ijk[0] = 0; ijk[0] < DIM; ijk[0]++)
+        {
+        DAX_TEST_ASSERT(grid.ComputePointIndex(ijk) == index,
+                        "Unexpected point index.");
+        DAX_TEST_ASSERT(grid.ComputePointLocation(index) == ijk,
+                        "Unexpected point location.");
+        dax::Vector3 expected = dax::make_Vector3(
+              grid.GetXCoordinates().GetPortalConstControl().Get(ijk[0]),
+              grid.GetYCoordinates().GetPortalConstControl().Get(ijk[1]),
+              grid.GetZCoordinates().GetPortalConstControl().Get(ijk[2]));
+        DAX_TEST_ASSERT(grid.ComputePointCoordinates(index) == expected,
+                        "Unexpected point coordinates.");
+        index++;
+        }
+      }
+    }
+
+  std::cout << "Test point coordinates portal." << std::endl;
+  GridType::PointCoordinatesType coords = grid.GetPointCoordinates();
+  DAX_TEST_ASSERT(coords.GetNumberOfValues() == grid.GetNumberOfPoints(),
+                  "Wrong number of point coordinates.");
+  GridType::PointCoordinatesType::PortalConstControl coordsPortal =
+      coords.GetPortalConstControl();
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(coordsPortal.Get(index)
+                    == grid.ComputePointCoordinates(index),
+                    "Point coordinates seem wrong.");
+    DAX_TEST_ASSERT(coordsPortal.GetFromIJK(grid.ComputePointLocation(index))
+                    == grid.ComputePointCoordinates(index),
+                    "Wrong point coordinates from ijk.");
+    }
+
+  std::cout << "Test copying point coordinates." << std::endl;
+  std::vector<dax::Vector3> copiedCoords(grid.GetNumberOfPoints());
+  coords.CopyInto(copiedCoords.begin());
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(copiedCoords[index] == grid.ComputePointCoordinates(index),
+                    "Copied point coordinates seem wrong.");
+    }
+
+  std::cout << "Test PrepareForInput" << std::endl;
+  GridType::TopologyStructConstExecution topology = grid.PrepareForInput();
+  DAX_TEST_ASSERT(topology.Extent.Min == grid.GetExtent().Min,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.Extent.Max == grid.GetExtent().Max,
+                  "Topology extent wrong.");
+
+  std::cout << "Test running a cell worklet." << std::endl;
+  dax::cont::ArrayHandle<dax::Vector3> centersHandle;
+  dax::cont::DispatcherMapCell<CellCenterWorklet>().Invoke(
+        grid, grid.GetPointCoordinates(), centersHandle);
+  DAX_TEST_ASSERT(centersHandle.GetNumberOfValues() == grid.GetNumberOfCells(),
+                  "Wrong number of cell centers.");
+  for (index = 0; index < grid.GetNumberOfCells(); index++)
+    {
+    dax::Id3 cellLocation = grid.ComputeCellLocation(index);
+    dax::Vector3 expected =
+        0.5f*(grid.ComputePointCoordinates(cellLocation)
+              + grid.ComputePointCoordinates(cellLocation
+                                             + dax::make_Id3(1, 1, 1)));
+    DAX_TEST_ASSERT(test_equal(centersHandle.GetPortalConstControl().Get(index),
+                               expected),
+                    "Wrong cell center.");
+    }
+
+  std::cout << "Test running a field worklet on the points." << std::endl;
+  dax::cont::ArrayHandle<dax::Vector3> copyHandle;
+  dax::cont::DispatcherMapField<CopyCoordinatesWorklet>().Invoke(
+        grid.GetPointCoordinates(), copyHandle);
+  for (index = 0; index < grid.GetNumberOfPoints(); index++)
+    {
+    DAX_TEST_ASSERT(copyHandle.GetPortalConstControl().Get(index)
+                    == grid.ComputePointCoordinates(index),
+                    "Wrong point coordinates from field worklet.");
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestRectilinearGrid(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestRectilinearGrid);
+}
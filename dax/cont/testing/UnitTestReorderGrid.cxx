@@ -0,0 +1,264 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/cont/ReorderGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/UnstructuredGrid.h>
+#include <dax/exec/WorkletMapCell.h>
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 16;
+
+typedef dax::cont::UnstructuredGrid<dax::CellTagHexahedron> GridType;
+typedef dax::cont::ArrayHandle<dax::Scalar> ScalarHandleType;
+typedef dax::cont::ArrayHandle<dax::Id> IdHandleType;
+
+struct CellSumWorklet : public dax::exec::WorkletMapCell
+{
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(
+      const dax::exec::CellField<dax::Scalar,dax::CellTagHexahedron> &values)
+  const
+  {
+    dax::Scalar sum = 0;
+    for (int vertexIndex = 0; vertexIndex < values.NUM_VERTICES; vertexIndex++)
+      {
+      sum += values[vertexIndex];
+      }
+    return sum;
+  }
+};
+
+// A deterministic shuffle so that the test always sees the same mesh.
+void MakeShuffle(std::vector<dax::Id> &shuffle, dax::Id size)
+{
+  shuffle.resize(size);
+  for (dax::Id index = 0; index < size; index++) { shuffle[index] = index; }
+  unsigned int seed = 12345;
+  for (dax::Id index = size - 1; index > 0; index--)
+    {
+    seed = seed*1103515245 + 12345;
+    std::swap(shuffle[index], shuffle[(seed >> 8) % (index + 1)]);
+    }
+}
+
+// Builds a hexahedron grid whose points and cells are numbered randomly, the
+// way a mesher might leave them.
+GridType MakeShuffledGrid()
+{
+  dax::cont::testing::TestGrid<GridType> ordered(DIM);
+  const dax::Id numPoints = ordered->GetNumberOfPoints();
+  const dax::Id numCells = ordered->GetNumberOfCells();
+
+  std::vector<dax::Id> pointShuffle;
+  MakeShuffle(pointShuffle, numPoints);
+  std::vector<dax::Id> cellShuffle;
+  MakeShuffle(cellShuffle, numCells);
+
+  // pointShuffle maps an ordered point index to its shuffled index.
+  std::vector<dax::Vector3> points(numPoints);
+  for (dax::Id index = 0; index < numPoints; index++)
+    {
+    points[pointShuffle[index]] = ordered->ComputePointCoordinates(index);
+    }
+  std::vector<dax::Id> connections(numCells*8);
+  for (dax::Id cellIndex = 0; cellIndex < numCells; cellIndex++)
+    {
+    dax::cont::testing::CellConnections<dax::CellTagHexahedron> vertices =
+        ordered.GetCellConnections(cellShuffle[cellIndex]);
+    for (int vertexIndex = 0; vertexIndex < 8; vertexIndex++)
+      {
+      connections[cellIndex*8 + vertexIndex] =
+          pointShuffle[vertices[vertexIndex]];
+      }
+    }
+
+  // The grid has to own its arrays since the vectors go away.
+  typedef dax::cont::DeviceAdapterAlgorithm<DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+      Algorithm;
+  IdHandleType connectionsHandle;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(connections), connectionsHandle);
+  dax::cont::ArrayHandle<dax::Vector3> pointsHandle;
+  Algorithm::Copy(dax::cont::make_ArrayHandle(points), pointsHandle);
+  return GridType(connectionsHandle, pointsHandle);
+}
+
+void CheckPermutation(const IdHandleType &permutation,
+                      const IdHandleType &inverse,
+                      dax::Id size)
+{
+  DAX_TEST_ASSERT(permutation.GetNumberOfValues() == size,
+                  "Permutation has wrong size.");
+  DAX_TEST_ASSERT(inverse.GetNumberOfValues() == size,
+                  "Inverse permutation has wrong size.");
+  for (dax::Id index = 0; index < size; index++)
+    {
+    const dax::Id value = permutation.GetPortalConstControl().Get(index);
+    DAX_TEST_ASSERT((value >= 0) && (value < size), "Bad permutation value.");
+    DAX_TEST_ASSERT(inverse.GetPortalConstControl().Get(value) == index,
+                    "Inverse permutation does not match.");
+    }
+}
+
+// The average spread of the point indices of a cell. The smaller it is, the
+// closer together the values gathered for a cell are in memory.
+dax::Scalar AverageIndexSpread(const GridType &grid)
+{
+  IdHandleType::PortalConstControl connections =
+      grid.GetCellConnections().GetPortalConstControl();
+  dax::Scalar totalSpread = 0;
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); cellIndex++)
+    {
+    dax::Id minIndex = connections.Get(cellIndex*8);
+    dax::Id maxIndex = minIndex;
+    for (int vertexIndex = 1; vertexIndex < 8; vertexIndex++)
+      {
+      minIndex = std::min(minIndex, connections.Get(cellIndex*8+vertexIndex));
+      maxIndex = std::max(maxIndex, connections.Get(cellIndex*8+vertexIndex));
+      }
+    totalSpread += static_cast<dax::Scalar>(maxIndex - minIndex);
+    }
+  return totalSpread/static_cast<dax::Scalar>(grid.GetNumberOfCells());
+}
+
+template<class CurveTag>
+void TestReorder(const GridType &inGrid, CurveTag)
+{
+  const dax::Id numPoints = inGrid.GetNumberOfPoints();
+  const dax::Id numCells = inGrid.GetNumberOfCells();
+
+  dax::cont::ReorderGrid<CurveTag> reorder;
+  GridType outGrid;
+  reorder.Run(inGrid, outGrid);
+
+  std::cout << "Checking permutations." << std::endl;
+  DAX_TEST_ASSERT(outGrid.GetNumberOfPoints() == numPoints,
+                  "Wrong number of points.");
+  DAX_TEST_ASSERT(outGrid.GetNumberOfCells() == numCells,
+                  "Wrong number of cells.");
+  CheckPermutation(reorder.GetPointPermutation(),
+                   reorder.GetPointInversePermutation(),
+                   numPoints);
+  CheckPermutation(reorder.GetCellPermutation(),
+                   reorder.GetCellInversePermutation(),
+                   numCells);
+
+  std::cout << "Checking cells are unchanged." << std::endl;
+  IdHandleType::PortalConstControl cellPermutation =
+      reorder.GetCellPermutation().GetPortalConstControl();
+  for (dax::Id cellIndex = 0; cellIndex < numCells; cellIndex++)
+    {
+    const dax::Id oldCellIndex = cellPermutation.Get(cellIndex);
+    for (int vertexIndex = 0; vertexIndex < 8; vertexIndex++)
+      {
+      const dax::Id newPoint = outGrid.GetCellConnections()
+          .GetPortalConstControl().Get(cellIndex*8 + vertexIndex);
+      const dax::Id oldPoint = inGrid.GetCellConnections()
+          .GetPortalConstControl().Get(oldCellIndex*8 + vertexIndex);
+      DAX_TEST_ASSERT(outGrid.ComputePointCoordinates(newPoint)
+                      == inGrid.ComputePointCoordinates(oldPoint),
+                      "Reordered cell has different vertices.");
+      }
+    }
+
+  std::cout << "Checking locality." << std::endl;
+  const dax::Scalar inSpread = AverageIndexSpread(inGrid);
+  const dax::Scalar outSpread = AverageIndexSpread(outGrid);
+  std::cout << "  Average index spread " << inSpread << " -> " << outSpread
+            << std::endl;
+  DAX_TEST_ASSERT(outSpread < 0.25f*inSpread,
+                  "Reordering did not bring cell points together.");
+
+  std::cout << "Checking fields map back." << std::endl;
+  std::vector<dax::Scalar> pointField(numPoints);
+  for (dax::Id index = 0; index < numPoints; index++)
+    {
+    pointField[index] = static_cast<dax::Scalar>(index);
+    }
+  ScalarHandleType pointFieldHandle = dax::cont::make_ArrayHandle(pointField);
+  ScalarHandleType reorderedPointField;
+  reorder.ReorderPointField(pointFieldHandle, reorderedPointField);
+  for (dax::Id index = 0; index < numPoints; index++)
+    {
+    DAX_TEST_ASSERT(reorderedPointField.GetPortalConstControl().Get(index)
+                    == static_cast<dax::Scalar>(
+                      reorder.GetPointPermutation()
+                      .GetPortalConstControl().Get(index)),
+                    "Bad reordered point field.");
+    }
+
+  ScalarHandleType expectedSums;
+  dax::cont::DispatcherMapCell<CellSumWorklet>().Invoke(
+        inGrid, pointFieldHandle, expectedSums);
+  ScalarHandleType reorderedSums;
+  dax::cont::DispatcherMapCell<CellSumWorklet>().Invoke(
+        outGrid, reorderedPointField, reorderedSums);
+  ScalarHandleType restoredSums;
+  reorder.RestoreCellField(reorderedSums, restoredSums);
+  for (dax::Id index = 0; index < numCells; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(restoredSums.GetPortalConstControl().Get(index),
+                               expectedSums.GetPortalConstControl().Get(index)),
+                    "Restored cell field does not match.");
+    }
+
+  ScalarHandleType reorderedExpectedSums;
+  reorder.ReorderCellField(expectedSums, reorderedExpectedSums);
+  ScalarHandleType restoredPointField;
+  reorder.RestorePointField(reorderedPointField, restoredPointField);
+  for (dax::Id index = 0; index < numCells; index++)
+    {
+    DAX_TEST_ASSERT(test_equal(
+                      reorderedExpectedSums.GetPortalConstControl().Get(index),
+                      reorderedSums.GetPortalConstControl().Get(index)),
+                    "Reordered cell field does not match.");
+    }
+  for (dax::Id index = 0; index < numPoints; index++)
+    {
+    DAX_TEST_ASSERT(restoredPointField.GetPortalConstControl().Get(index)
+                    == pointField[index],
+                    "Restored point field does not match.");
+    }
+}
+
+void TestReorderGrid()
+{
+  GridType grid = MakeShuffledGrid();
+
+  std::cout << "*** Morton order" << std::endl;
+  TestReorder(grid, dax::exec::internal::SpaceFillingCurveTagMorton());
+
+  std::cout << "*** Hilbert order" << std::endl;
+  TestReorder(grid, dax::exec::internal::SpaceFillingCurveTagHilbert());
+}
+
+} // anonymous namespace
+
+int UnitTestReorderGrid(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestReorderGrid);
+}
@@ -0,0 +1,257 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#define DAX_ARRAY_CONTAINER_CONTROL DAX_ARRAY_CONTAINER_CONTROL_BASIC
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ScatterPlan.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherGenerateKeysValues.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/testing/Testing.h>
+#include <dax/cont/testing/TestingGridGenerator.h>
+
+#include <dax/exec/WorkletGenerateKeysValues.h>
+
+#include <vector>
+
+namespace {
+
+const dax::Id DIM = 4;
+
+struct TestScatterPlanWorklet : public dax::exec::WorkletGenerateKeysValues
+{
+  typedef void ControlSignature(TopologyIn, FieldCellIn, FieldOut);
+  typedef _3 ExecutionSignature(_2, VisitIndex);
+
+  DAX_EXEC_EXPORT
+  dax::Id operator()(dax::Id index, dax::Id visitIndex) const
+  {
+    return 10*index + 1000*visitIndex;
+  }
+};
+
+typedef dax::cont::ScatterPlan<> ScatterPlanType;
+
+void TestBuildPlan()
+{
+  std::cout << "Building plan from counts" << std::endl;
+
+  std::vector<dax::Id> countData(5);
+  countData[0] = 2;
+  countData[1] = 0;
+  countData[2] = 3;
+  countData[3] = 1;
+  countData[4] = 0;
+  dax::cont::ArrayHandle<dax::Id> counts =
+      dax::cont::make_ArrayHandle(countData);
+
+  ScatterPlanType plan(counts);
+  DAX_TEST_ASSERT(plan.IsValid(), "Built plan is not valid.");
+  DAX_TEST_ASSERT(plan.GetNumberOfInputValues() == 5,
+                  "Plan has wrong number of input values.");
+  DAX_TEST_ASSERT(plan.GetNumberOfOutputValues() == 6,
+                  "Plan has wrong number of output values.");
+
+  const dax::Id expectedMap[6] = { 0, 0, 2, 2, 2, 3 };
+  const dax::Id expectedVisit[6] = { 0, 1, 0, 1, 2, 0 };
+
+  std::vector<dax::Id> map(6);
+  plan.GetOutputToInputMap().CopyInto(map.begin());
+  std::vector<dax::Id> visitIndex(6);
+  plan.GetVisitIndex().CopyInto(visitIndex.begin());
+  for (dax::Id index = 0; index < 6; index++)
+    {
+    DAX_TEST_ASSERT(map[index] == expectedMap[index],
+                    "Bad value in output to input map.");
+    DAX_TEST_ASSERT(visitIndex[index] == expectedVisit[index],
+                    "Bad value in visit index.");
+    }
+
+  std::cout << "Copies share state" << std::endl;
+  ScatterPlanType copy = plan;
+  copy.Invalidate();
+  DAX_TEST_ASSERT(!plan.IsValid(), "Invalidating a copy did not invalidate.");
+  DAX_TEST_ASSERT(plan.GetNumberOfOutputValues() == 0,
+                  "Invalid plan has output values.");
+
+  std::cout << "Rebuilding plan" << std::endl;
+  countData[1] = 4;
+  counts = dax::cont::make_ArrayHandle(countData);
+  copy.Build(counts);
+  DAX_TEST_ASSERT(plan.IsValid(), "Rebuilt plan is not valid.");
+  DAX_TEST_ASSERT(plan.GetNumberOfOutputValues() == 10,
+                  "Rebuilt plan has wrong number of output values.");
+  const dax::Id lastVisitIndex =
+      plan.GetVisitIndex().GetPortalConstControl().Get(5);
+  DAX_TEST_ASSERT(lastVisitIndex == 3,
+                  "Visit index not recomputed after rebuild.");
+
+  std::cout << "Empty plan" << std::endl;
+  std::vector<dax::Id> zeroData(3, 0);
+  ScatterPlanType emptyPlan(dax::cont::make_ArrayHandle(zeroData));
+  DAX_TEST_ASSERT(emptyPlan.IsValid(), "Empty plan is not valid.");
+  DAX_TEST_ASSERT(emptyPlan.GetNumberOfOutputValues() == 0,
+                  "Empty plan has output values.");
+}
+
+void TestLargeCounts()
+{
+  std::cout << "Building plan with counts spanning many chunks" << std::endl;
+
+  std::vector<dax::Id> countData(2000);
+  for (std::size_t index = 0; index < countData.size(); index++)
+    {
+    // Mix long runs of empty inputs with inputs generating many values.
+    countData[index] = (index % 97 == 0) ? 1500 + index : (index % 5);
+    if (index > 1000 && index < 1500) { countData[index] = 0; }
+    }
+  ScatterPlanType plan(dax::cont::make_ArrayHandle(countData));
+
+  std::vector<dax::Id> map(plan.GetNumberOfOutputValues());
+  plan.GetOutputToInputMap().CopyInto(map.begin());
+  std::vector<dax::Id> visitIndex(plan.GetNumberOfOutputValues());
+  plan.GetVisitIndex().CopyInto(visitIndex.begin());
+
+  std::size_t outIndex = 0;
+  for (std::size_t input = 0; input < countData.size(); input++)
+    {
+    for (dax::Id visit = 0; visit < countData[input]; visit++)
+      {
+      DAX_TEST_ASSERT(outIndex < map.size(), "Plan has too few outputs.");
+      DAX_TEST_ASSERT(map[outIndex] == static_cast<dax::Id>(input),
+                      "Bad value in output to input map.");
+      DAX_TEST_ASSERT(visitIndex[outIndex] == visit,
+                      "Bad value in visit index.");
+      outIndex++;
+      }
+    }
+  DAX_TEST_ASSERT(outIndex == map.size(), "Plan has too many outputs.");
+}
+
+void TestConstantPlan()
+{
+  std::cout << "Constant plan" << std::endl;
+
+  dax::cont::ScatterPlanConstant<> plan(3, 4);
+  DAX_TEST_ASSERT(plan.GetNumberOfOutputValues() == 12,
+                  "Constant plan has wrong number of output values.");
+
+  std::vector<dax::Id> map(12);
+  plan.GetOutputToInputMap().CopyInto(map.begin());
+  std::vector<dax::Id> visitIndex(12);
+  plan.GetVisitIndex().CopyInto(visitIndex.begin());
+  for (dax::Id index = 0; index < 12; index++)
+    {
+    DAX_TEST_ASSERT(map[index] == index/3,
+                    "Bad value in constant output to input map.");
+    DAX_TEST_ASSERT(visitIndex[index] == index%3,
+                    "Bad value in constant visit index.");
+    }
+
+  typedef dax::cont::internal::IsConstantScatterCount<
+      dax::cont::ArrayHandleConstant<dax::Id> > ConstantCountCheck;
+  typedef dax::cont::internal::IsConstantScatterCount<
+      dax::cont::ArrayHandle<dax::Id> > BasicCountCheck;
+  DAX_TEST_ASSERT(ConstantCountCheck::value,
+                  "Constant count array not recognized.");
+  DAX_TEST_ASSERT(!BasicCountCheck::value,
+                  "Basic count array taken for constant.");
+}
+
+template<class PortalType>
+void CheckOutput(const PortalType &outValues, const std::vector<dax::Id> &counts)
+{
+  dax::Id outIndex = 0;
+  for (std::size_t cellIndex = 0; cellIndex < counts.size(); cellIndex++)
+    {
+    for (dax::Id visit = 0; visit < counts[cellIndex]; visit++)
+      {
+      dax::Id expectedValue = 10*(cellIndex+1) + 1000*visit;
+      DAX_TEST_ASSERT(outValues.Get(outIndex) == expectedValue,
+                      "Got bad value from dispatch with shared plan.");
+      outIndex++;
+      }
+    }
+  DAX_TEST_ASSERT(outValues.GetNumberOfValues() == outIndex,
+                  "Wrong number of output values.");
+}
+
+void TestSharePlan()
+{
+  typedef dax::cont::UniformGrid<> GridType;
+  dax::cont::testing::TestGrid<GridType> inGenerator(DIM);
+  GridType inGrid = inGenerator.GetRealGrid();
+  const dax::Id numCells = inGrid.GetNumberOfCells();
+
+  std::vector<dax::Id> countData(numCells);
+  std::vector<dax::Id> cellFieldData(numCells);
+  for (dax::Id cellIndex = 0; cellIndex < numCells; cellIndex++)
+    {
+    countData[cellIndex] = cellIndex % 3;
+    cellFieldData[cellIndex] = cellIndex + 1;
+    }
+  dax::cont::ArrayHandle<dax::Id> counts =
+      dax::cont::make_ArrayHandle(countData);
+  dax::cont::ArrayHandle<dax::Id> cellField =
+      dax::cont::make_ArrayHandle(cellFieldData);
+
+  typedef dax::cont::DispatcherGenerateKeysValues<TestScatterPlanWorklet>
+      DispatcherType;
+
+  std::cout << "Dispatch builds an invalid plan it is given" << std::endl;
+  ScatterPlanType plan;
+  DispatcherType first(counts);
+  first.SetReleaseOutputCountArray(false);
+  first.SetScatterPlan(plan);
+  dax::cont::ArrayHandle<dax::Id> firstOut;
+  first.Invoke(inGrid, cellField, firstOut);
+  DAX_TEST_ASSERT(plan.IsValid(), "Dispatcher did not build shared plan.");
+  CheckOutput(firstOut.GetPortalConstControl(), countData);
+
+  std::cout << "Second dispatch reuses the plan" << std::endl;
+  // The counts are not looked at when the plan is valid, so give the second
+  // dispatcher nonsense counts to make sure the plan is what gets used.
+  std::vector<dax::Id> wrongCountData(numCells, 1);
+  DispatcherType second(dax::cont::make_ArrayHandle(wrongCountData));
+  second.SetScatterPlan(first.GetScatterPlan());
+  dax::cont::ArrayHandle<dax::Id> secondOut;
+  second.Invoke(inGrid, cellField, secondOut);
+  CheckOutput(secondOut.GetPortalConstControl(), countData);
+
+  std::cout << "Dispatch without a plan builds its own" << std::endl;
+  DispatcherType third(dax::cont::make_ArrayHandle(wrongCountData));
+  dax::cont::ArrayHandle<dax::Id> thirdOut;
+  third.Invoke(inGrid, cellField, thirdOut);
+  CheckOutput(thirdOut.GetPortalConstControl(), wrongCountData);
+  DAX_TEST_ASSERT(third.GetScatterPlan().GetNumberOfOutputValues() == numCells,
+                  "Dispatcher does not report the plan it built.");
+}
+
+void TestScatterPlan()
+{
+  TestBuildPlan();
+  TestLargeCounts();
+  TestConstantPlan();
+  TestSharePlan();
+}
+
+} // Anonymous namespace
+
+int UnitTestScatterPlan(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestScatterPlan);
+}
@@ -0,0 +1,137 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/cont/StructuredGrid.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/exec/WorkletMapCell.h>
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+namespace {
+
+typedef dax::cont::StructuredGrid<> GridType;
+
+struct CellCenterWorklet : public dax::exec::WorkletMapCell
+{
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(
+      const dax::exec::CellField<dax::Vector3,dax::CellTagHexahedron> &coords)
+  const
+  {
+    dax::Vector3 sum = dax::make_Vector3(0.0, 0.0, 0.0);
+    for (int vertexIndex = 0; vertexIndex < coords.NUM_VERTICES; vertexIndex++)
+      {
+      sum = sum + coords[vertexIndex];
+      }
+    return (dax::Scalar(1)/dax::Scalar(coords.NUM_VERTICES))*sum;
+  }
+};
+
+void TestStructuredGrid()
+{
+  const dax::Id DIM = 5;
+
+  dax::cont::testing::TestGrid<GridType> gridGen(DIM);
+  GridType grid = gridGen.GetRealGrid();
+
+  std::cout << "Test basic information." << std::endl;
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == (DIM-1)*(DIM-1)*(DIM-1),
+                  "Wrong number of cells.");
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == DIM*DIM*DIM,
+                  "Wrong number of points.");
+  DAX_TEST_ASSERT(grid.GetPointCoordinates().GetNumberOfValues()
+                  == grid.GetNumberOfPoints(),
+                  "Wrong number of point coordinates.");
+
+  std::cout << "Test point locations and coordinates." << std::endl;
+  GridType::PointCoordinatesType::PortalConstControl coordsPortal =
+      grid.GetPointCoordinates().GetPortalConstControl();
+  dax::Id index = 0;
+  dax::Id3 ijk;
+  for (ijk[2] = 0; ijk[2] < DIM; ijk[2]++)
+    {
+    for (ijk[1] = 0; ijk[1] < DIM; ijk[1]++)
+      {
+      for (ijk[0] = 0; ijk[0] < DIM; ijk[0]++)
+        {
+        DAX_TEST_ASSERT(grid.ComputePointIndex(ijk) == index,
+                        "Unexpected point index.");
+        DAX_TEST_ASSERT(grid.ComputePointLocation(index) == ijk,
+                        "Unexpected point location.");
+        DAX_TEST_ASSERT(grid.ComputePointCoordinates(ijk)
+                        == coordsPortal.Get(index),
+                        "Unexpected point coordinates.");
+        index++;
+        }
+      }
+    }
+
+  std::cout << "Test PrepareForInput" << std::endl;
+  GridType::TopologyStructConstExecution topology = grid.PrepareForInput();
+  DAX_TEST_ASSERT(topology.Extent.Min == grid.GetExtent().Min,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.Extent.Max == grid.GetExtent().Max,
+                  "Topology extent wrong.");
+  DAX_TEST_ASSERT(topology.GetNumberOfCells() == grid.GetNumberOfCells(),
+                  "Topology has wrong number of cells.");
+  for (index = 0; index < grid.GetNumberOfCells(); index++)
+    {
+    dax::exec::CellVertices<dax::CellTagHexahedron> connections =
+        topology.GetCellConnections(index);
+    dax::cont::testing::CellConnections<dax::CellTagHexahedron> expected =
+        gridGen.GetCellConnections(index);
+    for (int vertexIndex = 0;
+         vertexIndex < connections.NUM_VERTICES;
+         vertexIndex++)
+      {
+      DAX_TEST_ASSERT(connections[vertexIndex] == expected[vertexIndex],
+                      "Wrong cell connections.");
+      }
+    }
+
+  std::cout << "Test running a cell worklet." << std::endl;
+  dax::cont::ArrayHandle<dax::Vector3> centersHandle;
+  dax::cont::DispatcherMapCell<CellCenterWorklet>().Invoke(
+        grid, grid.GetPointCoordinates(), centersHandle);
+  DAX_TEST_ASSERT(centersHandle.GetNumberOfValues() == grid.GetNumberOfCells(),
+                  "Wrong number of cell centers.");
+  for (index = 0; index < grid.GetNumberOfCells(); index++)
+    {
+    dax::cont::testing::CellCoordinates<dax::CellTagHexahedron> coords =
+        gridGen.GetCellVertexCoordinates(index);
+    dax::Vector3 expected = dax::make_Vector3(0.0, 0.0, 0.0);
+    for (int vertexIndex = 0; vertexIndex < coords.NUM_VERTICES; vertexIndex++)
+      {
+      expected = expected + coords[vertexIndex];
+      }
+    expected = (dax::Scalar(1)/dax::Scalar(coords.NUM_VERTICES))*expected;
+    DAX_TEST_ASSERT(test_equal(centersHandle.GetPortalConstControl().Get(index),
+                               expected),
+                    "Wrong cell center.");
+    }
+}
+
+} // anonymous namespace
+
+int UnitTestStructuredGrid(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestStructuredGrid);
+}
@@ -82,6 +82,66 @@ void TestUniformGrid()
                     "Point coordinates seem wrong.");
     }
 
+  std::cout << "Test point coordinates with offset extent." << std::endl;
+  dax::cont::UniformGrid<> offsetGrid;
+  offsetGrid.SetExtent(dax::make_Id3(-2, 3, 1), dax::make_Id3(4, 5, 7));
+  offsetGrid.SetOrigin(dax::make_Vector3(0.5, -1.0, 2.0));
+  offsetGrid.SetSpacing(dax::make_Vector3(0.25, 2.0, 1.5));
+  dax::cont::UniformGrid<>::PointCoordinatesType::PortalConstControl
+      offsetPortal = offsetGrid.GetPointCoordinates().GetPortalConstControl();
+  const dax::Id numOffsetPoints = offsetGrid.GetNumberOfPoints();
+  DAX_TEST_ASSERT(offsetPortal.GetNumberOfValues() == numOffsetPoints,
+                  "Wrong number of point coordinates.");
+  for (index = 0; index < numOffsetPoints; index++)
+    {
+    DAX_TEST_ASSERT(offsetPortal.ComputeLocation(index)
+                    == dax::flatIndexToIndex3(index, offsetGrid.GetExtent()),
+                    "Unexpected point coordinate location.");
+    DAX_TEST_ASSERT(offsetPortal.Get(index)
+                    == offsetGrid.ComputePointCoordinates(index),
+                    "Point coordinates seem wrong.");
+    }
+
+  std::cout << "Test point coordinates iterator." << std::endl;
+  typedef dax::cont::UniformGrid<>::PointCoordinatesType::PortalConstControl
+      ::IteratorType IteratorType;
+  index = 0;
+  for (IteratorType iter = offsetPortal.GetIteratorBegin();
+       iter != offsetPortal.GetIteratorEnd();
+       iter++)
+    {
+    DAX_TEST_ASSERT(*iter == offsetGrid.ComputePointCoordinates(index),
+                    "Iterator gave wrong point coordinates.");
+    index++;
+    }
+  DAX_TEST_ASSERT(index == numOffsetPoints, "Iterator visited wrong count.");
+  IteratorType iter = offsetPortal.GetIteratorEnd();
+  for (index = numOffsetPoints-1; index >= 0; index--)
+    {
+    --iter;
+    DAX_TEST_ASSERT(*iter == offsetGrid.ComputePointCoordinates(index),
+                    "Reverse iterator gave wrong point coordinates.");
+    }
+  for (index = 0; index < numOffsetPoints; index += 13)
+    {
+    DAX_TEST_ASSERT(offsetPortal.GetIteratorBegin()[index]
+                    == offsetGrid.ComputePointCoordinates(index),
+                    "Random access iterator gave wrong point coordinates.");
+    }
+
+  std::cout << "Test point coordinates from ijk." << std::endl;
+  DAX_TEST_ASSERT(offsetPortal.GetIJKDimensions()
+                  == dax::extentDimensions(offsetGrid.GetExtent()),
+                  "Wrong ijk dimensions.");
+  for (index = 0; index < numOffsetPoints; index++)
+    {
+    dax::Id3 location = offsetGrid.ComputePointLocation(index);
+    DAX_TEST_ASSERT(offsetPortal.GetFromIJK(location
+                                            - offsetGrid.GetExtent().Min)
+                    == offsetGrid.ComputePointCoordinates(index),
+                    "Wrong point coordinates from ijk.");
+    }
+
   std::cout << "Test PrepareForInput" << std::endl;
   dax::cont::UniformGrid<>::TopologyStructConstExecution topology =
       grid.PrepareForInput();
@@ -93,6 +153,36 @@ void TestUniformGrid()
                   "Topology extent wrong.");
   DAX_TEST_ASSERT(topology.Extent.Max == grid.GetExtent().Max,
                   "Topology extent wrong.");
+
+  std::cout << "Test reverse connectivity" << std::endl;
+  dax::cont::UniformGrid<>::PointCellsStructConstExecution pointCells =
+      grid.PreparePointCellsForInput();
+  dax::Id numIncidences = 0;
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::exec::internal::TopologyUniform::PointCellsType cells =
+        pointCells.GetPointCells(pointIndex);
+    for (dax::Id cellIndex = 0;
+         cellIndex < cells.GetNumberOfCells();
+         cellIndex++)
+      {
+      dax::exec::CellVertices<dax::CellTagVoxel> vertices =
+          topology.GetCellConnections(cells[cellIndex]);
+      bool found = false;
+      for (int vertexIndex = 0;
+           vertexIndex < vertices.NUM_VERTICES;
+           vertexIndex++)
+        {
+        found |= (vertices[vertexIndex] == pointIndex);
+        }
+      DAX_TEST_ASSERT(found, "Point listed with a cell that does not use it.");
+      }
+    numIncidences += cells.GetNumberOfCells();
+    }
+  DAX_TEST_ASSERT(numIncidences == 8*grid.GetNumberOfCells(),
+                  "Cells missing from reverse connectivity.");
 }
 
 } // anonymous namespace
@@ -56,6 +56,62 @@ void TestUnstructuredGrid()
     DAX_TEST_ASSERT(connections.Get(index)==topology.CellConnections.Get(index),
                     "Bad connection.");
     }
+
+  std::cout << "Test reverse connectivity." << std::endl;
+  const GridType &constGrid = grid;
+  GridType::PointCellsArrayType::PortalConstControl offsets
+      = constGrid.GetPointCellOffsets().GetPortalConstControl();
+  GridType::PointCellsArrayType::PortalConstControl cellIds
+      = constGrid.GetPointCellIds().GetPortalConstControl();
+  const int NUM_VERTICES =
+      dax::CellTraits<dax::CellTagHexahedron>::NUM_VERTICES;
+  DAX_TEST_ASSERT(offsets.GetNumberOfValues() == grid.GetNumberOfPoints()+1,
+                  "Wrong number of point cell offsets.");
+  DAX_TEST_ASSERT(offsets.Get(grid.GetNumberOfPoints())
+                  == connections.GetNumberOfValues(),
+                  "Wrong number of point cell ids.");
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    for (dax::Id index = offsets.Get(pointIndex);
+         index < offsets.Get(pointIndex+1);
+         index++)
+      {
+      const dax::Id cellIndex = cellIds.Get(index);
+      bool found = false;
+      for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+        {
+        found |= (connections.Get(cellIndex*NUM_VERTICES + vertexIndex)
+                  == pointIndex);
+        }
+      DAX_TEST_ASSERT(found, "Point listed with a cell that does not use it.");
+      }
+    }
+
+  GridType::PointCellsStructConstExecution pointCells =
+      grid.PreparePointCellsForInput();
+  DAX_TEST_ASSERT(pointCells.GetPointCells(0).GetNumberOfCells() == 1,
+                  "Corner point should be in one cell.");
+  DAX_TEST_ASSERT(pointCells.GetPointCells(DIM*DIM+DIM+1).GetNumberOfCells()
+                  == 8,
+                  "Interior point should be in eight cells.");
+
+  std::cout << "Test reverse connectivity after new connections." << std::endl;
+  // Writing the connections through a copy of the grid changes the arrays
+  // of both, so neither may keep its reverse connectivity.
+  GridType gridCopy = grid;
+  GridType::TopologyStructExecution newTopology = gridCopy.PrepareForOutput(1);
+  for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+    {
+    newTopology.CellConnections.Set(vertexIndex, vertexIndex);
+    }
+  DAX_TEST_ASSERT(constGrid.GetPointCellOffsets().GetPortalConstControl()
+                  .Get(grid.GetNumberOfPoints()) == NUM_VERTICES,
+                  "Reverse connectivity not rebuilt for new connections.");
+  DAX_TEST_ASSERT(grid.PreparePointCellsForInput()
+                  .GetPointCells(DIM*DIM+DIM+1).GetNumberOfCells() == 0,
+                  "Point no longer used is still listed with cells.");
 }
 
 } // anonymous namespace
@@ -0,0 +1,212 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/UnstructuredGridMixed.h>
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/exec/CellField.h>
+#include <dax/exec/WorkletMapCell.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+// Sum of the point values of the cell, plus 100 times the cell value.
+struct SumCellWorklet : public dax::exec::WorkletMapCell
+{
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldCellIn,
+                                FieldOut);
+  typedef _4 ExecutionSignature(_2,_3);
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  dax::Scalar operator()(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                         dax::Scalar cellValue) const
+  {
+    dax::Scalar sum = 100*cellValue;
+    for (int vertexIndex = 0; vertexIndex < values.NUM_VERTICES; vertexIndex++)
+      {
+      sum += values[vertexIndex];
+      }
+    return sum;
+  }
+};
+
+typedef dax::cont::UnstructuredGridMixed<> GridType;
+
+const dax::Id NUM_POINTS = 12;
+const dax::Id NUM_CELLS = 5;
+
+// A hexahedron, a wedge, a tetrahedron, a triangle, and another hexahedron.
+const dax::Id CELL_SHAPES[NUM_CELLS] = { 12, 13, 10, 5, 12 };
+const dax::Id CELL_OFFSETS[NUM_CELLS] = { 0, 8, 14, 18, 21 };
+const dax::Id CELL_CONNECTIONS[] = {
+  0, 1, 2, 3, 4, 5, 6, 7,
+  4, 5, 8, 7, 6, 9,
+  8, 9, 10, 11,
+  1, 10, 3,
+  11, 10, 9, 8, 7, 6, 5, 4
+};
+const dax::Id NUM_CONNECTIONS = 29;
+
+GridType MakeGrid(const dax::Id *shapes)
+{
+  std::vector<dax::Vector3> points(NUM_POINTS);
+  for (dax::Id pointIndex = 0; pointIndex < NUM_POINTS; pointIndex++)
+    {
+    points[pointIndex] = dax::make_Vector3(pointIndex, 2*pointIndex, 0);
+    }
+  return GridType(dax::cont::make_ArrayHandle(shapes, NUM_CELLS),
+                  dax::cont::make_ArrayHandle(CELL_OFFSETS, NUM_CELLS),
+                  dax::cont::make_ArrayHandle(CELL_CONNECTIONS,
+                                              NUM_CONNECTIONS),
+                  dax::cont::make_ArrayHandle(points));
+}
+
+template<class CellTag>
+void CheckCellsOfShape(const GridType &grid,
+                       const dax::Id *expectedCellIds,
+                       dax::Id numExpected)
+{
+  const int NUM_VERTICES = dax::CellTraits<CellTag>::NUM_VERTICES;
+  DAX_TEST_ASSERT(grid.GetNumberOfCellsOfShape(CellTag()) == numExpected,
+                  "Wrong number of cells of a type.");
+
+  GridType::CellIdsType::PortalConstControl cellIds =
+      grid.GetCellIdsOfShape(CellTag()).GetPortalConstControl();
+  typename GridType::CellsOfShape<CellTag>::type cells =
+      grid.GetCellsOfShape(CellTag());
+  DAX_TEST_ASSERT(cells.GetNumberOfCells() == numExpected,
+                  "Wrong number of cells in grid of a type.");
+  DAX_TEST_ASSERT(cells.GetNumberOfPoints() == NUM_POINTS,
+                  "Grid of a type has the wrong points.");
+  typename GridType::CellsOfShape<CellTag>::type::CellConnectionsType::
+      PortalConstControl connections =
+      cells.GetCellConnections().GetPortalConstControl();
+
+  for (dax::Id index = 0; index < numExpected; index++)
+    {
+    DAX_TEST_ASSERT(cellIds.Get(index) == expectedCellIds[index],
+                    "Wrong cell in group.");
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; vertexIndex++)
+      {
+      DAX_TEST_ASSERT(
+            connections.Get(index*NUM_VERTICES + vertexIndex)
+            == CELL_CONNECTIONS[CELL_OFFSETS[expectedCellIds[index]]
+                                + vertexIndex],
+            "Wrong connections in grid of a type.");
+      }
+    }
+}
+
+void TestCellsOfShape()
+{
+  std::cout << "Test grouping cells by type." << std::endl;
+  GridType grid = MakeGrid(CELL_SHAPES);
+  DAX_TEST_ASSERT(grid.GetNumberOfCells() == NUM_CELLS,
+                  "Wrong number of cells.");
+  DAX_TEST_ASSERT(grid.GetNumberOfPoints() == NUM_POINTS,
+                  "Wrong number of points.");
+
+  const dax::Id hexahedra[] = { 0, 4 };
+  const dax::Id wedges[] = { 1 };
+  const dax::Id tetrahedra[] = { 2 };
+  const dax::Id triangles[] = { 3 };
+  CheckCellsOfShape<dax::CellTagHexahedron>(grid, hexahedra, 2);
+  CheckCellsOfShape<dax::CellTagWedge>(grid, wedges, 1);
+  CheckCellsOfShape<dax::CellTagTetrahedron>(grid, tetrahedra, 1);
+  CheckCellsOfShape<dax::CellTagTriangle>(grid, triangles, 1);
+  CheckCellsOfShape<dax::CellTagQuadrilateral>(grid, NULL, 0);
+}
+
+void TestDispatch()
+{
+  std::cout << "Test running a worklet on all cell types." << std::endl;
+  GridType grid = MakeGrid(CELL_SHAPES);
+
+  std::vector<dax::Scalar> pointField(NUM_POINTS);
+  for (dax::Id pointIndex = 0; pointIndex < NUM_POINTS; pointIndex++)
+    {
+    pointField[pointIndex] = pointIndex + 1;
+    }
+  std::vector<dax::Scalar> cellField(NUM_CELLS);
+  for (dax::Id cellIndex = 0; cellIndex < NUM_CELLS; cellIndex++)
+    {
+    cellField[cellIndex] = cellIndex;
+    }
+
+  dax::cont::ArrayHandle<dax::Scalar> resultHandle;
+  dax::cont::DispatcherMapCell<SumCellWorklet>().Invoke(
+        grid,
+        dax::cont::make_ArrayHandle(pointField),
+        dax::cont::make_ArrayHandle(cellField),
+        resultHandle);
+
+  DAX_TEST_ASSERT(resultHandle.GetNumberOfValues() == NUM_CELLS,
+                  "Wrong number of results.");
+  std::vector<dax::Scalar> result(NUM_CELLS);
+  resultHandle.CopyInto(result.begin());
+
+  for (dax::Id cellIndex = 0; cellIndex < NUM_CELLS; cellIndex++)
+    {
+    const dax::Id end = (cellIndex+1 < NUM_CELLS)
+        ? CELL_OFFSETS[cellIndex+1] : NUM_CONNECTIONS;
+    dax::Scalar expected = 100*cellField[cellIndex];
+    for (dax::Id index = CELL_OFFSETS[cellIndex]; index < end; index++)
+      {
+      expected += pointField[CELL_CONNECTIONS[index]];
+      }
+    DAX_TEST_ASSERT(test_equal(result[cellIndex], expected),
+                    "Bad value computed for a cell.");
+    }
+}
+
+void TestUnsupportedShape()
+{
+  std::cout << "Test cell type that cannot be in a mixed grid." << std::endl;
+  const dax::Id badShapes[NUM_CELLS] = { 12, 13, 42, 5, 12 };
+  GridType grid = MakeGrid(badShapes);
+  try
+    {
+    grid.GetNumberOfCellsOfShape(dax::CellTagHexahedron());
+    DAX_TEST_FAIL("Did not get an error for an unsupported cell type.");
+    }
+  catch (dax::cont::ErrorControlBadValue &error)
+    {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    }
+}
+
+void TestUnstructuredGridMixed()
+{
+  TestCellsOfShape();
+  TestDispatch();
+  TestUnsupportedShape();
+}
+
+} // anonymous namespace
+
+int UnitTestUnstructuredGridMixed(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestUnstructuredGridMixed);
+}
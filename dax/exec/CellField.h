@@ -57,6 +57,13 @@ public:
   CellField(const CellField &src)
     : Values(src.Values) {  }
 
+  DAX_EXEC_CONT_EXPORT
+  CellField &operator=(const CellField &src)
+  {
+    this->Values = src.Values;
+    return *this;
+  }
+
   DAX_EXEC_EXPORT
   const FieldType &operator[](int vertexIndex) const {
     return this->Values[vertexIndex];
@@ -16,20 +16,72 @@
 #ifndef __dax_exec_InterpolatedCellPoints_h
 #define __dax_exec_InterpolatedCellPoints_h
 
+#include <dax/Types.h>
 #include <dax/exec/CellField.h>
 
 namespace dax {
 namespace exec {
 
+/// \brief A point of an interpolated cell.
+///
+/// The point lies on the line from input point \c Point1 to input point \c
+/// Point2, \c Weight of the way from the first to the second. A record of a
+/// point to itself is that input point. The ids are kept as integers so that
+/// they are exact for any number of points.
+///
+struct InterpolationRecord
+{
+  dax::Id Point1;
+  dax::Id Point2;
+  dax::Scalar Weight;
+
+  DAX_EXEC_CONT_EXPORT
+  InterpolationRecord() : Point1(0), Point2(0), Weight(0) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  InterpolationRecord(dax::Id point1, dax::Id point2, dax::Scalar weight)
+    : Point1(point1), Point2(point2), Weight(weight) {  }
+};
+
+namespace internal {
+
+/// Key identifying the edge an interpolation record lies on, independent of
+/// the order of its two points. With 32 bit ids both points are packed into
+/// a single 64 bit integer.
+///
+#if DAX_SIZE_ID == 4
+typedef dax::internal::UInt64Type InterpolationEdgeKey;
+
+DAX_EXEC_CONT_EXPORT
+InterpolationEdgeKey MakeInterpolationEdgeKey(dax::Id low, dax::Id high)
+{
+  return (static_cast<InterpolationEdgeKey>(
+            static_cast<dax::internal::UInt32Type>(low)) << 32)
+      | static_cast<dax::internal::UInt32Type>(high);
+}
+#else
+typedef dax::Id2 InterpolationEdgeKey;
+
+DAX_EXEC_CONT_EXPORT
+InterpolationEdgeKey MakeInterpolationEdgeKey(dax::Id low, dax::Id high)
+{
+  return InterpolationEdgeKey(low, high);
+}
+#endif
+
+} // namespace internal
+
 /// \brief Holds the point indices for a cell of a particular type.
 ///
 /// This class is really is a convienience wrapper around a dax::Tuple.
 ///
 template<class CellTag>
-class InterpolatedCellPoints : public dax::exec::CellField<dax::Vector3, CellTag>
+class InterpolatedCellPoints
+    : public dax::exec::CellField<dax::exec::InterpolationRecord, CellTag>
 {
 private:
-  typedef dax::exec::CellField<dax::Vector3, CellTag> Superclass;
+  typedef dax::exec::CellField<dax::exec::InterpolationRecord, CellTag>
+      Superclass;
 public:
   const static int NUM_VERTICES = Superclass::NUM_VERTICES;
   typedef typename Superclass::TupleType TupleType;
@@ -41,7 +93,8 @@ public:
   InterpolatedCellPoints(const TupleType &pointIndices) : Superclass(pointIndices) {  }
 
   DAX_CONT_EXPORT
-  InterpolatedCellPoints(dax::Vector3 value) : Superclass(value) {  }
+  InterpolatedCellPoints(const dax::exec::InterpolationRecord &value)
+    : Superclass(value) {  }
 
   // Although this copy constructor should be identical to the default copy
   // constructor, we have noticed that NVCC's default copy constructor can
@@ -54,10 +107,47 @@ public:
   void SetInterpolationPoint( dax::Id index, dax::Id pos1, dax::Id pos2,
                               dax::Scalar weight )
     {
-    (*this)[index]=dax::Vector3( pos1, pos2, weight);
+    (*this)[index]=dax::exec::InterpolationRecord(pos1, pos2, weight);
     }
 };
 
+/// \brief Holds all the interpolated cells generated from one input cell.
+///
+/// Worklets deriving from dax::exec::WorkletInterpolatedCellSet are given
+/// one of these in place of a single InterpolatedCellPoints and add each
+/// cell they generate, up to \c MaxCells of them.
+///
+template<class CellTag, int MaxCells>
+class InterpolatedCellSet
+{
+public:
+  typedef dax::exec::InterpolatedCellPoints<CellTag> CellType;
+  const static int NUM_VERTICES = CellType::NUM_VERTICES;
+  const static int MAX_CELLS = MaxCells;
+
+  DAX_EXEC_CONT_EXPORT
+  InterpolatedCellSet() : NumberOfCells(0) {  }
+
+  /// Adds a cell to the set and returns it to have its points set. No more
+  /// than \c MAX_CELLS cells can be added.
+  ///
+  DAX_EXEC_EXPORT
+  CellType &AddCell()
+    {
+    return this->Cells[this->NumberOfCells++];
+    }
+
+  DAX_EXEC_CONT_EXPORT
+  int GetNumberOfCells() const { return this->NumberOfCells; }
+
+  DAX_EXEC_CONT_EXPORT
+  const CellType &operator[](int index) const { return this->Cells[index]; }
+
+private:
+  CellType Cells[MaxCells];
+  int NumberOfCells;
+};
+
 }
 } // namespace dax::exec
 
@@ -70,7 +160,7 @@ template<class CellTag>
 struct VectorTraits<dax::exec::InterpolatedCellPoints<CellTag> >
 {
   typedef dax::exec::InterpolatedCellPoints<CellTag> InterpolatedCellPointsType;
-  typedef dax::Id ComponentType;
+  typedef dax::exec::InterpolationRecord ComponentType;
   static const int NUM_COMPONENTS = InterpolatedCellPointsType::NUM_VERTICES;
   typedef typename internal::VectorTraitsMultipleComponentChooser<
       NUM_COMPONENTS>::Type HasMultipleComponents;
@@ -0,0 +1,124 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_Neighborhood_h
+#define __dax_exec_Neighborhood_h
+
+#include <dax/Types.h>
+
+namespace dax {
+namespace exec {
+
+/// \brief Holds the field values of the points around a point of a
+/// structured grid.
+///
+/// The values cover the points offset by -\c Radius to \c Radius in each of
+/// the i, j, and k directions. Offsets that fall off the grid are clamped to
+/// its boundary, so the value at such an offset is that of the nearest point
+/// on the grid. Use ClampOffset to find out which offset was actually sampled
+/// (for example, to turn a central difference into a one-sided one).
+///
+template<typename FieldType, int Radius>
+class Neighborhood
+{
+public:
+  const static int RADIUS = Radius;
+  const static int WIDTH = 2*Radius + 1;
+  const static int NUM_VALUES = WIDTH*WIDTH*WIDTH;
+  typedef dax::Tuple<FieldType, NUM_VALUES> TupleType;
+
+  DAX_EXEC_CONT_EXPORT
+  Neighborhood() {  }
+
+  DAX_EXEC_CONT_EXPORT
+  Neighborhood(const TupleType &values,
+               const dax::Id3 &ijk,
+               const dax::Id3 &dimensions)
+    : Values(values), IJK(ijk), Dimensions(dimensions) {  }
+
+  /// Returns the value of the point offset by (\c di, \c dj, \c dk) from the
+  /// center. Each offset must be in [-\c Radius, \c Radius].
+  ///
+  DAX_EXEC_EXPORT
+  const FieldType &Get(int di, int dj, int dk) const {
+    return this->Values[Neighborhood::GetValueIndex(di, dj, dk)];
+  }
+
+  DAX_EXEC_EXPORT
+  FieldType &Get(int di, int dj, int dk) {
+    return this->Values[Neighborhood::GetValueIndex(di, dj, dk)];
+  }
+
+  /// Returns the value of the center point.
+  ///
+  DAX_EXEC_EXPORT
+  const FieldType &GetCenter() const { return this->Get(0, 0, 0); }
+
+  /// Returns the offset along \c dimension that is actually sampled for the
+  /// requested \c offset once it is clamped to the grid.
+  ///
+  DAX_EXEC_EXPORT
+  int ClampOffset(int dimension, int offset) const {
+    const dax::Id index = this->IJK[dimension] + offset;
+    if (index < 0) { return static_cast<int>(-this->IJK[dimension]); }
+    if (index >= this->Dimensions[dimension])
+      {
+      return static_cast<int>(this->Dimensions[dimension] - 1
+                              - this->IJK[dimension]);
+      }
+    return offset;
+  }
+
+  /// Returns the i, j, k index of the center point.
+  ///
+  DAX_EXEC_EXPORT
+  const dax::Id3 &GetIJK() const { return this->IJK; }
+
+  /// Returns the number of points of the grid in each direction.
+  ///
+  DAX_EXEC_EXPORT
+  const dax::Id3 &GetDimensions() const { return this->Dimensions; }
+
+  DAX_EXEC_EXPORT
+  const TupleType &GetAsTuple() const { return this->Values; }
+
+  DAX_EXEC_EXPORT
+  TupleType &GetAsTuple() { return this->Values; }
+
+  DAX_EXEC_EXPORT
+  void SetCenter(const dax::Id3 &ijk, const dax::Id3 &dimensions)
+  {
+    this->IJK = ijk;
+    this->Dimensions = dimensions;
+  }
+
+  /// Returns the position in the tuple of the value at the given offset.
+  /// Values are ordered with i varying fastest, like the points of a grid.
+  ///
+  DAX_EXEC_EXPORT
+  static int GetValueIndex(int di, int dj, int dk) {
+    return (di + Radius) + WIDTH*((dj + Radius) + WIDTH*(dk + Radius));
+  }
+
+private:
+  TupleType Values;
+  dax::Id3 IJK;
+  dax::Id3 Dimensions;
+};
+
+}
+} // namespace dax::exec
+
+#endif //__dax_exec_Neighborhood_h
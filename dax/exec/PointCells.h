@@ -0,0 +1,104 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_PointCells_h
+#define __dax_exec_PointCells_h
+
+#include <dax/Types.h>
+#include <dax/exec/Assert.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax {
+namespace exec {
+
+/// \brief The indices of the cells incident to a point.
+///
+/// This is a view of \c Size consecutive entries, starting at \c Start, of a
+/// portal of cell indices. Unstructured grids use their reverse connectivity
+/// array as the portal. Uniform grids use an implicit portal.
+///
+template<typename IndexPortalType>
+class PointCells
+{
+public:
+  DAX_EXEC_EXPORT
+  PointCells(const IndexPortalType &cellIndices, dax::Id start, dax::Id size)
+    : CellIndices(cellIndices), Start(start), Size(size) {  }
+
+  /// Returns the number of cells incident to the point.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const { return this->Size; }
+
+  /// Returns the index of the \c index'th cell incident to the point.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id operator[](dax::Id index) const
+  {
+    return this->CellIndices.Get(this->Start + index);
+  }
+
+private:
+  IndexPortalType CellIndices;
+  dax::Id Start;
+  dax::Id Size;
+};
+
+/// \brief The values of a cell field for the cells incident to a point.
+///
+/// Worklets that map cells to points receive this for each \c FieldCellIn
+/// argument. Values are read from the field when they are accessed.
+///
+template<typename PointCellsType, typename FieldExecArgType>
+class PointCellField
+{
+public:
+  typedef typename FieldExecArgType::ValueType ValueType;
+
+  DAX_EXEC_EXPORT
+  PointCellField(const PointCellsType &cells,
+                 const FieldExecArgType &field,
+                 const dax::exec::internal::WorkletBase &worklet)
+    : Cells(cells), Field(field), Worklet(worklet) {  }
+
+  /// Returns the number of cells incident to the point.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfValues() const { return this->Cells.GetNumberOfCells(); }
+
+  /// Returns the field value of the \c index'th cell incident to the point.
+  ///
+  DAX_EXEC_EXPORT
+  ValueType operator[](dax::Id index) const
+  {
+    DAX_ASSERT_EXEC(index < this->GetNumberOfValues(), this->Worklet);
+    return this->Field(this->Cells[index], this->Worklet);
+  }
+
+  /// Returns the indices of the cells incident to the point.
+  ///
+  DAX_EXEC_EXPORT
+  const PointCellsType &GetCells() const { return this->Cells; }
+
+private:
+  PointCellsType Cells;
+  FieldExecArgType Field;
+  dax::exec::internal::WorkletBase Worklet;
+};
+
+}
+} // namespace dax::exec
+
+#endif //__dax_exec_PointCells_h
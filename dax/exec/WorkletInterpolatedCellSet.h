@@ -0,0 +1,47 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_WorkletInterpolatedCellSet_h
+#define __dax_exec_WorkletInterpolatedCellSet_h
+
+#include <dax/exec/WorkletInterpolatedCell.h>
+#include <dax/cont/sig/Tag.h>
+
+namespace dax {
+namespace exec {
+
+///----------------------------------------------------------------------------
+/// Superclass for worklets that generate all the interpolated cells of an
+/// input cell in one invocation. The geometry argument of the worklet is a
+/// dax::exec::InterpolatedCellSet that the worklet adds each of its cells to.
+/// Subclasses declare the most cells an input cell can generate as \c
+/// MAX_CELLS.
+///
+/// DispatcherGenerateInterpolatedCells invokes these worklets once on each
+/// input cell, without a count of the cells to generate, and compacts the
+/// cells afterwards.
+///
+class WorkletInterpolatedCellSet : public dax::exec::WorkletInterpolatedCell
+{
+public:
+  typedef dax::cont::sig::Cell DomainType;
+
+  DAX_EXEC_EXPORT WorkletInterpolatedCellSet() { }
+};
+
+}
+}
+
+#endif //__dax_exec_WorkletInterpolatedCellSet_h
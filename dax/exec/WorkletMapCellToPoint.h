@@ -0,0 +1,63 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_WorkletMapCellToPoint_h
+#define __dax_exec_WorkletMapCellToPoint_h
+
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/arg/Topology.h>
+#include <dax/cont/sig/Tag.h>
+
+namespace dax {
+namespace exec {
+
+///----------------------------------------------------------------------------
+/// Superclass for worklets that map cells to points. The worklet is invoked
+/// once for each point of the grid given as topology. The topology argument
+/// gives the worklet a dax::exec::PointCells listing the cells incident to
+/// the point, and fields declared with FieldCellIn give it a
+/// dax::exec::PointCellField with the values of those cells. Use this with
+/// dax::cont::DispatcherMapCellToPoint.
+///
+class WorkletMapCellToPoint : public dax::exec::internal::WorkletBase
+{
+public:
+  typedef dax::cont::sig::Point DomainType;
+
+  DAX_EXEC_EXPORT WorkletMapCellToPoint() { }
+protected:
+  typedef dax::cont::sig::Cell Cell;
+
+#ifndef FieldIn
+# define FieldIn dax::cont::arg::Field(*)(In)
+# define FieldOut dax::cont::arg::Field(*)(Out)
+#endif
+
+#ifndef FieldCell
+# define FieldCellIn dax::cont::arg::Field(*)(In,Cell)
+# define FieldInCell dax::cont::arg::Field(*)(In,Cell)
+#endif
+
+#ifndef TopologyIn
+# define TopologyIn dax::cont::arg::Topology(*)(In)
+# define TopologyOut dax::cont::arg::Topology(*)(Out)
+#endif
+};
+
+}
+}
+
+#endif //__dax_exec_WorkletMapCellToPoint_h
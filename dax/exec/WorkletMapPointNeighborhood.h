@@ -0,0 +1,68 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_WorkletMapPointNeighborhood_h
+#define __dax_exec_WorkletMapPointNeighborhood_h
+
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/cont/arg/Field.h>
+#include <dax/cont/arg/Topology.h>
+#include <dax/cont/sig/Tag.h>
+
+namespace dax {
+namespace exec {
+
+///----------------------------------------------------------------------------
+/// Superclass for worklets that compute a value for each point of a uniform
+/// grid from the values of the points around it, such as stencils and finite
+/// differences. Fields declared with FieldPointNeighborhoodIn are given to
+/// the worklet as a dax::exec::Neighborhood of \c NEIGHBORHOOD_RADIUS points
+/// in every direction around the point. Use this with
+/// dax::cont::DispatcherMapPointNeighborhood.
+///
+class WorkletMapPointNeighborhood : public dax::exec::internal::WorkletBase
+{
+public:
+  typedef dax::cont::sig::AnyDomain DomainType;
+
+  /// The number of points on each side of the center that the neighborhoods
+  /// given to the worklet hold. Subclasses can redefine this to read a wider
+  /// stencil.
+  ///
+  static const int NEIGHBORHOOD_RADIUS = 1;
+
+  DAX_EXEC_CONT_EXPORT WorkletMapPointNeighborhood() { }
+protected:
+  typedef dax::cont::sig::PointNeighborhood PointNeighborhood;
+
+#ifndef FieldIn
+# define FieldIn dax::cont::arg::Field(*)(In)
+# define FieldOut dax::cont::arg::Field(*)(Out)
+#endif
+
+#ifndef FieldPointNeighborhoodIn
+# define FieldPointNeighborhoodIn dax::cont::arg::Field(*)(In,PointNeighborhood)
+#endif
+
+#ifndef TopologyIn
+# define TopologyIn dax::cont::arg::Topology(*)(In)
+# define TopologyOut dax::cont::arg::Topology(*)(Out)
+#endif
+};
+
+}
+}
+
+#endif //__dax_exec_WorkletMapPointNeighborhood_h
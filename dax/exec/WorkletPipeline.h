@@ -0,0 +1,862 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_WorkletPipeline_h
+#define __dax_exec_WorkletPipeline_h
+
+#include <dax/exec/WorkletMapField.h>
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+#include <dax/internal/GetNthType.h>
+#include <dax/internal/WorkletSignatureFunctions.h>
+
+#include <boost/function_types/function_arity.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/or.hpp>
+#include <boost/mpl/push_back.hpp>
+#include <boost/mpl/vector.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+namespace dax { namespace exec {
+
+/// \headerfile WorkletPipeline.h dax/exec/WorkletPipeline.h
+/// \brief Names input field \c N (the first is 1) of a pipeline as an
+/// argument of a PipelineStage.
+///
+template<int N>
+struct PipelineInput {  };
+
+/// \headerfile WorkletPipeline.h dax/exec/WorkletPipeline.h
+/// \brief Names the value produced by stage \c N (the first is 1) of a
+/// pipeline as an argument of a later PipelineStage.
+///
+template<int N>
+struct PipelineResult {  };
+
+namespace internal {
+
+/// The argument of a stage that is not given one: the value produced by the
+/// stage before it, or the first input of the pipeline for the first stage.
+///
+struct PipelinePrevious {  };
+
+} // namespace internal
+
+/// \headerfile WorkletPipeline.h dax/exec/WorkletPipeline.h
+/// \brief Declares the type of the value a stage of a WorkletPipeline
+/// produces and where the stage gets its arguments.
+///
+/// A stage given to a pipeline as a plain worklet takes the value produced by
+/// the stage before it (the first stage takes the first input of the
+/// pipeline) and is assumed to produce a value of the same type (as Sine,
+/// Square, and the like do). Wrap the worklet in a \c PipelineStage when it
+/// produces some other type, for example \code
+/// PipelineStage<dax::worklet::Magnitude, dax::Scalar> \endcode.
+///
+/// \c Arguments wires the FieldIn arguments of the worklet. It is a function
+/// type with one PipelineInput or PipelineResult placeholder for each FieldIn,
+/// in order. A result placeholder must name a stage that comes before this
+/// one. For example, a worklet with the control signature (FieldIn, FieldIn,
+/// FieldOut) that combines the second input of the pipeline with the value of
+/// the first stage is declared as \code
+/// PipelineStage<Combine, dax::Scalar,
+///               void(PipelineInput<2>, PipelineResult<1>)> \endcode.
+/// A stage can take up to three arguments.
+///
+template<class WorkletType,
+         class OutputType,
+         class Arguments = void(dax::exec::internal::PipelinePrevious)>
+struct PipelineStage {  };
+
+namespace internal {
+
+/// Marks the end of the stages of a WorkletPipeline.
+///
+struct PipelineEnd {  };
+
+/// Fills the places of the inputs a pipeline does not have.
+///
+struct PipelineNoInput {  };
+
+/// The input fields of one invocation of a pipeline. Together with the
+/// PipelineResults wrapping them, these are the values the stages can take as
+/// arguments. All of them are local to the invocation.
+///
+template<class Input1,
+         class Input2 = PipelineNoInput,
+         class Input3 = PipelineNoInput>
+struct PipelineInputs
+{
+  static const int NUM_RESULTS = 0;
+
+  DAX_EXEC_EXPORT PipelineInputs(const Input1 &input1,
+                                 const Input2 &input2 = Input2(),
+                                 const Input3 &input3 = Input3())
+    : Value1(input1), Value2(input2), Value3(input3) {  }
+
+  Input1 Value1;
+  Input2 Value2;
+  Input3 Value3;
+};
+
+/// The values available after a stage has run: the value that stage produced
+/// (result number \c NUM_RESULTS) and the values available before it.
+///
+template<class Before, class T>
+struct PipelineResults
+{
+  typedef Before BeforeType;
+  typedef T ValueType;
+  static const int NUM_RESULTS = Before::NUM_RESULTS + 1;
+
+  DAX_EXEC_EXPORT PipelineResults(const Before &before, const T &value)
+    : BeforeValues(before), Value(value) {  }
+
+  const Before &BeforeValues;
+  const T &Value;
+};
+
+/// Looks up the value a placeholder names in \c Values.
+///
+template<class Values, class Placeholder>
+struct PipelineArgument;
+
+template<class Values, int N>
+struct PipelineArgument<Values, dax::exec::PipelineInput<N> >
+{
+private:
+  typedef PipelineArgument<typename Values::BeforeType,
+                           dax::exec::PipelineInput<N> > BeforeArgument;
+public:
+  typedef typename BeforeArgument::type type;
+  DAX_EXEC_EXPORT static const type &Get(const Values &values)
+  {
+    return BeforeArgument::Get(values.BeforeValues);
+  }
+};
+
+template<class Input1, class Input2, class Input3>
+struct PipelineArgument<PipelineInputs<Input1,Input2,Input3>,
+                        dax::exec::PipelineInput<1> >
+{
+  typedef Input1 type;
+  DAX_EXEC_EXPORT static const type &Get(
+      const PipelineInputs<Input1,Input2,Input3> &values)
+  {
+    return values.Value1;
+  }
+};
+
+template<class Input1, class Input2, class Input3>
+struct PipelineArgument<PipelineInputs<Input1,Input2,Input3>,
+                        dax::exec::PipelineInput<2> >
+{
+  typedef Input2 type;
+  DAX_EXEC_EXPORT static const type &Get(
+      const PipelineInputs<Input1,Input2,Input3> &values)
+  {
+    return values.Value2;
+  }
+};
+
+template<class Input1, class Input2, class Input3>
+struct PipelineArgument<PipelineInputs<Input1,Input2,Input3>,
+                        dax::exec::PipelineInput<3> >
+{
+  typedef Input3 type;
+  DAX_EXEC_EXPORT static const type &Get(
+      const PipelineInputs<Input1,Input2,Input3> &values)
+  {
+    return values.Value3;
+  }
+};
+
+template<class Values, int N, bool IsLatest>
+struct PipelineResultArgument
+{
+  typedef typename Values::ValueType type;
+  DAX_EXEC_EXPORT static const type &Get(const Values &values)
+  {
+    return values.Value;
+  }
+};
+
+template<class Values, int N>
+struct PipelineResultArgument<Values, N, false>
+{
+private:
+  typedef PipelineArgument<typename Values::BeforeType,
+                           dax::exec::PipelineResult<N> > BeforeArgument;
+public:
+  typedef typename BeforeArgument::type type;
+  DAX_EXEC_EXPORT static const type &Get(const Values &values)
+  {
+    return BeforeArgument::Get(values.BeforeValues);
+  }
+};
+
+template<class Values, int N>
+struct PipelineArgument<Values, dax::exec::PipelineResult<N> >
+  : PipelineResultArgument<Values, N, N == Values::NUM_RESULTS>
+{
+  // If you get a compile error here, a stage takes the result of itself or
+  // of a stage that comes after it.
+  BOOST_MPL_ASSERT_RELATION(N, >=, 1);
+  BOOST_MPL_ASSERT_RELATION(N, <=, Values::NUM_RESULTS);
+};
+
+template<class Values>
+struct PipelineArgument<Values, PipelinePrevious>
+  : PipelineArgument<Values,
+                     typename boost::mpl::if_c<
+                       Values::NUM_RESULTS == 0,
+                       dax::exec::PipelineInput<1>,
+                       dax::exec::PipelineResult<Values::NUM_RESULTS>
+                       >::type>
+{  };
+
+/// The highest pipeline input a placeholder, or a function type of
+/// placeholders, names.
+///
+template<class Placeholder>
+struct PipelineInputsUsed
+{
+  static const int value = 0;
+};
+template<>
+struct PipelineInputsUsed<PipelinePrevious>
+{
+  static const int value = 1;
+};
+template<int N>
+struct PipelineInputsUsed<dax::exec::PipelineInput<N> >
+{
+  static const int value = N;
+};
+template<class A1>
+struct PipelineInputsUsed<void(A1)>
+{
+  static const int value = PipelineInputsUsed<A1>::value;
+};
+template<class A1, class A2>
+struct PipelineInputsUsed<void(A1,A2)>
+{
+  static const int value =
+      (PipelineInputsUsed<A1>::value > PipelineInputsUsed<void(A2)>::value)
+      ? PipelineInputsUsed<A1>::value : PipelineInputsUsed<void(A2)>::value;
+};
+template<class A1, class A2, class A3>
+struct PipelineInputsUsed<void(A1,A2,A3)>
+{
+  static const int value =
+      (PipelineInputsUsed<A1>::value > PipelineInputsUsed<void(A2,A3)>::value)
+      ? PipelineInputsUsed<A1>::value : PipelineInputsUsed<void(A2,A3)>::value;
+};
+
+template<class Stage>
+struct PipelineStageTraits
+{
+  typedef Stage WorkletType;
+  typedef void Arguments(PipelinePrevious);
+  template<class Values> struct Output
+  {
+    typedef typename PipelineArgument<Values,PipelinePrevious>::type type;
+  };
+};
+
+template<class WorkletType_, class OutputType, class Arguments_>
+struct PipelineStageTraits<
+    dax::exec::PipelineStage<WorkletType_,OutputType,Arguments_> >
+{
+  typedef WorkletType_ WorkletType;
+  typedef Arguments_ Arguments;
+  template<class Values> struct Output { typedef OutputType type; };
+};
+
+struct PipelineSignatureTypes
+{
+protected:
+  typedef dax::cont::sig::In In;
+  typedef dax::cont::sig::Out Out;
+  typedef dax::cont::sig::placeholders::_1 _1;
+  typedef dax::cont::sig::placeholders::_2 _2;
+  typedef dax::cont::sig::placeholders::_3 _3;
+  typedef dax::cont::sig::placeholders::_4 _4;
+};
+
+/// The signatures a map field worklet with \c NumArguments inputs can have to
+/// be a stage: it either returns its value or writes it to its last argument.
+///
+template<int NumArguments>
+struct PipelineStageSignatures;
+
+template<>
+struct PipelineStageSignatures<1> : PipelineSignatureTypes
+{
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2);
+  typedef _2 ReturnExecutionSignature(_1);
+};
+template<>
+struct PipelineStageSignatures<2> : PipelineSignatureTypes
+{
+  typedef void ControlSignature(FieldIn, FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3);
+  typedef _3 ReturnExecutionSignature(_1, _2);
+};
+template<>
+struct PipelineStageSignatures<3> : PipelineSignatureTypes
+{
+  typedef void ControlSignature(FieldIn, FieldIn, FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2, _3, _4);
+  typedef _4 ReturnExecutionSignature(_1, _2, _3);
+};
+
+/// Invokes a stage worklet with its arguments, regardless of whether its
+/// execution signature returns the result or writes it to its last argument.
+///
+template<class WorkletType, class A1, class OutputType>
+DAX_EXEC_EXPORT void PipelineInvokeStage(const WorkletType &worklet,
+                                         const A1 &a1,
+                                         OutputType &output,
+                                         boost::true_type)
+{
+  worklet(a1, output);
+}
+template<class WorkletType, class A1, class OutputType>
+DAX_EXEC_EXPORT void PipelineInvokeStage(const WorkletType &worklet,
+                                         const A1 &a1,
+                                         OutputType &output,
+                                         boost::false_type)
+{
+  output = worklet(a1);
+}
+template<class WorkletType, class A1, class A2, class OutputType>
+DAX_EXEC_EXPORT void PipelineInvokeStage(const WorkletType &worklet,
+                                         const A1 &a1,
+                                         const A2 &a2,
+                                         OutputType &output,
+                                         boost::true_type)
+{
+  worklet(a1, a2, output);
+}
+template<class WorkletType, class A1, class A2, class OutputType>
+DAX_EXEC_EXPORT void PipelineInvokeStage(const WorkletType &worklet,
+                                         const A1 &a1,
+                                         const A2 &a2,
+                                         OutputType &output,
+                                         boost::false_type)
+{
+  output = worklet(a1, a2);
+}
+template<class WorkletType, class A1, class A2, class A3, class OutputType>
+DAX_EXEC_EXPORT void PipelineInvokeStage(const WorkletType &worklet,
+                                         const A1 &a1,
+                                         const A2 &a2,
+                                         const A3 &a3,
+                                         OutputType &output,
+                                         boost::true_type)
+{
+  worklet(a1, a2, a3, output);
+}
+template<class WorkletType, class A1, class A2, class A3, class OutputType>
+DAX_EXEC_EXPORT void PipelineInvokeStage(const WorkletType &worklet,
+                                         const A1 &a1,
+                                         const A2 &a2,
+                                         const A3 &a3,
+                                         OutputType &output,
+                                         boost::false_type)
+{
+  output = worklet(a1, a2, a3);
+}
+
+template<class WorkletType>
+struct PipelineStageReturnsVoid
+{
+  typedef typename boost::is_same<
+      typename dax::internal::GetNthType<
+        0, typename WorkletType::ExecutionSignature>::type,
+      void>::type type;
+};
+
+/// Gets the arguments of a stage from the values available to it and invokes
+/// the stage.
+///
+template<class Arguments>
+struct PipelineCallStage;
+
+template<class A1>
+struct PipelineCallStage<void(A1)>
+{
+  template<class WorkletType, class Values, class OutputType>
+  DAX_EXEC_EXPORT static void Call(const WorkletType &worklet,
+                                   const Values &values,
+                                   OutputType &output)
+  {
+    PipelineInvokeStage(worklet,
+                        PipelineArgument<Values,A1>::Get(values),
+                        output,
+                        typename PipelineStageReturnsVoid<WorkletType>::type());
+  }
+};
+template<class A1, class A2>
+struct PipelineCallStage<void(A1,A2)>
+{
+  template<class WorkletType, class Values, class OutputType>
+  DAX_EXEC_EXPORT static void Call(const WorkletType &worklet,
+                                   const Values &values,
+                                   OutputType &output)
+  {
+    PipelineInvokeStage(worklet,
+                        PipelineArgument<Values,A1>::Get(values),
+                        PipelineArgument<Values,A2>::Get(values),
+                        output,
+                        typename PipelineStageReturnsVoid<WorkletType>::type());
+  }
+};
+template<class A1, class A2, class A3>
+struct PipelineCallStage<void(A1,A2,A3)>
+{
+  template<class WorkletType, class Values, class OutputType>
+  DAX_EXEC_EXPORT static void Call(const WorkletType &worklet,
+                                   const Values &values,
+                                   OutputType &output)
+  {
+    PipelineInvokeStage(worklet,
+                        PipelineArgument<Values,A1>::Get(values),
+                        PipelineArgument<Values,A2>::Get(values),
+                        PipelineArgument<Values,A3>::Get(values),
+                        output,
+                        typename PipelineStageReturnsVoid<WorkletType>::type());
+  }
+};
+
+/// Writes the value of the last stage to an output field.
+///
+template<class OutputType>
+struct PipelineWriteLast
+{
+  DAX_EXEC_EXPORT PipelineWriteLast(OutputType &output) : Output(output) {  }
+
+  template<class Values>
+  DAX_EXEC_EXPORT void operator()(const Values &values) const
+  {
+    this->Output = values.Value;
+  }
+
+  OutputType &Output;
+};
+
+/// Writes the value of stage \c KeepStage to an output field and passes the
+/// values on to the next writer.
+///
+template<int KeepStage, class KeptType, class NextWriter>
+struct PipelineWriteKept
+{
+  DAX_EXEC_EXPORT PipelineWriteKept(KeptType &kept, const NextWriter &next)
+    : Kept(kept), Next(next) {  }
+
+  template<class Values>
+  DAX_EXEC_EXPORT void operator()(const Values &values) const
+  {
+    this->Kept = PipelineArgument<
+        Values,dax::exec::PipelineResult<KeepStage> >::Get(values);
+    this->Next(values);
+  }
+
+  KeptType &Kept;
+  NextWriter Next;
+};
+
+} // namespace internal
+
+/// \headerfile WorkletPipeline.h dax/exec/WorkletPipeline.h
+/// \brief A map field worklet that runs map field worklets one after the
+/// other.
+///
+/// \c Stage is the first worklet (or PipelineStage) and \c Rest is the
+/// WorkletPipeline for the remaining stages, or internal::PipelineEnd. The
+/// values passed between the stages are local variables, so they are never
+/// written to an array. Use dax::cont::PipelineMapField rather than building
+/// these types by hand.
+///
+/// Used directly as a worklet, the pipeline takes one input field and writes
+/// the value of its last stage. Pipelines with stages wired to more inputs
+/// are run through dax::cont::PipelineMapField.
+///
+template<class Stage, class Rest = dax::exec::internal::PipelineEnd>
+class WorkletPipeline : public dax::exec::WorkletMapField
+{
+  typedef dax::exec::internal::PipelineStageTraits<Stage> StageTraits;
+  typedef typename StageTraits::WorkletType StageWorkletType;
+  typedef typename StageTraits::Arguments StageArguments;
+  typedef typename boost::is_same<
+      Rest,dax::exec::internal::PipelineEnd>::type IsLastStage;
+
+  // A stage takes the values its arguments name and produces one value, so
+  // stages are map field worklets with one FieldIn for each argument and a
+  // FieldOut. Worklets with any other kind of argument are not supported.
+  typedef dax::exec::internal::PipelineStageSignatures<
+      boost::function_types::function_arity<StageArguments>::value>
+      StageSignatures;
+  typedef typename boost::is_base_of<
+      dax::exec::WorkletMapField,StageWorkletType>::type
+      Stage_Should_Be_WorkletMapField;
+  typedef typename boost::is_same<
+      typename StageWorkletType::ControlSignature,
+      typename StageSignatures::ControlSignature>::type
+      Stage_ControlSignature_Should_Be_FieldIn_Per_Argument_And_FieldOut;
+  typedef typename boost::mpl::or_<
+      boost::is_same<typename StageWorkletType::ExecutionSignature,
+                     typename StageSignatures::ExecutionSignature>,
+      boost::is_same<typename StageWorkletType::ExecutionSignature,
+                     typename StageSignatures::ReturnExecutionSignature>
+      >::type
+      Stage_ExecutionSignature_Should_Pass_Arguments_In_Order;
+
+  // If you get a compile error on one of the following lines, then one of
+  // the worklets given to the pipeline does not match the arguments wired to
+  // it.
+  BOOST_MPL_ASSERT((Stage_Should_Be_WorkletMapField));
+  BOOST_MPL_ASSERT((
+      Stage_ControlSignature_Should_Be_FieldIn_Per_Argument_And_FieldOut));
+  BOOST_MPL_ASSERT((Stage_ExecutionSignature_Should_Pass_Arguments_In_Order));
+
+  template<class R, int Dummy = 0> struct RestInputs
+    { static const int value = R::NUM_INPUTS; };
+  template<int Dummy> struct RestInputs<dax::exec::internal::PipelineEnd, Dummy>
+    { static const int value = 1; };
+
+  typedef dax::exec::internal::PipelineInputsUsed<StageArguments> StageInputs;
+
+public:
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef void ExecutionSignature(_1, _2);
+
+  typedef Rest RestType;
+
+  /// The number of input fields the stages take.
+  ///
+  static const int NUM_INPUTS =
+      (StageInputs::value > RestInputs<Rest>::value)
+      ? StageInputs::value : RestInputs<Rest>::value;
+
+  DAX_EXEC_CONT_EXPORT WorkletPipeline() {  }
+  DAX_EXEC_CONT_EXPORT WorkletPipeline(const StageWorkletType &stageWorklet,
+                                       const Rest &rest = Rest())
+    : StageWorklet(stageWorklet), RestWorklet(rest) {  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &buffer)
+  {
+    this->WorkletMapField::SetErrorMessageBuffer(buffer);
+    this->StageWorklet.SetErrorMessageBuffer(buffer);
+    this->SetRestErrorMessageBuffer(buffer, IsLastStage());
+  }
+
+  template<class InputType, class OutputType>
+  DAX_EXEC_EXPORT void operator()(const InputType &input,
+                                  OutputType &output) const
+  {
+    this->Run(dax::exec::internal::PipelineInputs<InputType>(input),
+              dax::exec::internal::PipelineWriteLast<OutputType>(output));
+  }
+
+  /// Runs this stage and the ones after it. \c values holds the inputs and
+  /// the results of the stages before this one. Once the last stage has run,
+  /// \c write is given the values of every stage.
+  ///
+  template<class Values, class Writer>
+  DAX_EXEC_EXPORT void Run(const Values &values, const Writer &write) const
+  {
+    typedef typename StageTraits::template Output<Values>::type ValueType;
+    ValueType value;
+    dax::exec::internal::PipelineCallStage<StageArguments>::Call(
+          this->StageWorklet, values, value);
+    this->Continue(
+          dax::exec::internal::PipelineResults<Values,ValueType>(values, value),
+          write,
+          IsLastStage());
+  }
+
+private:
+  StageWorkletType StageWorklet;
+  Rest RestWorklet;
+
+  DAX_CONT_EXPORT void SetRestErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &buffer, boost::false_type)
+  {
+    this->RestWorklet.SetErrorMessageBuffer(buffer);
+  }
+  DAX_CONT_EXPORT void SetRestErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &, boost::true_type)
+  {  }
+
+  template<class Values, class Writer>
+  DAX_EXEC_EXPORT void Continue(const Values &values,
+                                const Writer &write,
+                                boost::false_type) const
+  {
+    this->RestWorklet.Run(values, write);
+  }
+  template<class Values, class Writer>
+  DAX_EXEC_EXPORT void Continue(const Values &values,
+                                const Writer &write,
+                                boost::true_type) const
+  {
+    write(values);
+  }
+};
+
+namespace internal {
+
+template<class Sequence, class Type, int Count>
+struct PipelineSignatureAppend
+{
+  typedef typename PipelineSignatureAppend<
+      typename boost::mpl::push_back<Sequence,Type>::type,
+      Type,
+      Count-1>::type type;
+};
+template<class Sequence, class Type>
+struct PipelineSignatureAppend<Sequence,Type,0>
+{
+  typedef Sequence type;
+};
+
+template<class Sequence, int Count>
+struct PipelineSignaturePlaceholders
+{
+  typedef typename boost::mpl::push_back<
+      typename PipelineSignaturePlaceholders<Sequence,Count-1>::type,
+      dax::cont::sig::Arg<Count> >::type type;
+};
+template<class Sequence>
+struct PipelineSignaturePlaceholders<Sequence,0>
+{
+  typedef Sequence type;
+};
+
+/// The parts of WorkletPipelineFused that do not depend on the number of
+/// inputs.
+///
+template<class PipelineType, int NumInputs, int Keep1, int Keep2, int Keep3>
+class WorkletPipelineFusedBase : public dax::exec::WorkletMapField
+{
+public:
+  static const int NUM_KEPT = (Keep1 != 0) + (Keep2 != 0) + (Keep3 != 0);
+  static const int NUM_ARGUMENTS = NumInputs + NUM_KEPT + 1;
+
+  typedef typename dax::internal::BuildSignature<
+      typename PipelineSignatureAppend<
+        typename PipelineSignatureAppend<
+          boost::mpl::vector<void>, FieldIn, NumInputs>::type,
+        FieldOut,
+        NUM_KEPT + 1>::type>::type ControlSignature;
+  typedef typename dax::internal::BuildSignature<
+      typename PipelineSignaturePlaceholders<
+        boost::mpl::vector<void>, NUM_ARGUMENTS>::type>::type
+      ExecutionSignature;
+
+  DAX_EXEC_CONT_EXPORT WorkletPipelineFusedBase() {  }
+  DAX_EXEC_CONT_EXPORT WorkletPipelineFusedBase(const PipelineType &pipeline)
+    : Pipeline(pipeline) {  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &buffer)
+  {
+    this->WorkletMapField::SetErrorMessageBuffer(buffer);
+    this->Pipeline.SetErrorMessageBuffer(buffer);
+  }
+
+protected:
+  template<class Values, class OutputType>
+  DAX_EXEC_EXPORT void Run(const Values &values, OutputType &output) const
+  {
+    this->Pipeline.Run(values, PipelineWriteLast<OutputType>(output));
+  }
+  template<class Values, class Kept1Type, class OutputType>
+  DAX_EXEC_EXPORT void Run(const Values &values,
+                           Kept1Type &kept1,
+                           OutputType &output) const
+  {
+    typedef PipelineWriteLast<OutputType> WriteLast;
+    this->Pipeline.Run(
+          values,
+          PipelineWriteKept<Keep1,Kept1Type,WriteLast>(
+            kept1, WriteLast(output)));
+  }
+  template<class Values, class Kept1Type, class Kept2Type, class OutputType>
+  DAX_EXEC_EXPORT void Run(const Values &values,
+                           Kept1Type &kept1,
+                           Kept2Type &kept2,
+                           OutputType &output) const
+  {
+    typedef PipelineWriteLast<OutputType> WriteLast;
+    typedef PipelineWriteKept<Keep2,Kept2Type,WriteLast> WriteKept2;
+    this->Pipeline.Run(
+          values,
+          PipelineWriteKept<Keep1,Kept1Type,WriteKept2>(
+            kept1, WriteKept2(kept2, WriteLast(output))));
+  }
+  template<class Values,
+           class Kept1Type, class Kept2Type, class Kept3Type,
+           class OutputType>
+  DAX_EXEC_EXPORT void Run(const Values &values,
+                           Kept1Type &kept1,
+                           Kept2Type &kept2,
+                           Kept3Type &kept3,
+                           OutputType &output) const
+  {
+    typedef PipelineWriteLast<OutputType> WriteLast;
+    typedef PipelineWriteKept<Keep3,Kept3Type,WriteLast> WriteKept3;
+    typedef PipelineWriteKept<Keep2,Kept2Type,WriteKept3> WriteKept2;
+    this->Pipeline.Run(
+          values,
+          PipelineWriteKept<Keep1,Kept1Type,WriteKept2>(
+            kept1, WriteKept2(kept2, WriteKept3(kept3, WriteLast(output)))));
+  }
+
+private:
+  PipelineType Pipeline;
+};
+
+/// A map field worklet that runs a WorkletPipeline on \c NumInputs input
+/// fields and writes the value of the last stage. It also writes the values
+/// of stages \c Keep1, \c Keep2, and \c Keep3, where 0 keeps nothing. The
+/// arguments are the inputs, then the kept values in order, then the output.
+///
+template<class PipelineType,
+         int NumInputs,
+         int Keep1 = 0,
+         int Keep2 = 0,
+         int Keep3 = 0>
+class WorkletPipelineFused;
+
+template<class PipelineType, int Keep1, int Keep2, int Keep3>
+class WorkletPipelineFused<PipelineType,1,Keep1,Keep2,Keep3>
+  : public WorkletPipelineFusedBase<PipelineType,1,Keep1,Keep2,Keep3>
+{
+  typedef WorkletPipelineFusedBase<PipelineType,1,Keep1,Keep2,Keep3>
+      Superclass;
+public:
+  DAX_EXEC_CONT_EXPORT WorkletPipelineFused() {  }
+  DAX_EXEC_CONT_EXPORT WorkletPipelineFused(const PipelineType &pipeline)
+    : Superclass(pipeline) {  }
+
+  template<class I1, class O1>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, O1 &o1) const
+  {
+    this->Run(PipelineInputs<I1>(i1), o1);
+  }
+  template<class I1, class O1, class O2>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, O1 &o1, O2 &o2) const
+  {
+    this->Run(PipelineInputs<I1>(i1), o1, o2);
+  }
+  template<class I1, class O1, class O2, class O3>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, O1 &o1, O2 &o2, O3 &o3) const
+  {
+    this->Run(PipelineInputs<I1>(i1), o1, o2, o3);
+  }
+  template<class I1, class O1, class O2, class O3, class O4>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1,
+                                  O1 &o1, O2 &o2, O3 &o3, O4 &o4) const
+  {
+    this->Run(PipelineInputs<I1>(i1), o1, o2, o3, o4);
+  }
+};
+
+template<class PipelineType, int Keep1, int Keep2, int Keep3>
+class WorkletPipelineFused<PipelineType,2,Keep1,Keep2,Keep3>
+  : public WorkletPipelineFusedBase<PipelineType,2,Keep1,Keep2,Keep3>
+{
+  typedef WorkletPipelineFusedBase<PipelineType,2,Keep1,Keep2,Keep3>
+      Superclass;
+public:
+  DAX_EXEC_CONT_EXPORT WorkletPipelineFused() {  }
+  DAX_EXEC_CONT_EXPORT WorkletPipelineFused(const PipelineType &pipeline)
+    : Superclass(pipeline) {  }
+
+  template<class I1, class I2, class O1>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, const I2 &i2, O1 &o1) const
+  {
+    this->Run(PipelineInputs<I1,I2>(i1, i2), o1);
+  }
+  template<class I1, class I2, class O1, class O2>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, const I2 &i2,
+                                  O1 &o1, O2 &o2) const
+  {
+    this->Run(PipelineInputs<I1,I2>(i1, i2), o1, o2);
+  }
+  template<class I1, class I2, class O1, class O2, class O3>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, const I2 &i2,
+                                  O1 &o1, O2 &o2, O3 &o3) const
+  {
+    this->Run(PipelineInputs<I1,I2>(i1, i2), o1, o2, o3);
+  }
+  template<class I1, class I2, class O1, class O2, class O3, class O4>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, const I2 &i2,
+                                  O1 &o1, O2 &o2, O3 &o3, O4 &o4) const
+  {
+    this->Run(PipelineInputs<I1,I2>(i1, i2), o1, o2, o3, o4);
+  }
+};
+
+template<class PipelineType, int Keep1, int Keep2, int Keep3>
+class WorkletPipelineFused<PipelineType,3,Keep1,Keep2,Keep3>
+  : public WorkletPipelineFusedBase<PipelineType,3,Keep1,Keep2,Keep3>
+{
+  typedef WorkletPipelineFusedBase<PipelineType,3,Keep1,Keep2,Keep3>
+      Superclass;
+public:
+  DAX_EXEC_CONT_EXPORT WorkletPipelineFused() {  }
+  DAX_EXEC_CONT_EXPORT WorkletPipelineFused(const PipelineType &pipeline)
+    : Superclass(pipeline) {  }
+
+  template<class I1, class I2, class I3, class O1>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, const I2 &i2, const I3 &i3,
+                                  O1 &o1) const
+  {
+    this->Run(PipelineInputs<I1,I2,I3>(i1, i2, i3), o1);
+  }
+  template<class I1, class I2, class I3, class O1, class O2>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, const I2 &i2, const I3 &i3,
+                                  O1 &o1, O2 &o2) const
+  {
+    this->Run(PipelineInputs<I1,I2,I3>(i1, i2, i3), o1, o2);
+  }
+  template<class I1, class I2, class I3, class O1, class O2, class O3>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, const I2 &i2, const I3 &i3,
+                                  O1 &o1, O2 &o2, O3 &o3) const
+  {
+    this->Run(PipelineInputs<I1,I2,I3>(i1, i2, i3), o1, o2, o3);
+  }
+  template<class I1, class I2, class I3,
+           class O1, class O2, class O3, class O4>
+  DAX_EXEC_EXPORT void operator()(const I1 &i1, const I2 &i2, const I3 &i3,
+                                  O1 &o1, O2 &o2, O3 &o3, O4 &o4) const
+  {
+    this->Run(PipelineInputs<I1,I2,I3>(i1, i2, i3), o1, o2, o3, o4);
+  }
+};
+
+} // namespace internal
+
+}} // namespace dax::exec
+
+#endif //__dax_exec_WorkletPipeline_h
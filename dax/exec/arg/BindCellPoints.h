@@ -33,6 +33,7 @@
 #include <dax/exec/internal/IJKIndex.h>
 #include <dax/exec/internal/WorkletBase.h>
 
+#include <boost/type_traits/is_same.hpp>
 #include <boost/utility/enable_if.hpp>
 
 namespace dax { namespace exec { namespace arg {
@@ -59,7 +60,9 @@ public:
       typename dax::cont::internal::Bindings<Invocation>::type &bindings):
     TopoExecArg(dax::exec::arg::GetNthExecArg<TopoIndex>(bindings)),
     ExecArg(dax::exec::arg::GetNthExecArg<N>(bindings)),
-    Value(typename dax::VectorTraits<ValueType>::ComponentType()) {}
+    Value(typename dax::VectorTraits<ValueType>::ComponentType()),
+    RowValue(typename dax::VectorTraits<ValueType>::ComponentType()),
+    RowIJK(-1) {}
 
   template<typename IndexType>
   DAX_EXEC_EXPORT ReturnType GetValueForWriting(const IndexType&,
@@ -71,16 +74,17 @@ public:
                             const IndexType& index,
                             const dax::exec::internal::WorkletBase& work) const
     {
-    ValueType v;
-    const dax::exec::CellVertices<CellTag>& pointIndices =
-                                            this->TopoExecArg(index, work);
-    for(int vertexIndex = 0;
-        vertexIndex < pointIndices.NUM_VERTICES;
-        ++vertexIndex)
-      {
-      v[vertexIndex] = this->ExecArg(pointIndices[vertexIndex],work);
-      }
-    return v;
+    return this->GatherValue(index,work);
+    }
+
+  DAX_EXEC_EXPORT ReturnType GetValueForReading(
+                            const dax::exec::internal::IJKIndex& index,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    return this->GatherRowValue(index,
+                                work,
+                                typename boost::is_same<
+                                  CellTag,dax::CellTagVoxel>::type());
     }
 
   DAX_EXEC_EXPORT void SaveValue(int index,
@@ -104,9 +108,70 @@ public:
       }
     }
 private:
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ValueType GatherValue(
+                            const IndexType& index,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    ValueType v;
+    const dax::exec::CellVertices<CellTag>& pointIndices =
+                                            this->TopoExecArg(index, work);
+    for(int vertexIndex = 0;
+        vertexIndex < pointIndices.NUM_VERTICES;
+        ++vertexIndex)
+      {
+      v[vertexIndex] = this->ExecArg(pointIndices[vertexIndex],work);
+      }
+    return v;
+    }
+
+  DAX_EXEC_EXPORT ValueType GatherRowValue(
+                            const dax::exec::internal::IJKIndex& index,
+                            const dax::exec::internal::WorkletBase& work,
+                            boost::false_type) const
+    {
+    return this->GatherValue(index,work);
+    }
+
+  // When the functor walks a row of voxels with the same copy of this
+  // binding, the left face (vertices 0, 3, 4, 7) of a voxel is the right face
+  // (vertices 1, 2, 6, 5) of the previous one. Carry it forward and only load
+  // the four new points.
+  DAX_EXEC_EXPORT ValueType GatherRowValue(
+                            const dax::exec::internal::IJKIndex& index,
+                            const dax::exec::internal::WorkletBase& work,
+                            boost::true_type) const
+    {
+    const dax::Id3 ijk = index.GetIJK();
+    if(ijk[0] == this->RowIJK[0] + 1 &&
+       ijk[1] == this->RowIJK[1] &&
+       ijk[2] == this->RowIJK[2])
+      {
+      const dax::exec::CellVertices<CellTag>& pointIndices =
+                                              this->TopoExecArg(index, work);
+      ValueType &v = this->RowValue;
+      v[0] = v[1];
+      v[3] = v[2];
+      v[4] = v[5];
+      v[7] = v[6];
+      v[1] = this->ExecArg(pointIndices[1],work);
+      v[2] = this->ExecArg(pointIndices[2],work);
+      v[5] = this->ExecArg(pointIndices[5],work);
+      v[6] = this->ExecArg(pointIndices[6],work);
+      }
+    else
+      {
+      this->RowValue = this->GatherValue(index,work);
+      }
+    this->RowIJK = ijk;
+    return this->RowValue;
+    }
+
   TopoExecArgType TopoExecArg;
   ExecArgType ExecArg;
   ValueType Value;
+  mutable ValueType RowValue;
+  mutable dax::Id3 RowIJK;
 };
 
 
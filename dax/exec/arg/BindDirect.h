@@ -31,15 +31,19 @@ class BindDirect
 {
   typedef dax::exec::arg::BindInfo<N,Invocation> MyInfo;
   typedef typename MyInfo::AllControlBindings AllControlBindings;
-  typedef typename MyInfo::ExecArgType ExecArgType;
   typedef typename MyInfo::Tags Tags;
-  ExecArgType ExecArg;
 public:
+  typedef typename MyInfo::ExecArgType ExecArgType;
   typedef typename ExecArgType::ReturnType ReturnType;
 
   DAX_CONT_EXPORT BindDirect(AllControlBindings& bindings):
     ExecArg(dax::exec::arg::GetNthExecArg<N>(bindings)) {}
 
+  DAX_EXEC_EXPORT const ExecArgType& GetExecArg() const
+    {
+    return this->ExecArg;
+    }
+
   template<typename IndexType>
   DAX_EXEC_EXPORT ReturnType operator()(const IndexType& id,
                       const dax::exec::internal::WorkletBase& worklet)
@@ -79,6 +83,8 @@ public:
   {
   }
 
+private:
+  ExecArgType ExecArg;
 };
 
 }}} // namespace dax::exec::arg
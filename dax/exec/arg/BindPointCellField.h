@@ -0,0 +1,99 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_BindPointCellField_h
+#define __dax_exec_arg_BindPointCellField_h
+#if defined(DAX_DOXYGEN_ONLY)
+
+#else // !defined(DAX_DOXYGEN_ONLY)
+
+#include <dax/Types.h>
+
+#include <dax/cont/arg/ConceptMap.h>
+#include <dax/cont/arg/Topology.h>
+
+#include <dax/exec/arg/ArgBase.h>
+#include <dax/exec/arg/BindInfo.h>
+#include <dax/exec/PointCells.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax { namespace exec { namespace arg {
+
+/// Binds a cell field to a worklet visiting points. The worklet gets the
+/// values of the field for the cells incident to the point, which are read
+/// through the reverse connectivity of the topology.
+///
+template <typename Invocation, int N>
+class BindPointCellField
+    : public dax::exec::arg::ArgBase<BindPointCellField<Invocation,N> >
+{
+  typedef dax::exec::arg::ArgBaseTraits<
+      BindPointCellField<Invocation, N > > Traits;
+
+  enum{TopoIndex=Traits::TopoIndex};
+  typedef typename Traits::TopoExecArgType TopoExecArgType;
+  typedef typename Traits::ExecArgType ExecArgType;
+
+public:
+
+  typedef typename Traits::ValueType ValueType;
+  typedef typename Traits::ReturnType ReturnType;
+  typedef typename Traits::SaveType SaveType;
+
+  DAX_CONT_EXPORT BindPointCellField(
+      typename dax::cont::internal::Bindings<Invocation>::type &bindings):
+    TopoExecArg(dax::exec::arg::GetNthExecArg<TopoIndex>(bindings)),
+    ExecArg(dax::exec::arg::GetNthExecArg<N>(bindings)) {}
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType GetValueForReading(
+                            const IndexType& index,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    return ValueType(this->TopoExecArg(index, work), this->ExecArg, work);
+    }
+
+private:
+  TopoExecArgType TopoExecArg;
+  ExecArgType ExecArg;
+};
+
+//the traits for BindPointCellField
+template <typename Invocation, int N >
+struct ArgBaseTraits< BindPointCellField<Invocation, N> >
+{
+private:
+  typedef dax::exec::arg::FindBindInfo<
+      dax::cont::arg::Topology,Invocation> TopoInfo;
+  typedef dax::exec::arg::BindInfo<N,Invocation> MyInfo;
+public:
+  enum{TopoIndex=TopoInfo::Index};
+
+  typedef typename TopoInfo::ExecArgType TopoExecArgType;
+  typedef typename MyInfo::ExecArgType ExecArgType;
+
+  typedef ::boost::false_type HasOutTag;
+  typedef ::boost::true_type HasInTag;
+
+  typedef dax::exec::PointCellField<typename TopoExecArgType::ValueType,
+                                    ExecArgType> ValueType;
+  typedef ValueType const ReturnType;
+  typedef ValueType SaveType;
+};
+
+}}} // namespace dax::exec::arg
+
+#endif // !defined(DAX_DOXYGEN_ONLY)
+#endif //__dax_exec_arg_BindPointCellField_h
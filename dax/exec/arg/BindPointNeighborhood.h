@@ -0,0 +1,192 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_BindPointNeighborhood_h
+#define __dax_exec_arg_BindPointNeighborhood_h
+#if defined(DAX_DOXYGEN_ONLY)
+
+#else // !defined(DAX_DOXYGEN_ONLY)
+
+#include <dax/Types.h>
+
+#include <dax/cont/sig/Tag.h>
+
+#include <dax/exec/Neighborhood.h>
+#include <dax/exec/arg/ArgBase.h>
+#include <dax/exec/arg/BindInfo.h>
+#include <dax/exec/internal/IJKIndex.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <boost/mpl/if.hpp>
+
+namespace dax { namespace exec { namespace arg {
+
+/// Binds a field of point values to a dax::exec::Neighborhood around the
+/// point being visited. The worklet must be scheduled over the i, j, k
+/// indices of the points of a structured grid; the index gives both the
+/// center and the dimensions of the grid.
+///
+template <typename Invocation, int N>
+class BindPointNeighborhood
+    : public dax::exec::arg::ArgBase<BindPointNeighborhood<Invocation,N> >
+{
+  typedef dax::exec::arg::ArgBaseTraits<
+      BindPointNeighborhood<Invocation, N > > Traits;
+
+  typedef typename Traits::ExecArgType ExecArgType;
+
+public:
+  typedef typename Traits::ValueType ValueType;
+  typedef typename Traits::ReturnType ReturnType;
+  typedef typename Traits::SaveType SaveType;
+
+  enum { RADIUS = ValueType::RADIUS };
+
+  DAX_CONT_EXPORT BindPointNeighborhood(
+      typename dax::cont::internal::Bindings<Invocation>::type &bindings):
+    ExecArg(dax::exec::arg::GetNthExecArg<N>(bindings)),
+    RowIJK(-1) {}
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType GetValueForReading(
+                            const IndexType&,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    work.RaiseError("Point neighborhoods can only be read by worklets "
+                    "scheduled over the points of a structured grid.");
+    return this->RowValue;
+    }
+
+  // When the functor walks a row of points with the same copy of this
+  // binding, the neighborhood of a point is that of the previous point
+  // shifted by one. Carry it forward and only load the new column.
+  DAX_EXEC_EXPORT ReturnType GetValueForReading(
+                            const dax::exec::internal::IJKIndex& index,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    const dax::Id3 ijk = index.GetIJK();
+    const dax::Id3 dims = index.GetDims();
+    if(ijk[0] == this->RowIJK[0] + 1 &&
+       ijk[1] == this->RowIJK[1] &&
+       ijk[2] == this->RowIJK[2])
+      {
+      this->ShiftRowValue(ijk, dims, work);
+      }
+    else
+      {
+      this->GatherRowValue(ijk, dims, work);
+      }
+    this->RowValue.SetCenter(ijk, dims);
+    this->RowIJK = ijk;
+    return this->RowValue;
+    }
+
+  DAX_EXEC_EXPORT void SaveValue(int,
+                        const dax::exec::internal::WorkletBase&) const
+    {
+    }
+
+  DAX_EXEC_EXPORT void SaveValue(int, const SaveType&,
+                        const dax::exec::internal::WorkletBase&) const
+    {
+    }
+
+private:
+  DAX_EXEC_EXPORT static dax::Id Clamp(dax::Id index, dax::Id size)
+    {
+    return (index < 0) ? 0 : ((index < size) ? index : size - 1);
+    }
+
+  // Index of the first point of the row at offsets (dj, dk) from the center.
+  DAX_EXEC_EXPORT static dax::Id RowStart(const dax::Id3& ijk,
+                                          const dax::Id3& dims,
+                                          int dj,
+                                          int dk)
+    {
+    return dims[0]*(Clamp(ijk[1] + dj, dims[1]) +
+                    dims[1]*Clamp(ijk[2] + dk, dims[2]));
+    }
+
+  DAX_EXEC_EXPORT void GatherRowValue(
+                            const dax::Id3& ijk,
+                            const dax::Id3& dims,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    for(int dk = -RADIUS; dk <= RADIUS; ++dk)
+      {
+      for(int dj = -RADIUS; dj <= RADIUS; ++dj)
+        {
+        const dax::Id rowStart = RowStart(ijk, dims, dj, dk);
+        for(int di = -RADIUS; di <= RADIUS; ++di)
+          {
+          this->RowValue.Get(di, dj, dk) =
+              this->ExecArg(rowStart + Clamp(ijk[0] + di, dims[0]), work);
+          }
+        }
+      }
+    }
+
+  DAX_EXEC_EXPORT void ShiftRowValue(
+                            const dax::Id3& ijk,
+                            const dax::Id3& dims,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    const dax::Id newI = Clamp(ijk[0] + RADIUS, dims[0]);
+    for(int dk = -RADIUS; dk <= RADIUS; ++dk)
+      {
+      for(int dj = -RADIUS; dj <= RADIUS; ++dj)
+        {
+        for(int di = -RADIUS; di < RADIUS; ++di)
+          {
+          this->RowValue.Get(di, dj, dk) = this->RowValue.Get(di+1, dj, dk);
+          }
+        this->RowValue.Get(RADIUS, dj, dk) =
+            this->ExecArg(RowStart(ijk, dims, dj, dk) + newI, work);
+        }
+      }
+    }
+
+  ExecArgType ExecArg;
+  mutable ValueType RowValue;
+  mutable dax::Id3 RowIJK;
+};
+
+//the traits for BindPointNeighborhood
+template <typename Invocation, int N >
+struct ArgBaseTraits< BindPointNeighborhood<Invocation, N> >
+{
+private:
+  typedef dax::exec::arg::BindInfo<N,Invocation> MyInfo;
+  typedef typename MyInfo::Tags Tags;
+public:
+  typedef typename MyInfo::ExecArgType ExecArgType;
+
+  typedef ::boost::false_type HasOutTag;
+
+  typedef typename ::boost::mpl::if_<typename Tags::template Has<dax::cont::sig::In>,
+                                   ::boost::true_type,
+                                   ::boost::false_type>::type HasInTag;
+
+  typedef dax::exec::Neighborhood<
+      typename ExecArgType::ValueType,
+      Invocation::Worklet::NEIGHBORHOOD_RADIUS> ValueType;
+  typedef const ValueType& ReturnType;
+  typedef ValueType SaveType;
+};
+
+}}} // namespace dax::exec::arg
+
+#endif // !defined(DAX_DOXYGEN_ONLY)
+#endif //__dax_exec_arg_BindPointNeighborhood_h
@@ -0,0 +1,193 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_FieldBatch_h
+#define __dax_exec_arg_FieldBatch_h
+
+#include <dax/Types.h>
+#include <dax/VectorTraits.h>
+
+#include <dax/exec/arg/ArgBase.h>
+#include <dax/exec/arg/BindDirect.h>
+#include <dax/exec/arg/BindWorkId.h>
+#include <dax/exec/arg/FieldConstant.h>
+#include <dax/exec/arg/FieldPortal.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <boost/mpl/if.hpp>
+
+namespace dax { namespace exec { namespace arg {
+
+/// \headerfile FieldBatch.h dax/exec/arg/FieldBatch.h
+/// \brief Execution argument that hands a worklet the values of \c N
+/// consecutive indices at once.
+///
+/// A \c FieldBatch wraps the execution argument \c ExecArgType of a worklet
+/// invoked one index at a time. Its index is the first of the \c N indices
+/// and its values are a dax::Tuple with one component per index. The index is
+/// either a dax::Id or, when scheduled over a grid, the IJKIndex of the first
+/// of \c N consecutive indices in a row. Only the arguments of map field
+/// worklets (arrays, constants, and the work id) can be batched.
+///
+template<typename ExecArgType, int N> class FieldBatch;
+
+template<typename Invocation, int Index, int N>
+class FieldBatch<dax::exec::arg::BindDirect<Invocation,Index>, N>
+  : public FieldBatch<
+      typename dax::exec::arg::BindDirect<Invocation,Index>::ExecArgType, N>
+{
+  typedef FieldBatch<
+      typename dax::exec::arg::BindDirect<Invocation,Index>::ExecArgType, N>
+    Superclass;
+public:
+  DAX_EXEC_CONT_EXPORT FieldBatch(
+      const dax::exec::arg::BindDirect<Invocation,Index> &binding):
+    Superclass(binding.GetExecArg()) {  }
+};
+
+template<typename T, typename Tags, typename PortalType, int N>
+class FieldBatch<dax::exec::arg::FieldPortal<T,Tags,PortalType>, N>
+{
+  typedef dax::exec::arg::FieldPortal<T,Tags,PortalType> ExecArgType;
+  typedef dax::exec::arg::ArgBaseTraits<ExecArgType> Traits;
+  typedef typename Traits::HasInTag HasInTag;
+  typedef typename Traits::HasOutTag HasOutTag;
+
+public:
+  typedef dax::Tuple<typename Traits::ValueType,N> ValueType;
+  typedef typename ::boost::mpl::if_<typename HasOutTag::type,
+                                   ValueType&,
+                                   ValueType const&>::type ReturnType;
+  typedef ValueType SaveType;
+
+  DAX_EXEC_CONT_EXPORT FieldBatch(const ExecArgType &execArg):
+    ExecArg(execArg),
+    Values(typename Traits::ValueType(
+             typename dax::VectorTraits<
+               typename Traits::ValueType>::ComponentType()))
+    {
+    }
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType operator()(
+                            const IndexType& start,
+                            const dax::exec::internal::WorkletBase& work)
+    {
+    this->ReadValues(start, work, HasInTag());
+    return this->Values;
+    }
+
+  DAX_EXEC_EXPORT void SaveExecutionResult(
+                            dax::Id start,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    this->SaveValues(start, work, HasOutTag());
+    }
+
+private:
+  template<typename IndexType>
+  DAX_EXEC_EXPORT void ReadValues(const IndexType& start,
+                                  const dax::exec::internal::WorkletBase& work,
+                                  ::boost::true_type)
+    {
+    this->ExecArg.GetBatch(start, this->Values, work);
+    }
+  template<typename IndexType>
+  DAX_EXEC_EXPORT void ReadValues(const IndexType&,
+                                  const dax::exec::internal::WorkletBase&,
+                                  ::boost::false_type)
+    {
+    }
+
+  DAX_EXEC_EXPORT void SaveValues(dax::Id start,
+                                  const dax::exec::internal::WorkletBase& work,
+                                  ::boost::true_type) const
+    {
+    this->ExecArg.SaveBatch(start, this->Values, work);
+    }
+  DAX_EXEC_EXPORT void SaveValues(dax::Id,
+                                  const dax::exec::internal::WorkletBase&,
+                                  ::boost::false_type) const
+    {
+    }
+
+  ExecArgType ExecArg;
+  ValueType Values;
+};
+
+template<typename T, int N>
+class FieldBatch<dax::exec::arg::FieldConstant<T>, N>
+{
+public:
+  typedef dax::Tuple<T,N> ValueType;
+  typedef ValueType const& ReturnType;
+  typedef ValueType SaveType;
+
+  DAX_EXEC_CONT_EXPORT FieldBatch(
+      const dax::exec::arg::FieldConstant<T> &execArg):
+    Values(execArg(0, dax::exec::internal::WorkletBase()))
+    {
+    }
+
+  DAX_EXEC_EXPORT ReturnType operator()(
+                            dax::Id,
+                            const dax::exec::internal::WorkletBase&) const
+    {
+    return this->Values;
+    }
+
+  DAX_EXEC_EXPORT void SaveExecutionResult(
+                            dax::Id,
+                            const dax::exec::internal::WorkletBase&) const
+    {
+    }
+
+private:
+  ValueType Values;
+};
+
+template<typename Invocation, int N>
+class FieldBatch<dax::exec::arg::BindWorkId<Invocation>, N>
+{
+public:
+  typedef dax::Tuple<dax::Id,N> ValueType;
+  typedef ValueType ReturnType;
+  typedef ValueType SaveType;
+
+  DAX_EXEC_CONT_EXPORT FieldBatch(
+      const dax::exec::arg::BindWorkId<Invocation> &) {  }
+
+  DAX_EXEC_EXPORT ReturnType operator()(
+                            dax::Id start,
+                            const dax::exec::internal::WorkletBase&) const
+    {
+    ValueType ids;
+    for(int lane = 0; lane < N; ++lane)
+      {
+      ids[lane] = start + lane;
+      }
+    return ids;
+    }
+
+  DAX_EXEC_EXPORT void SaveExecutionResult(
+                            dax::Id,
+                            const dax::exec::internal::WorkletBase&) const
+    {
+    }
+};
+
+}}} // namespace dax::exec::arg
+
+#endif //__dax_exec_arg_FieldBatch_h
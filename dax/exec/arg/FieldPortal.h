@@ -75,6 +75,56 @@ public:
     dax::exec::internal::FieldSet(Portal,index,v,work);
     }
 
+  /// Reads the values at the \c N consecutive indices starting at \c start.
+  /// Used when a worklet is invoked on a batch of indices (see FieldBatch).
+  ///
+  template<int N>
+  DAX_EXEC_EXPORT void GetBatch(dax::Id start,
+                                dax::Tuple<ValueType,N> &values,
+                                const dax::exec::internal::WorkletBase& work) const
+    {
+    for(int lane = 0; lane < N; ++lane)
+      {
+      values[lane] = dax::exec::internal::FieldGet(this->Portal,
+                                                   start + lane,
+                                                   work);
+      }
+    }
+
+  /// Reads the values at the \c N consecutive indices of a row starting at
+  /// \c start. Each value is read through its location, so portals with IJK
+  /// access do not split the flat index.
+  ///
+  template<int N>
+  DAX_EXEC_EXPORT void GetBatch(const dax::exec::internal::IJKIndex &start,
+                                dax::Tuple<ValueType,N> &values,
+                                const dax::exec::internal::WorkletBase& work) const
+    {
+    dax::exec::internal::IJKIndex index(start);
+    const dax::Id iStart = start.GetIJK()[0];
+    for(int lane = 0; lane < N; ++lane)
+      {
+      index.SetI(iStart + lane);
+      values[lane] = dax::exec::internal::FieldGet(this->Portal, index, work);
+      }
+    }
+
+  /// Writes the values at the \c N consecutive indices starting at \c start.
+  ///
+  template<int N>
+  DAX_EXEC_EXPORT void SaveBatch(dax::Id start,
+                                 const dax::Tuple<ValueType,N> &values,
+                                 const dax::exec::internal::WorkletBase& work) const
+    {
+    for(int lane = 0; lane < N; ++lane)
+      {
+      dax::exec::internal::FieldSet(this->Portal,
+                                    start + lane,
+                                    values[lane],
+                                    work);
+      }
+    }
+
 private:
   ValueType Value;
   PortalType Portal;
@@ -33,6 +33,8 @@
 #include <dax/exec/arg/BindCellTag.h>
 #include <dax/exec/arg/BindDirect.h>
 #include <dax/exec/arg/BindPermutedCellField.h>
+#include <dax/exec/arg/BindPointCellField.h>
+#include <dax/exec/arg/BindPointNeighborhood.h>
 #include <dax/exec/arg/BindWorkId.h>
 #include <dax/exec/arg/BindKeyGroup.h>
 #include <dax/Types.h>
@@ -88,6 +90,42 @@ public:
     >::type type;
 };
 
+//specialize on arg to field mapping, with Field(PointNeighborhood) being
+//read as the neighborhood of each point instead of a single value
+template<typename Tags,
+         typename Invocation,
+         int N>
+class BindArg<dax::cont::sig::AnyDomain,
+              dax::cont::arg::Field(Tags),
+              Invocation,
+              N>
+{
+public:
+  typedef typename boost::mpl::if_<
+    typename Tags::template Has<dax::cont::sig::PointNeighborhood>,
+    BindPointNeighborhood<Invocation, N>,
+    BindDirect<Invocation, N>
+    >::type type;
+};
+
+//specialize on arg to field mapping when visiting points, with Field(Cell)
+//being read as the values of the cells incident to the point
+template<typename Tags,
+         typename Invocation,
+         int N>
+class BindArg<dax::cont::sig::Point,
+              dax::cont::arg::Field(Tags),
+              Invocation,
+              N>
+{
+public:
+  typedef typename boost::mpl::if_<
+    typename Tags::template Has<dax::cont::sig::Cell>,
+    BindPointCellField<Invocation, N>,
+    BindDirect<Invocation, N>
+    >::type type;
+};
+
 //specialize on arg to field mapping when the cells are being permuted
 template<typename Tags,
          typename Invocation,
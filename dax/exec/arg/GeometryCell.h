@@ -23,10 +23,10 @@
 #include <dax/CellTag.h>
 
 #include <dax/exec/arg/ArgBase.h>
+#include <dax/exec/CellField.h>
 #include <dax/exec/CellVertices.h>
 #include <dax/exec/internal/FieldAccess.h>
 #include <dax/exec/internal/WorkletBase.h>
-#include <dax/exec/InterpolatedCellPoints.h>
 
 #include <boost/mpl/if.hpp>
 #include <boost/utility/enable_if.hpp>
@@ -107,7 +107,8 @@ struct ArgBaseTraits< dax::exec::arg::GeometryCell< Tags, TopologyType, PortalTy
                                    ::boost::true_type,
                                    ::boost::false_type>::type HasInTag;
 
-  typedef dax::exec::InterpolatedCellPoints<typename TopologyType::CellTag> ValueType;
+  typedef dax::exec::CellField<dax::Vector3,
+                              typename TopologyType::CellTag> ValueType;
 
   typedef typename boost::mpl::if_<typename HasOutTag::type,
                                    ValueType&,
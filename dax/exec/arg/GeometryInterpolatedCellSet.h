@@ -0,0 +1,127 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_GeometryInterpolatedCellSet_h
+#define __dax_exec_arg_GeometryInterpolatedCellSet_h
+#if defined(DAX_DOXYGEN_ONLY)
+
+#else // !defined(DAX_DOXYGEN_ONLY)
+
+#include <dax/Types.h>
+#include <dax/CellTag.h>
+
+#include <dax/exec/arg/ArgBase.h>
+#include <dax/exec/internal/FieldAccess.h>
+#include <dax/exec/internal/WorkletBase.h>
+#include <dax/exec/InterpolatedCellPoints.h>
+
+#include <boost/type_traits/integral_constant.hpp>
+
+namespace dax { namespace exec { namespace arg {
+
+/// Geometry parameter that collects the set of interpolated cells a worklet
+/// generates from an input cell and appends their records to the room of the
+/// block of the input cell. The cells of a block must be invoked in order by
+/// the same thread: the first cell of a block starts its count at zero and
+/// every other cell continues from the count the cell before it left.
+///
+template <typename Tags, typename _CellTag, int MaxCells,
+          typename PortalType, typename CountPortalType>
+class GeometryInterpolatedCellSet
+  : public dax::exec::arg::ArgBase<
+      GeometryInterpolatedCellSet<Tags,_CellTag,MaxCells,
+                                  PortalType,CountPortalType> >
+{
+public:
+  //needed for cell type binding to be public
+  typedef _CellTag CellTag;
+
+  typedef dax::exec::arg::ArgBaseTraits<
+      GeometryInterpolatedCellSet<Tags,CellTag,MaxCells,
+                                  PortalType,CountPortalType> > Traits;
+
+  typedef typename Traits::ValueType ValueType;
+  typedef typename Traits::ReturnType ReturnType;
+  typedef typename Traits::SaveType SaveType;
+
+  DAX_CONT_EXPORT GeometryInterpolatedCellSet(const PortalType& p,
+                                              const CountPortalType& counts,
+                                              dax::Id blockSize):
+    Portal(p),
+    BlockCounts(counts),
+    BlockSize(blockSize),
+    Cells()
+    {
+    }
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType GetValueForWriting(const IndexType&,
+                            const dax::exec::internal::WorkletBase&)
+    { return this->Cells; }
+
+  DAX_EXEC_EXPORT void SaveValue(dax::Id index,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    this->SaveValue(index,this->Cells,work);
+    }
+
+  DAX_EXEC_EXPORT void SaveValue(dax::Id index,
+                            const SaveType& values,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    const dax::Id block = index / this->BlockSize;
+    const dax::Id count = (index % this->BlockSize == 0) ? 0 :
+      dax::exec::internal::FieldGet(this->BlockCounts, block, work);
+
+    const dax::Id blockStart = block * this->BlockSize * MaxCells;
+    for(int cell = 0; cell < values.GetNumberOfCells(); ++cell)
+      {
+      dax::exec::internal::FieldSetMultiple(
+            this->Portal,
+            (blockStart + count + cell) * ValueType::NUM_VERTICES,
+            values[cell].GetAsTuple(),
+            work);
+      }
+    dax::exec::internal::FieldSet(this->BlockCounts,
+                                  block,
+                                  count + values.GetNumberOfCells(),
+                                  work);
+    }
+private:
+  PortalType Portal;
+  CountPortalType BlockCounts;
+  dax::Id BlockSize;
+  ValueType Cells;
+};
+
+//the traits for GeometryInterpolatedCellSet
+template <typename Tags, typename CellTag, int MaxCells,
+          typename PortalType, typename CountPortalType>
+struct ArgBaseTraits<
+    dax::exec::arg::GeometryInterpolatedCellSet<
+      Tags, CellTag, MaxCells, PortalType, CountPortalType > >
+{
+  typedef boost::true_type HasOutTag;
+  typedef boost::false_type HasInTag;
+
+  typedef dax::exec::InterpolatedCellSet<CellTag,MaxCells> ValueType;
+  typedef ValueType& ReturnType;
+  typedef ValueType SaveType;
+};
+
+}}} // namespace dax::exec::arg
+
+#endif // !defined(DAX_DOXYGEN_ONLY)
+#endif //__dax_exec_arg_GeometryInterpolatedCellSet_h
@@ -0,0 +1,81 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_arg_TopologyPointCells_h
+#define __dax_exec_arg_TopologyPointCells_h
+
+#include <dax/Types.h>
+
+#include <dax/exec/arg/ArgBase.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/mpl/if.hpp>
+
+namespace dax { namespace exec { namespace arg {
+
+/// Execution argument of a topology visited by point. Reading it gives the
+/// cells incident to the point. It is input only.
+///
+template <typename Tags, typename TopologyType>
+class TopologyPointCells
+    : public dax::exec::arg::ArgBase< TopologyPointCells<Tags, TopologyType> >
+{
+public:
+  //needed for cell type binding to be public
+  typedef typename TopologyType::CellTag CellTag;
+
+  typedef dax::exec::arg::ArgBaseTraits<
+      TopologyPointCells< Tags, TopologyType > > Traits;
+
+  typedef typename Traits::ValueType ValueType;
+  typedef typename Traits::ReturnType ReturnType;
+  typedef typename Traits::SaveType SaveType;
+
+  DAX_CONT_EXPORT TopologyPointCells(const TopologyType& t):
+    Topo(t)
+    {
+    }
+
+  template<typename IndexType>
+  DAX_EXEC_EXPORT ReturnType GetValueForReading(
+                            const IndexType& index,
+                            const dax::exec::internal::WorkletBase& work) const
+    {
+    (void)work;  // Shut up compiler.
+    DAX_ASSERT_EXEC(index >= 0, work);
+    DAX_ASSERT_EXEC(index < Topo.GetNumberOfPoints(), work);
+    return this->Topo.GetPointCells(index);
+    }
+
+private:
+  TopologyType Topo;
+};
+
+//the traits for TopologyPointCells
+template <typename Tags, typename TopologyType>
+struct ArgBaseTraits< dax::exec::arg::TopologyPointCells< Tags, TopologyType > >
+{
+  typedef ::boost::false_type HasOutTag;
+  typedef ::boost::true_type HasInTag;
+
+  typedef typename TopologyType::PointCellsType ValueType;
+  typedef ValueType const ReturnType;
+  typedef ValueType SaveType;
+};
+
+} } } //namespace dax::exec::arg
+
+#endif //__dax_exec_arg_TopologyPointCells_h
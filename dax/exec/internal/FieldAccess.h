@@ -18,6 +18,9 @@
 
 #include <dax/Types.h>
 #include <dax/exec/Assert.h>
+#include <dax/exec/internal/IJKIndex.h>
+
+#include <boost/type_traits/integral_constant.hpp>
 
 namespace dax { namespace exec { namespace internal {
 
@@ -32,6 +35,72 @@ FieldGet(const PortalType &arrayPortal, dax::Id index, const WorkType &work)
   return arrayPortal.Get(index);
 }
 
+/// Portals whose values are a function of an i, j, k location (such as the
+/// point coordinates of a uniform grid) specialize this traits class to set
+/// \c HasIJKAccess to \c boost::true_type. Such portals provide \c
+/// GetIJKDimensions, which returns the dimensions of the structured block the
+/// values are laid out in, and \c GetFromIJK, which returns the value at an
+/// i, j, k location within that block. This lets a value be fetched without
+/// first splitting a flat index into a location.
+///
+template<class PortalType>
+struct ArrayPortalIJKTraits
+{
+  typedef boost::false_type HasIJKAccess;
+};
+
+namespace detail {
+
+template<class PortalType, class WorkType>
+DAX_EXEC_EXPORT
+typename PortalType::ValueType
+FieldGetIJK(const PortalType &arrayPortal,
+            const dax::exec::internal::IJKIndex &index,
+            const WorkType &work,
+            boost::false_type)
+{
+  return FieldGet(arrayPortal, static_cast<dax::Id>(index), work);
+}
+
+template<class PortalType, class WorkType>
+DAX_EXEC_EXPORT
+typename PortalType::ValueType
+FieldGetIJK(const PortalType &arrayPortal,
+            const dax::exec::internal::IJKIndex &index,
+            const WorkType &work,
+            boost::true_type)
+{
+  // The index might be scheduled over a different block than the values are
+  // laid out in (for example cells versus points of the same grid).
+  if (index.GetDims() == arrayPortal.GetIJKDimensions())
+    {
+    DAX_ASSERT_EXEC(static_cast<dax::Id>(index) >= 0, work);
+    DAX_ASSERT_EXEC(
+          static_cast<dax::Id>(index) < arrayPortal.GetNumberOfValues(), work);
+    return arrayPortal.GetFromIJK(index.GetIJK());
+    }
+  else
+    {
+    return FieldGet(arrayPortal, static_cast<dax::Id>(index), work);
+    }
+}
+
+} // namespace detail
+
+template<class PortalType, class WorkType>
+DAX_EXEC_EXPORT
+typename PortalType::ValueType
+FieldGet(const PortalType &arrayPortal,
+         const dax::exec::internal::IJKIndex &index,
+         const WorkType &work)
+{
+  return detail::FieldGetIJK(
+        arrayPortal,
+        index,
+        work,
+        typename ArrayPortalIJKTraits<PortalType>::HasIJKAccess());
+}
+
 template<class PortalType, class WorkType>
 DAX_EXEC_EXPORT
 void FieldSet(const PortalType &arrayPortal,
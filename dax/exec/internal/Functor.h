@@ -18,12 +18,15 @@
 
 # include <dax/Types.h>
 # include <dax/cont/internal/Bindings.h>
+# include <dax/exec/arg/FieldBatch.h>
 # include <dax/exec/arg/FindBinding.h>
+# include <dax/exec/internal/FunctorRange.h>
 # include <dax/exec/internal/IJKIndex.h>
 # include <dax/exec/internal/WorkletBase.h>
 # include <dax/internal/GetNthType.h>
 # include <dax/internal/Members.h>
 
+#include <boost/mpl/bool.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <boost/utility/enable_if.hpp>
 
@@ -41,6 +44,18 @@ struct FunctorMemberMap
   };
 };
 
+template <typename Invocation, int BatchSize>
+struct FunctorBatchMemberMap
+{
+  template <int Id, typename Parameter>
+  struct Get
+  {
+  typedef dax::exec::arg::FieldBatch<
+      typename dax::exec::arg::FindBinding<Invocation, Parameter>::type,
+      BatchSize> type;
+  };
+};
+
 struct FunctorWorkletMemberMap
 {
   template<int N, typename ExecArgType>
@@ -164,6 +179,36 @@ public:
     this->InvokeWorklet(index);
   }
 
+  /// Invokes the worklet on the indices [\c begin, \c end). If the worklet
+  /// declares a \c BATCH_SIZE larger than 1, it is invoked on that many
+  /// consecutive indices at a time and on single indices for the remainder.
+  ///
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id begin, dax::Id end) const
+  {
+    this->InvokeRange(begin,
+                      end,
+                      boost::mpl::bool_<(WorkletType::BATCH_SIZE > 1)>());
+  }
+
+  /// Invokes the worklet on the indices [\c iBegin, \c iEnd) of the row that
+  /// \c index is on. Unlike calling the functor once per index, a single copy
+  /// of the arguments is used for the whole row, so execution arguments can
+  /// carry values from one index to the next (see BindCellPoints). If the
+  /// worklet declares a \c BATCH_SIZE larger than 1, the row is invoked in
+  /// batches like a range of dax::Id.
+  ///
+  DAX_EXEC_EXPORT
+  void InvokeRow(dax::exec::internal::IJKIndex &index,
+                 dax::Id iBegin,
+                 dax::Id iEnd) const
+  {
+    this->InvokeRow(index,
+                    iBegin,
+                    iEnd,
+                    boost::mpl::bool_<(WorkletType::BATCH_SIZE > 1)>());
+  }
+
 private:
   WorkletType Worklet;
 
@@ -174,6 +219,96 @@ private:
 
   const ArgumentsType Arguments;
 
+  typedef dax::internal::Members<
+      ExecutionSignature,
+      detail::FunctorBatchMemberMap<Invocation, WorkletType::BATCH_SIZE>
+    > BatchArgumentsType;
+
+  DAX_EXEC_EXPORT
+  void InvokeRange(dax::Id begin, dax::Id end, boost::mpl::false_) const
+  {
+    for (dax::Id index = begin; index < end; ++index)
+      {
+      this->InvokeWorklet(index);
+      }
+  }
+
+  DAX_EXEC_EXPORT
+  void InvokeRange(dax::Id begin, dax::Id end, boost::mpl::true_) const
+  {
+    const dax::Id batchSize = WorkletType::BATCH_SIZE;
+    dax::Id index = begin;
+    if (end - begin >= batchSize)
+      {
+      // The batch arguments hold the values for all lanes, so only make
+      // them once for the whole range.
+      BatchArgumentsType instance(this->Arguments,
+                                  dax::internal::MembersCopyTag(),
+                                  dax::internal::MembersExecContTag());
+      for (; index + batchSize <= end; index += batchSize)
+        {
+        this->DoInvokeWorklet<BatchArgumentsType::FIRST_INDEX>(instance,
+                                                               index);
+        instance.ForEachExec(
+              detail::FunctorSaveArgs<dax::Id>(index, this->Worklet));
+        }
+      }
+    for (; index < end; ++index)
+      {
+      this->InvokeWorklet(index);
+      }
+  }
+
+  DAX_EXEC_EXPORT
+  void InvokeRow(dax::exec::internal::IJKIndex &index,
+                 dax::Id iBegin,
+                 dax::Id iEnd,
+                 boost::mpl::false_) const
+  {
+    typedef dax::exec::internal::IJKIndex IndexType;
+    ArgumentsType instance(this->Arguments);
+    for (dax::Id i = iBegin; i < iEnd; ++i)
+      {
+      index.SetI(i);
+      this->DoInvokeWorklet<ArgumentsType::FIRST_INDEX>(instance, index);
+      instance.ForEachExec(
+            detail::FunctorSaveArgs<IndexType>(index, this->Worklet));
+      }
+  }
+
+  DAX_EXEC_EXPORT
+  void InvokeRow(dax::exec::internal::IJKIndex &index,
+                 dax::Id iBegin,
+                 dax::Id iEnd,
+                 boost::mpl::true_) const
+  {
+    // Consecutive indices of a row are consecutive values, so the row can be
+    // batched the same way as a range. Values that depend on the location
+    // (such as uniform point coordinates) are still read through the IJK.
+    typedef dax::exec::internal::IJKIndex IndexType;
+    const dax::Id batchSize = WorkletType::BATCH_SIZE;
+    dax::Id i = iBegin;
+    if (iEnd - iBegin >= batchSize)
+      {
+      BatchArgumentsType instance(this->Arguments,
+                                  dax::internal::MembersCopyTag(),
+                                  dax::internal::MembersExecContTag());
+      for (; i + batchSize <= iEnd; i += batchSize)
+        {
+        index.SetI(i);
+        this->DoInvokeWorklet<BatchArgumentsType::FIRST_INDEX>(instance,
+                                                               index);
+        instance.ForEachExec(
+              detail::FunctorSaveArgs<IndexType>(index, this->Worklet));
+        }
+      }
+    for (; i < iEnd; ++i)
+      {
+      index.SetI(i);
+      this->InvokeWorklet(index);
+      }
+  }
+
   template<typename IndexType>
   DAX_EXEC_EXPORT
   void InvokeWorklet(IndexType index) const
@@ -192,13 +327,13 @@ private:
           detail::FunctorSaveArgs<IndexType>(index, this->Worklet));
   }
 
-  template<int FirstIndex, typename IndexType>
+  template<int FirstIndex, typename MembersType, typename IndexType>
   DAX_EXEC_EXPORT
   typename boost::enable_if_c<FirstIndex == 0>::type
-  DoInvokeWorklet(ArgumentsType &argumentsInstance,
+  DoInvokeWorklet(MembersType &argumentsInstance,
                   const IndexType &index) const
   {
-    typedef typename ArgumentsType::ReturnType::ReturnType ReturnType;
+    typedef typename MembersType::ReturnType::ReturnType ReturnType;
     argumentsInstance.template Get<0>()(index,this->Worklet) =
         dax::internal::ParameterPackInvokeWithReturnExec<
             typename boost::remove_reference<ReturnType>::type>(
@@ -208,10 +343,10 @@ private:
             index, this->Worklet));
   }
 
-  template<int FirstIndex, typename IndexType>
+  template<int FirstIndex, typename MembersType, typename IndexType>
   DAX_EXEC_EXPORT
   typename boost::enable_if_c<FirstIndex != 0>::type
-  DoInvokeWorklet(ArgumentsType &argumentsInstance,
+  DoInvokeWorklet(MembersType &argumentsInstance,
                   const IndexType &index) const
   {
     dax::internal::ParameterPackInvokeExec(
@@ -222,6 +357,29 @@ private:
   }
 };
 
+template<typename Invocation>
+struct FunctorRange<Functor<Invocation> >
+{
+  DAX_EXEC_EXPORT static void Invoke(const Functor<Invocation> &functor,
+                                     dax::Id begin,
+                                     dax::Id end)
+  {
+    functor(begin, end);
+  }
+};
+
+template<typename Invocation>
+struct IJKIndexRow<Functor<Invocation> >
+{
+  DAX_EXEC_EXPORT static void Invoke(const Functor<Invocation> &functor,
+                                     IJKIndex &index,
+                                     dax::Id iBegin,
+                                     dax::Id iEnd)
+  {
+    functor.InvokeRow(index, iBegin, iEnd);
+  }
+};
+
 }}} // namespace dax::exec::internal
 
 # endif //__dax_exec_internal_Functor_h
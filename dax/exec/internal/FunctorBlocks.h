@@ -0,0 +1,82 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_FunctorBlocks_h
+#define __dax_exec_internal_FunctorBlocks_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+#include <dax/exec/internal/FunctorRange.h>
+
+namespace dax { namespace exec { namespace internal {
+
+/// Wraps a functor scheduled over a range of dax::Id so that it is instead
+/// scheduled over blocks of that range. Each invocation of this functor walks
+/// all the indices of one block in order, so the invocation for an index can
+/// rely on those before it in the block having finished. Functors use this to
+/// append to a buffer kept per block without any synchronization.
+///
+/// Schedule this functor over the number of blocks returned by
+/// GetNumberOfBlocks.
+///
+template<class FunctorType>
+class FunctorBlocks
+{
+public:
+  DAX_CONT_EXPORT FunctorBlocks(const FunctorType &functor,
+                                dax::Id numIndices,
+                                dax::Id blockSize)
+    : Functor(functor),
+      NumberOfIndices(numIndices),
+      BlockSize(blockSize)
+    {  }
+
+  /// Returns the number of blocks of size \c blockSize needed to cover \c
+  /// numIndices indices.
+  ///
+  DAX_EXEC_CONT_EXPORT static dax::Id GetNumberOfBlocks(dax::Id numIndices,
+                                                        dax::Id blockSize)
+  {
+    return (numIndices + blockSize - 1)/blockSize;
+  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &errorMessage)
+  {
+    this->Functor.SetErrorMessageBuffer(errorMessage);
+  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id block) const
+  {
+    const dax::Id begin = block*this->BlockSize;
+    dax::Id end = begin + this->BlockSize;
+    if (end > this->NumberOfIndices)
+      {
+      end = this->NumberOfIndices;
+      }
+    dax::exec::internal::FunctorRange<FunctorType>::Invoke(this->Functor,
+                                                           begin,
+                                                           end);
+  }
+
+private:
+  FunctorType Functor;
+  dax::Id NumberOfIndices;
+  dax::Id BlockSize;
+};
+
+}}} // namespace dax::exec::internal
+
+#endif //__dax_exec_internal_FunctorBlocks_h
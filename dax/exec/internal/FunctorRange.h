@@ -0,0 +1,45 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_FunctorRange_h
+#define __dax_exec_internal_FunctorRange_h
+
+#include <dax/Types.h>
+
+namespace dax { namespace exec { namespace internal {
+
+/// Invokes a functor on the indices [\c begin, \c end). Schedulers iterating
+/// a dax::Id range use this for each chunk of work they hand to a thread. The
+/// default calls the functor once per index. Functors that can process a
+/// whole range more efficiently (for example, by invoking a worklet on
+/// several indices at once) specialize it.
+///
+template<class FunctorType>
+struct FunctorRange
+{
+  DAX_EXEC_EXPORT static void Invoke(const FunctorType &functor,
+                                     dax::Id begin,
+                                     dax::Id end)
+  {
+    for (dax::Id index = begin; index < end; ++index)
+      {
+      functor(index);
+      }
+  }
+};
+
+}}} // namespace dax::exec::internal
+
+#endif //__dax_exec_internal_FunctorRange_h
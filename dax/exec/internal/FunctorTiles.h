@@ -0,0 +1,116 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_FunctorTiles_h
+#define __dax_exec_internal_FunctorTiles_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/ErrorMessageBuffer.h>
+#include <dax/exec/internal/IJKIndex.h>
+
+namespace dax { namespace exec { namespace internal {
+
+/// Wraps a functor scheduled over a dax::Id3 range so that it is instead
+/// scheduled over tiles of that range. Each invocation of this functor walks
+/// all the indices of one tile, a row at a time. Tiles small enough that the
+/// data around them stays in cache make stencil-like access patterns, where
+/// each index reads its neighbors in j and k, reuse the loaded data instead
+/// of streaming planes of it through the cache.
+///
+/// Schedule this functor over the range returned by GetNumberOfTiles. It can
+/// be given either the i, j, k index of a tile or its flat index, so it works
+/// on device adapters that flatten dax::Id3 ranges.
+///
+template<class FunctorType>
+class FunctorTiles
+{
+public:
+  DAX_CONT_EXPORT FunctorTiles(const FunctorType &functor,
+                               const dax::Id3 &dimensions,
+                               const dax::Id3 &tileSize)
+    : Functor(functor),
+      Dimensions(dimensions),
+      TileSize(tileSize),
+      NumberOfTiles(GetNumberOfTiles(dimensions, tileSize))
+    {  }
+
+  /// Returns the number of tiles of size \c tileSize in each direction needed
+  /// to cover a range of \c dimensions.
+  ///
+  DAX_EXEC_CONT_EXPORT static dax::Id3 GetNumberOfTiles(
+      const dax::Id3 &dimensions,
+      const dax::Id3 &tileSize)
+  {
+    return dax::make_Id3((dimensions[0] + tileSize[0] - 1)/tileSize[0],
+                         (dimensions[1] + tileSize[1] - 1)/tileSize[1],
+                         (dimensions[2] + tileSize[2] - 1)/tileSize[2]);
+  }
+
+  DAX_CONT_EXPORT void SetErrorMessageBuffer(
+      const dax::exec::internal::ErrorMessageBuffer &errorMessage)
+  {
+    this->Functor.SetErrorMessageBuffer(errorMessage);
+  }
+
+  DAX_EXEC_EXPORT void operator()(dax::exec::internal::IJKIndex tile) const
+  {
+    this->InvokeTile(tile.GetIJK());
+  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id tileIndex) const
+  {
+    const dax::Id3 &numTiles = this->NumberOfTiles;
+    this->InvokeTile(dax::make_Id3(tileIndex % numTiles[0],
+                                   (tileIndex/numTiles[0]) % numTiles[1],
+                                   tileIndex/(numTiles[0]*numTiles[1])));
+  }
+
+private:
+  DAX_EXEC_EXPORT void InvokeTile(const dax::Id3 &tile) const
+  {
+    dax::Id3 begin;
+    dax::Id3 end;
+    for (int dimension = 0; dimension < 3; ++dimension)
+      {
+      begin[dimension] = tile[dimension]*this->TileSize[dimension];
+      end[dimension] = begin[dimension] + this->TileSize[dimension];
+      if (end[dimension] > this->Dimensions[dimension])
+        {
+        end[dimension] = this->Dimensions[dimension];
+        }
+      }
+
+    dax::exec::internal::IJKIndex index(this->Dimensions);
+    for (dax::Id k = begin[2]; k < end[2]; ++k)
+      {
+      index.SetK(k);
+      for (dax::Id j = begin[1]; j < end[1]; ++j)
+        {
+        index.SetJ(j);
+        dax::exec::internal::IJKIndexRow<FunctorType>::Invoke(
+              this->Functor, index, begin[0], end[0]);
+        }
+      }
+  }
+
+  FunctorType Functor;
+  dax::Id3 Dimensions;
+  dax::Id3 TileSize;
+  dax::Id3 NumberOfTiles;
+};
+
+}}} // namespace dax::exec::internal
+
+#endif //__dax_exec_internal_FunctorTiles_h
@@ -16,6 +16,7 @@
 #ifndef __dax__exec__internal__GridTopologies_h
 #define __dax__exec__internal__GridTopologies_h
 
+#include <dax/exec/internal/TopologyStructured.h>
 #include <dax/exec/internal/TopologyUniform.h>
 #include <dax/exec/internal/TopologyUnstructured.h>
 
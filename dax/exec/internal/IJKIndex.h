@@ -46,6 +46,8 @@ struct IJKIndex
 
   DAX_EXEC_EXPORT const dax::Id3 GetIJK() const { return this->IJK; }
 
+  DAX_EXEC_EXPORT const dax::Id3 GetDims() const { return this->Dims; }
+
   DAX_CONT_EXPORT void SetI(dax::Id v) { this->IJK[0]=v; }
 
   DAX_CONT_EXPORT void SetJ(dax::Id v) { this->IJK[1]=v; this->UpdateCache(); }
@@ -81,6 +83,27 @@ private:
   dax::Id CachedValue;
 };
 
+/// Invokes a functor on the indices [\c iBegin, \c iEnd) of the row that
+/// \c index is on. Schedulers iterating a dax::Id3 range use this for their
+/// innermost loop. The default calls the functor once per index. Functors
+/// that can share work between neighboring indices of a row specialize it.
+///
+template<class FunctorType>
+struct IJKIndexRow
+{
+  DAX_EXEC_EXPORT static void Invoke(const FunctorType &functor,
+                                     IJKIndex &index,
+                                     dax::Id iBegin,
+                                     dax::Id iEnd)
+  {
+    for (dax::Id i = iBegin; i < iEnd; ++i)
+      {
+      index.SetI(i);
+      functor(index);
+      }
+  }
+};
+
 } } }
 
 #endif //__dax_exec_internal_IJKIndex_h
@@ -0,0 +1,147 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_SpaceFillingCurve_h
+#define __dax_exec_internal_SpaceFillingCurve_h
+
+#include <dax/Types.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Tag to order points along a Morton (Z-order) curve. Morton keys are cheap
+/// to compute, but the curve jumps between distant locations at the
+/// boundaries of each octant.
+///
+struct SpaceFillingCurveTagMorton {  };
+
+/// Tag to order points along a Hilbert curve. Hilbert keys take a few more
+/// operations than Morton keys, but consecutive keys are always neighboring
+/// cells of the lattice, so the curve has no jumps.
+///
+struct SpaceFillingCurveTagHilbert {  };
+
+/// The number of bits of each coordinate used to build a key. The three
+/// coordinates together fit in the 32 bits of the smallest dax::Id.
+///
+const int SPACE_FILLING_CURVE_BITS = 10;
+
+namespace detail {
+
+/// Builds a key by interleaving the lowest \c numBits bits of the three
+/// coordinates, taking the bit of coordinate 0 first at each level.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Id InterleaveBits(const dax::Id3 &coords, int numBits)
+{
+  dax::Id key = 0;
+  for (int bit = numBits - 1; bit >= 0; --bit)
+    {
+    for (int component = 0; component < 3; ++component)
+      {
+      key = (key << 1) | ((coords[component] >> bit) & 1);
+      }
+    }
+  return key;
+}
+
+} // namespace detail
+
+/// Returns the index along a Morton curve of the lattice location \c coords.
+/// Each component of \c coords must be in [0, 2^numBits).
+///
+DAX_EXEC_CONT_EXPORT
+dax::Id SpaceFillingCurveKey(const dax::Id3 &coords,
+                             int numBits,
+                             SpaceFillingCurveTagMorton)
+{
+  return detail::InterleaveBits(coords, numBits);
+}
+
+/// Returns the index along a Hilbert curve of the lattice location \c coords.
+/// Each component of \c coords must be in [0, 2^numBits). This uses John
+/// Skilling's method, which transforms the coordinates so that interleaving
+/// their bits gives the Hilbert index.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Id SpaceFillingCurveKey(const dax::Id3 &coords,
+                             int numBits,
+                             SpaceFillingCurveTagHilbert)
+{
+  dax::Id3 x = coords;
+  const dax::Id highBit = dax::Id(1) << (numBits - 1);
+
+  // Inverse undo of the rotations and reflections.
+  for (dax::Id q = highBit; q > 1; q >>= 1)
+    {
+    const dax::Id p = q - 1;
+    for (int component = 0; component < 3; ++component)
+      {
+      if (x[component] & q)
+        {
+        x[0] ^= p;
+        }
+      else
+        {
+        const dax::Id t = (x[0] ^ x[component]) & p;
+        x[0] ^= t;
+        x[component] ^= t;
+        }
+      }
+    }
+
+  // Gray encode.
+  x[1] ^= x[0];
+  x[2] ^= x[1];
+  dax::Id t = 0;
+  for (dax::Id q = highBit; q > 1; q >>= 1)
+    {
+    if (x[2] & q) { t ^= q - 1; }
+    }
+  x[0] ^= t;
+  x[1] ^= t;
+  x[2] ^= t;
+
+  return detail::InterleaveBits(x, numBits);
+}
+
+/// Maps a location inside a bounding box to the lattice used to compute
+/// space filling curve keys. \c scale is the number of lattice steps per unit
+/// length along each axis.
+///
+DAX_EXEC_CONT_EXPORT
+dax::Id3 SpaceFillingCurveQuantize(const dax::Vector3 &location,
+                                   const dax::Vector3 &origin,
+                                   const dax::Vector3 &scale,
+                                   int numBits)
+{
+  const dax::Id maxValue = (dax::Id(1) << numBits) - 1;
+  dax::Id3 coords;
+  for (int component = 0; component < 3; ++component)
+    {
+    dax::Id value = static_cast<dax::Id>(
+          (location[component] - origin[component])*scale[component]);
+    coords[component] =
+        (value < 0) ? 0 : ((value > maxValue) ? maxValue : value);
+    }
+  return coords;
+}
+
+}
+}
+} // namespace dax::exec::internal
+
+#endif //__dax_exec_internal_SpaceFillingCurve_h
@@ -0,0 +1,82 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax__exec__internal__TopologyStructured_h
+#define __dax__exec__internal__TopologyStructured_h
+
+#include <dax/CellTag.h>
+#include <dax/Extent.h>
+
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/PointCells.h>
+#include <dax/exec/internal/TopologyUniform.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+
+/// Contains all the parameters necessary to specify the topology of a
+/// structured (curvilinear) grid. The connections are implicit in the extent
+/// just as they are for a uniform grid, but because the point coordinates are
+/// arbitrary the cells are general hexahedra rather than voxels.
+///
+struct TopologyStructured {
+  typedef dax::CellTagHexahedron CellTag;
+
+  Extent3 Extent;
+
+  /// Returns the number of points in a structured grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    dax::Id3 dims = dax::extentDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  /// Returns the number of cells in a structured grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfCells() const
+  {
+    dax::Id3 dims = dax::extentCellDimensions(this->Extent);
+    return dims[0]*dims[1]*dims[2];
+  }
+
+  template< class IndexType >
+  DAX_EXEC_EXPORT
+  dax::exec::CellVertices<CellTag>
+  GetCellConnections(const IndexType& cellIndex) const
+  {
+    return detail::ComputeImplicitCellConnections<CellTag>(this->Extent,
+                                                           cellIndex);
+  }
+
+  typedef dax::exec::PointCells<detail::ImplicitPointCellsPortal>
+      PointCellsType;
+
+  /// Returns the indices of the cells incident to a point. Nothing is stored
+  /// for this; the cells are found from the i, j, k location of the point.
+  ///
+  DAX_EXEC_EXPORT
+  PointCellsType GetPointCells(dax::Id pointIndex) const
+  {
+    return detail::ComputeImplicitPointCells(this->Extent, pointIndex);
+  }
+};
+
+}  }  } //namespace dax::exec::internal
+
+#endif //__dax__exec__internal__TopologyStructured_h
@@ -21,6 +21,7 @@
 #include <dax/Extent.h>
 
 #include <dax/exec/CellVertices.h>
+#include <dax/exec/PointCells.h>
 #include <dax/exec/internal/IJKIndex.h>
 namespace dax {
 namespace exec {
@@ -67,6 +68,126 @@ public:
 
   dax::Id XDim, FirstPointIndex, SecondPointIndex;
 };
+
+/// \brief Implicit portal of the indices of the cells incident to a point
+///
+/// The cells incident to a point of a uniform grid form a block of at most
+/// 2 x 2 x 2 cells. This portal holds the first cell of the block and its
+/// size, and computes the index of each cell in the block when asked.
+///
+class ImplicitPointCellsPortal
+{
+public:
+  typedef dax::Id ValueType;
+
+  DAX_EXEC_EXPORT
+  ImplicitPointCellsPortal(const dax::Id3 &cellDims,
+                           const dax::Id3 &firstCell,
+                           const dax::Id3 &blockDims)
+    : XDim(cellDims[0]),
+      XYDim(cellDims[0]*cellDims[1]),
+      FirstCellIndex(firstCell[0]
+                     + cellDims[0]*(firstCell[1] + cellDims[1]*firstCell[2])),
+      BlockXDim(blockDims[0]),
+      BlockXYDim(blockDims[0]*blockDims[1])
+  {
+  }
+
+  DAX_EXEC_EXPORT
+  dax::Id Get(dax::Id index) const
+  {
+    const dax::Id k = index / this->BlockXYDim;
+    const dax::Id ij = index - k*this->BlockXYDim;
+    const dax::Id j = ij / this->BlockXDim;
+    const dax::Id i = ij - j*this->BlockXDim;
+    return this->FirstCellIndex + i + j*this->XDim + k*this->XYDim;
+  }
+
+private:
+  dax::Id XDim, XYDim, FirstCellIndex, BlockXDim, BlockXYDim;
+};
+
+/// Computes the indices of the vertices of a cell in a structured grid of
+/// the given extent. The connections of a structured grid are implicit, so
+/// they are the same for any hexahedral cell type.
+///
+template<class CellTag, class IndexType>
+DAX_EXEC_EXPORT
+dax::exec::CellVertices<CellTag>
+ComputeImplicitCellConnections(const dax::Extent3 &extent,
+                               const IndexType &cellIndex);
+
+template<class CellTag>
+DAX_EXEC_EXPORT
+ImplicitCellVertices<CellTag>
+ComputeImplicitVertices(const dax::Extent3 &extent, const dax::Id &cellIndex)
+{
+  return ImplicitCellVertices<CellTag>(
+        dax::extentDimensions(extent),
+        dax::indexToConnectivityIndex(cellIndex, extent));
+}
+
+template<class CellTag>
+DAX_EXEC_EXPORT
+ImplicitCellVertices<CellTag>
+ComputeImplicitVertices(const dax::Extent3 &extent,
+                        const dax::exec::internal::IJKIndex &cellIndex)
+{
+  return ImplicitCellVertices<CellTag>(dax::extentDimensions(extent),
+                                       cellIndex);
+}
+
+template<class CellTag, class IndexType>
+DAX_EXEC_EXPORT
+dax::exec::CellVertices<CellTag>
+ComputeImplicitCellConnections(const dax::Extent3 &extent,
+                               const IndexType &cellIndex)
+{
+  ImplicitCellVertices<CellTag> indices =
+      ComputeImplicitVertices<CellTag>(extent, cellIndex);
+
+  dax::exec::CellVertices<CellTag> values;
+
+  values[0] = indices.FirstPointIndex;
+  values[1] = indices.FirstPointIndex + 1;
+  values[2] = indices.FirstPointIndex + indices.XDim + 1;
+  values[3] = indices.FirstPointIndex + indices.XDim;
+  values[4] = indices.SecondPointIndex;
+  values[5] = indices.SecondPointIndex + 1;
+  values[6] = indices.SecondPointIndex + indices.XDim + 1;
+  values[7] = indices.SecondPointIndex + indices.XDim;
+  return values;
+}
+
+/// Finds the cells incident to a point of a structured grid of the given
+/// extent from the i, j, k location of the point.
+///
+DAX_EXEC_EXPORT
+dax::exec::PointCells<ImplicitPointCellsPortal>
+ComputeImplicitPointCells(const dax::Extent3 &extent, dax::Id pointIndex)
+{
+  const dax::Id3 pointDims = dax::extentDimensions(extent);
+  const dax::Id3 cellDims = dax::extentCellDimensions(extent);
+  const dax::Id3 ijk(pointIndex % pointDims[0],
+                     (pointIndex / pointDims[0]) % pointDims[1],
+                     pointIndex / (pointDims[0]*pointDims[1]));
+
+  // The cells from ijk - 1 to ijk, clipped to the grid.
+  dax::Id3 firstCell;
+  dax::Id3 blockDims;
+  for (int dimension = 0; dimension < 3; ++dimension)
+    {
+    firstCell[dimension] = (ijk[dimension] > 0) ? ijk[dimension] - 1 : 0;
+    const dax::Id lastCell = (ijk[dimension] < cellDims[dimension])
+        ? ijk[dimension] : cellDims[dimension] - 1;
+    blockDims[dimension] = lastCell - firstCell[dimension] + 1;
+    if (blockDims[dimension] < 0) { blockDims[dimension] = 0; }
+    }
+  return dax::exec::PointCells<ImplicitPointCellsPortal>(
+        ImplicitPointCellsPortal(cellDims, firstCell, blockDims),
+        0,
+        blockDims[0]*blockDims[1]*blockDims[2]);
+}
 }
 
 /// Contains all the parameters necessary to specify the topology of a uniform
@@ -119,43 +240,25 @@ DAX_ALIGN_BEGIN(DAX_SIZE_SCALAR) struct TopologyUniform {
     return this->GetPointCoordiantes(ijk);
   }
 
-  DAX_EXEC_EXPORT
-  detail::ImplicitCellVertices<dax::CellTagVoxel>
-  ComputeImplictVertices(const dax::Id& cellIndex) const
-  {
-    typedef detail::ImplicitCellVertices<dax::CellTagVoxel> ReturnType;
-    return ReturnType( dax::extentDimensions(this->Extent),
-                       dax::indexToConnectivityIndex(cellIndex,this->Extent));
-  }
-
-  DAX_EXEC_EXPORT
-  detail::ImplicitCellVertices<dax::CellTagVoxel>
-  ComputeImplictVertices(const dax::exec::internal::IJKIndex& cellIndex) const
-  {
-  typedef detail::ImplicitCellVertices<dax::CellTagVoxel> ReturnType;
-  return ReturnType(dax::extentDimensions(this->Extent), cellIndex);
-  }
-
   template< class IndexType >
   DAX_EXEC_EXPORT
   dax::exec::CellVertices<CellTag>
   GetCellConnections(const IndexType& cellIndex) const
   {
+    return detail::ComputeImplicitCellConnections<CellTag>(this->Extent,
+                                                           cellIndex);
+  }
 
-    typedef detail::ImplicitCellVertices<CellTag> ReturnType;
-    ReturnType indices = this->ComputeImplictVertices(cellIndex);
-
-    dax::exec::CellVertices<CellTag> values;
+  typedef dax::exec::PointCells<detail::ImplicitPointCellsPortal>
+      PointCellsType;
 
-    values[0] = indices.FirstPointIndex;
-    values[1] = indices.FirstPointIndex + 1;
-    values[2] = indices.FirstPointIndex + indices.XDim + 1;
-    values[3] = indices.FirstPointIndex + indices.XDim;
-    values[4] = indices.SecondPointIndex;
-    values[5] = indices.SecondPointIndex + 1;
-    values[6] = indices.SecondPointIndex + indices.XDim + 1;
-    values[7] = indices.SecondPointIndex + indices.XDim;
-    return values;
+  /// Returns the indices of the cells incident to a point. Nothing is stored
+  /// for this; the cells are found from the i, j, k location of the point.
+  ///
+  DAX_EXEC_EXPORT
+  PointCellsType GetPointCells(dax::Id pointIndex) const
+  {
+    return detail::ComputeImplicitPointCells(this->Extent, pointIndex);
   }
 } DAX_ALIGN_END(DAX_SIZE_SCALAR);
 
@@ -19,6 +19,7 @@
 #include <dax/Types.h>
 
 #include <dax/exec/CellVertices.h>
+#include <dax/exec/PointCells.h>
 
 namespace dax {
 namespace exec {
@@ -102,6 +103,53 @@ struct TopologyUnstructured
   }
 };
 
+/// The reverse connectivity of an unstructured grid. For each point it holds
+/// the list of cells that use the point, stored as one array of cell indices
+/// and an array of \c numberOfPoints + 1 offsets into it.
+///
+template<typename T, class IdPortalT>
+struct TopologyUnstructuredPointCells
+{
+  typedef T CellTag;
+  typedef IdPortalT IdPortalType;
+  typedef dax::exec::PointCells<IdPortalType> PointCellsType;
+
+  TopologyUnstructuredPointCells()
+    : Offsets(IdPortalType()), CellIds(IdPortalType()), NumberOfPoints(0)
+    {
+    }
+
+  TopologyUnstructuredPointCells(IdPortalType offsets,
+                                 IdPortalType cellIds,
+                                 dax::Id numberOfPoints)
+    : Offsets(offsets), CellIds(cellIds), NumberOfPoints(numberOfPoints)
+  {
+  }
+
+  IdPortalType Offsets;
+  IdPortalType CellIds;
+  dax::Id NumberOfPoints;
+
+  /// Returns the number of points in a unstructured grid.
+  ///
+  DAX_EXEC_EXPORT
+  dax::Id GetNumberOfPoints() const
+  {
+    return this->NumberOfPoints;
+  }
+
+  /// Returns the indices of the cells incident to a point.
+  ///
+  DAX_EXEC_EXPORT
+  PointCellsType GetPointCells(dax::Id pointIndex) const
+  {
+    const dax::Id start = this->Offsets.Get(pointIndex);
+    return PointCellsType(this->CellIds,
+                          start,
+                          this->Offsets.Get(pointIndex+1) - start);
+  }
+};
+
 } //internal
 } //exec
 } //dax
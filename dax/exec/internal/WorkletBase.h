@@ -37,6 +37,14 @@ class WorkletBase
 public:
   DAX_EXEC_CONT_EXPORT WorkletBase() {  }
 
+  /// The number of consecutive indices the worklet can be invoked on at
+  /// once. A worklet that sets this larger than 1 must also provide an
+  /// operator() that takes a dax::Tuple of \c BATCH_SIZE values in place of
+  /// each argument, one component per index. The batch operator() is only
+  /// used for map field worklets scheduled over a dax::Id range.
+  ///
+  static const int BATCH_SIZE = 1;
+
   DAX_EXEC_EXPORT void RaiseError(const char *message) const
   {
     this->ErrorMessage.RaiseError(message);
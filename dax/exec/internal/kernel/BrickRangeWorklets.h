@@ -0,0 +1,213 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_BrickRangeWorklets_h
+#define __dax_exec_internal_kernel_BrickRangeWorklets_h
+
+#include <dax/Types.h>
+#include <dax/cont/sig/Tag.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Describes how the cells of a uniform grid are split into bricks of
+/// BrickSize^3 cells. The bricks on the upper boundary may be smaller.
+///
+struct BrickLayout
+{
+  dax::Id3 CellDimensions;
+  dax::Id3 NumberOfBricks;
+  dax::Id BrickSize;
+
+  DAX_EXEC_CONT_EXPORT BrickLayout() {  }
+
+  DAX_EXEC_CONT_EXPORT BrickLayout(const dax::Id3 &cellDimensions,
+                                   dax::Id brickSize)
+    : CellDimensions(cellDimensions), BrickSize(brickSize)
+  {
+    for (int dimension = 0; dimension < 3; ++dimension)
+      {
+      this->NumberOfBricks[dimension] =
+          (cellDimensions[dimension] + brickSize - 1)/brickSize;
+      }
+  }
+
+  DAX_EXEC_CONT_EXPORT dax::Id GetNumberOfBricks() const
+  {
+    return this->NumberOfBricks[0]*this->NumberOfBricks[1]
+        *this->NumberOfBricks[2];
+  }
+
+  DAX_EXEC_CONT_EXPORT dax::Id GetCellsPerBrick() const
+  {
+    return this->BrickSize*this->BrickSize*this->BrickSize;
+  }
+
+  /// Returns the i, j, k location of the first cell of a brick.
+  ///
+  DAX_EXEC_CONT_EXPORT dax::Id3 GetFirstCell(dax::Id brick) const
+  {
+    return this->BrickSize*dax::make_Id3(
+          brick % this->NumberOfBricks[0],
+          (brick / this->NumberOfBricks[0]) % this->NumberOfBricks[1],
+          brick / (this->NumberOfBricks[0]*this->NumberOfBricks[1]));
+  }
+
+  /// Returns the index of the first point of the cell at \c ijk.
+  ///
+  DAX_EXEC_CONT_EXPORT dax::Id GetFirstPoint(const dax::Id3 &ijk) const
+  {
+    return ijk[0] + (this->CellDimensions[0] + 1)
+        *(ijk[1] + (this->CellDimensions[1] + 1)*ijk[2]);
+  }
+};
+
+/// Finds the minimum and maximum of the point values of each brick. The
+/// points of a brick are those of its cells, so neighboring bricks share a
+/// layer of points.
+///
+template<class FieldPortalType, class RangePortalType>
+struct ComputeBrickRangesFunctor : dax::exec::internal::WorkletBase
+{
+  FieldPortalType Field;
+  RangePortalType Ranges;
+  BrickLayout Layout;
+
+  DAX_CONT_EXPORT
+  ComputeBrickRangesFunctor(const FieldPortalType &field,
+                            const RangePortalType &ranges,
+                            const BrickLayout &layout)
+    : Field(field), Ranges(ranges), Layout(layout) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id brick) const {
+    const dax::Id3 firstCell = this->Layout.GetFirstCell(brick);
+    dax::Id3 lastPoint;
+    for (int dimension = 0; dimension < 3; ++dimension)
+      {
+      lastPoint[dimension] = firstCell[dimension] + this->Layout.BrickSize;
+      if (lastPoint[dimension] > this->Layout.CellDimensions[dimension])
+        {
+        lastPoint[dimension] = this->Layout.CellDimensions[dimension];
+        }
+      }
+
+    dax::Scalar minValue = this->Field.Get(this->Layout.GetFirstPoint(firstCell));
+    dax::Scalar maxValue = minValue;
+    dax::Id3 ijk;
+    for (ijk[2] = firstCell[2]; ijk[2] <= lastPoint[2]; ++ijk[2])
+      {
+      for (ijk[1] = firstCell[1]; ijk[1] <= lastPoint[1]; ++ijk[1])
+        {
+        ijk[0] = firstCell[0];
+        const dax::Id rowStart = this->Layout.GetFirstPoint(ijk);
+        for (dax::Id i = 0; i <= lastPoint[0] - firstCell[0]; ++i)
+          {
+          const dax::Scalar value = this->Field.Get(rowStart + i);
+          minValue = (value < minValue) ? value : minValue;
+          maxValue = (value > maxValue) ? value : maxValue;
+          }
+        }
+      }
+    this->Ranges.Set(brick, dax::make_Vector2(minValue, maxValue));
+  }
+};
+
+/// Flags the bricks whose range of values intersects the query range.
+///
+template<class RangePortalType, class FlagPortalType>
+struct MarkActiveBricksFunctor : dax::exec::internal::WorkletBase
+{
+  RangePortalType Ranges;
+  FlagPortalType Flags;
+  dax::Vector2 Query;
+
+  DAX_CONT_EXPORT
+  MarkActiveBricksFunctor(const RangePortalType &ranges,
+                          const FlagPortalType &flags,
+                          const dax::Vector2 &query)
+    : Ranges(ranges), Flags(flags), Query(query) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id brick) const {
+    const dax::Vector2 range = this->Ranges.Get(brick);
+    this->Flags.Set(brick, (range[0] <= this->Query[1])
+                           && (range[1] >= this->Query[0]));
+  }
+};
+
+/// Lists the cells of the active bricks. Each index is one cell slot of an
+/// active brick; slots past the boundary of the grid are flagged 0 so that
+/// they can be compacted away.
+///
+template<class BricksPortalType, class IdPortalType>
+struct ActiveBrickCellsFunctor : dax::exec::internal::WorkletBase
+{
+  BricksPortalType ActiveBricks;
+  IdPortalType CellIds;
+  IdPortalType Flags;
+  BrickLayout Layout;
+
+  DAX_CONT_EXPORT
+  ActiveBrickCellsFunctor(const BricksPortalType &activeBricks,
+                          const IdPortalType &cellIds,
+                          const IdPortalType &flags,
+                          const BrickLayout &layout)
+    : ActiveBricks(activeBricks),
+      CellIds(cellIds),
+      Flags(flags),
+      Layout(layout) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    const dax::Id brickSize = this->Layout.BrickSize;
+    const dax::Id cellsPerBrick = this->Layout.GetCellsPerBrick();
+    const dax::Id slot = index % cellsPerBrick;
+    const dax::Id3 ijk = this->Layout.GetFirstCell(
+          this->ActiveBricks.Get(index / cellsPerBrick))
+        + dax::make_Id3(slot % brickSize,
+                        (slot / brickSize) % brickSize,
+                        slot / (brickSize*brickSize));
+    const bool inside = (ijk[0] < this->Layout.CellDimensions[0]) &&
+                        (ijk[1] < this->Layout.CellDimensions[1]) &&
+                        (ijk[2] < this->Layout.CellDimensions[2]);
+    this->Flags.Set(index, inside);
+    this->CellIds.Set(index, ijk[0] + this->Layout.CellDimensions[0]
+                      *(ijk[1] + this->Layout.CellDimensions[1]*ijk[2]));
+  }
+};
+
+/// Wraps a map cell worklet so that it is invoked on a permutation of the
+/// cells of a grid, given to the dispatcher with dax::cont::make_Permutation,
+/// rather than on every cell.
+///
+template<class WorkletType>
+struct PermutedCellWorklet : WorkletType
+{
+  typedef dax::cont::sig::PermutedCell DomainType;
+
+  DAX_CONT_EXPORT PermutedCellWorklet(const WorkletType &worklet)
+    : WorkletType(worklet) {  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_BrickRangeWorklets_h
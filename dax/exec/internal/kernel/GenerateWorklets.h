@@ -16,8 +16,11 @@
 #ifndef __dax_exec_internal_kernel_GenerateWorklets_h
 #define __dax_exec_internal_kernel_GenerateWorklets_h
 
+#include <dax/Pair.h>
 #include <dax/Types.h>
+#include <dax/exec/InterpolatedCellPoints.h>
 #include <dax/exec/WorkletMapField.h>
+#include <dax/exec/internal/WorkletBase.h>
 #include <dax/math/VectorAnalysis.h>
 
 namespace dax {
@@ -60,12 +63,157 @@ struct GetUsedPointsFunctor : public WorkletMapField
   }
 };
 
-template<class InPortalType,
+//Replaces each point id of the cell connections with its new id. Every
+//index only reads and writes its own connection, so the connections are
+//rewritten in place.
+template<class IdConstPortalType, class IdPortalType>
+struct RemapPointIdsFunctor : dax::exec::internal::WorkletBase
+{
+  IdConstPortalType NewPointIds;
+  IdPortalType Connections;
+
+  DAX_CONT_EXPORT
+  RemapPointIdsFunctor(const IdConstPortalType &newPointIds,
+                       const IdPortalType &connections)
+    : NewPointIds(newPointIds), Connections(connections) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    this->Connections.Set(index,
+                          this->NewPointIds.Get(this->Connections.Get(index)));
+  }
+};
+
+//Flags the merged interpolation records that are new points, as opposed to
+//records of an input point to itself.
+template<class RecordPortalType, class IdPortalType>
+struct MarkNewInterpolationRecordsFunctor : dax::exec::internal::WorkletBase
+{
+  RecordPortalType Records;
+  IdPortalType Flags;
+
+  DAX_CONT_EXPORT
+  MarkNewInterpolationRecordsFunctor(const RecordPortalType &records,
+                                     const IdPortalType &flags)
+    : Records(records), Flags(flags) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::exec::InterpolationRecord record = this->Records.Get(index);
+    this->Flags.Set(index, (record.Point1 != record.Point2) ? 1 : 0);
+  }
+};
+
+//Copies the records each block of input cells generated from the front of
+//the block's room to the block's offset in the compacted records.
+template<class RecordConstPortalType,
+         class IdConstPortalType,
+         class OutRecordPortalType>
+struct CompactInterpolatedCellBlocksFunctor : dax::exec::internal::WorkletBase
+{
+  RecordConstPortalType BlockRecords;
+  IdConstPortalType BlockCounts;
+  IdConstPortalType BlockOffsets;
+  OutRecordPortalType Records;
+  dax::Id BlockCapacity;
+  dax::Id NumVertices;
+
+  DAX_CONT_EXPORT CompactInterpolatedCellBlocksFunctor(
+      const RecordConstPortalType &blockRecords,
+      const IdConstPortalType &blockCounts,
+      const IdConstPortalType &blockOffsets,
+      const OutRecordPortalType &records,
+      dax::Id blockCapacity,
+      dax::Id numVertices)
+    : BlockRecords(blockRecords),
+      BlockCounts(blockCounts),
+      BlockOffsets(blockOffsets),
+      Records(records),
+      BlockCapacity(blockCapacity),
+      NumVertices(numVertices) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id block) const
+  {
+    const dax::Id numRecords = this->BlockCounts.Get(block)*this->NumVertices;
+    const dax::Id inStart = block*this->BlockCapacity;
+    const dax::Id outStart = this->BlockOffsets.Get(block)*this->NumVertices;
+    for (dax::Id index = 0; index < numRecords; ++index)
+      {
+      this->Records.Set(outStart + index,
+                        this->BlockRecords.Get(inStart + index));
+      }
+  }
+};
+
+//Writes the record of each input point to itself.
+template<class OutRecordPortalType>
+struct InputPointRecordsFunctor : dax::exec::internal::WorkletBase
+{
+  OutRecordPortalType Records;
+
+  DAX_CONT_EXPORT
+  InputPointRecordsFunctor(const OutRecordPortalType &records)
+    : Records(records) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    this->Records.Set(index, dax::exec::InterpolationRecord(index, index, 0));
+  }
+};
+
+//Gives each merged record its point id when the input points are placed
+//ahead of the new points: a record of an input point to itself is that
+//point, and the new records are written after the input points in order.
+template<class RecordPortalType,
+         class IdConstPortalType,
+         class IdPortalType,
+         class OutRecordPortalType>
+struct PlaceAfterInputPointsFunctor : dax::exec::internal::WorkletBase
+{
+  RecordPortalType Records;
+  IdConstPortalType NewPointOffsets;
+  IdPortalType PointIds;
+  OutRecordPortalType OutRecords;
+  dax::Id NumInputPoints;
+
+  DAX_CONT_EXPORT PlaceAfterInputPointsFunctor(
+      const RecordPortalType &records,
+      const IdConstPortalType &newPointOffsets,
+      const IdPortalType &pointIds,
+      const OutRecordPortalType &outRecords,
+      dax::Id numInputPoints)
+    : Records(records),
+      NewPointOffsets(newPointOffsets),
+      PointIds(pointIds),
+      OutRecords(outRecords),
+      NumInputPoints(numInputPoints) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::exec::InterpolationRecord record = this->Records.Get(index);
+    if (record.Point1 == record.Point2)
+      {
+      this->PointIds.Set(index, record.Point1);
+      }
+    else
+      {
+      const dax::Id pointId =
+          this->NumInputPoints + this->NewPointOffsets.Get(index);
+      this->PointIds.Set(index, pointId);
+      this->OutRecords.Set(pointId, record);
+      }
+  }
+};
+
+template<class RecordPortalType,
+         class InPortalType,
          class OutPortalType >
 struct InterpolateFieldToField
   {
-    DAX_CONT_EXPORT InterpolateFieldToField(const InPortalType &inPortal,
+    DAX_CONT_EXPORT InterpolateFieldToField(const RecordPortalType &records,
+                                            const InPortalType &inPortal,
                                             const OutPortalType &outPortal) :
+    Records(records),
     Input(inPortal),
     Output(outPortal)
     {  }
@@ -73,29 +221,305 @@ struct InterpolateFieldToField
 
     DAX_EXEC_EXPORT void operator()(dax::Id index) const
     {
-      const dax::Vector3 interpolationInfo = this->Output.Get(index);
-      //a vector3 holding the following:
-      // 0 the first id to load from input
-      // 1 the second id to load from input
-      // 2 the weight/ratio to interpolate from the two ids
+      const dax::exec::InterpolationRecord record = this->Records.Get(index);
 
       typedef typename InPortalType::ValueType InValueType;
-      typedef typename OutPortalType::ValueType OutValueType;
 
-      const InValueType first = this->Input.Get(interpolationInfo[0]);
-      const InValueType second = this->Input.Get(interpolationInfo[1]);
+      const InValueType first = this->Input.Get(record.Point1);
+      const InValueType second = this->Input.Get(record.Point2);
 
-      this->Output.Set(index,
-                       dax::math::Lerp(first,second,interpolationInfo[2]) );
+      this->Output.Set(index, dax::math::Lerp(first,second,record.Weight) );
     }
 
     DAX_CONT_EXPORT void SetErrorMessageBuffer(
         const dax::exec::internal::ErrorMessageBuffer &) {  }
 
+    RecordPortalType Records;
     InPortalType Input;
     OutPortalType Output;
   };
 
+//Puts an interpolation record in a canonical order, lowest point id first.
+//Returns true if the record had to be reordered.
+DAX_EXEC_EXPORT
+bool CanonicalInterpolationRecord(dax::exec::InterpolationRecord &record)
+{
+  if (record.Point2 < record.Point1)
+    {
+    record = dax::exec::InterpolationRecord(record.Point2,
+                                            record.Point1,
+                                            1 - record.Weight);
+    return true;
+    }
+  return false;
+}
+
+//Puts an interpolation record in a canonical order, lowest point id first,
+//and computes the key of the edge it lies on. Returns true if the record had
+//to be reordered.
+DAX_EXEC_EXPORT
+bool CanonicalInterpolationEdgeKey(dax::exec::InterpolationRecord &record,
+                                   dax::exec::internal::InterpolationEdgeKey &key)
+{
+  const bool reordered = CanonicalInterpolationRecord(record);
+  key = dax::exec::internal::MakeInterpolationEdgeKey(record.Point1,
+                                                      record.Point2);
+  return reordered;
+}
+
+//Puts each interpolation record in a canonical order and packs the layer of
+//its cell and its two point ids into a single 64 bit key, layer in the
+//highest bits. Each point id takes PointBits bits, so the key only uses
+//its 2*PointBits lowest bits plus those of the layer.
+template<class RecordPortalType, class LayerPortalType, class KeyPortalType>
+struct InterpolationPackedEdgeKeysFunctor : dax::exec::internal::WorkletBase
+{
+  RecordPortalType Records;
+  LayerPortalType Layers;
+  dax::Id NumVerticesPerCell;
+  int PointBits;
+  KeyPortalType Keys;
+
+  DAX_CONT_EXPORT InterpolationPackedEdgeKeysFunctor(
+      const RecordPortalType &records,
+      const LayerPortalType &layers,
+      dax::Id numVerticesPerCell,
+      int pointBits,
+      const KeyPortalType &keys)
+    : Records(records),
+      Layers(layers),
+      NumVerticesPerCell(numVerticesPerCell),
+      PointBits(pointBits),
+      Keys(keys) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    typedef dax::internal::UInt64Type KeyType;
+    dax::exec::InterpolationRecord record = this->Records.Get(index);
+    if (CanonicalInterpolationRecord(record))
+      {
+      this->Records.Set(index, record);
+      }
+    KeyType key = (static_cast<KeyType>(record.Point1) << this->PointBits)
+        | static_cast<KeyType>(record.Point2);
+    //a shift by the full width is undefined, and there is no room for a
+    //layer then anyway
+    if (2*this->PointBits < 64)
+      {
+      key |= static_cast<KeyType>(
+               this->Layers.Get(index / this->NumVerticesPerCell))
+          << (2*this->PointBits);
+      }
+    this->Keys.Set(index, key);
+  }
+};
+
+//Flags the values that have a bit set at or above Bit, treating them as
+//unsigned. Used to find how many bits the values take.
+template<class ValuePortalType, class IdPortalType>
+struct MarkBitsAtOrAboveFunctor : dax::exec::internal::WorkletBase
+{
+  ValuePortalType Values;
+  IdPortalType Flags;
+  int Bit;
+
+  DAX_CONT_EXPORT MarkBitsAtOrAboveFunctor(const ValuePortalType &values,
+                                           const IdPortalType &flags,
+                                           int bit)
+    : Values(values), Flags(flags), Bit(bit) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::internal::UInt64Type value =
+        static_cast<dax::internal::UInt64Type>(this->Values.Get(index));
+    this->Flags.Set(index, (value >> this->Bit) != 0 ? 1 : 0);
+  }
+};
+
+//First step of a radix sort pass on Bit: flags the keys that have a 0 at
+//Bit. The exclusive scan of the flags then places those keys.
+template<class KeyPortalType, class IdPortalType>
+struct RadixZeroFlagsFunctor : dax::exec::internal::WorkletBase
+{
+  KeyPortalType Keys;
+  IdPortalType Flags;
+  int Bit;
+
+  DAX_CONT_EXPORT RadixZeroFlagsFunctor(const KeyPortalType &keys,
+                                        const IdPortalType &flags,
+                                        int bit)
+    : Keys(keys), Flags(flags), Bit(bit) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    this->Flags.Set(index, ((this->Keys.Get(index) >> this->Bit) & 1) ? 0 : 1);
+  }
+};
+
+//Second step of a radix sort pass on Bit: moves the keys with a 0 at Bit
+//ahead of those with a 1, keeping the order within each, and the values
+//along with them. ZeroOffsets is the exclusive scan of the zero flags.
+template<class KeyConstPortalType,
+         class IdConstPortalType,
+         class KeyPortalType,
+         class IdPortalType>
+struct RadixSplitFunctor : dax::exec::internal::WorkletBase
+{
+  KeyConstPortalType Keys;
+  IdConstPortalType Values;
+  IdConstPortalType ZeroOffsets;
+  dax::Id NumZeros;
+  int Bit;
+  KeyPortalType SortedKeys;
+  IdPortalType SortedValues;
+
+  DAX_CONT_EXPORT RadixSplitFunctor(const KeyConstPortalType &keys,
+                                    const IdConstPortalType &values,
+                                    const IdConstPortalType &zeroOffsets,
+                                    dax::Id numZeros,
+                                    int bit,
+                                    const KeyPortalType &sortedKeys,
+                                    const IdPortalType &sortedValues)
+    : Keys(keys),
+      Values(values),
+      ZeroOffsets(zeroOffsets),
+      NumZeros(numZeros),
+      Bit(bit),
+      SortedKeys(sortedKeys),
+      SortedValues(sortedValues) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const typename KeyConstPortalType::ValueType key = this->Keys.Get(index);
+    const dax::Id zerosBefore = this->ZeroOffsets.Get(index);
+    const dax::Id destination = ((key >> this->Bit) & 1)
+        ? this->NumZeros + (index - zerosBefore)
+        : zerosBefore;
+    this->SortedKeys.Set(destination, key);
+    this->SortedValues.Set(destination, this->Values.Get(index));
+  }
+};
+
+//Puts each interpolation record in a canonical order and computes the key of
+//the edge it lies on.
+template<class RecordPortalType, class KeyPortalType>
+struct InterpolationEdgeKeysFunctor : dax::exec::internal::WorkletBase
+{
+  RecordPortalType Records;
+  KeyPortalType Keys;
+
+  DAX_CONT_EXPORT InterpolationEdgeKeysFunctor(const RecordPortalType &records,
+                                               const KeyPortalType &keys)
+    : Records(records), Keys(keys) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    dax::exec::InterpolationRecord record = this->Records.Get(index);
+    dax::exec::internal::InterpolationEdgeKey key;
+    if (CanonicalInterpolationEdgeKey(record, key))
+      {
+      this->Records.Set(index, record);
+      }
+    this->Keys.Set(index, key);
+  }
+};
+
+//Same as InterpolationEdgeKeysFunctor, but pairs each edge key with the layer
+//of the cell the record belongs to, so that records of different layers never
+//share a key.
+template<class RecordPortalType, class LayerPortalType, class KeyPortalType>
+struct InterpolationLayerEdgeKeysFunctor : dax::exec::internal::WorkletBase
+{
+  RecordPortalType Records;
+  LayerPortalType Layers;
+  dax::Id NumVerticesPerCell;
+  KeyPortalType Keys;
+
+  DAX_CONT_EXPORT InterpolationLayerEdgeKeysFunctor(
+      const RecordPortalType &records,
+      const LayerPortalType &layers,
+      dax::Id numVerticesPerCell,
+      const KeyPortalType &keys)
+    : Records(records),
+      Layers(layers),
+      NumVerticesPerCell(numVerticesPerCell),
+      Keys(keys) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    dax::exec::InterpolationRecord record = this->Records.Get(index);
+    dax::exec::internal::InterpolationEdgeKey key;
+    if (CanonicalInterpolationEdgeKey(record, key))
+      {
+      this->Records.Set(index, record);
+      }
+    this->Keys.Set(index,
+          dax::make_Pair(this->Layers.Get(index / this->NumVerticesPerCell),
+                         key));
+  }
+};
+
+//Flags the first entry of each run of equal keys in a sorted key array.
+template<class KeyPortalType, class IdPortalType>
+struct MarkUniqueKeysFunctor : dax::exec::internal::WorkletBase
+{
+  KeyPortalType SortedKeys;
+  IdPortalType Flags;
+
+  DAX_CONT_EXPORT MarkUniqueKeysFunctor(const KeyPortalType &sortedKeys,
+                                        const IdPortalType &flags)
+    : SortedKeys(sortedKeys), Flags(flags) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const bool isFirst = (index == 0) ||
+        (this->SortedKeys.Get(index) != this->SortedKeys.Get(index-1));
+    this->Flags.Set(index, isFirst ? 1 : 0);
+  }
+};
+
+//Given the records sorted by edge key, the original index of each sorted
+//record, the flags of the first record of each edge and their inclusive scan,
+//points each output vertex at its merged point and keeps one record per edge.
+template<class RecordPortalType,
+         class IdConstPortalType,
+         class IdPortalType,
+         class OutRecordPortalType>
+struct MergeInterpolationEdgesFunctor : dax::exec::internal::WorkletBase
+{
+  RecordPortalType Records;
+  IdConstPortalType SortedIndices;
+  IdConstPortalType Flags;
+  IdConstPortalType UniqueIds;
+  IdPortalType Connections;
+  OutRecordPortalType UniqueRecords;
+
+  DAX_CONT_EXPORT MergeInterpolationEdgesFunctor(
+      const RecordPortalType &records,
+      const IdConstPortalType &sortedIndices,
+      const IdConstPortalType &flags,
+      const IdConstPortalType &uniqueIds,
+      const IdPortalType &connections,
+      const OutRecordPortalType &uniqueRecords)
+    : Records(records),
+      SortedIndices(sortedIndices),
+      Flags(flags),
+      UniqueIds(uniqueIds),
+      Connections(connections),
+      UniqueRecords(uniqueRecords) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id index) const
+  {
+    const dax::Id vertexIndex = this->SortedIndices.Get(index);
+    const dax::Id pointId = this->UniqueIds.Get(index) - 1;
+    this->Connections.Set(vertexIndex, pointId);
+    if (this->Flags.Get(index))
+      {
+      this->UniqueRecords.Set(pointId, this->Records.Get(vertexIndex));
+      }
+  }
+};
+
 template< typename ReductionMapType >
 struct Offset2CountFunctor : dax::exec::internal::WorkletBase
 {
@@ -0,0 +1,89 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_MixedCellWorklets_h
+#define __dax_exec_internal_kernel_MixedCellWorklets_h
+
+#include <dax/Types.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Copies the connections of a list of cells of a mixed grid, all with
+/// \c NUM_VERTICES vertices, into the fixed-size layout of a grid with a
+/// single cell type.
+///
+template<int NUM_VERTICES,
+         class CellIdsPortalType,
+         class OffsetsPortalType,
+         class ConnectionsPortalType,
+         class OutConnectionsPortalType>
+struct GatherCellConnectionsFunctor : dax::exec::internal::WorkletBase
+{
+  CellIdsPortalType CellIds;
+  OffsetsPortalType Offsets;
+  ConnectionsPortalType Connections;
+  OutConnectionsPortalType OutConnections;
+
+  GatherCellConnectionsFunctor(const CellIdsPortalType &cellIds,
+                               const OffsetsPortalType &offsets,
+                               const ConnectionsPortalType &connections,
+                               const OutConnectionsPortalType &outConnections)
+    : CellIds(cellIds),
+      Offsets(offsets),
+      Connections(connections),
+      OutConnections(outConnections) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    const dax::Id start = this->Offsets.Get(this->CellIds.Get(index));
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; ++vertexIndex)
+      {
+      this->OutConnections.Set(index*NUM_VERTICES + vertexIndex,
+                               this->Connections.Get(start + vertexIndex));
+      }
+  }
+};
+
+/// Writes the values computed for a list of cells back to the places of
+/// those cells in a field over all the cells of a grid.
+///
+template<class CellIdsPortalType, class InPortalType, class OutPortalType>
+struct ScatterCellFieldFunctor : dax::exec::internal::WorkletBase
+{
+  CellIdsPortalType CellIds;
+  InPortalType InField;
+  OutPortalType OutField;
+
+  ScatterCellFieldFunctor(const CellIdsPortalType &cellIds,
+                          const InPortalType &inField,
+                          const OutPortalType &outField)
+    : CellIds(cellIds), InField(inField), OutField(outField) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    this->OutField.Set(this->CellIds.Get(index), this->InField.Get(index));
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_MixedCellWorklets_h
@@ -0,0 +1,216 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_exec_internal_kernel_ReorderGridWorklets_h
+#define __dax_exec_internal_kernel_ReorderGridWorklets_h
+
+#include <dax/Types.h>
+#include <dax/VectorTraits.h>
+#include <dax/exec/internal/SpaceFillingCurve.h>
+#include <dax/exec/internal/WorkletBase.h>
+
+namespace dax {
+namespace exec {
+namespace internal {
+namespace kernel {
+
+/// Finds the bounds of the points in each chunk of \c CHUNK_SIZE points.
+/// The control environment finishes the reduction over the chunks.
+///
+template<class PointsPortalType, class BoundsPortalType>
+struct PointBoundsFunctor : dax::exec::internal::WorkletBase
+{
+  static const dax::Id CHUNK_SIZE = 1024;
+
+  PointsPortalType Points;
+  BoundsPortalType MinBounds;
+  BoundsPortalType MaxBounds;
+
+  PointBoundsFunctor(const PointsPortalType &points,
+                     const BoundsPortalType &minBounds,
+                     const BoundsPortalType &maxBounds)
+    : Points(points), MinBounds(minBounds), MaxBounds(maxBounds) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id chunk) const {
+    const dax::Id begin = chunk*CHUNK_SIZE;
+    dax::Id end = begin + CHUNK_SIZE;
+    if (end > this->Points.GetNumberOfValues())
+      {
+      end = this->Points.GetNumberOfValues();
+      }
+    dax::Vector3 minBounds = this->Points.Get(begin);
+    dax::Vector3 maxBounds = minBounds;
+    for (dax::Id index = begin + 1; index < end; ++index)
+      {
+      const dax::Vector3 point = this->Points.Get(index);
+      for (int component = 0; component < 3; ++component)
+        {
+        if (point[component] < minBounds[component])
+          {
+          minBounds[component] = point[component];
+          }
+        if (point[component] > maxBounds[component])
+          {
+          maxBounds[component] = point[component];
+          }
+        }
+      }
+    this->MinBounds.Set(chunk, minBounds);
+    this->MaxBounds.Set(chunk, maxBounds);
+  }
+};
+
+/// Computes the space filling curve key of each point.
+///
+template<class CurveTag, class PointsPortalType, class KeysPortalType>
+struct PointCurveKeyFunctor : dax::exec::internal::WorkletBase
+{
+  PointsPortalType Points;
+  KeysPortalType Keys;
+  dax::Vector3 Origin;
+  dax::Vector3 Scale;
+
+  PointCurveKeyFunctor(const PointsPortalType &points,
+                       const KeysPortalType &keys,
+                       const dax::Vector3 &origin,
+                       const dax::Vector3 &scale)
+    : Points(points), Keys(keys), Origin(origin), Scale(scale) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    const int numBits = dax::exec::internal::SPACE_FILLING_CURVE_BITS;
+    this->Keys.Set(index,
+                   dax::exec::internal::SpaceFillingCurveKey(
+                     dax::exec::internal::SpaceFillingCurveQuantize(
+                       this->Points.Get(index),
+                       this->Origin,
+                       this->Scale,
+                       numBits),
+                     numBits,
+                     CurveTag()));
+  }
+};
+
+/// Computes the space filling curve key of the centroid of each cell of a
+/// grid whose cells all have \c NUM_VERTICES vertices.
+///
+template<class CurveTag,
+         int NUM_VERTICES,
+         class ConnectionsPortalType,
+         class PointsPortalType,
+         class KeysPortalType>
+struct CellCurveKeyFunctor : dax::exec::internal::WorkletBase
+{
+  ConnectionsPortalType Connections;
+  PointsPortalType Points;
+  KeysPortalType Keys;
+  dax::Vector3 Origin;
+  dax::Vector3 Scale;
+
+  CellCurveKeyFunctor(const ConnectionsPortalType &connections,
+                      const PointsPortalType &points,
+                      const KeysPortalType &keys,
+                      const dax::Vector3 &origin,
+                      const dax::Vector3 &scale)
+    : Connections(connections),
+      Points(points),
+      Keys(keys),
+      Origin(origin),
+      Scale(scale) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    const int numBits = dax::exec::internal::SPACE_FILLING_CURVE_BITS;
+    dax::Vector3 centroid = dax::make_Vector3(0.0, 0.0, 0.0);
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; ++vertexIndex)
+      {
+      centroid = centroid + this->Points.Get(
+            this->Connections.Get(index*NUM_VERTICES + vertexIndex));
+      }
+    centroid = (dax::Scalar(1)/dax::Scalar(NUM_VERTICES))*centroid;
+    this->Keys.Set(index,
+                   dax::exec::internal::SpaceFillingCurveKey(
+                     dax::exec::internal::SpaceFillingCurveQuantize(
+                       centroid, this->Origin, this->Scale, numBits),
+                     numBits,
+                     CurveTag()));
+  }
+};
+
+/// Writes the inverse of a permutation, so that
+/// Inverse[Permutation[index]] == index.
+///
+template<class PermutationPortalType, class InversePortalType>
+struct InvertPermutationFunctor : dax::exec::internal::WorkletBase
+{
+  PermutationPortalType Permutation;
+  InversePortalType Inverse;
+
+  InvertPermutationFunctor(const PermutationPortalType &permutation,
+                           const InversePortalType &inverse)
+    : Permutation(permutation), Inverse(inverse) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    this->Inverse.Set(this->Permutation.Get(index), index);
+  }
+};
+
+/// Writes the connections of each cell of a reordered grid. Cell \c index
+/// of the new grid is cell CellPermutation[index] of the old grid, and each
+/// of its vertices is renumbered with the new index of that point.
+///
+template<int NUM_VERTICES,
+         class CellPermutationPortalType,
+         class PointInversePortalType,
+         class ConnectionsPortalType,
+         class OutConnectionsPortalType>
+struct PermuteCellConnectionsFunctor : dax::exec::internal::WorkletBase
+{
+  CellPermutationPortalType CellPermutation;
+  PointInversePortalType PointInverse;
+  ConnectionsPortalType Connections;
+  OutConnectionsPortalType OutConnections;
+
+  PermuteCellConnectionsFunctor(
+      const CellPermutationPortalType &cellPermutation,
+      const PointInversePortalType &pointInverse,
+      const ConnectionsPortalType &connections,
+      const OutConnectionsPortalType &outConnections)
+    : CellPermutation(cellPermutation),
+      PointInverse(pointInverse),
+      Connections(connections),
+      OutConnections(outConnections) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id index) const {
+    const dax::Id start = this->CellPermutation.Get(index)*NUM_VERTICES;
+    for (int vertexIndex = 0; vertexIndex < NUM_VERTICES; ++vertexIndex)
+      {
+      this->OutConnections.Set(
+            index*NUM_VERTICES + vertexIndex,
+            this->PointInverse.Get(
+              this->Connections.Get(start + vertexIndex)));
+      }
+  }
+};
+
+}
+}
+}
+} //dax::exec::internal::kernel
+
+#endif //__dax_exec_internal_kernel_ReorderGridWorklets_h
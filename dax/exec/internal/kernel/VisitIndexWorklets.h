@@ -18,6 +18,7 @@
 
 #include <dax/Types.h>
 #include <dax/exec/WorkletMapField.h>
+#include <dax/exec/internal/WorkletBase.h>
 
 namespace dax {
 namespace exec {
@@ -48,6 +49,107 @@ struct ComputeVisitIndex : public WorkletMapField
   }
 };
 
+/// Implicit output to input map of a scatter where every input value generates
+/// the same number of output values.
+///
+struct ConstantScatterInputIndex
+{
+  DAX_EXEC_CONT_EXPORT ConstantScatterInputIndex(dax::Id count = 1)
+    : Count(count) {  }
+
+  DAX_EXEC_CONT_EXPORT dax::Id operator()(dax::Id outIndex) const
+  {
+    return outIndex / this->Count;
+  }
+
+  dax::Id Count;
+};
+
+/// Implicit visit index of a scatter where every input value generates the
+/// same number of output values.
+///
+struct ConstantScatterVisitIndex
+{
+  DAX_EXEC_CONT_EXPORT ConstantScatterVisitIndex(dax::Id count = 1)
+    : Count(count) {  }
+
+  DAX_EXEC_CONT_EXPORT dax::Id operator()(dax::Id outIndex) const
+  {
+    return outIndex % this->Count;
+  }
+
+  dax::Id Count;
+};
+
+/// Fills the output to input map and the visit index of a scatter from the
+/// inclusive scan of the output counts in one pass. Scheduled once per chunk
+/// of CHUNK_SIZE output values so that the work stays balanced whatever the
+/// counts are. Each chunk finds the input value of its first output with a
+/// binary search and then walks forward through the scan.
+///
+template<typename ScanPortalType, typename IdPortalType>
+struct ScatterMapAndVisitIndex : dax::exec::internal::WorkletBase
+{
+  static const dax::Id CHUNK_SIZE = 1024;
+
+  ScanPortalType ScannedCounts;
+  IdPortalType OutputToInputMap;
+  IdPortalType VisitIndex;
+  dax::Id NumberOfOutputValues;
+
+  DAX_CONT_EXPORT
+  ScatterMapAndVisitIndex(const ScanPortalType &scannedCounts,
+                          const IdPortalType &outputToInputMap,
+                          const IdPortalType &visitIndex,
+                          dax::Id numberOfOutputValues)
+    : ScannedCounts(scannedCounts),
+      OutputToInputMap(outputToInputMap),
+      VisitIndex(visitIndex),
+      NumberOfOutputValues(numberOfOutputValues) {  }
+
+  DAX_EXEC_EXPORT
+  void operator()(dax::Id chunk) const
+  {
+    const dax::Id outBegin = chunk*CHUNK_SIZE;
+    const dax::Id outEnd =
+        (outBegin + CHUNK_SIZE < this->NumberOfOutputValues)
+        ? outBegin + CHUNK_SIZE : this->NumberOfOutputValues;
+
+    //the input value generating outBegin is the first one whose inclusive
+    //scan is larger than outBegin
+    dax::Id low = 0;
+    dax::Id high = this->ScannedCounts.GetNumberOfValues();
+    while (low < high)
+      {
+      const dax::Id middle = low + (high - low)/2;
+      if (this->ScannedCounts.Get(middle) <= outBegin)
+        {
+        low = middle + 1;
+        }
+      else
+        {
+        high = middle;
+        }
+      }
+
+    dax::Id input = low;
+    dax::Id inputBegin = (input > 0) ? this->ScannedCounts.Get(input-1) : 0;
+    dax::Id inputEnd = this->ScannedCounts.Get(input);
+    for (dax::Id outIndex = outBegin; outIndex < outEnd; ++outIndex)
+      {
+      //skip over inputs that generate nothing
+      while (outIndex >= inputEnd)
+        {
+        ++input;
+        inputBegin = inputEnd;
+        inputEnd = this->ScannedCounts.Get(input);
+        }
+      this->OutputToInputMap.Set(outIndex, input);
+      this->VisitIndex.Set(outIndex, outIndex - inputBegin);
+      }
+  }
+};
+
 }
 }
 }
@@ -14,12 +14,25 @@
 //
 //=============================================================================
 
+#define DAX_DEVICE_ADAPTER DAX_DEVICE_ADAPTER_SERIAL
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/arg/FieldArrayHandle.h>
 #include <dax/cont/arg/FieldConstant.h>
+#include <dax/cont/arg/TopologyUniformGrid.h>
+#include <dax/cont/dispatcher/CollectCount.h>
+#include <dax/cont/dispatcher/CreateExecutionResources.h>
 #include <dax/cont/internal/Bindings.h>
 #include <dax/cont/sig/Arg.h>
+#include <dax/exec/CellField.h>
+#include <dax/exec/WorkletMapCell.h>
 #include <dax/exec/internal/Functor.h>
 #include <dax/exec/internal/WorkletBase.h>
-#include <dax/testing/Testing.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
 
 namespace {
 using dax::cont::arg::Field;
@@ -36,16 +49,78 @@ struct WorkType1 : public dax::exec::internal::WorkletBase
 struct Worklet1: public WorkType1
 {
   static float TestValue;
+  static int InvokeCount;
   typedef void ControlSignature(FieldIn);
   typedef void ExecutionSignature(_1);
   template <typename T>
   void operator()(T v) const
     {
     TestValue = v;
+    ++InvokeCount;
     }
 };
 
 float Worklet1::TestValue = 0;
+int Worklet1::InvokeCount = 0;
+
+struct Worklet2: public WorkType1
+{
+  static int InvokeCount;
+  static int BatchInvokeCount;
+  static const int BATCH_SIZE = 4;
+  typedef void ControlSignature(FieldIn);
+  typedef void ExecutionSignature(_1);
+  void operator()(float) const
+    {
+    ++InvokeCount;
+    }
+  void operator()(const dax::Tuple<float,BATCH_SIZE> &v) const
+    {
+    const dax::Tuple<float,BATCH_SIZE> expected(2.0f);
+    DAX_TEST_ASSERT(v == expected,
+                    "Batch did not get the constant in every lane.");
+    ++BatchInvokeCount;
+    }
+};
+
+int Worklet2::InvokeCount = 0;
+int Worklet2::BatchInvokeCount = 0;
+
+typedef dax::Tuple<dax::Scalar,8> VoxelValues;
+
+struct CopyCellValues: public dax::exec::WorkletMapCell
+{
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldCellOut);
+  typedef _3 ExecutionSignature(_2);
+  VoxelValues operator()(
+      const dax::exec::CellField<dax::Scalar,dax::CellTagVoxel> &values) const
+    {
+    return values.GetAsTuple();
+    }
+};
+
+typedef dax::cont::ArrayHandle<dax::Scalar> ScalarHandle;
+typedef dax::cont::ArrayHandle<VoxelValues> VoxelValuesHandle;
+typedef dax::internal::ParameterPack<
+    dax::cont::UniformGrid<>, ScalarHandle, VoxelValuesHandle> GatherParameters;
+typedef dax::internal::Invocation<CopyCellValues,GatherParameters>
+    GatherInvocation;
+typedef dax::cont::internal::Bindings<GatherInvocation>::type GatherBindings;
+
+GatherBindings BindGather(const dax::cont::UniformGrid<> &grid,
+                          const ScalarHandle &field,
+                          const VoxelValuesHandle &output)
+{
+  GatherBindings bindings = dax::cont::internal::BindingsCreate(
+        CopyCellValues(),
+        dax::internal::make_ParameterPack(grid, field, output));
+  dax::Id count = 1;
+  bindings.ForEachCont(
+        dax::cont::dispatcher::CollectCount<CopyCellValues::DomainType>(count));
+  bindings.ForEachCont(
+        dax::cont::dispatcher::CreateExecutionResources(count));
+  return bindings;
+}
 
 void Functor()
 {
@@ -58,11 +133,132 @@ void Functor()
   dax::exec::internal::Functor<Invocation1> f1(w1, b1);
   f1(0);
   DAX_TEST_ASSERT(Worklet1::TestValue == 1.0f, "TestValue is not 1.0f");
+
+  Worklet1::InvokeCount = 0;
+  dax::exec::internal::IJKIndex index(dax::make_Id3(8, 4, 2),
+                                      dax::make_Id3(0, 1, 1));
+  dax::exec::internal::IJKIndexRow<
+      dax::exec::internal::Functor<Invocation1> >::Invoke(f1, index, 2, 7);
+  DAX_TEST_ASSERT(Worklet1::InvokeCount == 5,
+                  "Row did not invoke the worklet once per index.");
+  DAX_TEST_ASSERT(index.GetIJK() == dax::make_Id3(6, 1, 1),
+                  "Row did not end on the last index.");
+
+  typedef dax::internal::Invocation<Worklet2,dax::internal::ParameterPack<float> > Invocation2;
+  typedef dax::cont::internal::Bindings<Invocation2>::type Bindings2;
+  Bindings2 b2(2.0f,
+               dax::internal::MembersInitialArgumentTag(),
+               dax::internal::MembersExecContTag());
+  Worklet2 w2;
+  dax::exec::internal::Functor<Invocation2> f2(w2, b2);
+  dax::exec::internal::FunctorRange<
+      dax::exec::internal::Functor<Invocation2> >::Invoke(f2, 5, 16);
+  DAX_TEST_ASSERT(Worklet2::BatchInvokeCount == 2,
+                  "Range was not invoked in batches.");
+  DAX_TEST_ASSERT(Worklet2::InvokeCount == 3,
+                  "Remainder of range was not invoked one index at a time.");
+
+  Worklet2::InvokeCount = 0;
+  Worklet2::BatchInvokeCount = 0;
+  dax::exec::internal::IJKIndex rowIndex(dax::make_Id3(32, 4, 2),
+                                         dax::make_Id3(0, 2, 1));
+  dax::exec::internal::IJKIndexRow<
+      dax::exec::internal::Functor<Invocation2> >::Invoke(f2, rowIndex, 3, 22);
+  DAX_TEST_ASSERT(Worklet2::BatchInvokeCount == 4,
+                  "Row was not invoked in batches.");
+  DAX_TEST_ASSERT(Worklet2::InvokeCount == 3,
+                  "Remainder of row was not invoked one index at a time.");
+}
+
+void FunctorRowGather()
+{
+  // Walking a row of voxels carries the shared face of the previous voxel
+  // forward. It must give the same values as gathering each voxel on its own,
+  // also for the first voxel of a row and rows split into tiles.
+  const dax::Id3 cellDims = dax::make_Id3(7, 3, 2);
+  dax::cont::UniformGrid<> grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), cellDims);
+  const dax::Id3 pointDims = cellDims + dax::make_Id3(1, 1, 1);
+  const dax::Id numCells = cellDims[0]*cellDims[1]*cellDims[2];
+
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (std::size_t pointIndex = 0; pointIndex < field.size(); ++pointIndex)
+    {
+    field[pointIndex] = static_cast<dax::Scalar>(pointIndex*pointIndex % 97);
+    }
+  ScalarHandle fieldHandle = dax::cont::make_ArrayHandle(field);
+
+  VoxelValuesHandle cellValues;
+  GatherBindings cellBindings = BindGather(grid, fieldHandle, cellValues);
+  dax::exec::internal::Functor<GatherInvocation> cellFunctor(
+        CopyCellValues(), cellBindings);
+
+  VoxelValuesHandle rowValues;
+  GatherBindings rowBindings = BindGather(grid, fieldHandle, rowValues);
+  dax::exec::internal::Functor<GatherInvocation> rowFunctor(
+        CopyCellValues(), rowBindings);
+
+  const dax::Id tileBreaks[] = { 0, 1, 4, cellDims[0] };
+  dax::exec::internal::IJKIndex cellIndex(cellDims);
+  dax::exec::internal::IJKIndex rowIndex(cellDims);
+  for (dax::Id k = 0; k < cellDims[2]; ++k)
+    {
+    cellIndex.SetK(k);
+    rowIndex.SetK(k);
+    for (dax::Id j = 0; j < cellDims[1]; ++j)
+      {
+      cellIndex.SetJ(j);
+      for (dax::Id i = 0; i < cellDims[0]; ++i)
+        {
+        cellIndex.SetI(i);
+        cellFunctor(cellIndex);
+        }
+
+      rowIndex.SetJ(j);
+      for (int tile = 0; tile < 3; ++tile)
+        {
+        dax::exec::internal::IJKIndexRow<
+            dax::exec::internal::Functor<GatherInvocation> >::Invoke(
+              rowFunctor, rowIndex, tileBreaks[tile], tileBreaks[tile+1]);
+        }
+      }
+    }
+
+  const dax::Id3 vertexOffsets[8] = {
+    dax::make_Id3(0,0,0), dax::make_Id3(1,0,0),
+    dax::make_Id3(1,1,0), dax::make_Id3(0,1,0),
+    dax::make_Id3(0,0,1), dax::make_Id3(1,0,1),
+    dax::make_Id3(1,1,1), dax::make_Id3(0,1,1) };
+  for (dax::Id cellId = 0; cellId < numCells; ++cellId)
+    {
+    const dax::Id3 ijk = dax::make_Id3(cellId % cellDims[0],
+                                       (cellId / cellDims[0]) % cellDims[1],
+                                       cellId / (cellDims[0]*cellDims[1]));
+    const VoxelValues cellValue =
+        cellValues.GetPortalConstControl().Get(cellId);
+    const VoxelValues rowValue = rowValues.GetPortalConstControl().Get(cellId);
+    for (int vertex = 0; vertex < 8; ++vertex)
+      {
+      const dax::Id3 point = ijk + vertexOffsets[vertex];
+      const dax::Scalar expected = field[
+          point[0] + pointDims[0]*(point[1] + pointDims[1]*point[2])];
+      DAX_TEST_ASSERT(cellValue[vertex] == expected,
+                      "Voxel gather got the wrong point value.");
+      DAX_TEST_ASSERT(rowValue[vertex] == expected,
+                      "Row gather differs from the voxel gather.");
+      }
+    }
+}
+
+void TestFunctor()
+{
+  Functor();
+  FunctorRowGather();
 }
 
 }
 
 int UnitTestFunctor(int, char *[])
 {
-  return dax::testing::Testing::Run(Functor);
+  return dax::cont::testing::Testing::Run(TestFunctor);
 }
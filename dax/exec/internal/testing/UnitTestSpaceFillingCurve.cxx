@@ -0,0 +1,126 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/exec/internal/SpaceFillingCurve.h>
+
+#include <dax/testing/Testing.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const int NUM_BITS = 3;
+const dax::Id DIM = 1 << NUM_BITS;
+
+template<class CurveTag>
+void GetCurveOrder(std::vector<dax::Id3> &order, CurveTag)
+{
+  order.assign(DIM*DIM*DIM, dax::make_Id3(-1, -1, -1));
+  dax::Id3 coords;
+  for (coords[2] = 0; coords[2] < DIM; coords[2]++)
+    {
+    for (coords[1] = 0; coords[1] < DIM; coords[1]++)
+      {
+      for (coords[0] = 0; coords[0] < DIM; coords[0]++)
+        {
+        dax::Id key = dax::exec::internal::SpaceFillingCurveKey(coords,
+                                                                NUM_BITS,
+                                                                CurveTag());
+        DAX_TEST_ASSERT((key >= 0) && (key < DIM*DIM*DIM),
+                        "Key out of range.");
+        DAX_TEST_ASSERT(order[key][0] == -1, "Two locations share a key.");
+        order[key] = coords;
+        }
+      }
+    }
+}
+
+dax::Id ManhattanDistance(const dax::Id3 &a, const dax::Id3 &b)
+{
+  dax::Id distance = 0;
+  for (int component = 0; component < 3; component++)
+    {
+    distance += std::max(a[component], b[component])
+        - std::min(a[component], b[component]);
+    }
+  return distance;
+}
+
+void TestMorton()
+{
+  std::cout << "Testing Morton keys." << std::endl;
+  std::vector<dax::Id3> order;
+  GetCurveOrder(order, dax::exec::internal::SpaceFillingCurveTagMorton());
+
+  // Each group of 8 consecutive keys is a 2x2x2 block.
+  for (dax::Id key = 0; key < DIM*DIM*DIM; key += 8)
+    {
+    for (dax::Id offset = 1; offset < 8; offset++)
+      {
+      DAX_TEST_ASSERT(ManhattanDistance(order[key], order[key+offset]) <= 3,
+                      "Morton block not compact.");
+      }
+    }
+  DAX_TEST_ASSERT(dax::exec::internal::SpaceFillingCurveKey(
+                    dax::make_Id3(1, 2, 4), NUM_BITS,
+                    dax::exec::internal::SpaceFillingCurveTagMorton())
+                  == 0124,
+                  "Unexpected bit interleaving.");
+}
+
+void TestHilbert()
+{
+  std::cout << "Testing Hilbert keys." << std::endl;
+  std::vector<dax::Id3> order;
+  GetCurveOrder(order, dax::exec::internal::SpaceFillingCurveTagHilbert());
+
+  // Consecutive locations along a Hilbert curve are always neighbors.
+  for (dax::Id key = 1; key < DIM*DIM*DIM; key++)
+    {
+    DAX_TEST_ASSERT(ManhattanDistance(order[key-1], order[key]) == 1,
+                    "Hilbert curve is not continuous.");
+    }
+}
+
+void TestQuantize()
+{
+  std::cout << "Testing quantization." << std::endl;
+  const dax::Vector3 origin = dax::make_Vector3(-1.0, 0.0, 2.0);
+  const dax::Vector3 scale = dax::make_Vector3(2.0, 1.0, 0.5);
+  DAX_TEST_ASSERT(dax::exec::internal::SpaceFillingCurveQuantize(
+                    dax::make_Vector3(0.0, 3.5, 6.0), origin, scale, NUM_BITS)
+                  == dax::make_Id3(2, 3, 2),
+                  "Bad quantized location.");
+  DAX_TEST_ASSERT(dax::exec::internal::SpaceFillingCurveQuantize(
+                    dax::make_Vector3(-5.0, 100.0, 2.0), origin, scale, NUM_BITS)
+                  == dax::make_Id3(0, DIM-1, 0),
+                  "Quantized location not clamped.");
+}
+
+void TestSpaceFillingCurve()
+{
+  TestMorton();
+  TestHilbert();
+  TestQuantize();
+}
+
+} // anonymous namespace
+
+int UnitTestSpaceFillingCurve(int, char *[])
+{
+  return dax::testing::Testing::Run(TestSpaceFillingCurve);
+}
@@ -0,0 +1,80 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/exec/InterpolatedCellPoints.h>
+
+#include <dax/CellTag.h>
+
+#include <dax/testing/Testing.h>
+
+namespace
+{
+
+void TestIdsExact()
+{
+  std::cout << "Checking point ids survive being stored in records."
+            << std::endl;
+
+  // Ids that do not fit in the mantissa of a float, or in 32 bits when ids
+  // are 64 bit.
+#if DAX_SIZE_ID == 4
+  const dax::Id largest = 2147483647;
+#else
+  const dax::Id largest = (dax::Id(1) << 40) + 5;
+#endif
+  const dax::Id ids[5] = { 0, 1, (1 << 24) + 1, (1 << 30) + 3, largest };
+  dax::exec::InterpolatedCellPoints<dax::CellTagTriangle> cell;
+  for (int index = 0; index < 5; index++)
+    {
+    cell.SetInterpolationPoint(0, ids[index], ids[4-index], 0.25f);
+    const dax::exec::InterpolationRecord record = cell[0];
+    DAX_TEST_ASSERT(record.Point1 == ids[index], "First point id changed.");
+    DAX_TEST_ASSERT(record.Point2 == ids[4-index], "Second point id changed.");
+    DAX_TEST_ASSERT(test_equal(record.Weight, dax::Scalar(0.25)),
+                    "Weight changed.");
+    }
+}
+
+void TestEdgeKeys()
+{
+  std::cout << "Checking edge keys." << std::endl;
+
+  typedef dax::exec::internal::InterpolationEdgeKey KeyType;
+  const dax::Id big = (1 << 24) + 1;
+  const KeyType key1 = dax::exec::internal::MakeInterpolationEdgeKey(big, big);
+  const KeyType key2 =
+      dax::exec::internal::MakeInterpolationEdgeKey(big, big+1);
+  const KeyType key3 =
+      dax::exec::internal::MakeInterpolationEdgeKey(big+1, 0);
+  DAX_TEST_ASSERT(key1 < key2, "Edge keys not ordered by second point.");
+  DAX_TEST_ASSERT(key2 < key3, "Edge keys not ordered by first point.");
+  DAX_TEST_ASSERT(key1 != key2, "Different edges have the same key.");
+  DAX_TEST_ASSERT(
+        key1 == dax::exec::internal::MakeInterpolationEdgeKey(big, big),
+        "Same edge has different keys.");
+}
+
+void TestInterpolatedCellPoints()
+{
+  TestIdsExact();
+  TestEdgeKeys();
+}
+
+} // anonymous namespace
+
+int UnitTestInterpolatedCellPoints(int, char *[])
+{
+  return dax::testing::Testing::Run(TestInterpolatedCellPoints);
+}
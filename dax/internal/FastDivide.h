@@ -0,0 +1,97 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_internal_FastDivide_h
+#define __dax_internal_FastDivide_h
+
+#include <dax/Types.h>
+
+namespace dax {
+namespace internal {
+
+/// \brief Divides by a fixed divisor with a multiply and a shift.
+///
+/// Integer division is one of the slowest arithmetic instructions on both
+/// CPUs and GPUs. When the same divisor is used over and over (such as the
+/// dimensions of a grid when converting flat indices to i, j, k locations),
+/// it pays to precompute a "magic" multiplier for the divisor once and
+/// replace every division with a 64 bit multiply and a shift (Granlund and
+/// Montgomery, "Division by Invariant Integers using Multiplication", 1994).
+///
+/// The result is exact for every numerator less than 2^31 and any divisor
+/// from 1 to 2^31. Callers with larger numerators must fall back to regular
+/// division.
+///
+class FastDivisor
+{
+public:
+  DAX_EXEC_CONT_EXPORT
+  FastDivisor() : Divisor(1), Multiplier(1), Shift(0) {  }
+
+  DAX_EXEC_CONT_EXPORT
+  explicit FastDivisor(dax::internal::UInt32Type divisor)
+    : Divisor(divisor)
+  {
+    // log2 of the divisor rounded up.
+    int log2Divisor = 0;
+    while ((static_cast<dax::internal::UInt64Type>(1) << log2Divisor)
+           < divisor)
+      {
+      log2Divisor++;
+      }
+
+    // With this multiplier, multiplier*divisor - 2^shift <= 2^log2Divisor,
+    // which keeps the error below one for every numerator under 2^32. The
+    // multiplier needs up to 33 bits, so the numerator is limited to 31 bits
+    // to keep the product in 64 bits.
+    this->Shift = 32 + log2Divisor;
+    this->Multiplier =
+        ((static_cast<dax::internal::UInt64Type>(1) << this->Shift) / divisor)
+        + 1;
+  }
+
+  DAX_EXEC_CONT_EXPORT
+  dax::internal::UInt32Type GetDivisor() const { return this->Divisor; }
+
+  /// Returns \c numerator / \c divisor.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::internal::UInt32Type Divide(dax::internal::UInt32Type numerator) const
+  {
+    return static_cast<dax::internal::UInt32Type>(
+          (this->Multiplier * numerator) >> this->Shift);
+  }
+
+  /// Returns both \c numerator / \c divisor and \c numerator % \c divisor.
+  ///
+  DAX_EXEC_CONT_EXPORT
+  dax::internal::UInt32Type Divide(dax::internal::UInt32Type numerator,
+                                   dax::internal::UInt32Type &remainder) const
+  {
+    const dax::internal::UInt32Type quotient = this->Divide(numerator);
+    remainder = numerator - quotient*this->Divisor;
+    return quotient;
+  }
+
+private:
+  dax::internal::UInt32Type Divisor;
+  dax::internal::UInt64Type Multiplier;
+  int Shift;
+};
+
+}
+} // namespace dax::internal
+
+#endif //__dax_internal_FastDivide_h
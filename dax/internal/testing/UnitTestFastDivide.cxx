@@ -0,0 +1,90 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/internal/FastDivide.h>
+#include <dax/testing/Testing.h>
+
+namespace {
+
+typedef dax::internal::UInt32Type UInt32;
+
+void CheckDivide(const dax::internal::FastDivisor &divisor, UInt32 numerator)
+{
+  UInt32 remainder;
+  UInt32 quotient = divisor.Divide(numerator, remainder);
+  DAX_TEST_ASSERT(quotient == numerator / divisor.GetDivisor(),
+                  "Bad quotient.");
+  DAX_TEST_ASSERT(remainder == numerator % divisor.GetDivisor(),
+                  "Bad remainder.");
+}
+
+void CheckDivisor(UInt32 value)
+{
+  dax::internal::FastDivisor divisor(value);
+
+  for (UInt32 numerator = 0; numerator < 4096; numerator++)
+    {
+    CheckDivide(divisor, numerator);
+    }
+
+  // Numerators around multiples of the divisor and the end of the range.
+  for (UInt32 multiple = 1; multiple < 64; multiple++)
+    {
+    if (multiple*static_cast<dax::internal::UInt64Type>(value) >= 0x7FFFFFFFu)
+      {
+      break;
+      }
+    UInt32 product = multiple*value;
+    CheckDivide(divisor, product - 1);
+    CheckDivide(divisor, product);
+    CheckDivide(divisor, product + 1);
+    }
+  for (UInt32 offset = 0; offset < 64; offset++)
+    {
+    CheckDivide(divisor, 0x7FFFFFFFu - offset);
+    }
+}
+
+void TestFastDivide()
+{
+  std::cout << "Checking small divisors." << std::endl;
+  for (UInt32 value = 1; value <= 1024; value++)
+    {
+    CheckDivisor(value);
+    }
+
+  std::cout << "Checking powers of two and their neighbors." << std::endl;
+  for (int bit = 1; bit < 31; bit++)
+    {
+    UInt32 power = static_cast<UInt32>(1) << bit;
+    CheckDivisor(power - 1);
+    CheckDivisor(power);
+    CheckDivisor(power + 1);
+    }
+
+  std::cout << "Checking typical grid dimensions." << std::endl;
+  CheckDivisor(129);
+  CheckDivisor(257*257);
+  CheckDivisor(1000003);
+  CheckDivisor(0x7FFFFFFFu);
+  CheckDivisor(0x80000000u);
+}
+
+} // anonymous namespace
+
+int UnitTestFastDivide(int, char *[])
+{
+  return dax::testing::Testing::Run(TestFastDivide);
+}
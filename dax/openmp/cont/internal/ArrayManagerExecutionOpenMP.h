@@ -21,8 +21,74 @@
 #include <dax/openmp/cont/internal/DeviceAdapterTagOpenMP.h>
 
 #include <dax/cont/internal/ArrayManagerExecution.h>
+#include <dax/cont/internal/NumaPlacement.h>
 #include <dax/thrust/cont/internal/ArrayManagerExecutionThrustShare.h>
 
+#include <omp.h>
+
+namespace dax {
+namespace openmp {
+namespace cont {
+namespace internal {
+
+/// Arrays that are not stored contiguously (implicit, permuted, zipped...)
+/// are left alone.
+///
+template<typename IteratorType, class PlacementTag>
+DAX_CONT_EXPORT void PlaceArray(IteratorType, IteratorType, PlacementTag) {  }
+
+template<typename T>
+DAX_CONT_EXPORT void PlaceArray(T *, T *,
+                                dax::cont::internal::NumaPlacementTagNone) {  }
+
+template<typename T>
+DAX_CONT_EXPORT void PlaceArray(
+    T *begin, T *end, dax::cont::internal::NumaPlacementTagFirstTouch)
+{
+  const dax::Id numberOfValues = static_cast<dax::Id>(end - begin);
+  if (numberOfValues*sizeof(T) <
+      dax::cont::internal::NUMA_PLACEMENT_MINIMUM_BYTES)
+    {
+    return;
+    }
+
+  // Thrust schedules with a plain omp parallel for, which uses the static
+  // schedule: one contiguous block of about numberOfValues/numThreads values
+  // per thread, in thread order. Touch the pages of the same blocks.
+#pragma omp parallel
+  {
+  const dax::Id numThreads = omp_get_num_threads();
+  const dax::Id threadIndex = omp_get_thread_num();
+  const dax::Id blockSize = numberOfValues / numThreads;
+  const dax::Id remainder = numberOfValues % numThreads;
+  const dax::Id blockBegin = blockSize*threadIndex +
+      ((threadIndex < remainder) ? threadIndex : remainder);
+  const dax::Id blockEnd =
+      blockBegin + blockSize + ((threadIndex < remainder) ? 1 : 0);
+  dax::cont::internal::NumaTouchPages(begin + blockBegin, begin + blockEnd);
+  }
+}
+
+template<typename T>
+DAX_CONT_EXPORT void PlaceArray(
+    T *begin, T *end, dax::cont::internal::NumaPlacementTagInterleave)
+{
+  const std::size_t numBytes = static_cast<std::size_t>(end - begin)*sizeof(T);
+  if (numBytes < dax::cont::internal::NUMA_PLACEMENT_MINIMUM_BYTES)
+    {
+    return;
+    }
+
+  dax::cont::internal::NumaInterleave(begin, numBytes);
+  // Touch anyway so that faulting the pages in is done in parallel.
+  PlaceArray(begin, end, dax::cont::internal::NumaPlacementTagFirstTouch());
+}
+
+}
+}
+}
+} // namespace dax::openmp::cont::internal
+
 // These must be placed in the dax::cont::internal namespace so that
 // the template can be found.
 
@@ -40,8 +106,35 @@ public:
   typedef dax::thrust::cont::internal::ArrayManagerExecutionThrustShare
       <T, ArrayContainerTag> Superclass;
   typedef typename Superclass::ValueType ValueType;
+  typedef typename Superclass::ContainerType ContainerType;
   typedef typename Superclass::PortalType PortalType;
   typedef typename Superclass::PortalConstType PortalConstType;
+
+  /// Allocates memory in the given \p controlArray. When the allocation
+  /// produced new memory, the pages are placed according to
+  /// DAX_DEFAULT_NUMA_PLACEMENT_TAG before anything writes to them. Memory
+  /// reused from a previous allocation is left untouched since it might also
+  /// be the input of the same operation.
+  ///
+  DAX_CONT_EXPORT void AllocateArrayForOutput(ContainerType &controlArray,
+                                              dax::Id numberOfValues)
+  {
+    const void *oldArray = dax::cont::internal::NumaArrayAddress(
+          controlArray.GetPortalConst().GetIteratorBegin());
+
+    this->Superclass::AllocateArrayForOutput(controlArray, numberOfValues);
+
+    PortalType portal = this->GetPortal();
+    const void *newArray =
+        dax::cont::internal::NumaArrayAddress(portal.GetIteratorBegin());
+    if ((newArray != NULL) && (newArray != oldArray))
+      {
+      dax::openmp::cont::internal::PlaceArray(
+            portal.GetIteratorBegin(),
+            portal.GetIteratorEnd(),
+            DAX_DEFAULT_NUMA_PLACEMENT_TAG());
+      }
+  }
 };
 
 }
@@ -20,6 +20,97 @@
 
 #include <dax/cont/internal/ArrayManagerExecution.h>
 #include <dax/cont/internal/ArrayManagerExecutionShareWithControl.h>
+#include <dax/cont/internal/NumaPlacement.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+
+namespace dax {
+namespace tbb {
+namespace cont {
+namespace internal {
+
+/// The "grain size" of scheduling with TBB.  Not a lot of thought has gone
+/// into picking this size.
+///
+const dax::Id TBB_GRAIN_SIZE = 128;
+
+#if TBB_INTERFACE_VERSION >= 9100
+/// Partitioner used both to schedule 1D work and to first touch output
+/// arrays. A static partition hands the same index ranges to the same threads
+/// each time, so pages are touched by the thread that later processes them.
+///
+typedef ::tbb::static_partitioner SchedulePartitionerType;
+#else
+// Older versions of TBB have no static partitioner. The first touch will still
+// spread pages across memory nodes but not necessarily match the schedule.
+typedef ::tbb::auto_partitioner SchedulePartitionerType;
+#endif
+
+template<typename T>
+class FirstTouchKernel
+{
+public:
+  DAX_CONT_EXPORT FirstTouchKernel(T *array) : Array(array) {  }
+
+  DAX_CONT_EXPORT
+  void operator()(const ::tbb::blocked_range<dax::Id> &range) const
+  {
+    dax::cont::internal::NumaTouchPages(this->Array + range.begin(),
+                                        this->Array + range.end());
+  }
+
+private:
+  T *Array;
+};
+
+/// Arrays that are not stored contiguously (implicit, permuted, zipped...)
+/// are left alone.
+///
+template<typename IteratorType, class PlacementTag>
+DAX_CONT_EXPORT void PlaceArray(IteratorType, IteratorType, PlacementTag) {  }
+
+template<typename T>
+DAX_CONT_EXPORT void PlaceArray(T *, T *,
+                                dax::cont::internal::NumaPlacementTagNone) {  }
+
+template<typename T>
+DAX_CONT_EXPORT void PlaceArray(
+    T *begin, T *end, dax::cont::internal::NumaPlacementTagFirstTouch)
+{
+  const dax::Id numberOfValues = static_cast<dax::Id>(end - begin);
+  if (numberOfValues*sizeof(T) <
+      dax::cont::internal::NUMA_PLACEMENT_MINIMUM_BYTES)
+    {
+    return;
+    }
+
+  ::tbb::parallel_for(
+        ::tbb::blocked_range<dax::Id>(0, numberOfValues, TBB_GRAIN_SIZE),
+        FirstTouchKernel<T>(begin),
+        SchedulePartitionerType());
+}
+
+template<typename T>
+DAX_CONT_EXPORT void PlaceArray(
+    T *begin, T *end, dax::cont::internal::NumaPlacementTagInterleave)
+{
+  const std::size_t numBytes = static_cast<std::size_t>(end - begin)*sizeof(T);
+  if (numBytes < dax::cont::internal::NUMA_PLACEMENT_MINIMUM_BYTES)
+    {
+    return;
+    }
+
+  dax::cont::internal::NumaInterleave(begin, numBytes);
+  // Touch anyway so that faulting the pages in is done in parallel.
+  PlaceArray(begin, end, dax::cont::internal::NumaPlacementTagFirstTouch());
+}
+
+}
+}
+}
+} // namespace dax::tbb::cont::internal
 
 // These must be placed in the dax::cont::internal namespace so that
 // the template can be found.
@@ -34,6 +125,38 @@ class ArrayManagerExecution
     : public dax::cont::internal::ArrayManagerExecutionShareWithControl
         <T, ArrayContainerTag>
 {
+public:
+  typedef dax::cont::internal::ArrayManagerExecutionShareWithControl
+      <T, ArrayContainerTag> Superclass;
+  typedef typename Superclass::ValueType ValueType;
+  typedef typename Superclass::ContainerType ContainerType;
+  typedef typename Superclass::PortalType PortalType;
+  typedef typename Superclass::PortalConstType PortalConstType;
+
+  /// Allocates memory in the given \p controlArray. When the allocation
+  /// produced new memory, the pages are placed according to
+  /// DAX_DEFAULT_NUMA_PLACEMENT_TAG before anything writes to them. Memory
+  /// reused from a previous allocation is left untouched since it might also
+  /// be the input of the same operation.
+  ///
+  DAX_CONT_EXPORT void AllocateArrayForOutput(ContainerType &controlArray,
+                                              dax::Id numberOfValues)
+  {
+    const void *oldArray = dax::cont::internal::NumaArrayAddress(
+          controlArray.GetPortalConst().GetIteratorBegin());
+
+    this->Superclass::AllocateArrayForOutput(controlArray, numberOfValues);
+
+    PortalType portal = this->GetPortal();
+    const void *newArray =
+        dax::cont::internal::NumaArrayAddress(portal.GetIteratorBegin());
+    if ((newArray != NULL) && (newArray != oldArray))
+      {
+      dax::tbb::cont::internal::PlaceArray(portal.GetIteratorBegin(),
+                                           portal.GetIteratorEnd(),
+                                           DAX_DEFAULT_NUMA_PLACEMENT_TAG());
+      }
+  }
 };
 
 }
@@ -34,6 +34,7 @@
 #include <dax/cont/internal/FindBinding.h>
 #include <dax/cont/internal/GridTags.h>
 
+#include <dax/exec/internal/FunctorRange.h>
 #include <dax/exec/internal/IJKIndex.h>
 #include <boost/type_traits/remove_reference.hpp>
 
@@ -60,10 +61,6 @@ struct DeviceAdapterAlgorithm<dax::tbb::cont::DeviceAdapterTagTBB> :
         dax::tbb::cont::DeviceAdapterTagTBB>
 {
 private:
-  // The "grain size" of scheduling with TBB.  Not a lot of thought has gone
-  // into picking this size.
-  static const dax::Id TBB_GRAIN_SIZE = 128;
-
   template<class InputPortalType, class OutputPortalType>
   struct ScanInclusiveBody
   {
@@ -286,10 +283,8 @@ private:
       // error and setting the message buffer as expected.
       try
         {
-        for (dax::Id index = range.begin(); index < range.end(); index++)
-          {
-          this->Functor(index);
-          }
+        dax::exec::internal::FunctorRange<FunctorType>::Invoke(
+              this->Functor, range.begin(), range.end());
         }
       catch (dax::cont::Error error)
         {
@@ -320,9 +315,15 @@ public:
     ScheduleKernel<FunctorType> kernel(functor);
     kernel.SetErrorMessageBuffer(errorMessage);
 
-    ::tbb::blocked_range<dax::Id> range(0, numInstances, TBB_GRAIN_SIZE);
+    ::tbb::blocked_range<dax::Id> range(
+          0, numInstances, dax::tbb::cont::internal::TBB_GRAIN_SIZE);
 
-    ::tbb::parallel_for(range, kernel);
+    // Use the same partition that first touched the output arrays (see
+    // ArrayManagerExecutionTBB) so that each thread works on local memory.
+    ::tbb::parallel_for(
+          range,
+          kernel,
+          dax::tbb::cont::internal::SchedulePartitionerType());
 
     if (errorMessage.IsErrorRaised())
       {
@@ -359,11 +360,8 @@ private:
           for( dax::Id j=range.rows().begin(); j!=range.rows().end(); ++j)
             {
             index.SetJ(j);
-            for( dax::Id i=range.cols().begin(); i!=range.cols().end(); ++i)
-              {
-              index.SetI(i);
-              this->Functor(index);
-              }
+            dax::exec::internal::IJKIndexRow<FunctorType>::Invoke(
+                  this->Functor, index, range.cols().begin(), range.cols().end());
             }
           }
         }
@@ -18,6 +18,7 @@
 
 #include <dax/exec/CellVertices.h>
 #include <dax/exec/WorkletGenerateKeysValues.h>
+#include <dax/exec/WorkletMapCellToPoint.h>
 #include <dax/exec/WorkletReduceKeysValues.h>
 
 namespace dax {
@@ -73,6 +74,32 @@ public:
   }
 };
 
+// Averages the values of the cells incident to each point in a single pass
+// over the points, reading the cells through the reverse connectivity of the
+// grid. Use with dax::cont::DispatcherMapCellToPoint.
+class CellDataToPointDataAverage
+  : public dax::exec::WorkletMapCellToPoint
+{
+public:
+  typedef void ControlSignature(TopologyIn, FieldCellIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  template<typename PointCellFieldType>
+  DAX_EXEC_EXPORT
+  typename PointCellFieldType::ValueType
+  operator()(const PointCellFieldType &cellValues) const
+  {
+    typedef typename PointCellFieldType::ValueType VType;
+    const dax::Id numCells = cellValues.GetNumberOfValues();
+    VType averageValue = VType();
+    if (numCells < 1) { return averageValue; }
+    for(dax::Id iCtr = 0; iCtr < numCells; iCtr++)
+      {
+      averageValue += cellValues[iCtr];
+      }
+    return (averageValue / numCells);
+  }
+};
 
 } } // namespace dax::worklet
 
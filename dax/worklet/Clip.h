@@ -0,0 +1,282 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#ifndef __Clip_worklet_
+#define __Clip_worklet_
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+#include <dax/exec/CellField.h>
+#include <dax/exec/CellVertices.h>
+#include <dax/exec/InterpolatedCellPoints.h>
+#include <dax/exec/WorkletInterpolatedCell.h>
+#include <dax/exec/WorkletMapCell.h>
+#include <dax/exec/WorkletMapField.h>
+
+#include <dax/worklet/Threshold.h>
+#include <dax/worklet/internal/ClipTable.h>
+
+namespace dax {
+namespace worklet {
+
+namespace internal{
+namespace clip{
+// -----------------------------------------------------------------------------
+/// Returns which vertices of a cell are kept, one bit per vertex.
+///
+template<typename T, class CellTag>
+DAX_EXEC_EXPORT
+int GetCellKeptVertices(const T isoValue,
+                        const dax::exec::CellField<dax::Scalar,CellTag> &values)
+{
+  int kept = 0;
+  for (int vertexIndex = 0;
+       vertexIndex < dax::CellTraits<CellTag>::NUM_VERTICES;
+       ++vertexIndex)
+    {
+    kept |= (values[vertexIndex] > isoValue) << vertexIndex;
+    }
+  return kept;
+}
+
+// -----------------------------------------------------------------------------
+/// Returns the case of one of the tetrahedra a cell is split into, given the
+/// kept vertices of the cell.
+///
+template<class CanonicalCellTag>
+DAX_EXEC_EXPORT
+int GetTetrahedronCase(int cellKeptVertices, int tetrahedron)
+{
+  typedef CellTetrahedra<CanonicalCellTag> Tetrahedra;
+  int tetCase = 0;
+  for (int vertexIndex = 0; vertexIndex < 4; ++vertexIndex)
+    {
+    const int cellVertex = Tetrahedra::GetVertex(tetrahedron, vertexIndex);
+    tetCase |= ((cellKeptVertices >> cellVertex) & 1) << vertexIndex;
+    }
+  return tetCase;
+}
+}
+}
+
+// -----------------------------------------------------------------------------
+/// Computes the signed distance of each point to a plane, scaled by the
+/// length of the normal. Clipping this field at 0 keeps the side the normal
+/// points to.
+///
+class ClipPlaneDistance : public dax::exec::WorkletMapField
+{
+public:
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef _2 ExecutionSignature(_1);
+
+  DAX_CONT_EXPORT ClipPlaneDistance(dax::Vector3 origin, dax::Vector3 normal)
+    : Origin(origin),
+      Normal(normal)
+  {
+  }
+
+  DAX_EXEC_EXPORT dax::Scalar operator()(const dax::Vector3 &coords) const
+  {
+    return dax::dot(this->Normal, coords - this->Origin);
+  }
+
+private:
+  dax::Vector3 Origin;
+  dax::Vector3 Normal;
+};
+
+// -----------------------------------------------------------------------------
+/// Sorts the cells for clipping away the parts where a point field is not
+/// above the isovalue. The first output is 1 for the cells kept whole, to be
+/// used as the count of ClipTopology. The second is the number of tetrahedra
+/// the cells that are cut generate, to be used as the count of ClipGenerate.
+/// Cells removed whole get 0 for both, so the amount of work and output
+/// follows the kept and cut cells. Works on hexahedra, voxels, wedges and
+/// tetrahedra.
+///
+class ClipClassify : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut, FieldOut);
+  typedef void ExecutionSignature(_2, _3, _4);
+
+  DAX_CONT_EXPORT ClipClassify(dax::Scalar isoValue)
+    : IsoValue(isoValue) {  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  void operator()(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                  dax::Id &keepCount,
+                  dax::Id &cutCount) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->Classify(values,
+                   keepCount,
+                   cutCount,
+                   typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag, class CanonicalCellTag>
+  DAX_EXEC_EXPORT
+  void Classify(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                dax::Id &keepCount,
+                dax::Id &cutCount,
+                CanonicalCellTag) const
+  {
+    typedef internal::clip::CellTetrahedra<CanonicalCellTag> Tetrahedra;
+    const int allVertices = (1 << dax::CellTraits<CellTag>::NUM_VERTICES) - 1;
+
+    const int kept =
+        internal::clip::GetCellKeptVertices(this->IsoValue, values);
+    keepCount = (kept == allVertices) ? 1 : 0;
+    cutCount = 0;
+    if (kept == 0 || kept == allVertices)
+      {
+      return;
+      }
+
+    for (int tetrahedron = 0;
+         tetrahedron < Tetrahedra::NUM_TETRAHEDRA;
+         ++tetrahedron)
+      {
+      const int tetCase =
+          internal::clip::GetTetrahedronCase<CanonicalCellTag>(kept,
+                                                               tetrahedron);
+      cutCount += internal::clip::TetrahedronNumTets[tetCase];
+      }
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Passes the cells ClipClassify keeps whole through unchanged. Run it with
+/// duplicate points kept so that the connections still refer to the input
+/// points, and give the output the point coordinates generated by
+/// ClipGenerate with SetKeepInputPoints.
+///
+typedef dax::worklet::ThresholdTopology ClipTopology;
+
+// -----------------------------------------------------------------------------
+/// Generates the tetrahedra of the cells ClipClassify found cut. Each cut
+/// cell is split into tetrahedra (see internal::clip::CellTetrahedra) and
+/// only the part of each above the isovalue is kept, which is a tetrahedron
+/// or a wedge made of three tetrahedra. Kept vertices are written as records
+/// of the input point to itself, so run the dispatcher with
+/// SetKeepInputPoints to share them with the output of ClipTopology.
+///
+class ClipGenerate : public dax::exec::WorkletInterpolatedCell
+{
+public:
+
+  typedef void ControlSignature(TopologyIn, GeometryOut, FieldPointIn);
+  typedef void ExecutionSignature(AsVertices(_1), _2, _3, VisitIndex);
+
+  DAX_CONT_EXPORT ClipGenerate(dax::Scalar isoValue)
+    : IsoValue(isoValue){ }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTetrahedron>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id inputCellVisitIndex) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->BuildTetrahedron(
+          verts,
+          outCell,
+          values,
+          inputCellVisitIndex,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag, class CanonicalCellTag>
+  DAX_EXEC_EXPORT void BuildTetrahedron(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTetrahedron>& outCell,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      dax::Id inputCellVisitIndex,
+      CanonicalCellTag) const
+  {
+    using dax::worklet::internal::clip::TetrahedronTable;
+    using dax::worklet::internal::marchingcubes::TetrahedronEdgeVertices;
+    typedef internal::clip::CellTetrahedra<CanonicalCellTag> Tetrahedra;
+
+    const int kept =
+        internal::clip::GetCellKeptVertices(this->IsoValue, values);
+
+    dax::Id pieceIndex = inputCellVisitIndex;
+    for (int tetrahedron = 0;
+         tetrahedron < Tetrahedra::NUM_TETRAHEDRA;
+         ++tetrahedron)
+      {
+      const int tetCase =
+          internal::clip::GetTetrahedronCase<CanonicalCellTag>(kept,
+                                                               tetrahedron);
+      const dax::Id numPieces = internal::clip::TetrahedronNumTets[tetCase];
+      if (pieceIndex >= numPieces)
+        {
+        pieceIndex -= numPieces;
+        continue;
+        }
+
+      for (dax::Id outVertIndex = 0;
+           outVertIndex < outCell.NUM_VERTICES;
+           ++outVertIndex)
+        {
+        const int code =
+            TetrahedronTable[tetCase][(pieceIndex*4)+outVertIndex];
+        if (code < internal::clip::TETRAHEDRON_EDGE_CODE)
+          {
+          const dax::Id pointId =
+              verts[Tetrahedra::GetVertex(tetrahedron, code)];
+          outCell.SetInterpolationPoint(outVertIndex, pointId, pointId, 0);
+          continue;
+          }
+
+        const int edge = code - internal::clip::TETRAHEDRON_EDGE_CODE;
+        const int vertA = Tetrahedra::GetVertex(
+              tetrahedron, TetrahedronEdgeVertices[edge][0]);
+        const int vertB = Tetrahedra::GetVertex(
+              tetrahedron, TetrahedronEdgeVertices[edge][1]);
+
+        // Find the weight for linear interpolation
+        const dax::Scalar weight = (this->IsoValue - values[vertA]) /
+                                  (values[vertB]-values[vertA]);
+
+        outCell.SetInterpolationPoint(outVertIndex,
+                                      verts[vertA],
+                                      verts[vertB],
+                                      weight);
+        }
+      return;
+      }
+  }
+};
+
+}
+} //dax::worklet
+
+#endif
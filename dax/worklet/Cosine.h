@@ -28,6 +28,8 @@ public:
   typedef void ControlSignature(FieldIn, FieldOut);
   typedef _2 ExecutionSignature(_1);
 
+  static const int BATCH_SIZE = 8;
+
 
   template<class ValueType>
   DAX_EXEC_EXPORT
@@ -35,6 +37,19 @@ public:
   {
     return dax::math::Cos(inValue);
   }
+
+  template<class ValueType>
+  DAX_EXEC_EXPORT
+  dax::Tuple<ValueType,BATCH_SIZE>
+  operator()(const dax::Tuple<ValueType,BATCH_SIZE> &inValues) const
+  {
+    dax::Tuple<ValueType,BATCH_SIZE> outValues;
+    for (int lane = 0; lane < BATCH_SIZE; ++lane)
+      {
+      outValues[lane] = dax::math::Cos(inValues[lane]);
+      }
+    return outValues;
+  }
 };
 
 }
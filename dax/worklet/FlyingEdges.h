@@ -0,0 +1,588 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __dax_worklet_FlyingEdges_h
+#define __dax_worklet_FlyingEdges_h
+
+#include <dax/Extent.h>
+#include <dax/Types.h>
+
+#include <dax/cont/ArrayContainerControlBasic.h>
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/exec/internal/WorkletBase.h>
+
+#include <dax/math/Compare.h>
+
+#include <dax/worklet/internal/MarchingCubesTable.h>
+
+namespace dax {
+namespace worklet {
+
+namespace internal {
+namespace flyingedges {
+
+/// Each point is classified as above (1) or below (0) the isovalue, the same
+/// way marching cubes classifies the vertices of a cell.
+///
+typedef unsigned char ClassType;
+
+// -----------------------------------------------------------------------------
+/// Point rows run along x. Row r holds the points (i, j, k) with
+/// r = j + k*ny, and the x edges between them.
+///
+struct RowLayout
+{
+  dax::Id3 Dimensions;
+
+  DAX_EXEC_CONT_EXPORT dax::Id GetJ(dax::Id row) const
+    { return row % this->Dimensions[1]; }
+  DAX_EXEC_CONT_EXPORT dax::Id GetK(dax::Id row) const
+    { return row / this->Dimensions[1]; }
+  DAX_EXEC_CONT_EXPORT dax::Id GetFirstPoint(dax::Id row) const
+    { return row * this->Dimensions[0]; }
+};
+
+/// Returns the range of point columns [first, last] of some adjacent rows
+/// where edges may be cut. Past the first and last cut x edge of every row
+/// the points keep the class of the row's end point, so the range only has
+/// to grow to the whole row when the end points of the rows differ. Cells
+/// [first, last) are the cells between the rows that may hold triangles. The
+/// range is empty (first > last) when no edge is cut.
+///
+template<class ClassPortalType, class TrimPortalType>
+DAX_EXEC_EXPORT
+dax::Id2 TrimRows(const dax::Id *rows,
+                  int numRows,
+                  const RowLayout &layout,
+                  const ClassPortalType &classes,
+                  const TrimPortalType &trims)
+{
+  const dax::Id nx = layout.Dimensions[0];
+  const ClassType firstClass = classes.Get(layout.GetFirstPoint(rows[0]));
+  const ClassType lastClass =
+      classes.Get(layout.GetFirstPoint(rows[0]) + nx - 1);
+  dax::Id2 range(nx - 1, 0);
+  bool firstDiffers = false;
+  bool lastDiffers = false;
+  for (int index = 0; index < numRows; ++index)
+    {
+    const dax::Id2 trim = trims.Get(rows[index]);
+    range[0] = dax::math::Min(range[0], trim[0]);
+    range[1] = dax::math::Max(range[1], trim[1]);
+    const dax::Id firstPoint = layout.GetFirstPoint(rows[index]);
+    firstDiffers |= (classes.Get(firstPoint) != firstClass);
+    lastDiffers |= (classes.Get(firstPoint + nx - 1) != lastClass);
+    }
+  if (firstDiffers) { range[0] = 0; }
+  if (lastDiffers) { range[1] = nx - 1; }
+  return range;
+}
+
+// -----------------------------------------------------------------------------
+/// First pass: classifies the points of each row, counts the cut x edges and
+/// records the first and one past the last cut x edge of the row. A row
+/// without cuts gets the empty trim (nx-1, 0).
+///
+template<class FieldPortalType,
+         class ClassPortalType,
+         class IdPortalType,
+         class TrimPortalType>
+struct ClassifyRows : dax::exec::internal::WorkletBase
+{
+  FieldPortalType Field;
+  dax::Scalar IsoValue;
+  RowLayout Layout;
+  ClassPortalType Classes;
+  IdPortalType XCounts;
+  TrimPortalType Trims;
+
+  DAX_CONT_EXPORT ClassifyRows(const FieldPortalType &field,
+                               dax::Scalar isoValue,
+                               const RowLayout &layout,
+                               const ClassPortalType &classes,
+                               const IdPortalType &xCounts,
+                               const TrimPortalType &trims)
+    : Field(field), IsoValue(isoValue), Layout(layout), Classes(classes),
+      XCounts(xCounts), Trims(trims) {  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    const dax::Id nx = this->Layout.Dimensions[0];
+    const dax::Id firstPoint = this->Layout.GetFirstPoint(row);
+
+    ClassType previous = (this->Field.Get(firstPoint) > this->IsoValue);
+    this->Classes.Set(firstPoint, previous);
+    dax::Id numCuts = 0;
+    dax::Id2 trim(nx - 1, 0);
+    for (dax::Id i = 1; i < nx; ++i)
+      {
+      const ClassType current =
+          (this->Field.Get(firstPoint + i) > this->IsoValue);
+      this->Classes.Set(firstPoint + i, current);
+      if (current != previous)
+        {
+        if (numCuts == 0) { trim[0] = i - 1; }
+        trim[1] = i;
+        ++numCuts;
+        }
+      previous = current;
+      }
+    this->XCounts.Set(row, numCuts);
+    this->Trims.Set(row, trim);
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Second pass: counts the cut y edges between each row and the next one in
+/// y, the cut z edges between each row and the next one in z, and the
+/// triangles of the row of cells between those four rows. The total number
+/// of points the row owns (x, y and z) is written for the scan.
+///
+template<class ClassPortalType,
+         class IdConstPortalType,
+         class IdPortalType,
+         class TrimPortalType>
+struct CountRows : dax::exec::internal::WorkletBase
+{
+  RowLayout Layout;
+  ClassPortalType Classes;
+  TrimPortalType Trims;
+  IdConstPortalType XCounts;
+  IdPortalType YCounts;
+  IdPortalType PointCounts;
+  IdPortalType TriangleCounts;
+
+  DAX_CONT_EXPORT CountRows(const RowLayout &layout,
+                            const ClassPortalType &classes,
+                            const TrimPortalType &trims,
+                            const IdConstPortalType &xCounts,
+                            const IdPortalType &yCounts,
+                            const IdPortalType &pointCounts,
+                            const IdPortalType &triangleCounts)
+    : Layout(layout), Classes(classes), Trims(trims), XCounts(xCounts),
+      YCounts(yCounts), PointCounts(pointCounts),
+      TriangleCounts(triangleCounts) {  }
+
+  DAX_EXEC_EXPORT dax::Id CountCutEdges(dax::Id row, dax::Id otherRow) const
+  {
+    const dax::Id rows[2] = { row, otherRow };
+    const dax::Id2 range =
+        TrimRows(rows, 2, this->Layout, this->Classes, this->Trims);
+    const dax::Id firstPoint = this->Layout.GetFirstPoint(row);
+    const dax::Id otherFirstPoint = this->Layout.GetFirstPoint(otherRow);
+    dax::Id numCuts = 0;
+    for (dax::Id i = range[0]; i <= range[1]; ++i)
+      {
+      numCuts += (this->Classes.Get(firstPoint + i) !=
+                  this->Classes.Get(otherFirstPoint + i));
+      }
+    return numCuts;
+  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    using dax::worklet::internal::marchingcubes::NumFaces;
+    const dax::Id ny = this->Layout.Dimensions[1];
+    const bool hasYEdges = (this->Layout.GetJ(row) < ny - 1);
+    const bool hasZEdges =
+        (this->Layout.GetK(row) < this->Layout.Dimensions[2] - 1);
+
+    const dax::Id numY = hasYEdges ? this->CountCutEdges(row, row + 1) : 0;
+    const dax::Id numZ = hasZEdges ? this->CountCutEdges(row, row + ny) : 0;
+    this->YCounts.Set(row, numY);
+    this->PointCounts.Set(row, this->XCounts.Get(row) + numY + numZ);
+
+    dax::Id numTriangles = 0;
+    if (hasYEdges && hasZEdges)
+      {
+      const dax::Id rows[4] = { row, row + 1, row + ny, row + ny + 1 };
+      const dax::Id2 range =
+          TrimRows(rows, 4, this->Layout, this->Classes, this->Trims);
+      dax::Id first[4];
+      for (int index = 0; index < 4; ++index)
+        {
+        first[index] = this->Layout.GetFirstPoint(rows[index]);
+        }
+      for (dax::Id i = range[0]; i < range[1]; ++i)
+        {
+        const int cellCase =
+            (this->Classes.Get(first[0] + i) << 0) |
+            (this->Classes.Get(first[0] + i + 1) << 1) |
+            (this->Classes.Get(first[1] + i + 1) << 2) |
+            (this->Classes.Get(first[1] + i) << 3) |
+            (this->Classes.Get(first[2] + i) << 4) |
+            (this->Classes.Get(first[2] + i + 1) << 5) |
+            (this->Classes.Get(first[3] + i + 1) << 6) |
+            (this->Classes.Get(first[3] + i) << 7);
+        numTriangles += NumFaces[cellCase];
+        }
+      }
+    this->TriangleCounts.Set(row, numTriangles);
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Last pass: writes the points on the cut edges each row owns, starting at
+/// the row's scanned point offset with the x edges first, then the y edges,
+/// then the z edges. The triangles of the row of cells are then written
+/// starting at the row's scanned triangle offset. The point on each edge of a
+/// cell is found by counting the cuts along the eight edge rows around the
+/// row of cells, so no point is ever generated twice.
+///
+template<class FieldPortalType,
+         class ClassPortalType,
+         class IdPortalType,
+         class TrimPortalType,
+         class CoordinatesPortalType,
+         class ConnectionsPortalType>
+struct GenerateRows : dax::exec::internal::WorkletBase
+{
+  FieldPortalType Field;
+  dax::Scalar IsoValue;
+  RowLayout Layout;
+  dax::Vector3 Origin;
+  dax::Vector3 Spacing;
+  ClassPortalType Classes;
+  TrimPortalType Trims;
+  IdPortalType XCounts;
+  IdPortalType YCounts;
+  IdPortalType PointOffsets;
+  IdPortalType TriangleOffsets;
+  CoordinatesPortalType Coordinates;
+  ConnectionsPortalType Connections;
+
+  DAX_CONT_EXPORT GenerateRows(const FieldPortalType &field,
+                               dax::Scalar isoValue,
+                               const RowLayout &layout,
+                               const dax::Vector3 &origin,
+                               const dax::Vector3 &spacing,
+                               const ClassPortalType &classes,
+                               const TrimPortalType &trims,
+                               const IdPortalType &xCounts,
+                               const IdPortalType &yCounts,
+                               const IdPortalType &pointOffsets,
+                               const IdPortalType &triangleOffsets,
+                               const CoordinatesPortalType &coordinates,
+                               const ConnectionsPortalType &connections)
+    : Field(field), IsoValue(isoValue), Layout(layout), Origin(origin),
+      Spacing(spacing), Classes(classes), Trims(trims), XCounts(xCounts),
+      YCounts(yCounts), PointOffsets(pointOffsets),
+      TriangleOffsets(triangleOffsets), Coordinates(coordinates),
+      Connections(connections) {  }
+
+  DAX_EXEC_EXPORT dax::Scalar Weight(dax::Id pointA, dax::Id pointB) const
+  {
+    const dax::Scalar valueA = this->Field.Get(pointA);
+    const dax::Scalar valueB = this->Field.Get(pointB);
+    return (this->IsoValue - valueA) / (valueB - valueA);
+  }
+
+  // Writes the points on the cut edges from each point of the row to the
+  // same point of otherRow, which is one step away along axis.
+  DAX_EXEC_EXPORT dax::Id GenerateCrossEdgePoints(dax::Id row,
+                                                  dax::Id otherRow,
+                                                  int axis,
+                                                  dax::Id pointId) const
+  {
+    const dax::Id rows[2] = { row, otherRow };
+    const dax::Id2 range =
+        TrimRows(rows, 2, this->Layout, this->Classes, this->Trims);
+    const dax::Id firstPoint = this->Layout.GetFirstPoint(row);
+    const dax::Id otherFirstPoint = this->Layout.GetFirstPoint(otherRow);
+    dax::Vector3 location(0, static_cast<dax::Scalar>(this->Layout.GetJ(row)),
+                          static_cast<dax::Scalar>(this->Layout.GetK(row)));
+    for (dax::Id i = range[0]; i <= range[1]; ++i)
+      {
+      if (this->Classes.Get(firstPoint + i) !=
+          this->Classes.Get(otherFirstPoint + i))
+        {
+        dax::Vector3 point = location;
+        point[0] = static_cast<dax::Scalar>(i);
+        point[axis] += this->Weight(firstPoint + i, otherFirstPoint + i);
+        this->Coordinates.Set(pointId++,
+                              this->Origin + this->Spacing * point);
+        }
+      }
+    return pointId;
+  }
+
+  DAX_EXEC_EXPORT void GeneratePoints(dax::Id row) const
+  {
+    const dax::Id ny = this->Layout.Dimensions[1];
+    const dax::Id firstPoint = this->Layout.GetFirstPoint(row);
+    dax::Id pointId = this->PointOffsets.Get(row);
+
+    const dax::Id2 trim = this->Trims.Get(row);
+    const dax::Vector3 location(0,
+        static_cast<dax::Scalar>(this->Layout.GetJ(row)),
+        static_cast<dax::Scalar>(this->Layout.GetK(row)));
+    for (dax::Id i = trim[0]; i < trim[1]; ++i)
+      {
+      if (this->Classes.Get(firstPoint + i) !=
+          this->Classes.Get(firstPoint + i + 1))
+        {
+        dax::Vector3 point = location;
+        point[0] = static_cast<dax::Scalar>(i) +
+            this->Weight(firstPoint + i, firstPoint + i + 1);
+        this->Coordinates.Set(pointId++,
+                              this->Origin + this->Spacing * point);
+        }
+      }
+    if (this->Layout.GetJ(row) < ny - 1)
+      {
+      pointId = this->GenerateCrossEdgePoints(row, row + 1, 1, pointId);
+      }
+    if (this->Layout.GetK(row) < this->Layout.Dimensions[2] - 1)
+      {
+      this->GenerateCrossEdgePoints(row, row + ny, 2, pointId);
+      }
+  }
+
+  DAX_EXEC_EXPORT void GenerateTriangles(dax::Id row) const
+  {
+    using dax::worklet::internal::marchingcubes::NumFaces;
+    using dax::worklet::internal::marchingcubes::TriTable;
+    const dax::Id ny = this->Layout.Dimensions[1];
+
+    //the four point rows around the row of cells, in the order of the
+    //vertices of a hexahedron: (j,k), (j+1,k), (j,k+1), (j+1,k+1)
+    const dax::Id rows[4] = { row, row + 1, row + ny, row + ny + 1 };
+    const dax::Id2 range =
+        TrimRows(rows, 4, this->Layout, this->Classes, this->Trims);
+
+    dax::Id first[4];
+    dax::Id xEdgeId[4];
+    for (int index = 0; index < 4; ++index)
+      {
+      first[index] = this->Layout.GetFirstPoint(rows[index]);
+      xEdgeId[index] = this->PointOffsets.Get(rows[index]);
+      }
+    //y edges at k and k+1, z edges at j and j+1
+    dax::Id yEdgeId[2];
+    dax::Id zEdgeId[2];
+    for (int index = 0; index < 2; ++index)
+      {
+      const dax::Id yRow = rows[2*index];
+      const dax::Id zRow = rows[index];
+      yEdgeId[index] = this->PointOffsets.Get(yRow) + this->XCounts.Get(yRow);
+      zEdgeId[index] = this->PointOffsets.Get(zRow) + this->XCounts.Get(zRow)
+          + this->YCounts.Get(zRow);
+      }
+
+    dax::Id triangleId = this->TriangleOffsets.Get(row);
+    for (dax::Id i = range[0]; i < range[1]; ++i)
+      {
+      const int c0 = this->Classes.Get(first[0] + i);
+      const int c1 = this->Classes.Get(first[0] + i + 1);
+      const int c2 = this->Classes.Get(first[1] + i + 1);
+      const int c3 = this->Classes.Get(first[1] + i);
+      const int c4 = this->Classes.Get(first[2] + i);
+      const int c5 = this->Classes.Get(first[2] + i + 1);
+      const int c6 = this->Classes.Get(first[3] + i + 1);
+      const int c7 = this->Classes.Get(first[3] + i);
+      const int cellCase = c0 | (c1 << 1) | (c2 << 2) | (c3 << 3) |
+          (c4 << 4) | (c5 << 5) | (c6 << 6) | (c7 << 7);
+
+      const dax::Id numFaces = NumFaces[cellCase];
+      if (numFaces > 0)
+        {
+        //the point on each of the 12 edges of the cell, numbered as in the
+        //marching cubes tables
+        const dax::Id edgePoints[12] = {
+          xEdgeId[0],
+          yEdgeId[0] + (c0 != c3),
+          xEdgeId[1],
+          yEdgeId[0],
+          xEdgeId[2],
+          yEdgeId[1] + (c4 != c7),
+          xEdgeId[3],
+          yEdgeId[1],
+          zEdgeId[0],
+          zEdgeId[0] + (c0 != c4),
+          zEdgeId[1] + (c3 != c7),
+          zEdgeId[1]
+        };
+        for (dax::Id face = 0; face < numFaces; ++face)
+          {
+          for (dax::Id vertex = 0; vertex < 3; ++vertex)
+            {
+            const unsigned char edge = TriTable[cellCase][3*face + vertex];
+            this->Connections.Set(3*triangleId + vertex, edgePoints[edge]);
+            }
+          ++triangleId;
+          }
+        }
+
+      //move past the edges at the start of this cell
+      xEdgeId[0] += (c0 != c1);
+      xEdgeId[1] += (c3 != c2);
+      xEdgeId[2] += (c4 != c5);
+      xEdgeId[3] += (c7 != c6);
+      yEdgeId[0] += (c0 != c3);
+      yEdgeId[1] += (c4 != c7);
+      zEdgeId[0] += (c0 != c4);
+      zEdgeId[1] += (c3 != c7);
+      }
+  }
+
+  DAX_EXEC_EXPORT void operator()(dax::Id row) const
+  {
+    this->GeneratePoints(row);
+    if ((this->Layout.GetJ(row) < this->Layout.Dimensions[1] - 1) &&
+        (this->Layout.GetK(row) < this->Layout.Dimensions[2] - 1))
+      {
+      this->GenerateTriangles(row);
+      }
+  }
+};
+
+}
+} // namespace internal::flyingedges
+
+// -----------------------------------------------------------------------------
+/// Contours a scalar point field of a UniformGrid with the Flying Edges
+/// algorithm, which makes the same triangles as marching cubes. Rather than
+/// classifying every cell independently, it sweeps the rows of points along
+/// x. A first pass classifies the points of each row and finds the range of
+/// the row holding cut x edges. A second pass counts the cut y and z edges
+/// and the triangles of each row within those ranges, and after scanning the
+/// counts a last pass writes the points and triangles of each row. Every cut
+/// edge gets exactly one point, so no duplicate points need merging.
+///
+/// Unlike the worklets, which are scheduled by a dispatcher, this runs all
+/// the passes itself in the control environment.
+///
+template<class DeviceAdapterTag = DAX_DEFAULT_DEVICE_ADAPTER_TAG>
+class FlyingEdges
+{
+public:
+  DAX_CONT_EXPORT FlyingEdges(dax::Scalar isoValue) : IsoValue(isoValue) {  }
+
+  /// Generates the isosurface of \c field, which holds one value per point
+  /// of \c grid, into the triangle grid \c outGrid.
+  ///
+  template<class FieldHandleType, class OutGridType>
+  DAX_CONT_EXPORT void Run(const dax::cont::UniformGrid<DeviceAdapterTag> &grid,
+                           const FieldHandleType &field,
+                           OutGridType &outGrid) const
+  {
+    namespace fe = dax::worklet::internal::flyingedges;
+    typedef dax::cont::DeviceAdapterAlgorithm<DeviceAdapterTag> Algorithm;
+    typedef dax::cont::ArrayContainerControlTagBasic Container;
+    typedef dax::cont::ArrayHandle<dax::Id, Container, DeviceAdapterTag>
+        IdHandleType;
+    typedef dax::cont::ArrayHandle<dax::Id2, Container, DeviceAdapterTag>
+        TrimHandleType;
+    typedef dax::cont::ArrayHandle<fe::ClassType, Container, DeviceAdapterTag>
+        ClassHandleType;
+    typedef typename OutGridType::PointCoordinatesType CoordinatesHandleType;
+    typedef typename OutGridType::CellConnectionsType ConnectionsHandleType;
+
+    fe::RowLayout layout;
+    layout.Dimensions = dax::extentDimensions(grid.GetExtent());
+    const dax::Id numRows = layout.Dimensions[1] * layout.Dimensions[2];
+    if (layout.Dimensions[0] < 2 ||
+        layout.Dimensions[1] < 2 ||
+        layout.Dimensions[2] < 2)
+      {
+      outGrid.GetPointCoordinates().PrepareForOutput(0);
+      outGrid.PrepareForOutput(0);
+      return;
+      }
+
+    ClassHandleType classes;
+    IdHandleType xCounts;
+    TrimHandleType trims;
+    {
+    fe::ClassifyRows<typename FieldHandleType::PortalConstExecution,
+                     typename ClassHandleType::PortalExecution,
+                     typename IdHandleType::PortalExecution,
+                     typename TrimHandleType::PortalExecution>
+        classify(field.PrepareForInput(),
+                 this->IsoValue,
+                 layout,
+                 classes.PrepareForOutput(grid.GetNumberOfPoints()),
+                 xCounts.PrepareForOutput(numRows),
+                 trims.PrepareForOutput(numRows));
+    Algorithm::Schedule(classify, numRows);
+    }
+
+    IdHandleType yCounts;
+    IdHandleType pointCounts;
+    IdHandleType triangleCounts;
+    {
+    fe::CountRows<typename ClassHandleType::PortalConstExecution,
+                  typename IdHandleType::PortalConstExecution,
+                  typename IdHandleType::PortalExecution,
+                  typename TrimHandleType::PortalConstExecution>
+        count(layout,
+              classes.PrepareForInput(),
+              trims.PrepareForInput(),
+              xCounts.PrepareForInput(),
+              yCounts.PrepareForOutput(numRows),
+              pointCounts.PrepareForOutput(numRows),
+              triangleCounts.PrepareForOutput(numRows));
+    Algorithm::Schedule(count, numRows);
+    }
+
+    IdHandleType pointOffsets;
+    IdHandleType triangleOffsets;
+    const dax::Id numPoints =
+        Algorithm::ScanExclusive(pointCounts, pointOffsets);
+    const dax::Id numTriangles =
+        Algorithm::ScanExclusive(triangleCounts, triangleOffsets);
+    pointCounts.ReleaseResources();
+    triangleCounts.ReleaseResources();
+
+    const dax::Extent3 &extent = grid.GetExtent();
+    const dax::Vector3 origin = grid.GetOrigin() + grid.GetSpacing() *
+        dax::make_Vector3(static_cast<dax::Scalar>(extent.Min[0]),
+                          static_cast<dax::Scalar>(extent.Min[1]),
+                          static_cast<dax::Scalar>(extent.Min[2]));
+    {
+    fe::GenerateRows<typename FieldHandleType::PortalConstExecution,
+                     typename ClassHandleType::PortalConstExecution,
+                     typename IdHandleType::PortalConstExecution,
+                     typename TrimHandleType::PortalConstExecution,
+                     typename CoordinatesHandleType::PortalExecution,
+                     typename ConnectionsHandleType::PortalExecution>
+        generate(field.PrepareForInput(),
+                 this->IsoValue,
+                 layout,
+                 origin,
+                 grid.GetSpacing(),
+                 classes.PrepareForInput(),
+                 trims.PrepareForInput(),
+                 xCounts.PrepareForInput(),
+                 yCounts.PrepareForInput(),
+                 pointOffsets.PrepareForInput(),
+                 triangleOffsets.PrepareForInput(),
+                 outGrid.GetPointCoordinates().PrepareForOutput(numPoints),
+                 outGrid.PrepareForOutput(numTriangles).CellConnections);
+    Algorithm::Schedule(generate, numRows);
+    }
+  }
+
+private:
+  dax::Scalar IsoValue;
+};
+
+}
+} //dax::worklet
+
+#endif //__dax_worklet_FlyingEdges_h
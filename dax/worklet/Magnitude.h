@@ -29,12 +29,24 @@ public:
   typedef void ControlSignature(FieldIn, FieldOut);
   typedef void ExecutionSignature(_1,_2);
 
+  static const int BATCH_SIZE = 8;
+
   DAX_EXEC_EXPORT
   void operator()(const dax::Vector3 &inValue,
                   dax::Scalar &outValue) const
   {
     outValue = dax::math::Magnitude(inValue);
   }
+
+  DAX_EXEC_EXPORT
+  void operator()(const dax::Tuple<dax::Vector3,BATCH_SIZE> &inValues,
+                  dax::Tuple<dax::Scalar,BATCH_SIZE> &outValues) const
+  {
+    for (int lane = 0; lane < BATCH_SIZE; ++lane)
+      {
+      outValues[lane] = dax::math::Magnitude(inValues[lane]);
+      }
+  }
 };
 
 }
@@ -19,10 +19,13 @@
 
 #include <dax/CellTag.h>
 #include <dax/CellTraits.h>
+#include <dax/cont/arg/ExecutionObject.h>
 #include <dax/exec/CellField.h>
 #include <dax/exec/CellVertices.h>
+#include <dax/exec/ExecutionObjectBase.h>
 #include <dax/exec/InterpolatedCellPoints.h>
 #include <dax/exec/WorkletInterpolatedCell.h>
+#include <dax/exec/WorkletInterpolatedCellSet.h>
 #include <dax/exec/WorkletMapCell.h>
 
 #include <dax/worklet/internal/MarchingCubesTable.h>
@@ -46,10 +49,34 @@ int GetHexahedronClassification(const T isoValue, const U& values )
           (values[6] > isoValue) << 6 |
           (values[7] > isoValue) << 7);
 }
+
+// -----------------------------------------------------------------------------
+/// Returns the case id of a cell of any type: bit v is set when the value of
+/// vertex v is above the isovalue.
+///
+template<typename T, class CellTag>
+DAX_EXEC_EXPORT
+int GetCellClassification(
+    const T isoValue,
+    const dax::exec::CellField<dax::Scalar,CellTag> &values)
+{
+  int caseId = 0;
+  for (int vertexIndex = 0;
+       vertexIndex < dax::CellTraits<CellTag>::NUM_VERTICES;
+       ++vertexIndex)
+    {
+    caseId |= (values[vertexIndex] > isoValue) << vertexIndex;
+    }
+  return caseId;
+}
 }
 }
 
 // -----------------------------------------------------------------------------
+/// Counts the cells each input cell generates for an isovalue. Hexahedra,
+/// voxels, tetrahedra and wedges generate triangles; quadrilaterals and
+/// triangles generate lines.
+///
 class MarchingCubesCount : public dax::exec::WorkletMapCell
 {
 public:
@@ -59,6 +86,14 @@ public:
   DAX_CONT_EXPORT MarchingCubesCount(dax::Scalar isoValue)
     : IsoValue(isoValue) {  }
 
+  /// Cells whose values are all above or all below the isovalue generate
+  /// nothing. dax::cont::BrickRanges uses this to skip them.
+  ///
+  DAX_CONT_EXPORT dax::Vector2 GetValueRange() const
+  {
+    return dax::make_Vector2(this->IsoValue, this->IsoValue);
+  }
+
   template<class CellTag>
   DAX_EXEC_EXPORT
   dax::Id operator()(
@@ -74,14 +109,15 @@ public:
 private:
   dax::Scalar IsoValue;
 
-  template<class CellTag>
+  template<class CellTag, class CanonicalCellTag>
   DAX_EXEC_EXPORT
   dax::Id GetNumFaces(const dax::exec::CellField<dax::Scalar,CellTag> &values,
-                      dax::CellTagHexahedron) const
+                      CanonicalCellTag) const
   {
-    const int voxelClass =
-    internal::marchingcubes::GetHexahedronClassification(IsoValue,values);
-    return dax::worklet::internal::marchingcubes::NumFaces[voxelClass];
+    typedef internal::marchingcubes::ContourTables<CanonicalCellTag> Tables;
+    const int caseId =
+        internal::marchingcubes::GetCellClassification(IsoValue,values);
+    return Tables::GetNumberOfCells(caseId);
   }
 };
 
@@ -97,17 +133,18 @@ public:
   DAX_CONT_EXPORT MarchingCubesGenerate(dax::Scalar isoValue)
     : IsoValue(isoValue){ }
 
-  template<class CellTag>
+  template<class CellTag, class OutCellTag>
   DAX_EXEC_EXPORT void operator()(
       const dax::exec::CellVertices<CellTag>& verts,
-      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+      dax::exec::InterpolatedCellPoints<OutCellTag>& outCell,
       const dax::exec::CellField<dax::Scalar,CellTag> &values,
       dax::Id inputCellVisitIndex) const
   {
     // If you get a compile error on the following line, it means that this
-    // worklet was used with an improper cell type.  Check the cell type for the
-    // input grid given in the control environment.
-    this->BuildTriangle(
+    // worklet was used with an improper cell type or output cell type.  Check
+    // the cell types of the input and output grids given in the control
+    // environment.
+    this->BuildCell(
           verts,
           outCell,
           values,
@@ -118,33 +155,30 @@ public:
 private:
   dax::Scalar IsoValue;
 
-  template<class CellTag>
-  DAX_EXEC_EXPORT void BuildTriangle(
+  template<class CellTag, class CanonicalCellTag>
+  DAX_EXEC_EXPORT void BuildCell(
       const dax::exec::CellVertices<CellTag>& verts,
-      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+      dax::exec::InterpolatedCellPoints<
+        typename internal::marchingcubes::ContourTables<
+          CanonicalCellTag>::OutCellTag>& outCell,
       const dax::exec::CellField<dax::Scalar,CellTag> &values,
       dax::Id inputCellVisitIndex,
-      dax::CellTagHexahedron) const
+      CanonicalCellTag) const
   {
-    using dax::worklet::internal::marchingcubes::TriTable;
-    // These should probably be available through the voxel class
-    const unsigned char voxelVertEdges[12][2] ={
-        {0,1}, {1,2}, {3,2}, {0,3},
-        {4,5}, {5,6}, {7,6}, {4,7},
-        {0,4}, {1,5}, {2,6}, {3,7},
-      };
+    typedef internal::marchingcubes::ContourTables<CanonicalCellTag> Tables;
 
-    const int voxelClass =
-        internal::marchingcubes::GetHexahedronClassification(IsoValue,values);
+    const int caseId =
+        internal::marchingcubes::GetCellClassification(IsoValue,values);
 
     //save the point ids and ratio to interpolate the points of the new cell
     for (dax::Id outVertIndex = 0;
          outVertIndex < outCell.NUM_VERTICES;
          ++outVertIndex)
       {
-      const unsigned char edge = TriTable[voxelClass][(inputCellVisitIndex*3)+outVertIndex];
-      const int vertA = voxelVertEdges[edge][0];
-      const int vertB = voxelVertEdges[edge][1];
+      const int edge = Tables::GetEdge(
+            caseId, (inputCellVisitIndex*outCell.NUM_VERTICES)+outVertIndex);
+      const int vertA = Tables::GetEdgeVertex(edge,0);
+      const int vertB = Tables::GetEdgeVertex(edge,1);
 
       // Find the weight for linear interpolation
       const dax::Scalar weight = (IsoValue - values[vertA]) /
@@ -157,6 +191,529 @@ private:
       }
   }
 };
+
+
+// -----------------------------------------------------------------------------
+/// Generates the same cells as MarchingCubesGenerate, but all the cells of an
+/// input cell in a single invocation, so it needs no MarchingCubesCount pass.
+/// Dispatch it with a DispatcherGenerateInterpolatedCells made without a
+/// count array.
+///
+class MarchingCubesGenerateCells : public dax::exec::WorkletInterpolatedCellSet
+{
+public:
+  /// The most cells an input cell generates (for a hexahedron or voxel).
+  ///
+  static const int MAX_CELLS = 5;
+
+  typedef void ControlSignature(TopologyIn, GeometryOut, FieldPointIn);
+  typedef void ExecutionSignature(AsVertices(_1), _2, _3);
+
+  DAX_CONT_EXPORT MarchingCubesGenerateCells(dax::Scalar isoValue)
+    : IsoValue(isoValue){ }
+
+  template<class CellTag, class OutCellTag, int MaxCells>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellSet<OutCellTag,MaxCells>& outCells,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type or output cell type.  Check
+    // the cell types of the input and output grids given in the control
+    // environment.
+    this->BuildCells(
+          verts,
+          outCells,
+          values,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag, int MaxCells, class CanonicalCellTag>
+  DAX_EXEC_EXPORT void BuildCells(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellSet<
+        typename internal::marchingcubes::ContourTables<
+          CanonicalCellTag>::OutCellTag, MaxCells>& outCells,
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      CanonicalCellTag) const
+  {
+    typedef internal::marchingcubes::ContourTables<CanonicalCellTag> Tables;
+    typedef typename internal::marchingcubes::ContourTables<
+        CanonicalCellTag>::OutCellTag OutCellTag;
+    const int numOutVerts = dax::CellTraits<OutCellTag>::NUM_VERTICES;
+
+    const int caseId =
+        internal::marchingcubes::GetCellClassification(IsoValue,values);
+    const int numCells = Tables::GetNumberOfCells(caseId);
+
+    for (int cellIndex = 0; cellIndex < numCells; ++cellIndex)
+      {
+      dax::exec::InterpolatedCellPoints<OutCellTag> &outCell =
+          outCells.AddCell();
+      for (int outVertIndex = 0; outVertIndex < numOutVerts; ++outVertIndex)
+        {
+        const int edge = Tables::GetEdge(
+              caseId, (cellIndex*numOutVerts)+outVertIndex);
+        const int vertA = Tables::GetEdgeVertex(edge,0);
+        const int vertB = Tables::GetEdgeVertex(edge,1);
+
+        // Find the weight for linear interpolation
+        const dax::Scalar weight = (IsoValue - values[vertA]) /
+                                  (values[vertB]-values[vertA]);
+
+        outCell.SetInterpolationPoint(outVertIndex,
+                                      verts[vertA],
+                                      verts[vertB],
+                                      weight);
+        }
+      }
+  }
+};
+
+
+// -----------------------------------------------------------------------------
+/// Same as MarchingCubesCount, but also writes the classification of each
+/// cell as a compact case id. Handing the case ids to
+/// MarchingCubesGenerateFromCase saves the generate pass from gathering all
+/// the point values of a cell and classifying it again for every triangle.
+///
+class MarchingCubesClassify : public dax::exec::WorkletMapCell
+{
+public:
+  typedef unsigned char CaseType;
+
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut, FieldOut);
+  typedef void ExecutionSignature(_2, _3, _4);
+
+  DAX_CONT_EXPORT MarchingCubesClassify(dax::Scalar isoValue)
+    : IsoValue(isoValue) {  }
+
+  /// Cells whose values are all above or all below the isovalue generate
+  /// nothing. dax::cont::BrickRanges uses this to skip them.
+  ///
+  DAX_CONT_EXPORT dax::Vector2 GetValueRange() const
+  {
+    return dax::make_Vector2(this->IsoValue, this->IsoValue);
+  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  void operator()(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                  dax::Id &numFaces,
+                  CaseType &caseId) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->Classify(values,
+                   numFaces,
+                   caseId,
+                   typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag, class CanonicalCellTag>
+  DAX_EXEC_EXPORT
+  void Classify(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                dax::Id &numFaces,
+                CaseType &caseId,
+                CanonicalCellTag) const
+  {
+    typedef internal::marchingcubes::ContourTables<CanonicalCellTag> Tables;
+    const int cellClass =
+        internal::marchingcubes::GetCellClassification(IsoValue,values);
+    numFaces = Tables::GetNumberOfCells(cellClass);
+    caseId = static_cast<CaseType>(cellClass);
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Execution object that gives a worklet random access to a whole point
+/// field, so that it can read just the values it needs instead of having the
+/// field gathered for every vertex of a cell.
+///
+template<class ArrayHandleType>
+class MarchingCubesPointField : public dax::exec::ExecutionObjectBase
+{
+  typedef typename ArrayHandleType::PortalConstExecution PortalType;
+public:
+  typedef typename ArrayHandleType::ValueType ValueType;
+
+  DAX_CONT_EXPORT
+  MarchingCubesPointField(ArrayHandleType handle)
+    : Values(handle.PrepareForInput()) {  }
+
+  DAX_EXEC_EXPORT ValueType operator[](dax::Id pointIndex) const
+  {
+    return this->Values.Get(pointIndex);
+  }
+
+private:
+  PortalType Values;
+};
+
+template<class ArrayHandleType>
+DAX_CONT_EXPORT
+MarchingCubesPointField<ArrayHandleType>
+make_MarchingCubesPointField(ArrayHandleType handle)
+{
+  return MarchingCubesPointField<ArrayHandleType>(handle);
+}
+
+// -----------------------------------------------------------------------------
+/// Generates the same triangles as MarchingCubesGenerate from the case ids
+/// written by MarchingCubesClassify. The case ids are a cell field of the
+/// input, which the generate dispatcher reads through its scatter map. The
+/// point field is passed as a MarchingCubesPointField so that only the end
+/// points of the cut edges are read.
+///
+class MarchingCubesGenerateFromCase : public dax::exec::WorkletInterpolatedCell
+{
+public:
+  typedef MarchingCubesClassify::CaseType CaseType;
+
+  typedef void ControlSignature(TopologyIn, GeometryOut, FieldCellIn, UserObject);
+  typedef void ExecutionSignature(AsVertices(_1), _2, _3, _4, VisitIndex);
+
+  DAX_CONT_EXPORT MarchingCubesGenerateFromCase(dax::Scalar isoValue)
+    : IsoValue(isoValue){ }
+
+  template<class CellTag, class OutCellTag, class PointFieldType>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<OutCellTag>& outCell,
+      CaseType caseId,
+      const PointFieldType &values,
+      dax::Id inputCellVisitIndex) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type or output cell type.  Check
+    // the cell types of the input and output grids given in the control
+    // environment.
+    this->BuildCell(
+          verts,
+          outCell,
+          caseId,
+          values,
+          inputCellVisitIndex,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+
+private:
+  dax::Scalar IsoValue;
+
+  template<class CellTag, class PointFieldType, class CanonicalCellTag>
+  DAX_EXEC_EXPORT void BuildCell(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<
+        typename internal::marchingcubes::ContourTables<
+          CanonicalCellTag>::OutCellTag>& outCell,
+      CaseType caseId,
+      const PointFieldType &values,
+      dax::Id inputCellVisitIndex,
+      CanonicalCellTag) const
+  {
+    typedef internal::marchingcubes::ContourTables<CanonicalCellTag> Tables;
+
+    //save the point ids and ratio to interpolate the points of the new cell
+    for (dax::Id outVertIndex = 0;
+         outVertIndex < outCell.NUM_VERTICES;
+         ++outVertIndex)
+      {
+      const int edge = Tables::GetEdge(
+            caseId, (inputCellVisitIndex*outCell.NUM_VERTICES)+outVertIndex);
+      const int vertA = Tables::GetEdgeVertex(edge,0);
+      const int vertB = Tables::GetEdgeVertex(edge,1);
+
+      // Find the weight for linear interpolation
+      const dax::Scalar valueA = values[verts[vertA]];
+      const dax::Scalar valueB = values[verts[vertB]];
+      const dax::Scalar weight = (IsoValue - valueA) / (valueB - valueA);
+
+      outCell.SetInterpolationPoint(outVertIndex,
+                                    verts[vertA],
+                                    verts[vertB],
+                                    weight);
+      }
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Execution object holding the isovalues used by MarchingCubesMultiCount and
+/// MarchingCubesMultiGenerate.
+///
+template<class ArrayHandleType>
+class MarchingCubesIsoValues : public dax::exec::ExecutionObjectBase
+{
+  typedef typename ArrayHandleType::PortalConstExecution PortalType;
+public:
+  DAX_CONT_EXPORT
+  MarchingCubesIsoValues(ArrayHandleType handle)
+    : Values(handle.PrepareForInput()) {  }
+
+  DAX_EXEC_EXPORT dax::Id GetNumberOfValues() const
+  {
+    return this->Values.GetNumberOfValues();
+  }
+
+  DAX_EXEC_EXPORT dax::Scalar operator[](dax::Id isoIndex) const
+  {
+    return this->Values.Get(isoIndex);
+  }
+
+private:
+  PortalType Values;
+};
+
+template<class ArrayHandleType>
+DAX_CONT_EXPORT
+MarchingCubesIsoValues<ArrayHandleType>
+make_MarchingCubesIsoValues(ArrayHandleType handle)
+{
+  return MarchingCubesIsoValues<ArrayHandleType>(handle);
+}
+
+// -----------------------------------------------------------------------------
+/// Execution object holding the case id of every cell for every isovalue,
+/// written by MarchingCubesMultiCount and read by MarchingCubesMultiGenerate.
+/// The case ids of a cell are stored together at the id given for the cell
+/// to both worklets.
+///
+template<class ArrayHandleType>
+class MarchingCubesMultiCases : public dax::exec::ExecutionObjectBase
+{
+  typedef typename ArrayHandleType::PortalExecution PortalType;
+public:
+  typedef MarchingCubesClassify::CaseType CaseType;
+
+  /// Allocates the case ids of \c numCells cells, for MarchingCubesMultiCount
+  /// to write.
+  ///
+  DAX_CONT_EXPORT
+  MarchingCubesMultiCases(ArrayHandleType handle,
+                          dax::Id numIsoValues,
+                          dax::Id numCells)
+    : Cases(handle.PrepareForOutput(numIsoValues*numCells)),
+      NumberOfIsoValues(numIsoValues) {  }
+
+  /// Reads the case ids written by MarchingCubesMultiCount.
+  ///
+  DAX_CONT_EXPORT
+  MarchingCubesMultiCases(ArrayHandleType handle, dax::Id numIsoValues)
+    : Cases(handle.PrepareForInPlace()),
+      NumberOfIsoValues(numIsoValues) {  }
+
+  DAX_EXEC_EXPORT CaseType Get(dax::Id cellId, dax::Id isoIndex) const
+  {
+    return this->Cases.Get(cellId*this->NumberOfIsoValues + isoIndex);
+  }
+
+  DAX_EXEC_EXPORT void Set(dax::Id cellId,
+                           dax::Id isoIndex,
+                           CaseType caseId) const
+  {
+    this->Cases.Set(cellId*this->NumberOfIsoValues + isoIndex, caseId);
+  }
+
+private:
+  PortalType Cases;
+  dax::Id NumberOfIsoValues;
+};
+
+template<class ArrayHandleType>
+DAX_CONT_EXPORT
+MarchingCubesMultiCases<ArrayHandleType>
+make_MarchingCubesMultiCases(ArrayHandleType handle,
+                             dax::Id numIsoValues,
+                             dax::Id numCells)
+{
+  return MarchingCubesMultiCases<ArrayHandleType>(handle,
+                                                  numIsoValues,
+                                                  numCells);
+}
+
+template<class ArrayHandleType>
+DAX_CONT_EXPORT
+MarchingCubesMultiCases<ArrayHandleType>
+make_MarchingCubesMultiCases(ArrayHandleType handle, dax::Id numIsoValues)
+{
+  return MarchingCubesMultiCases<ArrayHandleType>(handle, numIsoValues);
+}
+
+// -----------------------------------------------------------------------------
+/// Same as MarchingCubesCount, but counts the triangles of every isovalue
+/// given as a MarchingCubesIsoValues. The point values of each cell are
+/// gathered once and classified against all the isovalues, and the case ids
+/// are kept in a MarchingCubesMultiCases for MarchingCubesMultiGenerate. The
+/// cell field of ids, usually a dax::cont::ArrayHandleCounting from 0, says
+/// where the case ids of each cell go.
+///
+class MarchingCubesMultiCount : public dax::exec::WorkletMapCell
+{
+public:
+  typedef void ControlSignature(TopologyIn, FieldPointIn, UserObject,
+                                FieldCellIn, UserObject, FieldOut);
+  typedef _6 ExecutionSignature(_2, _3, _4, _5);
+
+  template<class CellTag, class IsoValuesType, class CasesType>
+  DAX_EXEC_EXPORT
+  dax::Id operator()(
+      const dax::exec::CellField<dax::Scalar,CellTag> &values,
+      const IsoValuesType &isoValues,
+      dax::Id cellId,
+      const CasesType &cases) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    return this->GetNumFaces(
+          values,
+          isoValues,
+          cellId,
+          cases,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+private:
+  template<class CellTag,
+           class IsoValuesType,
+           class CasesType,
+           class CanonicalCellTag>
+  DAX_EXEC_EXPORT
+  dax::Id GetNumFaces(const dax::exec::CellField<dax::Scalar,CellTag> &values,
+                      const IsoValuesType &isoValues,
+                      dax::Id cellId,
+                      const CasesType &cases,
+                      CanonicalCellTag) const
+  {
+    typedef internal::marchingcubes::ContourTables<CanonicalCellTag> Tables;
+    dax::Id numFaces = 0;
+    const dax::Id numIsoValues = isoValues.GetNumberOfValues();
+    for (dax::Id isoIndex = 0; isoIndex < numIsoValues; ++isoIndex)
+      {
+      const int caseId =
+          internal::marchingcubes::GetCellClassification(
+            isoValues[isoIndex],values);
+      cases.Set(cellId,
+                isoIndex,
+                static_cast<typename CasesType::CaseType>(caseId));
+      numFaces += Tables::GetNumberOfCells(caseId);
+      }
+    return numFaces;
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Generates the triangles counted by MarchingCubesMultiCount, from the case
+/// ids it kept. The triangles of a cell are ordered by isovalue, and the
+/// isovalue of each triangle is found from the face counts of the cell's
+/// cases, so the point values are not gathered and the cell is not
+/// classified again. The point field is passed as a MarchingCubesPointField
+/// so that only the end points of the cut edges are read, and the cell ids
+/// must be the ones given to MarchingCubesMultiCount.
+///
+/// The index of the isovalue of each triangle is written to the last
+/// argument. Pass that array to SetMergeLayers on the dispatcher so that
+/// points of different isovalues lying on the same edge are not merged.
+///
+class MarchingCubesMultiGenerate : public dax::exec::WorkletInterpolatedCell
+{
+public:
+
+  typedef void ControlSignature(TopologyIn, GeometryOut, UserObject,
+                                UserObject, FieldCellIn, UserObject, FieldOut);
+  typedef void ExecutionSignature(AsVertices(_1), _2, _3, _4, _5, _6, _7,
+                                  VisitIndex);
+
+  template<class CellTag,
+           class OutCellTag,
+           class PointFieldType,
+           class IsoValuesType,
+           class CasesType>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<OutCellTag>& outCell,
+      const PointFieldType &values,
+      const IsoValuesType &isoValues,
+      dax::Id cellId,
+      const CasesType &cases,
+      dax::Id &isoIndex,
+      dax::Id inputCellVisitIndex) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type or output cell type.  Check
+    // the cell types of the input and output grids given in the control
+    // environment.
+    this->BuildCell(
+          verts,
+          outCell,
+          values,
+          isoValues,
+          cellId,
+          cases,
+          isoIndex,
+          inputCellVisitIndex,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+
+private:
+  template<class CellTag,
+           class PointFieldType,
+           class IsoValuesType,
+           class CasesType,
+           class CanonicalCellTag>
+  DAX_EXEC_EXPORT void BuildCell(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<
+        typename internal::marchingcubes::ContourTables<
+          CanonicalCellTag>::OutCellTag>& outCell,
+      const PointFieldType &values,
+      const IsoValuesType &isoValues,
+      dax::Id cellId,
+      const CasesType &cases,
+      dax::Id &isoIndex,
+      dax::Id inputCellVisitIndex,
+      CanonicalCellTag) const
+  {
+    typedef internal::marchingcubes::ContourTables<CanonicalCellTag> Tables;
+
+    //find the isovalue this visit belongs to by skipping the triangles of
+    //the isovalues before it
+    dax::Id faceIndex = inputCellVisitIndex;
+    int caseId = cases.Get(cellId, 0);
+    for (isoIndex = 0; faceIndex >= Tables::GetNumberOfCells(caseId); )
+      {
+      faceIndex -= Tables::GetNumberOfCells(caseId);
+      caseId = cases.Get(cellId, ++isoIndex);
+      }
+    const dax::Scalar isoValue = isoValues[isoIndex];
+
+    //save the point ids and ratio to interpolate the points of the new cell
+    for (dax::Id outVertIndex = 0;
+         outVertIndex < outCell.NUM_VERTICES;
+         ++outVertIndex)
+      {
+      const int edge = Tables::GetEdge(
+            caseId, (faceIndex*outCell.NUM_VERTICES)+outVertIndex);
+      const int vertA = Tables::GetEdgeVertex(edge,0);
+      const int vertB = Tables::GetEdgeVertex(edge,1);
+
+      // Find the weight for linear interpolation
+      const dax::Scalar valueA = values[verts[vertA]];
+      const dax::Scalar valueB = values[verts[vertB]];
+      const dax::Scalar weight = (isoValue - valueA) / (valueB - valueA);
+
+      outCell.SetInterpolationPoint(outVertIndex,
+                                    verts[vertA],
+                                    verts[vertB],
+                                    weight);
+      }
+  }
+};
 }
 } //dax::worklet
 
@@ -0,0 +1,75 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#ifndef __PointGradient_worklet_
+#define __PointGradient_worklet_
+
+#include <dax/exec/Neighborhood.h>
+#include <dax/exec/WorkletMapPointNeighborhood.h>
+
+namespace dax {
+namespace worklet {
+
+/// Computes the gradient of a point field of a uniform grid at each point
+/// using central differences. On the boundary of the grid the difference is
+/// one sided, and the gradient is 0 in any direction the grid is flat in.
+/// Use with dax::cont::DispatcherMapPointNeighborhood, giving the grid and
+/// its point field. The worklet has to be constructed with the spacing of
+/// that grid, as in PointGradient(grid.GetSpacing()).
+///
+class PointGradient : public dax::exec::WorkletMapPointNeighborhood
+{
+public:
+  typedef void ControlSignature(TopologyIn, FieldPointNeighborhoodIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  DAX_CONT_EXPORT
+  explicit PointGradient(const dax::Vector3 &spacing) : Spacing(spacing) {  }
+
+  DAX_EXEC_EXPORT
+  dax::Vector3 operator()(
+      const dax::exec::Neighborhood<dax::Scalar,1> &field) const
+  {
+    dax::Vector3 gradient;
+    for (int dimension = 0; dimension < 3; ++dimension)
+      {
+      const int low = field.ClampOffset(dimension, -1);
+      const int high = field.ClampOffset(dimension, 1);
+      if (high == low)
+        {
+        gradient[dimension] = 0;
+        continue;
+        }
+      int lowOffset[3] = { 0, 0, 0 };
+      int highOffset[3] = { 0, 0, 0 };
+      lowOffset[dimension] = low;
+      highOffset[dimension] = high;
+      const dax::Scalar difference =
+          field.Get(highOffset[0], highOffset[1], highOffset[2])
+          - field.Get(lowOffset[0], lowOffset[1], lowOffset[2]);
+      gradient[dimension] =
+          difference/((high - low)*this->Spacing[dimension]);
+      }
+    return gradient;
+  }
+
+private:
+  dax::Vector3 Spacing;
+};
+
+}
+} // namespace dax::worklet
+
+#endif //__PointGradient_worklet_
@@ -168,6 +168,154 @@ private:
   }
 };
 
+
+// -----------------------------------------------------------------------------
+/// Same as SliceCount, but also writes the classification of each cell as a
+/// compact case id for SliceGenerateFromCase.
+///
+class SliceClassify : public dax::exec::WorkletMapCell
+{
+public:
+  typedef unsigned char CaseType;
+
+  typedef void ControlSignature(TopologyIn, FieldPointIn, FieldOut, FieldOut);
+  typedef void ExecutionSignature(_2, _3, _4);
+
+  DAX_CONT_EXPORT SliceClassify(dax::Vector3 origin, dax::Vector3 normal)
+    : Origin(origin),
+      Normal(normal)
+  {
+  }
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  void operator()(const dax::exec::CellField<dax::Vector3,CellTag> &coords,
+                  dax::Id &numFaces,
+                  CaseType &caseId) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->Classify(coords,
+                   numFaces,
+                   caseId,
+                   typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+private:
+  dax::Vector3 Origin;
+  dax::Vector3 Normal;
+
+  template<class CellTag>
+  DAX_EXEC_EXPORT
+  void Classify(const dax::exec::CellField<dax::Vector3,CellTag> &coords,
+                dax::Id &numFaces,
+                CaseType &caseId,
+                dax::CellTagHexahedron) const
+  {
+    const dax::Scalar isoValue = dax::dot(Normal,Origin);
+    const int voxelClass =(
+          ( dax::dot(Normal, coords[0] - Origin ) > isoValue ) << 0 |
+          ( dax::dot(Normal, coords[1] - Origin ) > isoValue ) << 1 |
+          ( dax::dot(Normal, coords[2] - Origin ) > isoValue ) << 2 |
+          ( dax::dot(Normal, coords[3] - Origin ) > isoValue ) << 3 |
+          ( dax::dot(Normal, coords[4] - Origin ) > isoValue ) << 4 |
+          ( dax::dot(Normal, coords[5] - Origin ) > isoValue ) << 5 |
+          ( dax::dot(Normal, coords[6] - Origin ) > isoValue ) << 6 |
+          ( dax::dot(Normal, coords[7] - Origin ) > isoValue ) << 7);
+    numFaces = dax::worklet::internal::marchingcubes::NumFaces[voxelClass];
+    caseId = static_cast<CaseType>(voxelClass);
+  }
+};
+
+// -----------------------------------------------------------------------------
+/// Generates the same triangles as SliceGenerate from the case ids written by
+/// SliceClassify. Like MarchingCubesGenerateFromCase, the point coordinates
+/// are passed as a MarchingCubesPointField so only the end points of the cut
+/// edges are read.
+///
+class SliceGenerateFromCase : public dax::exec::WorkletInterpolatedCell
+{
+public:
+  typedef SliceClassify::CaseType CaseType;
+
+  typedef void ControlSignature(TopologyIn, GeometryOut, FieldCellIn, UserObject);
+  typedef void ExecutionSignature(AsVertices(_1), _2, _3, _4, VisitIndex);
+
+  DAX_CONT_EXPORT SliceGenerateFromCase(dax::Vector3 origin,
+                                        dax::Vector3 normal)
+    : Origin(origin),
+      Normal(normal)
+  {
+  }
+
+  template<class CellTag, class PointCoordinatesType>
+  DAX_EXEC_EXPORT void operator()(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+      CaseType caseId,
+      const PointCoordinatesType &coords,
+      dax::Id inputCellVisitIndex) const
+  {
+    // If you get a compile error on the following line, it means that this
+    // worklet was used with an improper cell type.  Check the cell type for the
+    // input grid given in the control environment.
+    this->BuildTriangle(
+          verts,
+          outCell,
+          caseId,
+          coords,
+          inputCellVisitIndex,
+          typename dax::CellTraits<CellTag>::CanonicalCellTag());
+  }
+
+private:
+  dax::Vector3 Origin;
+  dax::Vector3 Normal;
+
+  template<class CellTag, class PointCoordinatesType>
+  DAX_EXEC_EXPORT void BuildTriangle(
+      const dax::exec::CellVertices<CellTag>& verts,
+      dax::exec::InterpolatedCellPoints<dax::CellTagTriangle>& outCell,
+      CaseType caseId,
+      const PointCoordinatesType &coords,
+      dax::Id inputCellVisitIndex,
+      dax::CellTagHexahedron) const
+  {
+    using dax::worklet::internal::marchingcubes::TriTable;
+
+    const dax::Scalar isoValue = dax::dot(this->Normal,this->Origin);
+
+    // These should probably be available through the voxel class
+    const unsigned char voxelVertEdges[12][2] ={
+        {0,1}, {1,2}, {3,2}, {0,3},
+        {4,5}, {5,6}, {7,6}, {4,7},
+        {0,4}, {1,5}, {2,6}, {3,7},
+      };
+
+    //save the point ids and ratio to interpolate the points of the new cell
+    for (dax::Id outVertIndex = 0;
+         outVertIndex < outCell.NUM_VERTICES;
+         ++outVertIndex)
+      {
+      const unsigned char edge = TriTable[caseId][(inputCellVisitIndex*3)+outVertIndex];
+      const int vertA = voxelVertEdges[edge][0];
+      const int vertB = voxelVertEdges[edge][1];
+
+      // Find the weight for linear interpolation
+      const dax::Scalar isoA =
+          dax::dot(this->Normal,coords[verts[vertA]]-this->Origin);
+      const dax::Scalar isoB =
+          dax::dot(this->Normal,coords[verts[vertB]]-this->Origin);
+      const dax::Scalar weight = (isoValue - isoA) / (isoB - isoA);
+
+      outCell.SetInterpolationPoint(outVertIndex,
+                                    verts[vertA],
+                                    verts[vertB],
+                                    weight);
+      }
+  }
+};
+
 }
 }
 #endif
@@ -27,6 +27,8 @@ public:
   typedef void ControlSignature(FieldIn, FieldOut);
   typedef _2 ExecutionSignature(_1);
 
+  static const int BATCH_SIZE = 8;
+
 
   template<class ValueType>
   DAX_EXEC_EXPORT
@@ -34,6 +36,19 @@ public:
   {
    return inValue * inValue;
   }
+
+  template<class ValueType>
+  DAX_EXEC_EXPORT
+  dax::Tuple<ValueType,BATCH_SIZE>
+  operator()(const dax::Tuple<ValueType,BATCH_SIZE> &inValues) const
+  {
+    dax::Tuple<ValueType,BATCH_SIZE> outValues;
+    for (int lane = 0; lane < BATCH_SIZE; ++lane)
+      {
+      outValues[lane] = inValues[lane] * inValues[lane];
+      }
+    return outValues;
+  }
 };
 
 }
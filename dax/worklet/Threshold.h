@@ -79,6 +79,15 @@ public:
   ThresholdCount(ValueType thresholdMin, ValueType thresholdMax)
     : ThresholdMin(thresholdMin), ThresholdMax(thresholdMax) {  }
 
+  /// Cells with a value outside this range are not passed.
+  /// dax::cont::BrickRanges uses this to skip cells when ValueType is a
+  /// scalar.
+  ///
+  DAX_CONT_EXPORT dax::Tuple<ValueType,2> GetValueRange() const
+  {
+    return dax::Tuple<ValueType,2>(this->ThresholdMin, this->ThresholdMax);
+  }
+
   template<class CellTag>
   DAX_EXEC_EXPORT
   dax::Id operator()(
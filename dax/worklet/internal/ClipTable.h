@@ -0,0 +1,104 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#ifndef __dax_worklet_internal_ClipTable_h
+#define __dax_worklet_internal_ClipTable_h
+
+#include <dax/CellTag.h>
+#include <dax/internal/ExportMacros.h>
+
+#include <dax/worklet/internal/MarchingCubesTable.h>
+
+namespace dax {
+namespace worklet{
+namespace internal{
+namespace clip{
+
+// Cut cells are split into tetrahedra, which are then clipped one at a time.
+// Each piece of a clipped tetrahedron is given by four point codes: 0 to 3
+// are the vertices of the tetrahedron and 4 to 9 are the points cut on the
+// edges of marchingcubes::TetrahedronEdgeVertices. A case has bit v set when
+// vertex v is kept. Every piece is positively oriented.
+
+// ---------------------------------------------------------- tetrahedronNumTets
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TetrahedronNumTets[16] =
+{ 0, 1, 1, 3, 1, 3, 3, 3, 1, 3, 3, 3, 3, 3, 3, 1 };
+
+// ............................................................ tetrahedronTable
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TetrahedronTable[16][12] =
+{
+   {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 4, 6, 7, 255, 255, 255, 255, 255, 255, 255, 255},
+   {4, 1, 5, 8, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 6, 7, 1, 6, 7, 1, 5, 7, 1, 5, 8},
+   {2, 6, 5, 9, 255, 255, 255, 255, 255, 255, 255, 255},
+   {4, 0, 7, 2, 7, 4, 2, 5, 2, 7, 5, 9},
+   {1, 4, 8, 2, 4, 8, 2, 6, 8, 2, 6, 9},
+   {0, 1, 2, 7, 1, 2, 7, 8, 2, 7, 8, 9},
+   {7, 3, 8, 9, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 4, 6, 3, 4, 6, 3, 8, 6, 3, 8, 9},
+   {4, 1, 5, 3, 5, 4, 3, 7, 3, 5, 7, 9},
+   {1, 0, 3, 6, 3, 1, 6, 5, 6, 3, 5, 9},
+   {2, 6, 5, 3, 6, 5, 3, 7, 5, 3, 7, 8},
+   {0, 2, 3, 4, 2, 3, 4, 5, 3, 4, 5, 8},
+   {2, 1, 3, 4, 3, 2, 4, 6, 4, 3, 6, 7},
+   {0, 1, 2, 3, 255, 255, 255, 255, 255, 255, 255, 255}
+};
+
+// Number of the first point code that lies on an edge.
+const int TETRAHEDRON_EDGE_CODE = 4;
+
+// ...................................................... hexahedronTetrahedra
+DAX_EXEC_CONSTANT_EXPORT const unsigned char HexahedronTetrahedra[6][4] =
+{ {0,1,2,6}, {0,2,3,6}, {0,3,7,6}, {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+
+// ........................................................... wedgeTetrahedra
+DAX_EXEC_CONSTANT_EXPORT const unsigned char WedgeTetrahedra[3][4] =
+{ {1,0,2,3}, {2,1,3,4}, {3,2,4,5} };
+
+// -----------------------------------------------------------------------------
+/// Gives the worklets uniform access to how each canonical cell type is
+/// split into positively oriented tetrahedra. The six tetrahedra of a
+/// hexahedron share the diagonal from vertex 0 to vertex 6, so neighboring
+/// voxels split their common face the same way. Cell types without a split
+/// leave this undefined so that they fail to compile.
+///
+template<class CellTag> struct CellTetrahedra;
+
+template<> struct CellTetrahedra<dax::CellTagHexahedron>
+{
+  static const int NUM_TETRAHEDRA = 6;
+  DAX_EXEC_EXPORT static int GetVertex(int tetrahedron, int vertex)
+    { return HexahedronTetrahedra[tetrahedron][vertex]; }
+};
+
+template<> struct CellTetrahedra<dax::CellTagWedge>
+{
+  static const int NUM_TETRAHEDRA = 3;
+  DAX_EXEC_EXPORT static int GetVertex(int tetrahedron, int vertex)
+    { return WedgeTetrahedra[tetrahedron][vertex]; }
+};
+
+template<> struct CellTetrahedra<dax::CellTagTetrahedron>
+{
+  static const int NUM_TETRAHEDRA = 1;
+  DAX_EXEC_EXPORT static int GetVertex(int, int vertex)
+    { return vertex; }
+};
+
+}}}} // dax::worklet::internal::clip
+
+#endif //__dax_worklet_internal_ClipTable_h
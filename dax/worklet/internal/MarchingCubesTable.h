@@ -17,6 +17,7 @@
 #ifndef __dax_worklet_internal_MarchingCubesTable_h
 #define __dax_worklet_internal_MarchingCubesTable_h
 
+#include <dax/CellTag.h>
 #include <dax/internal/ExportMacros.h>
 
 namespace dax {
@@ -305,6 +306,212 @@ DAX_EXEC_CONSTANT_EXPORT const unsigned char TriTable[256][16] =
    {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255}
 };
 
+// ..................................................... hexahedronEdgeVertices
+DAX_EXEC_CONSTANT_EXPORT const unsigned char HexahedronEdgeVertices[12][2] =
+{ {0,1}, {1,2}, {3,2}, {0,3},
+  {4,5}, {5,6}, {7,6}, {4,7},
+  {0,4}, {1,5}, {2,6}, {3,7} };
+
+// -------------------------------------------------------- tetrahedronNumFaces
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TetrahedronNumFaces[16] =
+{ 0, 1, 1, 2, 1, 2, 2, 1, 1, 2, 2, 1, 2, 1, 1, 0,
+};
+
+// ........................................................ tetrahedronTriTable
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TetrahedronTriTable[16][6] =
+{
+   {255, 255, 255, 255, 255, 255},
+   {0, 3, 2, 255, 255, 255},
+   {0, 1, 4, 255, 255, 255},
+   {1, 4, 3, 1, 3, 2},
+   {1, 2, 5, 255, 255, 255},
+   {0, 3, 5, 0, 5, 1},
+   {0, 2, 5, 0, 5, 4},
+   {3, 5, 4, 255, 255, 255},
+   {3, 4, 5, 255, 255, 255},
+   {0, 4, 5, 0, 5, 2},
+   {0, 1, 5, 0, 5, 3},
+   {1, 5, 2, 255, 255, 255},
+   {1, 2, 3, 1, 3, 4},
+   {0, 4, 1, 255, 255, 255},
+   {0, 2, 3, 255, 255, 255},
+   {255, 255, 255, 255, 255, 255}
+};
+
+// .................................................... tetrahedronEdgeVertices
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TetrahedronEdgeVertices[6][2] =
+{ {0,1}, {1,2}, {2,0}, {0,3}, {1,3}, {2,3} };
+
+// -------------------------------------------------------------- wedgeNumFaces
+DAX_EXEC_CONSTANT_EXPORT const unsigned char WedgeNumFaces[64] =
+{ 0, 1, 1, 2, 1, 2, 2, 1, 1, 2, 2, 3, 2, 3, 3, 2,
+  1, 2, 2, 3, 2, 3, 3, 2, 2, 3, 3, 2, 3, 4, 4, 1,
+  1, 2, 2, 3, 2, 3, 3, 2, 2, 3, 3, 4, 3, 2, 4, 1,
+  2, 3, 3, 4, 3, 4, 2, 1, 1, 2, 2, 1, 2, 1, 1, 0,
+};
+
+// .............................................................. wedgeTriTable
+DAX_EXEC_CONSTANT_EXPORT const unsigned char WedgeTriTable[64][12] =
+{
+   {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 2, 6, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 7, 1, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {1, 2, 6, 1, 6, 7, 255, 255, 255, 255, 255, 255},
+   {1, 8, 2, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 1, 8, 0, 8, 6, 255, 255, 255, 255, 255, 255},
+   {0, 7, 8, 0, 8, 2, 255, 255, 255, 255, 255, 255},
+   {6, 7, 8, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {3, 6, 5, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 2, 5, 0, 5, 3, 255, 255, 255, 255, 255, 255},
+   {0, 7, 1, 3, 6, 5, 255, 255, 255, 255, 255, 255},
+   {1, 2, 5, 1, 5, 3, 1, 3, 7, 255, 255, 255},
+   {1, 8, 2, 3, 6, 5, 255, 255, 255, 255, 255, 255},
+   {0, 1, 8, 0, 8, 5, 0, 5, 3, 255, 255, 255},
+   {0, 7, 8, 0, 8, 2, 3, 6, 5, 255, 255, 255},
+   {3, 7, 8, 3, 8, 5, 255, 255, 255, 255, 255, 255},
+   {3, 4, 7, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 2, 6, 3, 4, 7, 255, 255, 255, 255, 255, 255},
+   {0, 3, 4, 0, 4, 1, 255, 255, 255, 255, 255, 255},
+   {1, 2, 6, 1, 6, 3, 1, 3, 4, 255, 255, 255},
+   {1, 8, 2, 3, 4, 7, 255, 255, 255, 255, 255, 255},
+   {0, 1, 8, 0, 8, 6, 3, 4, 7, 255, 255, 255},
+   {0, 3, 4, 0, 4, 8, 0, 8, 2, 255, 255, 255},
+   {3, 4, 8, 3, 8, 6, 255, 255, 255, 255, 255, 255},
+   {4, 7, 6, 4, 6, 5, 255, 255, 255, 255, 255, 255},
+   {0, 2, 5, 0, 5, 4, 0, 4, 7, 255, 255, 255},
+   {0, 6, 5, 0, 5, 4, 0, 4, 1, 255, 255, 255},
+   {1, 2, 5, 1, 5, 4, 255, 255, 255, 255, 255, 255},
+   {1, 8, 2, 4, 7, 6, 4, 6, 5, 255, 255, 255},
+   {0, 1, 8, 0, 8, 5, 0, 5, 4, 0, 4, 7},
+   {0, 6, 5, 0, 5, 4, 0, 4, 8, 0, 8, 2},
+   {4, 8, 5, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {4, 5, 8, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 2, 6, 4, 5, 8, 255, 255, 255, 255, 255, 255},
+   {0, 7, 1, 4, 5, 8, 255, 255, 255, 255, 255, 255},
+   {1, 2, 6, 1, 6, 7, 4, 5, 8, 255, 255, 255},
+   {1, 4, 5, 1, 5, 2, 255, 255, 255, 255, 255, 255},
+   {0, 1, 4, 0, 4, 5, 0, 5, 6, 255, 255, 255},
+   {0, 7, 4, 0, 4, 5, 0, 5, 2, 255, 255, 255},
+   {4, 5, 6, 4, 6, 7, 255, 255, 255, 255, 255, 255},
+   {3, 6, 8, 3, 8, 4, 255, 255, 255, 255, 255, 255},
+   {0, 2, 8, 0, 8, 4, 0, 4, 3, 255, 255, 255},
+   {0, 7, 1, 3, 6, 8, 3, 8, 4, 255, 255, 255},
+   {1, 2, 8, 1, 8, 4, 1, 4, 3, 1, 3, 7},
+   {1, 4, 3, 1, 3, 6, 1, 6, 2, 255, 255, 255},
+   {0, 1, 4, 0, 4, 3, 255, 255, 255, 255, 255, 255},
+   {0, 7, 4, 0, 4, 3, 0, 3, 6, 0, 6, 2},
+   {3, 7, 4, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {3, 5, 8, 3, 8, 7, 255, 255, 255, 255, 255, 255},
+   {0, 2, 6, 3, 5, 8, 3, 8, 7, 255, 255, 255},
+   {0, 3, 5, 0, 5, 8, 0, 8, 1, 255, 255, 255},
+   {1, 2, 6, 1, 6, 3, 1, 3, 5, 1, 5, 8},
+   {1, 7, 3, 1, 3, 5, 1, 5, 2, 255, 255, 255},
+   {0, 1, 7, 0, 7, 3, 0, 3, 5, 0, 5, 6},
+   {0, 3, 5, 0, 5, 2, 255, 255, 255, 255, 255, 255},
+   {3, 5, 6, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {6, 8, 7, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 2, 8, 0, 8, 7, 255, 255, 255, 255, 255, 255},
+   {0, 6, 8, 0, 8, 1, 255, 255, 255, 255, 255, 255},
+   {1, 2, 8, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {1, 7, 6, 1, 6, 2, 255, 255, 255, 255, 255, 255},
+   {0, 1, 7, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {0, 6, 2, 255, 255, 255, 255, 255, 255, 255, 255, 255},
+   {255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255}
+};
+
+// .......................................................... wedgeEdgeVertices
+DAX_EXEC_CONSTANT_EXPORT const unsigned char WedgeEdgeVertices[9][2] =
+{ {0,1}, {1,2}, {2,0}, {3,4}, {4,5}, {5,3}, {0,3}, {1,4}, {2,5} };
+
+// ------------------------------------------------------ quadrilateralNumLines
+DAX_EXEC_CONSTANT_EXPORT const unsigned char QuadrilateralNumLines[16] =
+{ 0, 1, 1, 1, 1, 2, 1, 1, 1, 1, 2, 1, 1, 1, 1, 0,
+};
+
+// ..................................................... quadrilateralLineTable
+DAX_EXEC_CONSTANT_EXPORT const unsigned char QuadrilateralLineTable[16][4] =
+{
+   {255, 255, 255, 255},
+   {3, 0, 255, 255},
+   {0, 1, 255, 255},
+   {3, 1, 255, 255},
+   {1, 2, 255, 255},
+   {3, 0, 1, 2},
+   {0, 2, 255, 255},
+   {3, 2, 255, 255},
+   {2, 3, 255, 255},
+   {2, 0, 255, 255},
+   {0, 1, 2, 3},
+   {2, 1, 255, 255},
+   {1, 3, 255, 255},
+   {1, 0, 255, 255},
+   {0, 3, 255, 255},
+   {255, 255, 255, 255}
+};
+
+// .................................................. quadrilateralEdgeVertices
+DAX_EXEC_CONSTANT_EXPORT const unsigned char QuadrilateralEdgeVertices[4][2] =
+{ {0,1}, {1,2}, {2,3}, {3,0} };
+
+// ----------------------------------------------------------- triangleNumLines
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TriangleNumLines[8] =
+{ 0, 1, 1, 1, 1, 1, 1, 0,
+};
+
+// .......................................................... triangleLineTable
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TriangleLineTable[8][2] =
+{
+   {255, 255},
+   {2, 0},
+   {0, 1},
+   {2, 1},
+   {1, 2},
+   {1, 0},
+   {0, 2},
+   {255, 255}
+};
+
+// ....................................................... triangleEdgeVertices
+DAX_EXEC_CONSTANT_EXPORT const unsigned char TriangleEdgeVertices[3][2] =
+{ {0,1}, {1,2}, {2,0} };
+
+// -----------------------------------------------------------------------------
+/// Gives the worklets uniform access to the case tables of each canonical
+/// cell type: the cell type generated (triangles for volumes, lines for
+/// faces), the number of cells generated for each case, the edge holding
+/// each vertex of those cells, and the two vertices of each edge. Cell types
+/// without tables leave this undefined so that they fail to compile.
+///
+template<class CellTag> struct ContourTables;
+
+#define DAX_CONTOUR_TABLES(cellTag, outCellTag, numCells, cellTable, edges) \
+template<> struct ContourTables<cellTag> \
+{ \
+  typedef outCellTag OutCellTag; \
+  DAX_EXEC_EXPORT static int GetNumberOfCells(int caseId) \
+    { return numCells[caseId]; } \
+  DAX_EXEC_EXPORT static int GetEdge(int caseId, int cellVertex) \
+    { return cellTable[caseId][cellVertex]; } \
+  DAX_EXEC_EXPORT static int GetEdgeVertex(int edge, int end) \
+    { return edges[edge][end]; } \
+}
+
+DAX_CONTOUR_TABLES(dax::CellTagHexahedron, dax::CellTagTriangle,
+                   NumFaces, TriTable, HexahedronEdgeVertices);
+DAX_CONTOUR_TABLES(dax::CellTagTetrahedron, dax::CellTagTriangle,
+                   TetrahedronNumFaces, TetrahedronTriTable,
+                   TetrahedronEdgeVertices);
+DAX_CONTOUR_TABLES(dax::CellTagWedge, dax::CellTagTriangle,
+                   WedgeNumFaces, WedgeTriTable, WedgeEdgeVertices);
+DAX_CONTOUR_TABLES(dax::CellTagQuadrilateral, dax::CellTagLine,
+                   QuadrilateralNumLines, QuadrilateralLineTable,
+                   QuadrilateralEdgeVertices);
+DAX_CONTOUR_TABLES(dax::CellTagTriangle, dax::CellTagLine,
+                   TriangleNumLines, TriangleLineTable,
+                   TriangleEdgeVertices);
+
+#undef DAX_CONTOUR_TABLES
+
 }}}} // dax::worklet::marchingcubes::internals
 
 #endif
@@ -0,0 +1,178 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+#include <dax/worklet/Cosine.h>
+#include <dax/worklet/Magnitude.h>
+#include <dax/worklet/Sine.h>
+#include <dax/worklet/Square.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <vector>
+
+namespace {
+
+// Worklets declaring a BATCH_SIZE are invoked on a dax::Tuple of consecutive
+// values for most indices and one value at a time for the indices left over
+// at the end of a range or row. Both must give the same results.
+
+// Array sizes: smaller than a batch, whole batches, and a remainder.
+const dax::Id ARRAY_SIZES[] = { 3, 64, 109 };
+const int NUM_ARRAY_SIZES = 3;
+
+dax::Scalar TestValue(dax::Id index)
+{
+  return static_cast<dax::Scalar>(0.37*index - 11.0);
+}
+
+dax::Vector3 TestVector(dax::Id index)
+{
+  return dax::make_Vector3(TestValue(index),
+                           TestValue(3*index + 1),
+                           TestValue(7*index + 2));
+}
+
+//-----------------------------------------------------------------------------
+template<class WorkletType>
+void TestReturnBatch(const char *name)
+{
+  std::cout << "Checking batches of " << name << std::endl;
+  const int BATCH_SIZE = WorkletType::BATCH_SIZE;
+  WorkletType worklet;
+
+  dax::Tuple<dax::Scalar,BATCH_SIZE> batchIn;
+  for (int lane = 0; lane < BATCH_SIZE; ++lane)
+    {
+    batchIn[lane] = TestValue(lane);
+    }
+  const dax::Tuple<dax::Scalar,BATCH_SIZE> batchOut = worklet(batchIn);
+  for (int lane = 0; lane < BATCH_SIZE; ++lane)
+    {
+    DAX_TEST_ASSERT(test_equal(batchOut[lane], worklet(batchIn[lane])),
+                    "Batch lane differs from scalar invocation.");
+    }
+
+  for (int sizeIndex = 0; sizeIndex < NUM_ARRAY_SIZES; ++sizeIndex)
+    {
+    const dax::Id size = ARRAY_SIZES[sizeIndex];
+    std::vector<dax::Scalar> in(size);
+    for (dax::Id index = 0; index < size; ++index)
+      {
+      in[index] = TestValue(index);
+      }
+    dax::cont::ArrayHandle<dax::Scalar> out;
+    dax::cont::DispatcherMapField<WorkletType>().Invoke(
+          dax::cont::make_ArrayHandle(in), out);
+
+    DAX_TEST_ASSERT(out.GetNumberOfValues() == size, "Wrong output size.");
+    for (dax::Id index = 0; index < size; ++index)
+      {
+      DAX_TEST_ASSERT(test_equal(out.GetPortalConstControl().Get(index),
+                                 worklet(in[index])),
+                      "Dispatched value differs from scalar invocation.");
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestMagnitudeBatch()
+{
+  std::cout << "Checking batches of Magnitude" << std::endl;
+  const int BATCH_SIZE = dax::worklet::Magnitude::BATCH_SIZE;
+  dax::worklet::Magnitude worklet;
+
+  dax::Tuple<dax::Vector3,BATCH_SIZE> batchIn;
+  for (int lane = 0; lane < BATCH_SIZE; ++lane)
+    {
+    batchIn[lane] = TestVector(lane);
+    }
+  dax::Tuple<dax::Scalar,BATCH_SIZE> batchOut;
+  worklet(batchIn, batchOut);
+  for (int lane = 0; lane < BATCH_SIZE; ++lane)
+    {
+    dax::Scalar scalarOut;
+    worklet(batchIn[lane], scalarOut);
+    DAX_TEST_ASSERT(test_equal(batchOut[lane], scalarOut),
+                    "Batch lane differs from scalar invocation.");
+    }
+
+  for (int sizeIndex = 0; sizeIndex < NUM_ARRAY_SIZES; ++sizeIndex)
+    {
+    const dax::Id size = ARRAY_SIZES[sizeIndex];
+    std::vector<dax::Vector3> in(size);
+    for (dax::Id index = 0; index < size; ++index)
+      {
+      in[index] = TestVector(index);
+      }
+    dax::cont::ArrayHandle<dax::Scalar> out;
+    dax::cont::DispatcherMapField<dax::worklet::Magnitude>().Invoke(
+          dax::cont::make_ArrayHandle(in), out);
+
+    DAX_TEST_ASSERT(out.GetNumberOfValues() == size, "Wrong output size.");
+    for (dax::Id index = 0; index < size; ++index)
+      {
+      dax::Scalar scalarOut;
+      worklet(in[index], scalarOut);
+      DAX_TEST_ASSERT(test_equal(out.GetPortalConstControl().Get(index),
+                                 scalarOut),
+                      "Dispatched value differs from scalar invocation.");
+      }
+    }
+
+  // Uniform grid coordinates are scheduled over rows of points. A row of 13
+  // points is one batch and five single points.
+  std::cout << "Checking batches of Magnitude over uniform points"
+            << std::endl;
+  dax::cont::UniformGrid<> grid;
+  grid.SetOrigin(dax::make_Vector3(-2.0, 0.5, 1.0));
+  grid.SetSpacing(dax::make_Vector3(0.25, 0.5, 2.0));
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(12, 4, 2));
+  dax::cont::ArrayHandle<dax::Scalar> out;
+  dax::cont::DispatcherMapField<dax::worklet::Magnitude>().Invoke(
+        grid.GetPointCoordinates(), out);
+
+  DAX_TEST_ASSERT(out.GetNumberOfValues() == grid.GetNumberOfPoints(),
+                  "Wrong output size.");
+  for (dax::Id index = 0; index < grid.GetNumberOfPoints(); ++index)
+    {
+    dax::Scalar scalarOut;
+    worklet(grid.ComputePointCoordinates(index), scalarOut);
+    DAX_TEST_ASSERT(test_equal(out.GetPortalConstControl().Get(index),
+                               scalarOut),
+                    "Value over uniform points differs from scalar invocation.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestWorkletBatch()
+{
+  TestReturnBatch<dax::worklet::Sine>("Sine");
+  TestReturnBatch<dax::worklet::Cosine>("Cosine");
+  TestReturnBatch<dax::worklet::Square>("Square");
+  TestMagnitudeBatch();
+}
+
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletBatch(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestWorkletBatch);
+}
@@ -27,6 +27,7 @@
 #include <dax/cont/ArrayHandleConstant.h>
 #include <dax/cont/DeviceAdapterSerial.h>
 #include <dax/cont/DispatcherGenerateKeysValues.h>
+#include <dax/cont/DispatcherMapCellToPoint.h>
 #include <dax/cont/DispatcherReduceKeysValues.h>
 
 #include <iostream>
@@ -70,8 +71,9 @@ void verifyPointData(const TestGrid &grid,
        pointIndex < dax::Id(computedPointData.size());
        pointIndex++)
     {
-    dax::Scalar expectedValue =
-      pointDataSums[pointIndex] / numConnections[pointIndex];
+    // Points not used by any cell get a value of 0.
+    dax::Scalar expectedValue = (numConnections[pointIndex] > 0)
+        ? pointDataSums[pointIndex] / numConnections[pointIndex] : 0;
     dax::Scalar computedValue = computedPointData[pointIndex];
     DAX_TEST_ASSERT(test_equal(computedValue, expectedValue),
                     "Got bad average at point");
@@ -129,6 +131,23 @@ struct TestCellDataToPointDataWorklet
     resultHandle.CopyInto(pointData.begin());
 
     verifyPointData(grid, field, pointData);
+
+    std::cout << "Running CellDataToPointDataAverage worklet" << std::endl;
+
+    dax::cont::ArrayHandle<dax::Scalar> averageHandle;
+    dax::cont::DispatcherMapCellToPoint<
+        dax::worklet::CellDataToPointDataAverage>().Invoke(grid.GetRealGrid(),
+                                                           fieldHandle,
+                                                           averageHandle);
+
+    std::cout << "Checking result" << std::endl;
+    DAX_TEST_ASSERT(averageHandle.GetNumberOfValues()
+                    == grid->GetNumberOfPoints(),
+                    "Wrong number of point values.");
+    std::vector<dax::Scalar> averageData(averageHandle.GetNumberOfValues());
+    averageHandle.CopyInto(averageData.begin());
+
+    verifyPointData(grid, field, averageData);
   }
 };
 
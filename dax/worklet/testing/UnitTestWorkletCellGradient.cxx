@@ -23,6 +23,8 @@
 #include <dax/cont/ArrayHandle.h>
 #include <dax/cont/DeviceAdapter.h>
 #include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/RectilinearGrid.h>
+#include <dax/cont/StructuredGrid.h>
 
 #include <vector>
 
@@ -122,6 +124,8 @@ struct TestCellGradientWorklet
 void TestCellGradient()
   {
   dax::cont::testing::GridTesting::TryAllGridTypes( TestCellGradientWorklet() );
+  TestCellGradientWorklet()( dax::cont::RectilinearGrid<>() );
+  TestCellGradientWorklet()( dax::cont::StructuredGrid<>() );
   }
 
 } // Anonymous namespace
@@ -0,0 +1,292 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/testing/TestingGridGenerator.h>
+#include <dax/cont/testing/Testing.h>
+
+#include <dax/worklet/Clip.h>
+
+#include <dax/CellTag.h>
+#include <dax/CellTraits.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherGenerateInterpolatedCells.h>
+#include <dax/cont/DispatcherGenerateTopology.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/DispatcherMapField.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/math/Sign.h>
+#include <dax/math/VectorAnalysis.h>
+
+#include <iostream>
+#include <vector>
+
+namespace {
+const dax::Id DIM = 9;
+
+//-----------------------------------------------------------------------------
+dax::Scalar TetrahedronVolume(const dax::Vector3 &p0,
+                              const dax::Vector3 &p1,
+                              const dax::Vector3 &p2,
+                              const dax::Vector3 &p3)
+{
+  return dax::dot(dax::math::Cross(p1-p0, p2-p0), p3-p0) / 6;
+}
+
+// Volume of a cell given the coordinates of its vertices, using the same
+// split into tetrahedra as the clip worklets.
+template<class CellTag, class CoordinatesType>
+dax::Scalar CellVolume(const CoordinatesType &coords)
+{
+  typedef dax::worklet::internal::clip::CellTetrahedra<
+      typename dax::CellTraits<CellTag>::CanonicalCellTag> Tetrahedra;
+  dax::Scalar volume = 0;
+  for (int tetrahedron = 0;
+       tetrahedron < Tetrahedra::NUM_TETRAHEDRA;
+       ++tetrahedron)
+    {
+    volume += TetrahedronVolume(coords[Tetrahedra::GetVertex(tetrahedron,0)],
+                                coords[Tetrahedra::GetVertex(tetrahedron,1)],
+                                coords[Tetrahedra::GetVertex(tetrahedron,2)],
+                                coords[Tetrahedra::GetVertex(tetrahedron,3)]);
+    }
+  return volume;
+}
+
+// Volume of all the cells of an unstructured grid, checking that they all
+// have the given orientation (the sign of their volume) unless it is 0.
+template<class GridType>
+dax::Scalar GridVolume(const GridType &grid, dax::Scalar orientation)
+{
+  typedef typename GridType::CellTag CellTag;
+  const int numVertices = dax::CellTraits<CellTag>::NUM_VERTICES;
+  dax::Scalar volume = 0;
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); ++cellIndex)
+    {
+    dax::Tuple<dax::Vector3,dax::CellTraits<CellTag>::NUM_VERTICES> coords;
+    for (int vertex = 0; vertex < numVertices; ++vertex)
+      {
+      const dax::Id pointIndex = grid.GetCellConnections()
+          .GetPortalConstControl().Get(cellIndex*numVertices + vertex);
+      coords[vertex] = grid.GetPointCoordinates()
+          .GetPortalConstControl().Get(pointIndex);
+      }
+    const dax::Scalar cellVolume = CellVolume<CellTag>(coords);
+    DAX_TEST_ASSERT(orientation*cellVolume >= 0, "Cell is inverted");
+    DAX_TEST_ASSERT(cellVolume != 0, "Cell is flat");
+    volume += dax::math::Abs(cellVolume);
+    }
+  return volume;
+}
+
+//-----------------------------------------------------------------------------
+struct TestClipWorklet
+{
+  typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+  typedef DAX_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapter;
+
+  typedef dax::cont::UnstructuredGrid<
+      dax::CellTagTetrahedron,ArrayContainer,ArrayContainer,DeviceAdapter>
+      TetrahedronGridType;
+
+  //----------------------------------------------------------------------------
+  template<typename GridType>
+  DAX_CONT_EXPORT
+  void operator()(const GridType&) const
+    {
+    dax::cont::testing::TestGrid<GridType,ArrayContainer,DeviceAdapter>
+        in(DIM);
+    GridType kept;
+    this->GridClip(in,kept);
+    }
+
+  //----------------------------------------------------------------------------
+  DAX_CONT_EXPORT
+  void operator()(const dax::cont::UniformGrid<DeviceAdapter>&) const
+    {
+    dax::cont::testing::TestGrid<
+        dax::cont::UniformGrid<DeviceAdapter>,ArrayContainer,DeviceAdapter>
+        in(DIM);
+    dax::cont::UnstructuredGrid<
+        dax::CellTagHexahedron,ArrayContainer,ArrayContainer,DeviceAdapter>
+        kept;
+    this->GridClip(in,kept);
+    }
+
+  //----------------------------------------------------------------------------
+  // Clips the grid with a plane and checks the cells kept whole plus the
+  // tetrahedra of the cut cells fill the side of the plane that is kept.
+  template <typename InGridType, typename KeptGridType>
+  DAX_CONT_EXPORT
+  dax::Scalar ClipVolume(
+      dax::cont::testing::TestGrid<InGridType,ArrayContainer,DeviceAdapter>
+        &inGridGenerator,
+      const dax::Vector3 &normal,
+      dax::Scalar orientation,
+      KeptGridType &kept) const
+    {
+    typedef dax::cont::ArrayHandle<dax::Id,ArrayContainer,DeviceAdapter>
+        CountHandleType;
+    typedef dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+        FieldHandleType;
+
+    const InGridType &inGrid = inGridGenerator.GetRealGrid();
+    const dax::Id numInputPoints = inGrid.GetNumberOfPoints();
+    //keep the plane off the points so that no clipped cell is flat
+    const dax::Vector3 origin =
+        dax::Scalar(0.5) * inGridGenerator.GetPointCoordinates(numInputPoints-1)
+        + dax::make_Vector3(0.01, 0.01, 0.01);
+
+    FieldHandleType distance;
+    dax::cont::DispatcherMapField<dax::worklet::ClipPlaneDistance,
+                                  DeviceAdapter>(
+          dax::worklet::ClipPlaneDistance(origin, normal))
+        .Invoke(inGrid.GetPointCoordinates(), distance);
+
+    CountHandleType keepCount;
+    CountHandleType cutCount;
+    dax::cont::DispatcherMapCell<dax::worklet::ClipClassify,DeviceAdapter>(
+          dax::worklet::ClipClassify(0))
+        .Invoke(inGrid, distance, keepCount, cutCount);
+
+    TetrahedronGridType cut;
+    dax::cont::DispatcherGenerateInterpolatedCells<
+        dax::worklet::ClipGenerate,CountHandleType,DeviceAdapter>
+        generate(cutCount, dax::worklet::ClipGenerate(0));
+    generate.SetKeepInputPoints(true);
+    generate.Invoke(inGrid, cut, distance);
+
+    dax::worklet::ClipTopology clipTopology;
+    dax::cont::DispatcherGenerateTopology<
+        dax::worklet::ClipTopology,CountHandleType,DeviceAdapter>
+        passThrough(keepCount, clipTopology);
+    passThrough.SetRemoveDuplicatePoints(false);
+    passThrough.Invoke(inGrid, kept);
+    kept.SetPointCoordinates(cut.GetPointCoordinates());
+
+    DAX_TEST_ASSERT(cut.GetNumberOfCells() > 0, "Nothing was cut");
+
+    //the input points come first with the same ids, then the new points,
+    //which lie on the plane
+    const dax::Id numPoints = cut.GetNumberOfPoints();
+    DAX_TEST_ASSERT(numPoints > numInputPoints, "No new points");
+    for (dax::Id pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+      {
+      const dax::Vector3 coordinates =
+          cut.GetPointCoordinates().GetPortalConstControl().Get(pointIndex);
+      if (pointIndex < numInputPoints)
+        {
+        DAX_TEST_ASSERT(test_equal(
+                          coordinates,
+                          inGridGenerator.GetPointCoordinates(pointIndex)),
+                        "Input point moved");
+        }
+      else
+        {
+        DAX_TEST_ASSERT(dax::math::Abs(dax::dot(normal, coordinates-origin))
+                        < 0.0001,
+                        "New point is not on the plane");
+        }
+      }
+
+    //every vertex of the output is on the kept side
+    const dax::Id numConnections = cut.GetCellConnections().GetNumberOfValues();
+    for (dax::Id index = 0; index < numConnections; ++index)
+      {
+      const dax::Id pointIndex =
+          cut.GetCellConnections().GetPortalConstControl().Get(index);
+      const dax::Vector3 coordinates =
+          cut.GetPointCoordinates().GetPortalConstControl().Get(pointIndex);
+      DAX_TEST_ASSERT(dax::dot(normal, coordinates-origin) > -0.0001,
+                      "Clipped cell reaches the removed side");
+      }
+
+    return GridVolume(kept, orientation) + GridVolume(cut, orientation);
+    }
+
+  //----------------------------------------------------------------------------
+  template <typename InGridType, typename KeptGridType>
+  DAX_CONT_EXPORT
+  void GridClip(
+      dax::cont::testing::TestGrid<InGridType,ArrayContainer,DeviceAdapter>
+        &inGridGenerator,
+      KeptGridType &kept) const
+    {
+    typedef typename InGridType::CellTag CellTag;
+    const InGridType &inGrid = inGridGenerator.GetRealGrid();
+
+    std::cout << "Running Clip worklet" << std::endl;
+    try
+      {
+      //the cells of the test grids are not all positively oriented, but the
+      //clipped cells must keep the orientation of the input when it is
+      //the same for all the cells
+      dax::Scalar inputVolume = 0;
+      bool anyPositive = false;
+      bool anyNegative = false;
+      for (dax::Id cellIndex = 0;
+           cellIndex < inGrid.GetNumberOfCells();
+           ++cellIndex)
+        {
+        const dax::Scalar cellVolume = CellVolume<CellTag>(
+              inGridGenerator.GetCellVertexCoordinates(cellIndex));
+        anyPositive |= (cellVolume > 0);
+        anyNegative |= (cellVolume < 0);
+        inputVolume += dax::math::Abs(cellVolume);
+        }
+      const dax::Scalar orientation =
+          (anyPositive && anyNegative) ? 0 : (anyPositive ? 1 : -1);
+
+      //the two sides of the plane make up the whole input
+      const dax::Vector3 normal = dax::make_Vector3(1.0, 2.0, 3.0);
+      const dax::Scalar aboveVolume =
+          this->ClipVolume(inGridGenerator, normal, orientation, kept);
+      KeptGridType keptBelow;
+      const dax::Scalar belowVolume =
+          this->ClipVolume(inGridGenerator,
+                           dax::Scalar(-1)*normal,
+                           orientation,
+                           keptBelow);
+      DAX_TEST_ASSERT(aboveVolume > 0 && belowVolume > 0,
+                      "One side of the plane is empty");
+      DAX_TEST_ASSERT(test_equal(aboveVolume + belowVolume, inputVolume),
+                      "Clipped volumes do not add up to the input");
+      }
+    catch (dax::cont::ErrorControl error)
+      {
+      std::cout << "Got error: " << error.GetMessage() << std::endl;
+      DAX_TEST_ASSERT(true==false,error.GetMessage());
+      }
+    }
+};
+
+
+//-----------------------------------------------------------------------------
+void TestClip()
+  {
+  dax::cont::testing::GridTesting::TryAllGridTypes(
+        TestClipWorklet(),
+        dax::testing::Testing::CellCheckTopologicalDimensions<3>());
+  }
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletClip(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestClip);
+}
@@ -0,0 +1,206 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/worklet/FlyingEdges.h>
+#include <dax/worklet/MarchingCubes.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DispatcherGenerateInterpolatedCells.h>
+#include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/UniformGrid.h>
+#include <dax/cont/UnstructuredGrid.h>
+
+#include <dax/math/VectorAnalysis.h>
+
+#include <dax/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace {
+const dax::Id DIM = 26;
+
+typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+typedef DAX_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapter;
+typedef dax::cont::UniformGrid<DeviceAdapter> UniformGridType;
+typedef dax::cont::UnstructuredGrid<
+    dax::CellTagTriangle,ArrayContainer,ArrayContainer,DeviceAdapter>
+    TriangleGridType;
+typedef dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+    FieldHandleType;
+
+//-----------------------------------------------------------------------------
+struct LinearField
+{
+  dax::Scalar operator()(const dax::Vector3 &coordinates) const
+  {
+    return coordinates[0] + coordinates[1] + coordinates[2];
+  }
+};
+
+struct SphereField
+{
+  dax::Scalar operator()(const dax::Vector3 &coordinates) const
+  {
+    return dax::math::Magnitude(coordinates - dax::make_Vector3(4.5, 5, 3.25));
+  }
+};
+
+// Constant along each row of points, so that rows without any cut x edge
+// still have cut y and z edges between them.
+struct PlaneField
+{
+  dax::Scalar operator()(const dax::Vector3 &coordinates) const
+  {
+    return coordinates[1] + 2*coordinates[2];
+  }
+};
+
+//-----------------------------------------------------------------------------
+std::vector<dax::Vector3> SortedCentroids(const TriangleGridType &grid,
+                                          dax::Scalar &area)
+{
+  std::vector<dax::Vector3> centroids;
+  area = 0;
+  for (dax::Id cellIndex = 0; cellIndex < grid.GetNumberOfCells(); ++cellIndex)
+    {
+    dax::Vector3 points[3];
+    for (dax::Id vertexIndex = 0; vertexIndex < 3; ++vertexIndex)
+      {
+      const dax::Id pointIndex = grid.GetCellConnections()
+          .GetPortalConstControl().Get(3*cellIndex + vertexIndex);
+      DAX_TEST_ASSERT(pointIndex >= 0 &&
+                      pointIndex < grid.GetNumberOfPoints(),
+                      "Bad point index in output connections.");
+      points[vertexIndex] =
+          grid.GetPointCoordinates().GetPortalConstControl().Get(pointIndex);
+      }
+    //round so that both algorithms sort the same triangles the same way
+    dax::Vector3 centroid = (points[0] + points[1] + points[2]) * dax::Scalar(1.0/3.0);
+    for (int component = 0; component < 3; ++component)
+      {
+      centroid[component] = floor(centroid[component]*1000 + 0.5) / 1000;
+      }
+    centroids.push_back(centroid);
+    area += dax::math::Magnitude(
+          dax::math::Cross(points[1] - points[0], points[2] - points[0])) * dax::Scalar(0.5);
+    }
+  std::sort(centroids.begin(), centroids.end());
+  return centroids;
+}
+
+//-----------------------------------------------------------------------------
+template<class FieldFunctor>
+void CompareWithMarchingCubes(const UniformGridType &grid,
+                              FieldFunctor fieldFunctor,
+                              dax::Scalar isoValue)
+{
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       ++pointIndex)
+    {
+    field[pointIndex] =
+        fieldFunctor(grid.ComputePointCoordinates(pointIndex));
+    }
+  FieldHandleType fieldHandle =
+      dax::cont::make_ArrayHandle(field, ArrayContainer(), DeviceAdapter());
+
+  typedef dax::cont::DispatcherGenerateInterpolatedCells<
+      dax::worklet::MarchingCubesGenerate > InterpolatedDispatcher;
+  typedef InterpolatedDispatcher::CountHandleType CountHandleType;
+
+  CountHandleType count;
+  dax::cont::DispatcherMapCell< dax::worklet::MarchingCubesCount >(
+        dax::worklet::MarchingCubesCount(isoValue)).Invoke(grid,
+                                                           fieldHandle,
+                                                           count);
+  TriangleGridType marchingCubesGrid;
+  InterpolatedDispatcher(count, dax::worklet::MarchingCubesGenerate(isoValue))
+      .Invoke(grid, marchingCubesGrid, fieldHandle);
+
+  TriangleGridType flyingEdgesGrid;
+  dax::worklet::FlyingEdges<DeviceAdapter>(isoValue).Run(grid,
+                                                         fieldHandle,
+                                                         flyingEdgesGrid);
+
+  std::cout << "  " << flyingEdgesGrid.GetNumberOfCells() << " triangles, "
+            << flyingEdgesGrid.GetNumberOfPoints() << " points" << std::endl;
+  DAX_TEST_ASSERT(flyingEdgesGrid.GetNumberOfCells() ==
+                  marchingCubesGrid.GetNumberOfCells(),
+                  "Flying edges made a different number of triangles.");
+  DAX_TEST_ASSERT(flyingEdgesGrid.GetNumberOfPoints() ==
+                  marchingCubesGrid.GetNumberOfPoints(),
+                  "Flying edges made a different number of unique points.");
+
+  dax::Scalar marchingCubesArea;
+  dax::Scalar flyingEdgesArea;
+  std::vector<dax::Vector3> marchingCubesCentroids =
+      SortedCentroids(marchingCubesGrid, marchingCubesArea);
+  std::vector<dax::Vector3> flyingEdgesCentroids =
+      SortedCentroids(flyingEdgesGrid, flyingEdgesArea);
+  DAX_TEST_ASSERT(test_equal(marchingCubesArea, flyingEdgesArea),
+                  "Flying edges surface has a different area.");
+  for (std::size_t index = 0; index < flyingEdgesCentroids.size(); ++index)
+    {
+    DAX_TEST_ASSERT(test_equal(marchingCubesCentroids[index],
+                               flyingEdgesCentroids[index]),
+                    "Flying edges made a different triangle.");
+    }
+
+  for (dax::Id pointIndex = 0;
+       pointIndex < flyingEdgesGrid.GetNumberOfPoints();
+       ++pointIndex)
+    {
+    const dax::Vector3 coordinates = flyingEdgesGrid.GetPointCoordinates()
+        .GetPortalConstControl().Get(pointIndex);
+    DAX_TEST_ASSERT(test_equal(fieldFunctor(coordinates), isoValue, 0.01),
+                    "Flying edges point is not on the isosurface.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TestFlyingEdges()
+{
+  UniformGridType grid;
+  grid.SetExtent(dax::make_Id3(0, 0, 0), dax::make_Id3(DIM-1, DIM-1, DIM-1));
+
+  std::cout << "Linear field" << std::endl;
+  CompareWithMarchingCubes(grid, LinearField(), 70);
+  CompareWithMarchingCubes(grid, LinearField(), 30.5);
+  std::cout << "Sphere" << std::endl;
+  CompareWithMarchingCubes(grid, SphereField(), 3.7);
+  std::cout << "Plane constant along x" << std::endl;
+  CompareWithMarchingCubes(grid, PlaneField(), 20.5);
+  std::cout << "No surface" << std::endl;
+  CompareWithMarchingCubes(grid, LinearField(), 1000);
+
+  std::cout << "Shifted extent and scaled grid" << std::endl;
+  grid.SetExtent(dax::make_Id3(-3, 2, 1), dax::make_Id3(12, 9, 15));
+  grid.SetOrigin(dax::make_Vector3(1, -2, 0.5));
+  grid.SetSpacing(dax::make_Vector3(0.5, 1, 0.25));
+  CompareWithMarchingCubes(grid, LinearField(), 9.3);
+}
+
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletFlyingEdges(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestFlyingEdges);
+}
@@ -24,14 +24,19 @@
 #include <dax/CellTag.h>
 #include <dax/CellTraits.h>
 #include <dax/TypeTraits.h>
+#include <dax/math/VectorAnalysis.h>
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/ArrayHandleCounting.h>
+#include <dax/cont/BrickRanges.h>
 #include <dax/cont/DispatcherGenerateInterpolatedCells.h>
 #include <dax/cont/DispatcherMapCell.h>
+#include <dax/cont/RectilinearGrid.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/UnstructuredGrid.h>
 
 #include <dax/cont/testing/Testing.h>
+#include <algorithm>
 #include <vector>
 
 
@@ -127,6 +132,200 @@ struct TestMarchingCubesWorklet
       DAX_TEST_ASSERT(NumberOfUniquePoints == secondOutGrid.GetNumberOfPoints() &&
                       NumberOfUniquePoints != valid_num_points,
           "We didn't merge to the correct number of points");
+
+      //run again keeping the case of each cell from the first step, which
+      //must generate exactly the same triangles
+      typedef  dax::cont::DispatcherMapCell<
+                      dax::worklet::MarchingCubesClassify > ClassifyDispatcher;
+      typedef  dax::cont::DispatcherGenerateInterpolatedCells<
+          dax::worklet::MarchingCubesGenerateFromCase > FromCaseDispatcher;
+      typedef dax::cont::ArrayHandle<
+          dax::worklet::MarchingCubesClassify::CaseType,
+          ArrayContainer, DeviceAdapter> CaseHandleType;
+
+      CountHandleType caseCount;
+      CaseHandleType caseIds;
+      ClassifyDispatcher classifyDispatcher(
+                      (dax::worklet::MarchingCubesClassify(isoValue)) );
+      classifyDispatcher.Invoke( inGrid.GetRealGrid(),
+                                 fieldHandle,
+                                 caseCount,
+                                 caseIds);
+
+      FromCaseDispatcher fromCaseDispatcher( caseCount,
+                    dax::worklet::MarchingCubesGenerateFromCase(isoValue) );
+      fromCaseDispatcher.SetRemoveDuplicatePoints(false);
+
+      UnstructuredGridType cachedOutGrid;
+      fromCaseDispatcher.Invoke(inGrid.GetRealGrid(),
+                                cachedOutGrid,
+                                caseIds,
+                                dax::worklet::make_MarchingCubesPointField(
+                                  fieldHandle));
+
+      DAX_TEST_ASSERT(cachedOutGrid.GetNumberOfCells() ==
+                      outGrid.GetNumberOfCells(),
+                      "Cached case generated a different number of cells");
+      const dax::Id numCachedPoints = cachedOutGrid.GetNumberOfPoints();
+      DAX_TEST_ASSERT(numCachedPoints == outGrid.GetNumberOfPoints(),
+                      "Cached case generated a different number of points");
+      for (dax::Id pointIndex = 0; pointIndex < numCachedPoints; ++pointIndex)
+        {
+        const dax::Vector3 expected = outGrid.GetPointCoordinates()
+            .GetPortalConstControl().Get(pointIndex);
+        const dax::Vector3 computed = cachedOutGrid.GetPointCoordinates()
+            .GetPortalConstControl().Get(pointIndex);
+        DAX_TEST_ASSERT(test_equal(expected, computed),
+                        "Cached case generated a different point");
+        }
+
+      //generate all the triangles of each cell at once, without the count
+      //pass. A block size that does not divide the number of cells must
+      //still give the same triangles in the same order
+      typedef  dax::cont::DispatcherGenerateInterpolatedCells<
+          dax::worklet::MarchingCubesGenerateCells > CellSetDispatcher;
+      CellSetDispatcher cellSetDispatcher(
+                      (dax::worklet::MarchingCubesGenerateCells(isoValue)) );
+      cellSetDispatcher.SetBlockSize(7);
+
+      UnstructuredGridType cellSetOutGrid;
+      cellSetDispatcher.Invoke(inGrid.GetRealGrid(),
+                               cellSetOutGrid,
+                               fieldHandle);
+      DAX_TEST_ASSERT(cellSetOutGrid.GetNumberOfCells() ==
+                      secondOutGrid.GetNumberOfCells(),
+                      "Cell sets generated a different number of cells");
+      DAX_TEST_ASSERT(cellSetOutGrid.GetNumberOfPoints() ==
+                      secondOutGrid.GetNumberOfPoints(),
+                      "Cell sets merged to a different number of points");
+      const dax::Id numCellSetConnections =
+          cellSetOutGrid.GetCellConnections().GetNumberOfValues();
+      for (dax::Id connIndex = 0;
+           connIndex < numCellSetConnections;
+           ++connIndex)
+        {
+        const dax::Id expectedId = secondOutGrid.GetCellConnections()
+            .GetPortalConstControl().Get(connIndex);
+        const dax::Id computedId = cellSetOutGrid.GetCellConnections()
+            .GetPortalConstControl().Get(connIndex);
+        DAX_TEST_ASSERT(expectedId == computedId,
+                        "Cell sets generated a different connection");
+        DAX_TEST_ASSERT(test_equal(
+                          secondOutGrid.GetPointCoordinates()
+                            .GetPortalConstControl().Get(expectedId),
+                          cellSetOutGrid.GetPointCoordinates()
+                            .GetPortalConstControl().Get(computedId)),
+                        "Cell sets generated a different point");
+        }
+
+      cellSetDispatcher.SetRemoveDuplicatePoints(false);
+      cellSetDispatcher.SetBlockSize(
+            CellSetDispatcher::DefaultBlockSize());
+      UnstructuredGridType unmergedCellSetOutGrid;
+      cellSetDispatcher.Invoke(inGrid.GetRealGrid(),
+                               unmergedCellSetOutGrid,
+                               fieldHandle);
+      const dax::Id numUnmergedPoints =
+          unmergedCellSetOutGrid.GetNumberOfPoints();
+      DAX_TEST_ASSERT(numUnmergedPoints == outGrid.GetNumberOfPoints(),
+                      "Cell sets generated a different number of points");
+      for (dax::Id pointIndex = 0; pointIndex < numUnmergedPoints; ++pointIndex)
+        {
+        DAX_TEST_ASSERT(test_equal(
+                          outGrid.GetPointCoordinates()
+                            .GetPortalConstControl().Get(pointIndex),
+                          unmergedCellSetOutGrid.GetPointCoordinates()
+                            .GetPortalConstControl().Get(pointIndex)),
+                        "Cell sets generated a different point");
+        }
+
+      //contour several isovalues at once, including the same one twice. The
+      //points of the two copies must not be merged together
+      const dax::Scalar otherIsoValue = isoValue - 3;
+      CountHandleType otherCount;
+      cellDispatcher = CellDispatcher(
+                      (dax::worklet::MarchingCubesCount(otherIsoValue)) );
+      cellDispatcher.Invoke( inGrid.GetRealGrid(), fieldHandle, otherCount);
+      InterpolatedDispatcher otherDispatcher( otherCount,
+                        dax::worklet::MarchingCubesGenerate(otherIsoValue) );
+      UnstructuredGridType otherOutGrid;
+      otherDispatcher.Invoke(inGrid.GetRealGrid(), otherOutGrid, fieldHandle);
+
+      std::vector<dax::Scalar> isoValues;
+      isoValues.push_back(isoValue);
+      isoValues.push_back(otherIsoValue);
+      isoValues.push_back(isoValue);
+      dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+          isoValuesHandle = dax::cont::make_ArrayHandle(isoValues,
+                                                        ArrayContainer(),
+                                                        DeviceAdapter());
+
+      typedef  dax::cont::DispatcherMapCell<
+                      dax::worklet::MarchingCubesMultiCount > MultiCellDispatcher;
+      typedef  dax::cont::DispatcherGenerateInterpolatedCells<
+          dax::worklet::MarchingCubesMultiGenerate > MultiInterpolatedDispatcher;
+
+      const dax::Id numInCells = inGrid->GetNumberOfCells();
+      dax::cont::ArrayHandleCounting<dax::Id,DeviceAdapter> cellIds =
+          dax::cont::make_ArrayHandleCounting(dax::Id(0), numInCells);
+      dax::cont::ArrayHandle<
+          dax::worklet::MarchingCubesClassify::CaseType,
+          ArrayContainer,
+          DeviceAdapter> multiCases;
+
+      CountHandleType multiCount;
+      MultiCellDispatcher().Invoke( inGrid.GetRealGrid(),
+                            fieldHandle,
+                            dax::worklet::make_MarchingCubesIsoValues(
+                              isoValuesHandle),
+                            cellIds,
+                            dax::worklet::make_MarchingCubesMultiCases(
+                              multiCases, 3, numInCells),
+                            multiCount);
+
+      CountHandleType isoIndices;
+      MultiInterpolatedDispatcher multiDispatcher(multiCount);
+      multiDispatcher.SetMergeLayers(isoIndices);
+      UnstructuredGridType multiOutGrid;
+      multiDispatcher.Invoke(inGrid.GetRealGrid(),
+                             multiOutGrid,
+                             dax::worklet::make_MarchingCubesPointField(
+                               fieldHandle),
+                             dax::worklet::make_MarchingCubesIsoValues(
+                               isoValuesHandle),
+                             cellIds,
+                             dax::worklet::make_MarchingCubesMultiCases(
+                               multiCases, 3),
+                             isoIndices);
+
+      const dax::Id numMultiCells = multiOutGrid.GetNumberOfCells();
+      DAX_TEST_ASSERT(numMultiCells == 2*outGrid.GetNumberOfCells() +
+                                       otherOutGrid.GetNumberOfCells(),
+                      "Several isovalues generated the wrong number of cells");
+      DAX_TEST_ASSERT(multiOutGrid.GetNumberOfPoints() ==
+                      2*NumberOfUniquePoints + otherOutGrid.GetNumberOfPoints(),
+                      "Several isovalues merged to the wrong number of points");
+      DAX_TEST_ASSERT(isoIndices.GetNumberOfValues() == numMultiCells,
+                      "Wrong number of isovalue indices");
+
+      //the field is linear, so every point lies exactly on its isovalue
+      for (dax::Id cellIndex = 0; cellIndex < numMultiCells; ++cellIndex)
+        {
+        const dax::Id isoIndex =
+            isoIndices.GetPortalConstControl().Get(cellIndex);
+        DAX_TEST_ASSERT(isoIndex >= 0 && isoIndex < 3,
+                        "Bad isovalue index");
+        for (dax::Id vertIndex = 0; vertIndex < 3; ++vertIndex)
+          {
+          const dax::Id pointIndex = multiOutGrid.GetCellConnections()
+              .GetPortalConstControl().Get(3*cellIndex + vertIndex);
+          const dax::Vector3 coordinates = multiOutGrid.GetPointCoordinates()
+              .GetPortalConstControl().Get(pointIndex);
+          DAX_TEST_ASSERT(test_equal(dax::dot(coordinates, trueGradient),
+                                     isoValues[isoIndex]),
+                          "Point does not lie on the isovalue of its cell");
+          }
+        }
       }
     catch (dax::cont::ErrorControl error)
       {
@@ -137,12 +336,351 @@ struct TestMarchingCubesWorklet
 };
 
 
+//-----------------------------------------------------------------------------
+/// Contours the same linear field on tetrahedra, wedges, quadrilaterals and
+/// triangles built by splitting the cells of a small box. The surface cut
+/// from a linear field does not depend on how the box is split, so the area
+/// (or length) of the output must match that of the hexahedra.
+struct TestContourCellTypes
+{
+  typedef dax::cont::ArrayContainerControlTagBasic ArrayContainer;
+  typedef DAX_DEFAULT_DEVICE_ADAPTER_TAG DeviceAdapter;
+
+  static const dax::Id CELL_DIM = 6;
+
+  std::vector<dax::Vector3> Points;
+  std::vector<dax::Scalar> Field;
+  dax::Vector3 Gradient;
+  dax::Scalar IsoValue;
+
+  TestContourCellTypes()
+    : Gradient(dax::make_Vector3(1.0, 2.0, 3.0)),
+      //field values are integers, so this never hits a vertex
+      IsoValue(dax::Scalar(17.3))
+  {
+    const dax::Id pointDim = CELL_DIM + 1;
+    for (dax::Id k = 0; k < pointDim; ++k)
+      {
+      for (dax::Id j = 0; j < pointDim; ++j)
+        {
+        for (dax::Id i = 0; i < pointDim; ++i)
+          {
+          const dax::Vector3 coordinates = dax::make_Vector3(i, j, k);
+          this->Points.push_back(coordinates);
+          this->Field.push_back(dax::dot(coordinates, this->Gradient));
+          }
+        }
+      }
+  }
+
+  // Point ids of the voxel at (i,j,k), in the hexahedron ordering.
+  void GetVoxel(dax::Id i, dax::Id j, dax::Id k, dax::Id voxel[8]) const
+  {
+    const dax::Id pointDim = CELL_DIM + 1;
+    const dax::Id base = i + pointDim*(j + pointDim*k);
+    voxel[0] = base;
+    voxel[1] = base + 1;
+    voxel[2] = base + 1 + pointDim;
+    voxel[3] = base + pointDim;
+    for (int vertex = 0; vertex < 4; ++vertex)
+      {
+      voxel[vertex+4] = voxel[vertex] + pointDim*pointDim;
+      }
+  }
+
+  // Splits every voxel (or the bottom face of every voxel in the first layer
+  // when numLayers is 0) into cells made of the given voxel vertices.
+  std::vector<dax::Id> Split(const int (*cells)[8],
+                             int numCells,
+                             int numVertices,
+                             dax::Id numLayers) const
+  {
+    std::vector<dax::Id> connections;
+    for (dax::Id k = 0; k < std::max(numLayers, dax::Id(1)); ++k)
+      {
+      for (dax::Id j = 0; j < CELL_DIM; ++j)
+        {
+        for (dax::Id i = 0; i < CELL_DIM; ++i)
+          {
+          dax::Id voxel[8];
+          this->GetVoxel(i, j, k, voxel);
+          for (int cell = 0; cell < numCells; ++cell)
+            {
+            for (int vertex = 0; vertex < numVertices; ++vertex)
+              {
+              connections.push_back(voxel[cells[cell][vertex]]);
+              }
+            }
+          }
+        }
+      }
+    return connections;
+  }
+
+  template<class CellTag, class OutCellTag>
+  void Contour(const std::vector<dax::Id> &connections,
+               dax::cont::UnstructuredGrid<
+                 OutCellTag,ArrayContainer,ArrayContainer,DeviceAdapter>
+               &outGrid) const
+  {
+    dax::cont::UnstructuredGrid<
+        CellTag,ArrayContainer,ArrayContainer,DeviceAdapter> inGrid(
+          dax::cont::make_ArrayHandle(connections,
+                                      ArrayContainer(),
+                                      DeviceAdapter()),
+          dax::cont::make_ArrayHandle(this->Points,
+                                      ArrayContainer(),
+                                      DeviceAdapter()));
+    this->ContourGrid(inGrid, this->Field, outGrid);
+  }
+
+  template<class InGridType, class OutCellTag>
+  void ContourGrid(const InGridType &inGrid,
+                   const std::vector<dax::Scalar> &field,
+                   dax::cont::UnstructuredGrid<
+                     OutCellTag,ArrayContainer,ArrayContainer,DeviceAdapter>
+                   &outGrid) const
+  {
+    dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+        fieldHandle = dax::cont::make_ArrayHandle(field,
+                                                  ArrayContainer(),
+                                                  DeviceAdapter());
+
+    dax::cont::ArrayHandle<dax::Id,ArrayContainer,DeviceAdapter> count;
+    dax::cont::DispatcherMapCell<dax::worklet::MarchingCubesCount>(
+          dax::worklet::MarchingCubesCount(this->IsoValue))
+        .Invoke(inGrid, fieldHandle, count);
+    dax::cont::DispatcherGenerateInterpolatedCells<
+        dax::worklet::MarchingCubesGenerate>(
+          count, dax::worklet::MarchingCubesGenerate(this->IsoValue))
+        .Invoke(inGrid, outGrid, fieldHandle);
+
+    DAX_TEST_ASSERT(outGrid.GetNumberOfCells() > 0, "Nothing contoured");
+    const dax::Id numPoints = outGrid.GetNumberOfPoints();
+    for (dax::Id pointIndex = 0; pointIndex < numPoints; ++pointIndex)
+      {
+      const dax::Vector3 coordinates = outGrid.GetPointCoordinates()
+          .GetPortalConstControl().Get(pointIndex);
+      DAX_TEST_ASSERT(test_equal(dax::dot(coordinates, this->Gradient),
+                                 this->IsoValue),
+                      "Point does not lie on the isosurface");
+      }
+  }
+
+  template<class OutCellTag>
+  dax::Vector3 GetCellPoint(
+      const dax::cont::UnstructuredGrid<
+        OutCellTag,ArrayContainer,ArrayContainer,DeviceAdapter> &grid,
+      dax::Id cellIndex,
+      int vertex) const
+  {
+    const dax::Id pointIndex = grid.GetCellConnections()
+        .GetPortalConstControl().Get(
+          dax::CellTraits<OutCellTag>::NUM_VERTICES*cellIndex + vertex);
+    return grid.GetPointCoordinates().GetPortalConstControl().Get(pointIndex);
+  }
+
+  // Total area of the triangles, checking each faces the higher values.
+  template<class CellTag>
+  dax::Scalar ContourArea(const std::vector<dax::Id> &connections) const
+  {
+    dax::cont::UnstructuredGrid<
+        dax::CellTagTriangle,ArrayContainer,ArrayContainer,DeviceAdapter>
+        outGrid;
+    this->Contour<CellTag>(connections, outGrid);
+    return this->SurfaceArea(outGrid);
+  }
+
+  // Same as ContourArea, but on a rectilinear grid covering the same box
+  // with planes of points that are not evenly spaced.
+  dax::Scalar RectilinearContourArea() const
+  {
+    const dax::Scalar axis[CELL_DIM+1] = { 0.0f, 0.5f, 1.5f, 3.0f,
+                                           4.0f, 5.5f, 6.0f };
+    std::vector<dax::Scalar> axisCoordinates(axis, axis+CELL_DIM+1);
+    dax::cont::ArrayHandle<dax::Scalar,ArrayContainer,DeviceAdapter>
+        axisHandle = dax::cont::make_ArrayHandle(axisCoordinates,
+                                                 ArrayContainer(),
+                                                 DeviceAdapter());
+    dax::cont::RectilinearGrid<ArrayContainer,DeviceAdapter>
+        inGrid(axisHandle, axisHandle, axisHandle);
+
+    std::vector<dax::Scalar> field(inGrid.GetNumberOfPoints());
+    for (dax::Id pointIndex = 0;
+         pointIndex < inGrid.GetNumberOfPoints();
+         ++pointIndex)
+      {
+      field[pointIndex] = dax::dot(inGrid.ComputePointCoordinates(pointIndex),
+                                   this->Gradient);
+      }
+
+    dax::cont::UnstructuredGrid<
+        dax::CellTagTriangle,ArrayContainer,ArrayContainer,DeviceAdapter>
+        outGrid;
+    this->ContourGrid(inGrid, field, outGrid);
+    return this->SurfaceArea(outGrid);
+  }
+
+  dax::Scalar SurfaceArea(
+      const dax::cont::UnstructuredGrid<
+        dax::CellTagTriangle,ArrayContainer,ArrayContainer,DeviceAdapter>
+      &outGrid) const
+  {
+    dax::Scalar area = 0;
+    for (dax::Id cellIndex = 0;
+         cellIndex < outGrid.GetNumberOfCells();
+         ++cellIndex)
+      {
+      const dax::Vector3 p0 = this->GetCellPoint(outGrid, cellIndex, 0);
+      const dax::Vector3 p1 = this->GetCellPoint(outGrid, cellIndex, 1);
+      const dax::Vector3 p2 = this->GetCellPoint(outGrid, cellIndex, 2);
+      const dax::Vector3 normal = dax::math::Cross(p1-p0, p2-p0);
+      DAX_TEST_ASSERT(dax::dot(normal, this->Gradient) > 0,
+                      "Triangle faces the lower values");
+      area += dax::Scalar(0.5)*dax::math::Magnitude(normal);
+      }
+    return area;
+  }
+
+  // Total length of the lines, checking the higher values are on their right.
+  template<class CellTag>
+  dax::Scalar ContourLength(const std::vector<dax::Id> &connections) const
+  {
+    dax::cont::UnstructuredGrid<
+        dax::CellTagLine,ArrayContainer,ArrayContainer,DeviceAdapter>
+        outGrid;
+    this->Contour<CellTag>(connections, outGrid);
+
+    dax::Scalar length = 0;
+    for (dax::Id cellIndex = 0;
+         cellIndex < outGrid.GetNumberOfCells();
+         ++cellIndex)
+      {
+      const dax::Vector3 direction =
+          this->GetCellPoint(outGrid, cellIndex, 1) -
+          this->GetCellPoint(outGrid, cellIndex, 0);
+      DAX_TEST_ASSERT(dax::math::Cross(direction, this->Gradient)[2] < 0,
+                      "Line has the wrong direction");
+      length += dax::math::Magnitude(direction);
+      }
+    return length;
+  }
+
+  void operator()() const
+  {
+    const int hexahedra[1][8] = { {0,1,2,3,4,5,6,7} };
+    const dax::Scalar hexArea = this->ContourArea<dax::CellTagHexahedron>(
+          this->Split(hexahedra, 1, 8, CELL_DIM));
+
+    //six positively oriented tetrahedra around the 0-6 diagonal
+    const int tetrahedra[6][8] = { {0,1,2,6}, {0,2,3,6}, {0,3,7,6},
+                                   {0,7,4,6}, {0,4,5,6}, {0,5,1,6} };
+    const dax::Scalar tetArea = this->ContourArea<dax::CellTagTetrahedron>(
+          this->Split(tetrahedra, 6, 4, CELL_DIM));
+    DAX_TEST_ASSERT(test_equal(tetArea, hexArea),
+                    "Tetrahedra gave a different surface");
+
+    const dax::Scalar rectilinearArea = this->RectilinearContourArea();
+    DAX_TEST_ASSERT(test_equal(rectilinearArea, hexArea),
+                    "Rectilinear grid gave a different surface");
+
+    const int wedges[2][8] = { {0,3,1,4,7,5}, {1,3,2,5,7,6} };
+    const dax::Scalar wedgeArea = this->ContourArea<dax::CellTagWedge>(
+          this->Split(wedges, 2, 6, CELL_DIM));
+    DAX_TEST_ASSERT(test_equal(wedgeArea, hexArea),
+                    "Wedges gave a different surface");
+
+    //the bottom face of the box holds the isoline 17.3 = x + 2y
+    const int quadrilaterals[1][8] = { {0,1,2,3} };
+    const dax::Scalar quadLength =
+        this->ContourLength<dax::CellTagQuadrilateral>(
+          this->Split(quadrilaterals, 1, 4, 0));
+    const int triangles[2][8] = { {0,1,2}, {0,2,3} };
+    const dax::Scalar triLength = this->ContourLength<dax::CellTagTriangle>(
+          this->Split(triangles, 2, 3, 0));
+    DAX_TEST_ASSERT(test_equal(triLength, quadLength),
+                    "Triangles gave a different line");
+  }
+};
+
+//-----------------------------------------------------------------------------
+void TestMarchingCubesBrickRanges()
+  {
+  std::cout << "Counting contour cells through brick ranges" << std::endl;
+  dax::cont::testing::TestGrid<dax::cont::UniformGrid<> > inGrid(DIM);
+
+  dax::Vector3 trueGradient = dax::make_Vector3(1.0, 1.0, 1.0);
+  dax::Id numPoints = inGrid->GetNumberOfPoints();
+  std::vector<dax::Scalar> field(numPoints);
+  for (dax::Id pointIndex = 0; pointIndex < numPoints; pointIndex++)
+    {
+    dax::Vector3 coordinates = inGrid.GetPointCoordinates(pointIndex);
+    field[pointIndex] = dax::dot(coordinates, trueGradient);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+
+  dax::worklet::MarchingCubesCount worklet(ISOVALUE);
+
+  dax::cont::ArrayHandle<dax::Id> trueCount;
+  dax::cont::DispatcherMapCell< dax::worklet::MarchingCubesCount >(
+        worklet).Invoke(inGrid.GetRealGrid(), fieldHandle, trueCount);
+
+  dax::cont::BrickRanges<> ranges(inGrid.GetRealGrid(), fieldHandle);
+  dax::cont::ArrayHandle<dax::Id> brickCount;
+  ranges.CountCells(worklet, fieldHandle, brickCount);
+
+  DAX_TEST_ASSERT(brickCount.GetNumberOfValues()
+                  == trueCount.GetNumberOfValues(),
+                  "Wrong number of counts from brick ranges.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < trueCount.GetNumberOfValues();
+       cellIndex++)
+    {
+    DAX_TEST_ASSERT(brickCount.GetPortalConstControl().Get(cellIndex)
+                    == trueCount.GetPortalConstControl().Get(cellIndex),
+                    "Brick ranges changed the contour count.");
+    }
+
+  // The classify worklet also writes case ids, which only matter for the
+  // cells that generate faces.
+  dax::worklet::MarchingCubesClassify classify(ISOVALUE);
+  dax::cont::ArrayHandle<dax::worklet::MarchingCubesClassify::CaseType>
+      trueCaseIds;
+  dax::cont::DispatcherMapCell< dax::worklet::MarchingCubesClassify >(
+        classify).Invoke(inGrid.GetRealGrid(), fieldHandle,
+                         trueCount, trueCaseIds);
+
+  dax::cont::ArrayHandle<dax::worklet::MarchingCubesClassify::CaseType>
+      brickCaseIds;
+  ranges.CountCells(classify, fieldHandle, brickCount, brickCaseIds);
+
+  DAX_TEST_ASSERT(brickCaseIds.GetNumberOfValues()
+                  == trueCaseIds.GetNumberOfValues(),
+                  "Wrong number of case ids from brick ranges.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < trueCount.GetNumberOfValues();
+       cellIndex++)
+    {
+    const dax::Id numFaces = trueCount.GetPortalConstControl().Get(cellIndex);
+    DAX_TEST_ASSERT(brickCount.GetPortalConstControl().Get(cellIndex)
+                    == numFaces,
+                    "Brick ranges changed the classified count.");
+    DAX_TEST_ASSERT((numFaces == 0) ||
+                    (brickCaseIds.GetPortalConstControl().Get(cellIndex)
+                     == trueCaseIds.GetPortalConstControl().Get(cellIndex)),
+                    "Brick ranges changed the case id.");
+    }
+  }
+
 //-----------------------------------------------------------------------------
 void TestMarchingCubes()
   {
   dax::cont::testing::GridTesting::TryAllGridTypes(
         TestMarchingCubesWorklet(),
         dax::testing::Testing::CellCheckHexahedron());
+  TestContourCellTypes()();
+  TestMarchingCubesBrickRanges();
   }
 } // Anonymous namespace
 
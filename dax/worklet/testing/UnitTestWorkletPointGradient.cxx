@@ -0,0 +1,213 @@
+//=============================================================================
+//
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//
+//  Copyright 2012 Sandia Corporation.
+//  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+//  the U.S. Government retains certain rights in this software.
+//
+//=============================================================================
+
+#include <dax/cont/testing/Testing.h>
+
+#include <dax/worklet/PointGradient.h>
+
+#include <dax/cont/ArrayHandle.h>
+#include <dax/cont/DeviceAdapter.h>
+#include <dax/cont/DispatcherMapPointNeighborhood.h>
+#include <dax/cont/ErrorControlBadValue.h>
+#include <dax/cont/UniformGrid.h>
+
+#include <vector>
+
+namespace {
+
+// Reads the value at a fixed offset of a neighborhood wider than that of
+// PointGradient, to check the values and the clamping at the boundary.
+class ReadNeighbor : public dax::exec::WorkletMapPointNeighborhood
+{
+public:
+  typedef void ControlSignature(TopologyIn, FieldPointNeighborhoodIn, FieldOut);
+  typedef _3 ExecutionSignature(_2);
+
+  static const int NEIGHBORHOOD_RADIUS = 2;
+
+  DAX_EXEC_EXPORT
+  dax::Id operator()(const dax::exec::Neighborhood<dax::Id,2> &field) const
+  {
+    return field.Get(2, -2, 1);
+  }
+};
+
+dax::cont::UniformGrid<> MakeGrid(
+    const dax::Id3 &dims,
+    const dax::Vector3 &spacing = dax::make_Vector3(0.5, 0.25, 2.0))
+{
+  dax::cont::UniformGrid<> grid;
+  grid.SetOrigin(dax::make_Vector3(-1.0, 0.5, 2.0));
+  grid.SetSpacing(spacing);
+  grid.SetExtent(dax::make_Id3(3, -2, 1),
+                 dax::make_Id3(3 + dims[0] - 1,
+                               -2 + dims[1] - 1,
+                               1 + dims[2] - 1));
+  return grid;
+}
+
+// Linear along each axis, so that both central and one sided differences are
+// exact.
+dax::Scalar Field(const dax::Vector3 &p)
+{
+  return 2*p[0] - p[1] + 3*p[2] + p[0]*p[1]*p[2];
+}
+
+dax::Vector3 FieldGradient(const dax::Vector3 &p)
+{
+  return dax::make_Vector3(2 + p[1]*p[2], -1 + p[0]*p[2], 3 + p[0]*p[1]);
+}
+
+void CheckPointGradient(
+    const dax::Id3 &dims,
+    const dax::Id3 &tileSize,
+    const dax::Vector3 &spacing = dax::make_Vector3(0.5, 0.25, 2.0))
+{
+  std::cout << "Point gradient on " << dims[0] << "x" << dims[1] << "x"
+            << dims[2] << " grid, tiles of " << tileSize[0] << "x"
+            << tileSize[1] << "x" << tileSize[2] << ", spacing "
+            << spacing[0] << " " << spacing[1] << " " << spacing[2]
+            << std::endl;
+
+  dax::cont::UniformGrid<> grid = MakeGrid(dims, spacing);
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    field[pointIndex] = Field(grid.ComputePointCoordinates(pointIndex));
+    }
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+  dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+
+  dax::cont::DispatcherMapPointNeighborhood<dax::worklet::PointGradient>
+      dispatcher(dax::worklet::PointGradient(grid.GetSpacing()));
+  dispatcher.SetTileSize(tileSize);
+  dispatcher.Invoke(grid, fieldHandle, gradientHandle);
+
+  DAX_TEST_ASSERT(gradientHandle.GetNumberOfValues()
+                  == grid.GetNumberOfPoints(),
+                  "Wrong number of gradients.");
+  std::vector<dax::Vector3> gradient(grid.GetNumberOfPoints());
+  gradientHandle.CopyInto(gradient.begin());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::Vector3 expected =
+        FieldGradient(grid.ComputePointCoordinates(pointIndex));
+    for (int dimension = 0; dimension < 3; ++dimension)
+      {
+      if (dims[dimension] == 1) { expected[dimension] = 0; }
+      }
+    DAX_TEST_ASSERT(test_equal(gradient[pointIndex], expected),
+                    "Got bad gradient.");
+    }
+}
+
+void CheckNeighborhoodValues(const dax::Id3 &dims, const dax::Id3 &tileSize)
+{
+  std::cout << "Neighborhood values on " << dims[0] << "x" << dims[1] << "x"
+            << dims[2] << " grid" << std::endl;
+
+  dax::cont::UniformGrid<> grid = MakeGrid(dims);
+  std::vector<dax::Id> field(grid.GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    field[pointIndex] = 1000*pointIndex;
+    }
+  dax::cont::ArrayHandle<dax::Id> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+  dax::cont::ArrayHandle<dax::Id> neighborHandle;
+
+  dax::cont::DispatcherMapPointNeighborhood<ReadNeighbor> dispatcher;
+  dispatcher.SetTileSize(tileSize);
+  dispatcher.Invoke(grid, fieldHandle, neighborHandle);
+
+  std::vector<dax::Id> neighbor(grid.GetNumberOfPoints());
+  neighborHandle.CopyInto(neighbor.begin());
+  for (dax::Id pointIndex = 0;
+       pointIndex < grid.GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::Id3 ijk = grid.ComputePointLocation(pointIndex);
+    dax::Id3 offset = dax::make_Id3(2, -2, 1);
+    for (int dimension = 0; dimension < 3; ++dimension)
+      {
+      ijk[dimension] += offset[dimension];
+      const dax::Id low = grid.GetExtent().Min[dimension];
+      const dax::Id high = grid.GetExtent().Max[dimension];
+      if (ijk[dimension] < low) { ijk[dimension] = low; }
+      if (ijk[dimension] > high) { ijk[dimension] = high; }
+      }
+    DAX_TEST_ASSERT(neighbor[pointIndex]
+                    == 1000*grid.ComputePointIndex(ijk),
+                    "Got wrong neighbor value.");
+    }
+}
+
+void CheckBadFieldLength()
+{
+  std::cout << "Field that does not match the grid" << std::endl;
+
+  dax::cont::UniformGrid<> grid = MakeGrid(dax::make_Id3(4, 4, 4));
+  std::vector<dax::Scalar> field(grid.GetNumberOfPoints() - 1, 1);
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+  dax::cont::ArrayHandle<dax::Vector3> gradientHandle;
+
+  bool gotError = false;
+  try
+    {
+    dax::cont::DispatcherMapPointNeighborhood<dax::worklet::PointGradient>(
+          dax::worklet::PointGradient(grid.GetSpacing()))
+        .Invoke(grid, fieldHandle, gradientHandle);
+    }
+  catch (dax::cont::ErrorControlBadValue error)
+    {
+    std::cout << "  Got expected error: " << error.GetMessage() << std::endl;
+    gotError = true;
+    }
+  DAX_TEST_ASSERT(gotError, "Field of the wrong length was not rejected.");
+}
+
+void TestPointGradient()
+{
+  const dax::Id3 defaultTiles = dax::make_Id3(64, 8, 8);
+  CheckPointGradient(dax::make_Id3(21, 14, 10), defaultTiles);
+  CheckPointGradient(dax::make_Id3(21, 14, 10), dax::make_Id3(3, 2, 5));
+  CheckPointGradient(dax::make_Id3(9, 7, 1), dax::make_Id3(4, 4, 4));
+  CheckPointGradient(dax::make_Id3(2, 1, 3), defaultTiles);
+  CheckPointGradient(dax::make_Id3(12, 9, 7), defaultTiles,
+                     dax::make_Vector3(4.0, 0.125, 1.5));
+
+  CheckNeighborhoodValues(dax::make_Id3(11, 6, 5), defaultTiles);
+  CheckNeighborhoodValues(dax::make_Id3(11, 6, 5), dax::make_Id3(4, 3, 2));
+  CheckNeighborhoodValues(dax::make_Id3(1, 2, 1), defaultTiles);
+
+  CheckBadFieldLength();
+}
+
+} // Anonymous namespace
+
+//-----------------------------------------------------------------------------
+int UnitTestWorkletPointGradient(int, char *[])
+{
+  return dax::cont::testing::Testing::Run(TestPointGradient);
+}
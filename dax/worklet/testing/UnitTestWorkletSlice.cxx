@@ -120,6 +120,51 @@ struct TestSliceWorklet
       DAX_TEST_ASSERT(validNumberOfPointsMerge ==
                                           secondOutGrid.GetNumberOfPoints(),
              "Incorrect number of points in the output grid when merging");
+
+      //run again keeping the case of each cell from the first step, which
+      //must generate exactly the same triangles
+      typedef  dax::cont::DispatcherMapCell<
+                          dax::worklet::SliceClassify > ClassifyDispatcher;
+      typedef  dax::cont::DispatcherGenerateInterpolatedCells<
+                  dax::worklet::SliceGenerateFromCase > FromCaseDispatcher;
+      typedef dax::cont::ArrayHandle<dax::worklet::SliceClassify::CaseType,
+                                     ArrayContainer, DeviceAdapter>
+        CaseHandleType;
+
+      CountHandleType caseCount;
+      CaseHandleType caseIds;
+      ClassifyDispatcher classifyDispatcher(
+                          (dax::worklet::SliceClassify(ORIGIN,NORMAL)));
+      classifyDispatcher.Invoke( inGrid.GetRealGrid(),
+                                 inGrid->GetPointCoordinates(),
+                                 caseCount,
+                                 caseIds);
+
+      FromCaseDispatcher fromCaseDispatcher(caseCount,
+                        dax::worklet::SliceGenerateFromCase(ORIGIN,NORMAL));
+      fromCaseDispatcher.SetRemoveDuplicatePoints(false);
+
+      UnstructuredGridType cachedOutGrid;
+      fromCaseDispatcher.Invoke(inGrid.GetRealGrid(),
+                                cachedOutGrid,
+                                caseIds,
+                                dax::worklet::make_MarchingCubesPointField(
+                                  inGrid->GetPointCoordinates()));
+
+      DAX_TEST_ASSERT(validNumberOfCells==cachedOutGrid.GetNumberOfCells(),
+             "Incorrect number of cells in the output grid from cached cases");
+      const dax::Id numCachedPoints = cachedOutGrid.GetNumberOfPoints();
+      DAX_TEST_ASSERT(validNumberOfPointsNoMerge==numCachedPoints,
+             "Incorrect number of points in the output grid from cached cases");
+      for (dax::Id pointIndex = 0; pointIndex < numCachedPoints; ++pointIndex)
+        {
+        const dax::Vector3 expected = outGrid.GetPointCoordinates()
+            .GetPortalConstControl().Get(pointIndex);
+        const dax::Vector3 computed = cachedOutGrid.GetPointCoordinates()
+            .GetPortalConstControl().Get(pointIndex);
+        DAX_TEST_ASSERT(test_equal(expected, computed),
+                        "Cached case generated a different point");
+        }
       }
     catch (dax::cont::ErrorControl error)
       {
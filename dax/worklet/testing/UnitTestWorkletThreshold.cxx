@@ -25,6 +25,8 @@
 #include <dax/TypeTraits.h>
 
 #include <dax/cont/ArrayHandle.h>
+#include <dax/cont/BrickRanges.h>
+#include <dax/cont/RectilinearGrid.h>
 #include <dax/cont/UniformGrid.h>
 #include <dax/cont/DispatcherGenerateTopology.h>
 #include <dax/cont/DispatcherMapCell.h>
@@ -161,6 +163,16 @@ struct TestThresholdWorklet
     this->GridThreshold(in,out);
     }
 
+  //----------------------------------------------------------------------------
+  DAX_CONT_EXPORT
+  void operator()(const dax::cont::RectilinearGrid<>&) const
+    {
+    dax::cont::testing::TestGrid<dax::cont::RectilinearGrid<> > in(DIM);
+    dax::cont::UnstructuredGrid<dax::CellTagHexahedron> out;
+
+    this->GridThreshold(in,out);
+    }
+
   //----------------------------------------------------------------------------
   template <typename InGridType,
             typename OutGridType>
@@ -241,10 +253,54 @@ struct TestThresholdWorklet
 };
 
 
+//-----------------------------------------------------------------------------
+static void TestThresholdBrickRanges()
+  {
+  std::cout << "Counting threshold cells through brick ranges" << std::endl;
+  dax::cont::testing::TestGrid<dax::cont::UniformGrid<> > inGrid(DIM);
+
+  dax::Vector3 trueGradient = dax::make_Vector3(1.0, 1.0, 1.0);
+  std::vector<dax::Scalar> field(inGrid->GetNumberOfPoints());
+  for (dax::Id pointIndex = 0;
+       pointIndex < inGrid->GetNumberOfPoints();
+       pointIndex++)
+    {
+    dax::Vector3 coordinates = inGrid.GetPointCoordinates(pointIndex);
+    field[pointIndex] = dax::dot(coordinates, trueGradient);
+    }
+  dax::cont::ArrayHandle<dax::Scalar> fieldHandle =
+      dax::cont::make_ArrayHandle(field);
+
+  typedef dax::worklet::ThresholdCount< dax::Scalar> CountWorklet;
+  CountWorklet worklet(MIN_THRESHOLD, MAX_THRESHOLD);
+
+  dax::cont::ArrayHandle<dax::Id> trueCount;
+  dax::cont::DispatcherMapCell< CountWorklet >(worklet).Invoke(
+        inGrid.GetRealGrid(), fieldHandle, trueCount);
+
+  dax::cont::BrickRanges<> ranges(inGrid.GetRealGrid(), fieldHandle);
+  dax::cont::ArrayHandle<dax::Id> brickCount;
+  ranges.CountCells(worklet, fieldHandle, brickCount);
+
+  DAX_TEST_ASSERT(brickCount.GetNumberOfValues()
+                  == trueCount.GetNumberOfValues(),
+                  "Wrong number of counts from brick ranges.");
+  for (dax::Id cellIndex = 0;
+       cellIndex < trueCount.GetNumberOfValues();
+       cellIndex++)
+    {
+    DAX_TEST_ASSERT(brickCount.GetPortalConstControl().Get(cellIndex)
+                    == trueCount.GetPortalConstControl().Get(cellIndex),
+                    "Brick ranges changed the threshold count.");
+    }
+  }
+
 //-----------------------------------------------------------------------------
 static void TestThreshold()
   {
   dax::cont::testing::GridTesting::TryAllGridTypes(TestThresholdWorklet());
+  TestThresholdWorklet()(dax::cont::RectilinearGrid<>());
+  TestThresholdBrickRanges();
   }
 } // Anonymous namespace
 